@@ -1,8 +1,10 @@
 #include "Logging.h"
 #include <sstream>
+#include <chrono>
 
 #include "spdlog/common.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
+#include "spdlog/async.h"
 
 #ifdef WINDOWS
 #include <Windows.h>
@@ -10,20 +12,28 @@
 #endif
 
 std::shared_ptr<spdlog::logger> Logger::myLogger;
+std::shared_ptr<spdlog::logger> Logger::myImmediateLogger;
 
 void Logger::Init() {
 	// Set our spd logging pattern
 	spdlog::set_pattern("%^[%l] %n: %v%$");
 
-	// Create a new color logger
-	myLogger = spdlog::stdout_color_mt("APP", spdlog::color_mode::always);
-	// Our log level is set to trace (the highest) by default
-	myLogger->set_level(spdlog::level::trace);
+	// Messages are formatted on the calling thread, then written to the console by a single worker thread
+	spdlog::init_thread_pool(LOG_QUEUE_SIZE, 1);
+
+	// Create a new color logger. If the queue is full, the oldest message is dropped so the caller never waits
+	myLogger = spdlog::stdout_color_mt<spdlog::async_factory_nonblock>("APP", spdlog::color_mode::always);
+	// Our log level is set to the lowest level that was compiled in
+	myLogger->set_level(static_cast<spdlog::level::level_enum>(LOG_ACTIVE_LEVEL));
 	// The default color for trace is the same as info, so we get our color output
 	auto console_sink = dynamic_cast<spdlog::sinks::stdout_color_sink_mt*>(myLogger->sinks().back().get());
 	// and make trace cyan instead
 	console_sink->set_color(spdlog::level::trace, console_sink->CYAN);
 
+	// The immediate logger shares the console, but isn't registered, so it doesn't take the "APP" name from the queued one
+	myImmediateLogger = std::make_shared<spdlog::logger>("APP", myLogger->sinks().back());
+	myImmediateLogger->set_level(spdlog::level::trace);
+
 #ifdef WINDOWS 
 	// Get the process handle
 	HANDLE process = GetCurrentProcess();
@@ -39,9 +49,35 @@ void Logger::Uninitialize()
 	HANDLE process = GetCurrentProcess();
 	SymCleanup(process);
 	myLogger = nullptr;
+	myImmediateLogger = nullptr;
+	// Writes out whatever is still in the queue, then stops the worker thread
 	spdlog::shutdown();
 }
 
+size_t Logger::GetDroppedCount()
+{
+	auto pool = spdlog::thread_pool();
+	return pool != nullptr ? pool->overrun_counter() : 0;
+}
+
+bool LogLimiter::Allow(uint32_t& skipped)
+{
+	int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	int64_t start = myWindowStart.load(std::memory_order_relaxed);
+
+	// Start a new window once the last one is over. Only one thread gets to reset the count
+	if (now - start >= LOG_RATE_LIMIT_WINDOW && myWindowStart.compare_exchange_strong(start, now, std::memory_order_relaxed))
+		myCount.store(0, std::memory_order_relaxed);
+
+	if (myCount.fetch_add(1, std::memory_order_relaxed) < LOG_RATE_LIMIT_COUNT) {
+		skipped = mySkipped.exchange(0, std::memory_order_relaxed);
+		return true;
+	}
+
+	mySkipped.fetch_add(1, std::memory_order_relaxed);
+	return false;
+}
+
 std::string Logger::DumpStackTrace()
 {
 	std::stringstream ss;
@@ -3,6 +3,30 @@
 #include "spdlog/fmt/ostr.h"
 #include "spdlog/logger.h"
 
+#include <atomic>
+#include <stdint.h>
+
+/*
+	The lowest level that gets compiled in. Any log call below it is removed, along with the formatting of its arguments.
+	Define it before including this header (or in the project settings) to override it.
+*/
+#ifndef LOG_ACTIVE_LEVEL
+#ifdef NDEBUG
+#define LOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#else
+#define LOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+#endif
+
+// The amount of messages the queue holds. When it is full, the oldest message is dropped instead of waiting
+#define LOG_QUEUE_SIZE 8192
+
+// Each log call can write this many messages per window, and the rest are counted instead of written
+#define LOG_RATE_LIMIT_COUNT 10
+
+// The length of the rate limit window (in milliseconds)
+#define LOG_RATE_LIMIT_WINDOW 1000
+
 class Logger {
 public:
 	/*
@@ -19,6 +43,14 @@ public:
 		Gets the logging instance
 	*/
 	inline static std::shared_ptr<spdlog::logger>& GetLogger() { return myLogger; }
+	/*
+		Gets a logger that writes to the same console, but writes straight away instead of going through the queue
+	*/
+	inline static std::shared_ptr<spdlog::logger>& GetImmediateLogger() { return myImmediateLogger; }
+	/*
+		Gets the amount of messages that were dropped because the queue was full
+	*/
+	static size_t GetDroppedCount();
 	/*
 		Dumps the current stack trace into a string for logging
 	*/
@@ -26,13 +58,66 @@ public:
 
 private:
 	static std::shared_ptr<spdlog::logger> myLogger;
+	static std::shared_ptr<spdlog::logger> myImmediateLogger;
+};
+
+/*
+	Limits how many messages a single log call can write, so a call in a loop or a repeated GL error doesn't flood the console.
+	Each log macro gets its own limiter.
+*/
+class LogLimiter {
+public:
+	/*
+		Returns true if the message should be written. If messages were held back since the last one was written, 
+		'skipped' is set to the amount of them
+	*/
+	bool Allow(uint32_t& skipped);
+
+private:
+	std::atomic<int64_t> myWindowStart{ 0 };
+	std::atomic<uint32_t> myCount{ 0 };
+	std::atomic<uint32_t> mySkipped{ 0 };
 };
 
+// Writes a message through the queue, if the level is on and the call hasn't gone over its limit
+#define LOG_LIMITED(level, ...) do { \
+	static ::LogLimiter _logLimiter; uint32_t _logSkipped = 0; \
+	if (::Logger::GetLogger()->should_log(level) && _logLimiter.Allow(_logSkipped)) { \
+		if (_logSkipped > 0) ::Logger::GetLogger()->log(level, "({} similar messages were held back)", _logSkipped); \
+		::Logger::GetLogger()->log(level, __VA_ARGS__); \
+	} } while (0)
+
 // Client log macros
-#define LOG_TRACE(...) ::Logger::GetLogger()->trace(__VA_ARGS__)
-#define LOG_INFO(...)  ::Logger::GetLogger()->info(__VA_ARGS__)
-#define LOG_WARN(...)  ::Logger::GetLogger()->warn(__VA_ARGS__)
-#define LOG_ERROR(...) { ::Logger::GetLogger()->error(__VA_ARGS__); ::Logger::GetLogger()->error("Location: \n{}", ::Logger::DumpStackTrace()); }
+#if LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define LOG_TRACE(...) LOG_LIMITED(spdlog::level::trace, __VA_ARGS__)
+#else
+#define LOG_TRACE(...) (void)0
+#endif
+
+#if LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define LOG_INFO(...)  LOG_LIMITED(spdlog::level::info, __VA_ARGS__)
+#else
+#define LOG_INFO(...)  (void)0
+#endif
+
+#if LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define LOG_WARN(...)  LOG_LIMITED(spdlog::level::warn, __VA_ARGS__)
+#else
+#define LOG_WARN(...)  (void)0
+#endif
+
+// The stack trace is only dumped for the errors that make it past the limit
+#if LOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define LOG_ERROR(...) do { \
+	static ::LogLimiter _logLimiter; uint32_t _logSkipped = 0; \
+	if (::Logger::GetLogger()->should_log(spdlog::level::err) && _logLimiter.Allow(_logSkipped)) { \
+		if (_logSkipped > 0) ::Logger::GetLogger()->error("({} similar messages were held back)", _logSkipped); \
+		::Logger::GetLogger()->error(__VA_ARGS__); ::Logger::GetLogger()->error("Location: \n{}", ::Logger::DumpStackTrace()); \
+	} } while (0)
+#else
+#define LOG_ERROR(...) (void)0
+#endif
 
 // Allows us to assert if a value is true, and automagically debug break if it is false
-#define LOG_ASSERT(x, ...) { if (!(x)) { ::Logger::GetLogger()->error(__VA_ARGS__); __debugbreak(); } }
\ No newline at end of file
+// This skips the queue, so the message is on the console before the break
+#define LOG_ASSERT(x, ...) { if (!(x)) { ::Logger::GetImmediateLogger()->error(__VA_ARGS__); __debugbreak(); } }
\ No newline at end of file
@@ -0,0 +1,18 @@
+#version 410
+
+// the vertex of the unit shape (or the line)
+layout (location = 0) in vec3 inPosition;
+
+// the colour and transformation of the instance (or the line)
+layout (location = 1) in vec4 inColor;
+layout (location = 2) in mat4 inModel; // takes up locations 2 - 5
+
+layout (location = 0) out vec4 outColor;
+
+uniform mat4 a_ViewProjection;
+
+void main() {
+	outColor = inColor;
+
+	gl_Position = a_ViewProjection * inModel * vec4(inPosition, 1);
+}
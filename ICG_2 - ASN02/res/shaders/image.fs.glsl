@@ -1,4 +1,4 @@
-#version 410
+#version 420
 
 layout (location = 0) in vec4 inColor;
 layout (location = 1) in vec3 inNormal;
@@ -6,6 +6,17 @@ layout (location = 2) in vec3 inWorldPos;
 layout (location = 3) in vec2 inUV;
 layout (location = 4) in vec3 inTexWeights; // multiple textures with varying opacities
 
+#ifdef SPRITE_ANIMATION
+layout (location = 5) in vec2 inNextUV;
+
+uniform float a_FrameBlend; // how much of the next frame is shown (0 - 1).
+#endif
+
+#ifdef SPRITE_BATCH
+layout (location = 5) in vec2 inNextUV;
+layout (location = 6) flat in float inFrameBlend; // how much of the next frame is shown (0 - 1).
+#endif
+
 layout (location = 0) out vec4 outColor;
 
 uniform float a_Alpha; // the overall alpha value of the entity.
@@ -15,6 +26,13 @@ uniform vec3 a_CameraPos;
 uniform sampler2D s_Albedos[3]; // now takes more than one value.
 
 void main() {
+#ifdef SPRITE_ANIMATION
+	// the current frame is in the first texture, and the next frame is in the second.
+	vec4 albedo = mix(texture(s_Albedos[0], inUV), texture(s_Albedos[1], inNextUV), a_FrameBlend);
+#elif defined(SPRITE_BATCH)
+	// both frames are on the sprite's atlas page.
+	vec4 albedo = mix(texture(s_Albedos[0], inUV), texture(s_Albedos[0], inNextUV), inFrameBlend);
+#else
 	// getting the weights
     float totalWeight = dot(inTexWeights, vec3(1, 1, 1));
 	vec3 weights = inTexWeights / totalWeight;
@@ -24,6 +42,7 @@ void main() {
 	    texture(s_Albedos[0], inUV) * weights.x +
 	    texture(s_Albedos[1], inUV) * weights.y +
 	    texture(s_Albedos[2], inUV) * weights.z;
+#endif
     
     vec3 result = albedo.rgb * inColor.rgb;
 
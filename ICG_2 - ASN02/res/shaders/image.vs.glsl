@@ -1,4 +1,4 @@
-#version 410
+#version 420
 
 layout (location = 0) in vec3 inPosition;
 layout (location = 1) in vec4 inColor;
@@ -11,6 +11,29 @@ layout (location = 2) out vec3 outWorldPos;
 layout (location = 3) out vec2 outUV;
 layout (location = 4) out vec3 outTexWeights;
 
+#if defined(SPRITE_ANIMATION) || defined(SPRITE_BATCH)
+layout (location = 5) out vec2 outNextUV;
+#endif
+
+#ifdef SPRITE_BATCH
+// the frame of the vertex's sprite, which comes from the sprite batch (see SpriteFrame in Mesh.h).
+layout (location = 4) in vec4 inFrame; // the uvs (x0, y0, x1, y1) of the current frame.
+layout (location = 5) in vec4 inNextFrame; // the uvs of the frame that's faded into.
+layout (location = 6) in float inFrameBlend; // how much of the next frame is shown (0 - 1).
+
+layout (location = 6) flat out float outFrameBlend;
+#endif
+
+#ifdef SPRITE_ANIMATION
+// the uvs (x0, y0, x1, y1) of each frame of the animation. The size must match IMAGE_ANIMATION_MAX_FRAMES.
+layout (std140, binding = 0) uniform FrameBlock {
+	vec4 a_Frames[64];
+};
+
+uniform int a_Frame; // the current frame
+uniform int a_NextFrame; // the frame after it, which is faded into.
+#endif
+
 uniform mat4 a_ModelViewProjection;
 uniform mat4 a_Model;
 uniform mat4 a_ModelView;
@@ -31,5 +54,16 @@ void main() {
 	);
 
 
+#ifdef SPRITE_ANIMATION
+	// the mesh's uvs are the corners of the quad, which are moved into each frame's uvs.
+	outUV = mix(a_Frames[a_Frame].xy, a_Frames[a_Frame].zw, inUV);
+	outNextUV = mix(a_Frames[a_NextFrame].xy, a_Frames[a_NextFrame].zw, inUV);
+#elif defined(SPRITE_BATCH)
+	// batched sprites share a material, so each sprite's frame is in its vertices instead of a uniform buffer.
+	outUV = mix(inFrame.xy, inFrame.zw, inUV);
+	outNextUV = mix(inNextFrame.xy, inNextFrame.zw, inUV);
+	outFrameBlend = inFrameBlend;
+#else
 	outUV = inUV;
+#endif
 }
\ No newline at end of file
@@ -1,20 +1,26 @@
 #version 440
 
+// keywords (defined by the shader's variant):
+// SINGLE_LIGHT: lights with the one light set by the a_Light uniforms, instead of the clustered lights.
+// USE_CLEAR_COLOR: background pixels are discarded, so that the clear colour is used for them.
+
 layout (location = 0) in vec4 inColor;
 layout (location = 1) in vec3 inNormal;
 layout (location = 2) in vec2 inScreenCoords;
 layout (location = 3) in vec2 inUV;
 
-layout(location = 0) out vec4 outColor;
+layout (location = 0) out vec4 outColor;
 
 layout(binding = 1) uniform sampler2D s_CameraDepth; // Camera's depth buffer
-layout(binding = 2) uniform sampler2D s_GNormal;     // The normal buffer
+layout(binding = 2) uniform sampler2D s_GNormal;     // The normal buffer (octahedral, RG16)
 
 // The inverse of the camera's view-project matrix (clip->world)
 uniform mat4 a_ViewProjectionInv;
+
 // The position of the camera, in world space
 uniform vec3 a_CameraPos;
 
+#ifdef SINGLE_LIGHT
 // The light's position, in world space
 uniform vec3  a_LightPos;
 // The light's color
@@ -23,15 +29,46 @@ uniform vec3  a_LightColor;
 uniform float a_LightAttenuation;
 // This should really be a GBuffer parameter
 uniform float a_MatShininess;
-
-// if 'true', then the clear colour is used for background pixels.
-uniform int a_UseClearColor;
-
-const vec3 HALF = vec3(0.5);
-const vec3 DOUBLE = vec3(2.0);
-// Unpacks a normal from the [0,1] range to the [-1, 1] range
-vec3 UnpackNormal(vec3 rawNormal) {
-	return (rawNormal - HALF) * DOUBLE;
+#else
+// the size of the cluster grid (matches LightClusters.h)
+#define CLUSTERS_X 16
+#define CLUSTERS_Y 9
+#define CLUSTERS_Z 24
+
+// struct for post light (matches ClusterLight in LightClusters.h)
+struct PostLight
+{
+	vec4 position; // xyz = position, w = radius
+	vec4 color; // rgb = colour, w = attenuation
+	vec4 material; // x = shininess
+};
+
+// post lights. There's no cap, since they're in a storage buffer.
+layout(std430, binding = 0) readonly buffer LightBuffer { PostLight a_Lights[]; };
+
+// the (offset, count) of each cluster's light list.
+layout(std430, binding = 1) readonly buffer ClusterBuffer { uvec2 a_Clusters[]; };
+
+// the light lists of all the clusters.
+layout(std430, binding = 2) readonly buffer IndexBuffer { uint a_LightIndices[]; };
+
+// the view matrix, for getting the depth of the pixel.
+uniform mat4 a_View;
+
+// the near and far planes of the depth slices
+uniform float a_ClusterNear;
+uniform float a_ClusterFar;
+#endif
+
+// Decodes an octahedral normal (stored in the [0, 1] range) back into a unit vector.
+// see: https://knarkowicz.wordpress.com/2014/04/16/octahedron-normal-vector-encoding/
+vec3 DecodeNormal(vec2 encoded) {
+	vec2 f = encoded * 2.0 - 1.0;
+	vec3 n = vec3(f.x, f.y, 1.0 - abs(f.x) - abs(f.y));
+	float t = clamp(-n.z, 0.0, 1.0);
+	n.x += (n.x >= 0.0) ? -t : t;
+	n.y += (n.y >= 0.0) ? -t : t;
+	return normalize(n);
 }
 
 // Calculates a world position from the main camera's depth buffer
@@ -48,7 +85,7 @@ vec4 GetWorldPos(vec2 uv) {
 }
 
 // Caluclate the blinn-phong factor
-vec3 BlinnPhong(vec3 fragPos, vec3 fragNorm, vec3 lightPosition, vec3 lightColor, float lAttenuation) {
+vec3 BlinnPhong(vec3 fragPos, vec3 fragNorm, vec3 lightPosition, vec3 lightColor, float lAttenuation, float lShininess) {
 	// Determine the direction from the position to the light
 	vec3 toLight = lightPosition - fragPos;
 
@@ -65,7 +102,7 @@ vec3 BlinnPhong(vec3 fragPos, vec3 fragNorm, vec3 lightPosition, vec3 lightColor
 
 	// Our specular power is the angle between the the normal and the half vector, raised
 	// to the power of the light's shininess
-	float specPower = pow(max(dot(fragNorm, halfDir), 0.0), a_MatShininess);
+	float specPower = pow(max(dot(fragNorm, halfDir), 0.0), lShininess);
 
 	// Finally, we can calculate the actual specular factor
 	vec3 specOut = specPower * lightColor;
@@ -84,23 +121,40 @@ vec3 BlinnPhong(vec3 fragPos, vec3 fragNorm, vec3 lightPosition, vec3 lightColor
 }
 
 void main() {
+#ifdef USE_CLEAR_COLOR
+	// if its a background pixel, it is discarded so that the clear colour is used instead.
+	if(texture(s_CameraDepth, inUV).r * 2 - 1 == 1.0F)
+		discard;
+#endif
+
 	// Extract the world position from the depth buffer
 	vec4 worldPos = GetWorldPos(inUV);  
 	// Extract our normal from the G Buffer
-	vec3 worldNormal = UnpackNormal(texture(s_GNormal, inUV).rgb);
+	vec3 worldNormal = DecodeNormal(texture(s_GNormal, inUV).rg);
 
+	// result
 	vec3 result = vec3(0, 0, 0);
 
-	// if its a background pixel, it is discarded so that the clear colour is used instead.
-	if(a_UseClearColor > 0 && texture(s_CameraDepth, inUV).r * 2 - 1 == 1.0F)
-	{
-		discard;
-	}
-	else // if its not a background pixel.
+#ifdef SINGLE_LIGHT
+	// Calculate our lighting for this point light
+	result = BlinnPhong(worldPos.xyz, worldNormal, a_LightPos, a_LightColor, a_LightAttenuation, a_MatShininess);
+#else
+	// finding the cluster the pixel is in. The depth slices are exponential, which matches LightClusters::GetSlice().
+	float viewDepth = -(a_View * vec4(worldPos.xyz, 1.0)).z;
+	int slice = int(floor(log(max(viewDepth, a_ClusterNear) / a_ClusterNear) / log(a_ClusterFar / a_ClusterNear) * CLUSTERS_Z));
+	ivec3 cell = ivec3(clamp(ivec2(inUV * vec2(CLUSTERS_X, CLUSTERS_Y)), ivec2(0), ivec2(CLUSTERS_X - 1, CLUSTERS_Y - 1)), clamp(slice, 0, CLUSTERS_Z - 1));
+	uvec2 cluster = a_Clusters[cell.x + CLUSTERS_X * (cell.y + CLUSTERS_Y * cell.z)];
+
+	// loop for the lights in this pixel's cluster
+	for(uint j = 0; j < cluster.y; j++)
 	{
-		// Calculate our lighting for this point light
-		result = BlinnPhong(worldPos.xyz, worldNormal, a_LightPos, a_LightColor, a_LightAttenuation);
+		uint i = a_LightIndices[cluster.x + j];
+
+		// getting the result.
+		result += BlinnPhong(worldPos.xyz, worldNormal, 
+		a_Lights[i].position.xyz, a_Lights[i].color.rgb, a_Lights[i].color.w, a_Lights[i].material.x);
 	}
+#endif
 
 	// Output the result
 	outColor = vec4(result, 1.0);
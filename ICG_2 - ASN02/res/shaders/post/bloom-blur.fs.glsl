@@ -0,0 +1,31 @@
+#version 440
+layout (location = 0) in vec4 inColor;
+layout (location = 1) in vec3 inNormal;
+layout (location = 2) in vec2 inScreenCoords;
+layout (location = 3) in vec2 inUV;
+
+layout (location = 0) out vec4 outColor;
+
+uniform sampler2D xImage;
+
+// the direction of the blur, which is either (1, 0) or (0, 1).
+uniform vec2 xDirection;
+
+// a 9 tap gaussian blur done in 5 samples.
+// neighbouring taps are combined into one sample between them, and the linear filtering weights them.
+// see: https://www.rastergrid.com/blog/2010/09/efficient-gaussian-blur-with-linear-sampling/
+const float OFFSETS[3] = float[](0.0F, 1.3846153846F, 3.2307692308F);
+const float WEIGHTS[3] = float[](0.2270270270F, 0.3162162162F, 0.0702702703F);
+
+void main() {
+	vec2 texel = xDirection / vec2(textureSize(xImage, 0));
+	vec3 color = texture(xImage, inUV).rgb * WEIGHTS[0];
+
+	for(int i = 1; i < 3; i++)
+	{
+		color += texture(xImage, inUV + texel * OFFSETS[i]).rgb * WEIGHTS[i];
+		color += texture(xImage, inUV - texel * OFFSETS[i]).rgb * WEIGHTS[i];
+	}
+
+	outColor = vec4(color, 1.0F);
+}
@@ -0,0 +1,23 @@
+#version 440
+layout (location = 0) in vec4 inColor;
+layout (location = 1) in vec3 inNormal;
+layout (location = 2) in vec2 inScreenCoords;
+layout (location = 3) in vec2 inUV;
+
+layout (location = 0) out vec4 outColor;
+
+// the scene
+uniform sampler2D xImage;
+
+// the bloom (the top of the mip chain after upsampling)
+uniform sampler2D xImage2;
+
+// how bright the bloom is.
+uniform float xIntensity;
+
+void main() {
+	vec3 scene = texture(xImage, inUV).rgb;
+	vec3 bloom = texture(xImage2, inUV).rgb;
+
+	outColor = vec4(scene + bloom * xIntensity, 1.0F);
+}
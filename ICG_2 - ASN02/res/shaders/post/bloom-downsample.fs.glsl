@@ -0,0 +1,38 @@
+#version 440
+layout (location = 0) in vec4 inColor;
+layout (location = 1) in vec3 inNormal;
+layout (location = 2) in vec2 inScreenCoords;
+layout (location = 3) in vec2 inUV;
+
+layout (location = 0) out vec4 outColor;
+
+// the previous (larger) level of the mip chain. For the first level, this is the scene.
+uniform sampler2D xImage;
+
+// if 1, only the colours brighter than the threshold are kept (used for the first level).
+uniform int xPrefilter;
+
+// the brightness that the bloom starts at.
+uniform float xThreshold;
+
+void main() {
+	// the size of a texel in the source image
+	vec2 texel = 1.0F / vec2(textureSize(xImage, 0));
+
+	// each sample is between 4 texels, so the linear filtering averages a 4x4 block with 4 samples.
+	vec3 color = (
+		texture(xImage, inUV + texel * vec2(-1.0F, -1.0F)).rgb +
+		texture(xImage, inUV + texel * vec2( 1.0F, -1.0F)).rgb +
+		texture(xImage, inUV + texel * vec2(-1.0F,  1.0F)).rgb +
+		texture(xImage, inUV + texel * vec2( 1.0F,  1.0F)).rgb
+	) * 0.25F;
+
+	// keeps the part of the colour that's above the threshold, which avoids a hard edge from step().
+	if(xPrefilter == 1)
+	{
+		float luminance = dot(color, vec3(0.299F, 0.587F, 0.114F));
+		color *= max(luminance - xThreshold, 0.0F) / max(luminance, 0.0001F);
+	}
+
+	outColor = vec4(color, 1.0F);
+}
@@ -0,0 +1,34 @@
+#version 440
+layout (location = 0) in vec4 inColor;
+layout (location = 1) in vec3 inNormal;
+layout (location = 2) in vec2 inScreenCoords;
+layout (location = 3) in vec2 inUV;
+
+layout (location = 0) out vec4 outColor;
+
+// the blurred level that's the same size as the output.
+uniform sampler2D xImage;
+
+// the smaller level, which has every level below it added in already.
+uniform sampler2D xImage2;
+
+// how much of the smaller level gets added. This is used to fade in the last level for radii in-between levels.
+uniform float xLowerWeight;
+
+void main() {
+	vec2 texel = 1.0F / vec2(textureSize(xImage2, 0));
+
+	// 3x3 tent filter, which stops the smaller level from looking blocky when it's scaled up.
+	vec3 lower =
+		texture(xImage2, inUV + texel * vec2(-1.0F, -1.0F)).rgb * 1.0F +
+		texture(xImage2, inUV + texel * vec2( 0.0F, -1.0F)).rgb * 2.0F +
+		texture(xImage2, inUV + texel * vec2( 1.0F, -1.0F)).rgb * 1.0F +
+		texture(xImage2, inUV + texel * vec2(-1.0F,  0.0F)).rgb * 2.0F +
+		texture(xImage2, inUV).rgb * 4.0F +
+		texture(xImage2, inUV + texel * vec2( 1.0F,  0.0F)).rgb * 2.0F +
+		texture(xImage2, inUV + texel * vec2(-1.0F,  1.0F)).rgb * 1.0F +
+		texture(xImage2, inUV + texel * vec2( 0.0F,  1.0F)).rgb * 2.0F +
+		texture(xImage2, inUV + texel * vec2( 1.0F,  1.0F)).rgb * 1.0F;
+
+	outColor = vec4(texture(xImage, inUV).rgb + lower * (xLowerWeight / 16.0F), 1.0F);
+}
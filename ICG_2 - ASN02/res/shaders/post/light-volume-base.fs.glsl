@@ -0,0 +1,8 @@
+#version 440
+
+layout (location = 0) out vec4 outColor;
+
+// the lights are added onto black.
+void main() {
+	outColor = vec4(0.0, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,8 @@
+#version 440
+
+// makes a triangle that covers the whole screen from the vertex index, so no vertex data is needed.
+// the triangle is on the far plane.
+void main() {
+	vec2 position = vec2((gl_VertexID == 1) ? 3.0 : -1.0, (gl_VertexID == 2) ? 3.0 : -1.0);
+	gl_Position = vec4(position, 1.0, 1.0);
+}
@@ -0,0 +1,5 @@
+#version 440
+
+// nothing is written, since only the stencil buffer is changed by the volumes.
+void main() {
+}
@@ -1,14 +1,12 @@
 #version 440
 
-layout (location = 0) in vec4 inColor;
-layout (location = 1) in vec3 inNormal;
-layout (location = 2) in vec2 inScreenCoords;
-layout (location = 3) in vec2 inUV;
+// the index of the light this volume belongs to.
+layout (location = 0) flat in int inLight;
 
 layout (location = 0) out vec4 outColor;
 
 layout(binding = 1) uniform sampler2D s_CameraDepth; // Camera's depth buffer
-layout(binding = 2) uniform sampler2D s_GNormal;     // The normal buffer
+layout(binding = 2) uniform sampler2D s_GNormal;     // The normal buffer (octahedral, RG16)
 
 // The inverse of the camera's view-project matrix (clip->world)
 uniform mat4 a_ViewProjectionInv;
@@ -16,33 +14,29 @@ uniform mat4 a_ViewProjectionInv;
 // The position of the camera, in world space
 uniform vec3 a_CameraPos;
 
-// maximum amount of lights
-#define MAX_LIGHTS 25
+// the size of the output, used to get the uv from the pixel position.
+uniform vec2 a_ScreenRes;
 
-// struct for post light
+// struct for post light (matches ClusterLight in LightClusters.h)
 struct PostLight
 {
-	vec3 position;
-	vec3 color;
-	float attenuation;
-	float shininess;
+	vec4 position; // xyz = position, w = radius
+	vec4 color; // rgb = colour, w = attenuation
+	vec4 material; // x = shininess, y = volume type
 };
 
-// post lights
-uniform PostLight a_Lights[MAX_LIGHTS]; 
-
-// number of enabled lights
-uniform int a_EnabledLights;
-
-
-// if 'true', then the clear colour is used for background pixels.
-uniform int a_UseClearColor;
-
-const vec3 HALF = vec3(0.5);
-const vec3 DOUBLE = vec3(2.0);
-// Unpacks a normal from the [0,1] range to the [-1, 1] range
-vec3 UnpackNormal(vec3 rawNormal) {
-	return (rawNormal - HALF) * DOUBLE;
+// the lights, sorted by volume type.
+layout(std430, binding = 3) readonly buffer VolumeBuffer { PostLight a_Volumes[]; };
+
+// Decodes an octahedral normal (stored in the [0, 1] range) back into a unit vector.
+// see: https://knarkowicz.wordpress.com/2014/04/16/octahedron-normal-vector-encoding/
+vec3 DecodeNormal(vec2 encoded) {
+	vec2 f = encoded * 2.0 - 1.0;
+	vec3 n = vec3(f.x, f.y, 1.0 - abs(f.x) - abs(f.y));
+	float t = clamp(-n.z, 0.0, 1.0);
+	n.x += (n.x >= 0.0) ? -t : t;
+	n.y += (n.y >= 0.0) ? -t : t;
+	return normalize(n);
 }
 
 // Calculates a world position from the main camera's depth buffer
@@ -95,50 +89,23 @@ vec3 BlinnPhong(vec3 fragPos, vec3 fragNorm, vec3 lightPosition, vec3 lightColor
 }
 
 void main() {
-	// Extract the world position from the depth buffer
-	vec4 worldPos = GetWorldPos(inUV);  
-	// Extract our normal from the G Buffer
-	vec3 worldNormal = UnpackNormal(texture(s_GNormal, inUV).rgb);
+	vec2 uv = gl_FragCoord.xy / a_ScreenRes;
+	PostLight light = a_Volumes[inLight];
 
-	int enabledLights = a_EnabledLights;
-	enabledLights = clamp(enabledLights, 0, MAX_LIGHTS); // clamping for minimum and maximum
-	
-	// result
-	vec3 result = vec3(0, 0, 0);
+	// background pixels aren't lit.
+	if(texture(s_CameraDepth, uv).r == 1.0)
+		discard;
 
-	// if its a background pixel, it is discarded so that the clear colour is used instead.
-	if(a_UseClearColor > 0 && texture(s_CameraDepth, inUV).r * 2 - 1 == 1.0F)
-	{
+	// Extract the world position from the depth buffer
+	vec4 worldPos = GetWorldPos(uv);
+
+	// the stencil only knows that the pixel is inside a volume of this type, so the radius of this light is checked.
+	if(distance(worldPos.xyz, light.position.xyz) > light.position.w)
 		discard;
-	}
-	else // if its not a background pixel.
-	{
-		// value that will be used to average the result.
-		float div = 0.0F;
-
-		// loop for enabled lights
-		if(enabledLights > 0)
-		{
-			for(int i = 0; i < enabledLights; i++)
-			{
-				// getting the result.
-				vec3 res = BlinnPhong(worldPos.xyz, worldNormal, 
-				a_Lights[i].position, a_Lights[i].color, a_Lights[i].attenuation, a_Lights[i].shininess);
-
-				result += res;
-
-				// if res has no effect on the light colour, it shouldn't be accounted for in the averaging of the colours.
-				if(res != vec3(0, 0, 0))
-					div += 1.0f;
-			}
-
-			// averaging results based on lights that had an effect on the final colour.
-			// result.x = result.x / div;
-			// result.y = result.y / div;
-			// result.z = result.z / div;
-		}
-	}	
-
-	// Output the result
-	outColor = vec4(result, 1.0);
-}
\ No newline at end of file
+
+	// Extract our normal from the G Buffer
+	vec3 worldNormal = DecodeNormal(texture(s_GNormal, uv).rg);
+
+	// the volumes are blended additively.
+	outColor = vec4(BlinnPhong(worldPos.xyz, worldNormal, light.position.xyz, light.color.rgb, light.color.w, light.material.x), 1.0);
+}
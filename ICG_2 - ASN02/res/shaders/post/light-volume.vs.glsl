@@ -0,0 +1,53 @@
+#version 440
+
+layout (location = 0) in vec3 inPosition;
+layout (location = 1) in vec4 inColor;
+layout (location = 2) in vec3 inNormal;
+layout (location = 3) in vec2 inUV;
+
+// the index of the light this volume belongs to.
+layout (location = 0) flat out int outLight;
+
+// struct for post light (matches ClusterLight in LightClusters.h)
+struct PostLight
+{
+	vec4 position; // xyz = position, w = radius
+	vec4 color; // rgb = colour, w = attenuation
+	vec4 material; // x = shininess, y = volume type (0 = sphere, 1 = cube, 2 = cone)
+};
+
+// the lights, sorted by volume type.
+layout(std430, binding = 3) readonly buffer VolumeBuffer { PostLight a_Volumes[]; };
+
+uniform mat4 a_ViewProjection;
+
+// where this volume type starts in the volume buffer.
+uniform int a_InstanceOffset;
+
+// the sphere mesh is made of flat faces inside a sphere with a radius of 1, so it's scaled up to cover the whole sphere.
+const float SPHERE_SCALE = 1.1;
+
+void main() {
+	int index = a_InstanceOffset + gl_InstanceID;
+	PostLight light = a_Volumes[index];
+	float radius = light.position.w;
+	vec3 local;
+
+	switch(int(light.material.y))
+	{
+	case 0: // sphere
+		local = inPosition * radius * SPHERE_SCALE;
+		break;
+
+	case 1: // cube (which goes from -1 to 1)
+		local = inPosition * radius;
+		break;
+
+	default: // cone. The point is moved to the light, and the base is a radius below it.
+		local = vec3(inPosition.xy * radius, (inPosition.z - 1.0) * radius * 0.5);
+		break;
+	}
+
+	outLight = index;
+	gl_Position = a_ViewProjection * vec4(light.position.xyz + local, 1.0);
+}
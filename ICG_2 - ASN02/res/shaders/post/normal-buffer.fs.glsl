@@ -8,7 +8,7 @@ layout (location = 3) in vec2 inUV;
 layout (location = 0) out vec4 outColor;
 
 layout(binding = 1) uniform sampler2D s_CameraDepth; // Camera's depth buffer
-layout(binding = 2) uniform sampler2D s_GNormal;     // The normal buffer
+layout(binding = 2) uniform sampler2D s_GNormal;     // The normal buffer (octahedral, RG16)
 
 uniform vec3 a_CameraPos; // camera position
 
@@ -16,14 +16,24 @@ uniform vec3 a_CameraPos; // camera position
 // rendered image
 uniform sampler2D xImage;
 
+// Decodes an octahedral normal (stored in the [0, 1] range) back into a unit vector.
+// see: https://knarkowicz.wordpress.com/2014/04/16/octahedron-normal-vector-encoding/
+vec3 DecodeNormal(vec2 encoded) {
+	vec2 f = encoded * 2.0 - 1.0;
+	vec3 n = vec3(f.x, f.y, 1.0 - abs(f.x) - abs(f.y));
+	float t = clamp(-n.z, 0.0, 1.0);
+	n.x += (n.x >= 0.0) ? -t : t;
+	n.y += (n.y >= 0.0) ? -t : t;
+	return normalize(n);
+}
+
 void main() {
 	// getting the image
 	vec4 img = texture(xImage, inUV);
 	
-	// gets the normal
-	vec4 norm = texture(s_GNormal, inUV);
-	norm.a = 1.0F;
+	// gets the normal, which is shown in the [0, 1] range.
+	vec4 norm = vec4(DecodeNormal(texture(s_GNormal, inUV).rg) * 0.5F + 0.5F, 1.0F);
 
 	// getting the out color
-	outColor = img * normalize(norm);
+	outColor = img * norm;
 }
\ No newline at end of file
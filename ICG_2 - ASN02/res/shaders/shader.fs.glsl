@@ -6,6 +6,8 @@ layout (location = 2) in vec3 inWorldPos;
 layout (location = 3) in vec2 inUV;
 
 layout (location = 0) out vec4 outColor;
+layout (location = 1) out vec2 outNormal; // octahedral normal (g-buffer)
+layout (location = 2) out vec2 outMaterial; // material id and roughness (g-buffer)
 
 uniform float a_Alpha; // alpha value
 
@@ -15,6 +17,25 @@ uniform vec3 a_CameraPos; // camera position
 
 // uniform sampler2D s_Albedo
 
+// the material id (0 - 255) and roughness (0 - 1) written to the g-buffer.
+uniform int a_MaterialId;
+uniform float a_Roughness;
+
+// wraps the lower half of the octahedron over the upper half.
+vec2 OctWrap(vec2 v) {
+	return (1.0 - abs(v.yx)) * vec2((v.x >= 0.0) ? 1.0 : -1.0, (v.y >= 0.0) ? 1.0 : -1.0);
+}
+
+// Encodes a unit normal into two values in the [0, 1] range by projecting it onto an octahedron.
+// see: https://knarkowicz.wordpress.com/2014/04/16/octahedron-normal-vector-encoding/
+vec2 EncodeNormal(vec3 n) {
+	n /= (abs(n.x) + abs(n.y) + abs(n.z));
+	n.xy = (n.z >= 0.0) ? n.xy : OctWrap(n.xy);
+	return n.xy * 0.5 + 0.5;
+}
+
 void main() {
 	outColor = vec4(inColor.rgb, inColor.a * a_Alpha); // * a_ColorMultiplier;
+	outNormal = EncodeNormal(normalize(inNormal));
+	outMaterial = vec2(a_MaterialId / 255.0, a_Roughness);
 }
\ No newline at end of file
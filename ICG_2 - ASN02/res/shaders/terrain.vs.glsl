@@ -37,6 +37,10 @@ void main() {
 	float t = texture(a_TextureSampler, inUV).r; // treats the pixel colour as the value of 't'
 	vertPos.z = (1.0f - t) * a_HeightMin + t * a_HeightMax; // lerps between the maximum and minimum height.
 
+	// the z position is only used by the skirts of the terrain patches, which hang below the edges to hide cracks.
+	// it's a fraction of the height range, so the skirts still reach far enough if the range changes.
+	vertPos.z += inPosition.z * abs(a_HeightMax - a_HeightMin);
+
 	outVertHeight =  vertPos.z; // saving the position of the vertex
 
 	gl_Position = a_ModelViewProjection * vec4(vertPos, 1);
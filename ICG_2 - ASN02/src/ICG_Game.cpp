@@ -27,7 +27,10 @@ void icg::ICG_Game::LoadContent()
 
 	// main scene.
 	ICG_MainScene * mainScene = new ICG_MainScene("ICG_2 - ASN02");
-	RegisterScene(mainScene, true);
+	RegisterScene(mainScene, false);
+
+	// the debug scene stays open while the main scene's files are read on the worker thread.
+	SetCurrentSceneWhenReady(mainScene->GetName());
 }
 
 // drawing imgui
@@ -11,15 +11,15 @@
 	* http://www.cplusplus.com/reference/vector/vector/resize/
 */
 
-// the maximum amount of post processed lights. 
-#define MAX_POST_LIGHTS 25
-
 // Main Scene
 #include "ICG_MainScene.h"
 #include "cherry/Game.h"
+#include "cherry/GLState.h"
+#include "cherry/ShaderCache.h"
 #include "cherry/objects/Primitives.h"
 #include "cherry/utils/Utils.h"
 #include <imgui\imgui.h>
+#include <toolkit/Logging.h>
 
 
 // if 'true', then the defaut light is enabled
@@ -31,6 +31,21 @@ icg::ICG_MainScene::ICG_MainScene(const std::string a_Name)
 {
 }
 
+// scene preload
+void icg::ICG_MainScene::OnPreload()
+{
+	cherry::GameplayScene::OnPreload();
+
+	// the light file is parsed here, so OnOpen() only makes the lights.
+	if (!DEFAULT_LIGHT_ENABLED)
+	{
+		preloadLights.clear();
+
+		if (ReadLightFile(LIGHT_INFO_FILE, preloadLights, preloadLightsEnabled))
+			preloadLightFile = LIGHT_INFO_FILE;
+	}
+}
+
 // scene open
 void icg::ICG_MainScene::OnOpen()
 {
@@ -87,24 +102,20 @@ void icg::ICG_MainScene::OnOpen()
 	LoadObjects();
 
 	/// FRAME BUFFERS
-	// frame buffer
-	FrameBuffer::Sptr fb = std::make_shared<FrameBuffer>(myWindowSize.x, myWindowSize.y);
+	// frame buffer, which is a g-buffer (albedo, octahedral normals, materials, and depth-stencil).
+	FrameBuffer::Sptr fb = GBuffer::Create(myWindowSize.x, myWindowSize.y);
 
-	// scene colour 
+	// scene colour, which is used for the light buffer.
 	RenderBufferDesc sceneColor = RenderBufferDesc();
 	sceneColor.ShaderReadable = true;
 	sceneColor.Attachment = RenderTargetAttachment::Color0;
 	sceneColor.Format = RenderTargetType::Color24; // loads with RGB
 
-	// scene depth
+	// scene depth, which has a stencil so that its depth can be copied into the light volume buffer.
 	RenderBufferDesc sceneDepth = RenderBufferDesc();
 	sceneDepth.ShaderReadable = true;
-	sceneDepth.Attachment = RenderTargetAttachment::Depth;
-	sceneDepth.Format = RenderTargetType::Depth24;
-
-	// colour and depth attachments
-	fb->AddAttachment(sceneColor);
-	fb->AddAttachment(sceneDepth);
+	sceneDepth.Attachment = RenderTargetAttachment::DepthStencil;
+	sceneDepth.Format = RenderTargetType::DepthStencil;
 
 	// registry frame buffer
 	Registry().ctx_or_set<FrameBuffer::Sptr>(fb);
@@ -117,7 +128,11 @@ void icg::ICG_MainScene::OnOpen()
 	// post light
 	if (DEFAULT_LIGHT_ENABLED)
 	{
-		postLight = new PostLight(GetName(), POST_VS, BLINN_PHONG_POST);
+		// the single light variant of the lighting shader, which uses the clear colour.
+		Shader::Sptr lightShader = std::make_shared<Shader>();
+		lightShader->Load(POST_VS, BLINN_PHONG_POST, { SINGLE_LIGHT_KEYWORD, USE_CLEAR_COLOR_KEYWORD });
+
+		postLight = new PostLight(GetName(), lightShader);
 		postLight->SetVolumeType(1);
 		postLight->position = { 1.0F, 1.0F, 10.0F };
 		postLight->color = { 0.214F, 0.892F, 0.528F };
@@ -128,7 +143,6 @@ void icg::ICG_MainScene::OnOpen()
 		postLight->shader->SetUniform("a_LightColor", postLight->color);
 		postLight->shader->SetUniform("a_LightAttenuation", postLight->attenuation);
 		postLight->shader->SetUniform("a_MatShininess", postLight->shininess);
-		postLight->shader->SetUniform("a_UseClearColor", 1); // uses clear color instead of black
 
 		// light buffer 
 		ls_fb = std::make_shared<FrameBuffer>(myWindowSize.x, myWindowSize.y);
@@ -146,7 +160,7 @@ void icg::ICG_MainScene::OnOpen()
 		// LoadFromFile("res/icg_2-asn02-light_info-01.txt");
 		// LoadFromFile("res/icg_2-asn02-light_info-02.txt");
 		// LoadFromFile("res/icg_2-asn02-light_info-03.txt");
-		LoadFromFile("res/icg_2-asn02-light_info-04.txt");
+		LoadFromFile(LIGHT_INFO_FILE);
 		// LoadFromFile("res/icg_2-asn02-light_info-05.txt");
 		UseClearColor(true);
 
@@ -174,12 +188,8 @@ void icg::ICG_MainScene::OnOpen()
 		edDesc.Attachment = RenderTargetAttachment::Depth;
 		edDesc.Format = RenderTargetType::Depth24;
 
-		// frame buffer
-		FrameBuffer::Sptr efb = std::make_shared<FrameBuffer>(myWindowSize.x, myWindowSize.y);
-		efb->AddAttachment(ecDesc);
-		efb->AddAttachment(edDesc);
-
-		effectLayer1 = new PostLayer(effectShader, efb);
+		// the frame buffer is taken from the render graph's pool each frame.
+		effectLayer1 = new PostLayer(effectShader, std::vector<RenderBufferDesc>{ ecDesc, edDesc });
 	}
 
 	// effect layer 2
@@ -199,11 +209,6 @@ void icg::ICG_MainScene::OnOpen()
 		edDesc.Attachment = RenderTargetAttachment::Depth;
 		edDesc.Format = RenderTargetType::Depth24;
 
-		// frame buffer
-		FrameBuffer::Sptr efb = std::make_shared<FrameBuffer>(myWindowSize.x, myWindowSize.y);
-		efb->AddAttachment(ecDesc);
-		efb->AddAttachment(edDesc);
-
 		// uniforms
 		effectShader->SetUniform("xKernel", glm::mat3(
 			1.0f / 9.0f * 1.0F, 1.0f / 9.0f * 1.0F, 1.0f / 9.0f * 1.0F,
@@ -211,11 +216,15 @@ void icg::ICG_MainScene::OnOpen()
 			1.0f / 9.0f * 1.0F, 1.0f / 9.0f * 1.0F, 1.0f / 9.0f * 1.0F
 		));
 
-		effectLayer2 = new PostLayer(effectShader, efb);
+		// the frame buffer is taken from the render graph's pool each frame.
+		effectLayer2 = new PostLayer(effectShader, std::vector<RenderBufferDesc>{ ecDesc, edDesc });
 		
 
 	}
 
+	// bloom layer
+	bloomLayer = new BloomLayer();
+
 	useFrameBuffers = true;
 
 	// TODO: make lights move around. 
@@ -345,6 +354,12 @@ void icg::ICG_MainScene::OnClose()
 	util::removeFromVector<PostLayer>(layers, effectLayer2);
 	delete effectLayer2;
 
+	util::removeFromVector<PostLayer>(layers, bloomLayer);
+	delete bloomLayer;
+
+	util::removeFromVector<PostLayer>(layers, lightVolumeLayer);
+	delete lightVolumeLayer;
+
 	// deleting the ohter lights
 	for (PostLight* light : lights)
 		delete light;
@@ -497,11 +512,18 @@ void icg::ICG_MainScene::KeyPressed(GLFWwindow* window, int key)
 
 	case GLFW_KEY_8: // effect 1
 		EnableEffect1();
+		break;
 
-	case GLFW_KEY_9:
+	case GLFW_KEY_9: // effect 2 (3x3 kernel)
 		EnableEffect2();
+		break;
+
+	case GLFW_KEY_0: // bloom
+		EnableBloom();
+		break;
 
-	case GLFW_KEY_0:
+	case GLFW_KEY_V: // light volumes or full screen lighting
+		SetLightVolumesEnabled(!useLightVolumes);
 		break;
 	}
 }
@@ -672,10 +694,138 @@ void icg::ICG_MainScene::DrawGui(float deltaTime)
 	tempInt = enabledLights;
 	if (ImGui::InputInt("Enabled Lights", &tempInt))
 	{
-		tempInt = glm::clamp(tempInt, 0, MAX_POST_LIGHTS);
+		tempInt = glm::clamp(tempInt, 0, (int)lights.size());
 		SetEnabledLights(tempInt);
 	}
 
+	// the clustered light lists from the last update, or the light volumes.
+	if (!DEFAULT_LIGHT_ENABLED && !useLightVolumes)
+	{
+		ImGui::Text("Light Clusters (V): %u lights, %u indices, %u max per cluster", lightClusters.GetLightCount(),
+			(unsigned int)lightClusters.GetLightIndices().size(), lightClusters.GetMaxLightsPerCluster());
+
+		if (lightLayer != nullptr)
+			ImGui::Text("Clustered Lighting: %.3f ms", lightLayer->GetGpuTime());
+	}
+	else if (!DEFAULT_LIGHT_ENABLED && lightVolumeLayer != nullptr)
+	{
+		ImGui::Text("Light Volumes (V): %u spheres, %u cubes, %u cones",
+			lightVolumeLayer->GetLightCount(LightVolumeLayer::SPHERE), lightVolumeLayer->GetLightCount(LightVolumeLayer::CUBE),
+			lightVolumeLayer->GetLightCount(LightVolumeLayer::CONE));
+
+		ImGui::Text("Volume Lighting: %.3f ms", lightVolumeLayer->GetGpuTime());
+	}
+
+	// the size of the g-buffer per frame compared to the old layout (RGB8 colour and 24-bit depth).
+	{
+		static const std::vector<RenderBufferDesc> gBufferTargets = GBuffer::GetTargets();
+		static const std::vector<RenderBufferDesc> oldTargets = {
+			GBuffer::MakeTarget(RenderTargetAttachment::Color0, RenderTargetType::Color24),
+			GBuffer::MakeTarget(RenderTargetAttachment::Depth, RenderTargetType::Depth24)
+		};
+
+		ImGui::Text("G-Buffer: %u bytes per pixel (old: %u)", GBuffer::GetBytesPerPixel(gBufferTargets), GBuffer::GetBytesPerPixel(oldTargets));
+		ImGui::Text("G-Buffer 1080p: %.2f MB (old: %.2f MB)", GBuffer::GetSizeMB(gBufferTargets, 1920, 1080), GBuffer::GetSizeMB(oldTargets, 1920, 1080));
+		ImGui::Text("G-Buffer 4K: %.2f MB (old: %.2f MB)", GBuffer::GetSizeMB(gBufferTargets, 3840, 2160), GBuffer::GetSizeMB(oldTargets, 3840, 2160));
+	}
+
+	// the OpenGL state calls that were sent and skipped in the last frame.
+	ImGui::Text("GL State Calls: %llu issued, %llu avoided",
+		(unsigned long long)GLState::GetFrameCallsIssued(), (unsigned long long)GLState::GetFrameCallsAvoided());
+
+	// the shader variants that have been compiled, and the time spent compiling them.
+	ImGui::Text("Shader Variants: %u compiled (%u cached), %.1f ms", Shader::GetCompiledVariantCount(),
+		(unsigned int)ShaderCache::GetCount(), Shader::GetCompileTime());
+
+	// the primitive shapes that have been generated, which are shared by the primitives made with the same settings.
+	ImGui::Text("Primitive Shapes: %u cached", (unsigned int)PrimitiveCache::GetCount());
+	ImGui::Text("Log Messages Dropped: %u", (unsigned int)Logger::GetDroppedCount());
+
+	// the raycast benchmarks on the character model, once on its own and once as 10k copies. The frame stalls while they run.
+	if (ImGui::Button("Ray Benchmark"))
+	{
+		meshBenchmark = RayBenchmark::RunMesh("res/objects/charactoereee.obj");
+		sceneBenchmark = RayBenchmark::RunScene("res/objects/charactoereee.obj", 10000);
+	}
+
+	if (meshBenchmark.Rays > 0)
+	{
+		ImGui::Text("Rays (Mesh): %.2f M/s, %.2f M/s in packets", meshBenchmark.RaysPerSecond / 1.0E6, meshBenchmark.PacketRaysPerSecond / 1.0E6);
+		ImGui::Text("Rays (%u Objects): %.2f M/s", (unsigned int)sceneBenchmark.Primitives, sceneBenchmark.RaysPerSecond / 1.0E6);
+	}
+
+	// the rigid body benchmark, which settles stacks of boxes twice and compares the results.
+	if (ImGui::Button("Physics Benchmark"))
+		physicsBenchmark = PhysicsBenchmark::Run();
+
+	if (physicsBenchmark.Steps > 0)
+	{
+		ImGui::Text("Physics (%u Bodies): %.3f ms per step, %u asleep, %s", physicsBenchmark.Bodies, physicsBenchmark.AverageStepTime,
+			physicsBenchmark.SleepingBodies, physicsBenchmark.Deterministic ? "deterministic" : "NOT deterministic");
+	}
+
+	// the object systems on 50k entities, compared with walking every entity.
+	if (ImGui::Button("Object Systems Benchmark"))
+		systemsBenchmark = ObjectBenchmark::RunSystems();
+
+	if (systemsBenchmark.Frames > 0)
+	{
+		ImGui::Text("Object Systems (%u Entities): %.3f ms per frame (%.3f ms visiting all), %s", systemsBenchmark.Entities,
+			systemsBenchmark.TaggedTime, systemsBenchmark.UntaggedTime, systemsBenchmark.Matching ? "matching" : "NOT matching");
+	}
+
+	// adding and removing 100k objects from an object list.
+	if (ImGui::Button("Object List Benchmark"))
+		listBenchmark = ObjectBenchmark::RunList();
+
+	if (listBenchmark.Objects > 0)
+	{
+		ImGui::Text("Object List (%u Objects): %.3f ms to add, %.3f ms to remove, %s", listBenchmark.Objects,
+			listBenchmark.InsertTime, listBenchmark.RemoveTime, listBenchmark.Correct ? "correct" : "NOT correct");
+	}
+
+	// the wave heights for 100k samples, buoyancy for 10k boxes, and the CPU waves compared with the water shader.
+	if (ImGui::Button("Wave Benchmark"))
+		waveBenchmark = WaveBenchmark::Run();
+
+	if (waveBenchmark.Samples > 0)
+	{
+		ImGui::Text("Waves (%u Samples): %.3f ms, %.3f ms batched", waveBenchmark.Samples, waveBenchmark.SingleTime, waveBenchmark.BatchTime);
+		ImGui::Text("Buoyancy (%u Boxes): %.3f ms per update", waveBenchmark.Floaters, waveBenchmark.BuoyancyTime);
+		ImGui::Text("Waves vs. Shader: %.6f position, %.6f height, %s", waveBenchmark.MaxPositionError, waveBenchmark.MaxHeightError,
+			waveBenchmark.Passed ? "matching" : "NOT matching");
+	}
+
+	// checks the light clusters against a brute force search, with the lights from the last update and with 4096 scattered lights.
+	if (!DEFAULT_LIGHT_ENABLED && ImGui::Button("Light Cluster Check"))
+	{
+		sceneClusterCheck = LightClusterCheck::Run(lightClusters.GetLights(), myCamera->GetView(), myCamera->GetProjection(),
+			lightClusters.GetNearPlane(), lightClusters.GetFarPlane());
+		scatteredClusterCheck = LightClusterCheck::Run();
+	}
+
+	if (scatteredClusterCheck.Samples > 0)
+	{
+		ImGui::Text("Light Clusters (%u Lights): %.2f per sample, %.2f reach, %s", sceneClusterCheck.Lights, sceneClusterCheck.AverageClusterLights,
+			sceneClusterCheck.AverageReachingLights, sceneClusterCheck.Passed ? "passed" : "FAILED");
+		ImGui::Text("Light Clusters (%u Lights): %.3f ms build, %.2f per sample, %.2f reach, %s", scatteredClusterCheck.Lights, scatteredClusterCheck.BuildTime,
+			scatteredClusterCheck.AverageClusterLights, scatteredClusterCheck.AverageReachingLights, scatteredClusterCheck.Passed ? "passed" : "FAILED");
+	}
+
+	// bloom settings, and the GPU time of the bloom next to the 3x3 kernel it replaces (the last time each was used).
+	if (bloomLayer != nullptr)
+	{
+		float bloomRadius = bloomLayer->GetRadius();
+
+		if (ImGui::SliderFloat("Bloom Radius", &bloomRadius, 4.0F, 1024.0F, "%.0f", 2.0F))
+			bloomLayer->SetRadius(bloomRadius);
+
+		ImGui::Text("Bloom (Mip Chain): %.3f ms, %u levels", bloomLayer->GetGpuTime(), bloomLayer->GetLevelCount());
+	}
+
+	if (effectLayer2 != nullptr)
+		ImGui::Text("3x3 Kernel: %.3f ms", effectLayer2->GetGpuTime());
+
 	// multiple lights
 	if (!DEFAULT_LIGHT_ENABLED)
 	{
@@ -687,7 +837,6 @@ void icg::ICG_MainScene::DrawGui(float deltaTime)
 		{
 			// light index bounds
 			lightIndex = glm::clamp(lightIndex, 0, (int)lights.size() - 1);
-			lightIndex = glm::clamp(lightIndex, 0, MAX_POST_LIGHTS - 1);
 
 			imguiCoord = lights[lightIndex]->position;
 		}
@@ -737,7 +886,7 @@ void icg::ICG_MainScene::DrawGui(float deltaTime)
 	// 	glm::vec2 posLimitsY{ -250.0F, 250.0F };
 	// 	glm::vec2 posLimitsZ{  0.0F, 10.0F };
 	// 
-	// 	for (int i = 0; i < lights.size() && i < MAX_POST_LIGHTS; i++)
+	// 	for (int i = 0; i < lights.size(); i++)
 	// 	{
 	// 		ImGui::BeginTabItem(std::string("Light " + std::to_string(i)).c_str());
 	// 
@@ -795,7 +944,7 @@ void icg::ICG_MainScene::DisableLight() { LightActivation(false); }
 // sets the amount of enabled lights.
 void icg::ICG_MainScene::SetEnabledLights(int enabled)
 {
-	if (enabled < 0 || enabled > MAX_POST_LIGHTS)
+	if (enabled < 0)
 		return;
 	
 	// only total amount of lights can be used.
@@ -919,7 +1068,7 @@ void icg::ICG_MainScene::EnableLightingView()
 	const Game* game = Game::GetRunningGame();
 
 	layers.clear();
-	layers.push_back(lightLayer);
+	layers.push_back(GetLightingLayer());
 
 	// updating the size of the buffer
 	lightLayer->OnWindowResize(game->GetWindowWidth(), game->GetWindowHeight());
@@ -936,7 +1085,7 @@ void icg::ICG_MainScene::EnableEffect1()
 	const Game* game = Game::GetRunningGame();
 
 	layers.clear();
-	layers.push_back(lightLayer);
+	layers.push_back(GetLightingLayer());
 	layers.push_back(effectLayer1);
 
 	// updating the size of the buffer
@@ -955,7 +1104,7 @@ void icg::ICG_MainScene::EnableEffect2()
 	const Game* game = Game::GetRunningGame();
 
 	layers.clear();
-	layers.push_back(lightLayer);
+	layers.push_back(GetLightingLayer());
 	layers.push_back(effectLayer2);
 
 	// updating the size of the buffer
@@ -963,39 +1112,130 @@ void icg::ICG_MainScene::EnableEffect2()
 	effectLayer2->OnWindowResize(game->GetWindowWidth(), game->GetWindowHeight());
 }
 
-// loads the lights from a file
-void icg::ICG_MainScene::LoadFromFile(std::string filePath)
+// enables the bloom
+void icg::ICG_MainScene::EnableBloom()
 {
 	using namespace cherry;
-	
-	// gets the running game
+
+	if (bloomLayer == nullptr)
+		return;
+
 	const Game* game = Game::GetRunningGame();
 
+	layers.clear();
+	layers.push_back(GetLightingLayer());
+	layers.push_back(bloomLayer);
+
+	// updating the size of the buffer
+	lightLayer->OnWindowResize(game->GetWindowWidth(), game->GetWindowHeight());
+}
+
+// reads the lights from a file
+bool icg::ICG_MainScene::ReadLightFile(const std::string& filePath, std::vector<LightInfo>& lightInfos, int& enabled)
+{
+	using namespace cherry;
+
 	// opening the file
 	std::ifstream file(filePath, std::ios::in);
 
 	if (!file)
 	{
-		std::runtime_error("File cannot be opened.");
-		file.close();
-		return;
+		LOG_ERROR("Light file cannot be opened: {}", filePath);
+		return false;
 	}
 
-	// no game is running.
-	if (game == nullptr)
-		return;
-
 	// Read Variables
 	// a line from the file.
 	std::string line;
 	std::vector<std::string> comps; // components
+	enabled = -1; // the amount of enabled lights from the file (-1 if not provided)
+
+	while (std::getline(file, line))
+	{
+		// splits a string based on the spaces in it.
+		// although it's separated by tabs, spacing will be detected as the same thing.
+		comps = util::splitString<std::string>(line);
+
+		// empty line
+		if (comps.empty())
+			continue;
+
+		if (comps[0] == "Enabled" && comps.size() >= 2) // amount of enabled lights
+		{
+			// setting the amount of enabled lights (there's no maximum, since the lights are clustered)
+			enabled = util::convertString<int>(comps[1]);
+		}
+		else if (util::isInt(comps[0]) && comps.size() >= 10) // number value of some sort.
+		{
+			// Order
+			// Number/Type/PositionX/PositionY/PositionZ/ColorRed/ColorGreen/ColorBlue/Attenuation/Shininess 
+			LightInfo info;
+
+			info.Number = util::convertString<int>(comps[0]);
+
+			// Type (1 = sphere, 2 = cube, 3 = cone)
+			info.Type = util::convertString<int>(comps[1]);
+
+			// Position (x, y, z)
+			info.Position.x = util::convertString<float>(comps[2]);
+			info.Position.y = util::convertString<float>(comps[3]);
+			info.Position.z = util::convertString<float>(comps[4]);
+
+			// Color (r, g, b)
+			info.Color.r = util::convertString<float>(comps[5]);
+			info.Color.g = util::convertString<float>(comps[6]);
+			info.Color.b = util::convertString<float>(comps[7]);
+
+			// Attenuation
+			info.Attenuation = util::convertString<float>(comps[8]);
+
+			// Shininess
+			info.Shininess = util::convertString<float>(comps[9]);
+
+			lightInfos.push_back(info);
+		}
+	}
+
+	file.close();
+	return true;
+}
+
+// loads the lights from a file
+void icg::ICG_MainScene::LoadFromFile(std::string filePath)
+{
+	using namespace cherry;
+	
+	// gets the running game
+	const Game* game = Game::GetRunningGame();
+
+	// no game is running.
+	if (game == nullptr)
+		return;
+
+	std::vector<LightInfo> lightInfos; // the lights from the file.
+	int fileEnabled = -1; // the amount of enabled lights from the file (-1 if not provided)
+
+	// the file was already read while the scene was preloading.
+	if (filePath == preloadLightFile)
+	{
+		lightInfos = std::move(preloadLights);
+		fileEnabled = preloadLightsEnabled;
+
+		preloadLightFile = "";
+		preloadLights.clear();
+		preloadLightsEnabled = -1;
+	}
+	else if (!ReadLightFile(filePath, lightInfos, fileEnabled))
+	{
+		return;
+	}
 
 	// post-processing shader
 	cherry::Shader::Sptr ls_shader = std::make_shared<Shader>();
 	cherry::Material::Sptr ls_material;
 
 	// light shader
-	ls_shader->Load(POST_VS, BLINN_PHONG_POST_MULTI);
+	ls_shader->Load(POST_VS, BLINN_PHONG_POST);
 	ls_material = std::make_shared<Material>(ls_shader);
 
 	// scene colour
@@ -1004,11 +1244,11 @@ void icg::ICG_MainScene::LoadFromFile(std::string filePath)
 	sceneColor.Attachment = RenderTargetAttachment::Color0;
 	sceneColor.Format = RenderTargetType::Color24; // loads with RGB
 
-	// scene depth
+	// scene depth. The stencil is used by the light volumes.
 	RenderBufferDesc sceneDepth = RenderBufferDesc();
 	sceneDepth.ShaderReadable = true;
-	sceneDepth.Attachment = RenderTargetAttachment::Depth;
-	sceneDepth.Format = RenderTargetType::Depth24;
+	sceneDepth.Attachment = RenderTargetAttachment::DepthStencil;
+	sceneDepth.Format = RenderTargetType::DepthStencil;
 
 	// light buffer 
 	ls_fb = std::make_shared<FrameBuffer>((float)game->GetWindowWidth(), (float)game->GetWindowHeight());
@@ -1018,70 +1258,38 @@ void icg::ICG_MainScene::LoadFromFile(std::string filePath)
 	// adding the post processing layer. 
 	lightLayer = new PostLayer(ls_shader, ls_fb);
 	layers.push_back(lightLayer);
-	
-	// int index = 0;
 
-	while (std::getline(file, line))
-	{
-		// splits a string based on the spaces in it.
-		// although it's separated by tabs, spacing will be detected as the same thing.
-		comps = util::splitString<std::string>(line);
-
-		if (comps[0] == "Enabled") // amount of enabled lights
-		{
-			// TODO: is this needed?
-			// lights.resize(util::convertString<int>(comps[1]));
-
-			// setting the amount of enabled lights (max is 25)
-			ls_shader->SetUniform("a_EnabledLights", util::convertString<int>(comps[1]));
-		}
-		else if (util::isInt(comps[0])) // number value of some sort.
-		{
-			// Order
-			// Number/Type/PositionX/PositionY/PositionZ/ColorRed/ColorGreen/ColorBlue/Attenuation/Shininess 
-	
-			// passing in the scene name, the material, and the index.
-			PostLight* light = new PostLight(GetName(), ls_material, util::convertString<int>((comps[0]))); // light
-			 
-			// index
-			// light->index = util::convertString<int>((comps[0])); 
-
-			// Type (1 = sphere, 2 = cube, 3 = cone)
-			light->SetVolumeType(util::convertString<int>((comps[1])) - 1);
-
-			// Position (x, y, z)
-			light->position.x = util::convertString<float>((comps[2]));
-			light->position.y = util::convertString<float>((comps[3]));
-			light->position.z = util::convertString<float>((comps[4]));
+	// the light volumes draw into the same buffer, so they can be swapped with the light layer.
+	lightVolumeLayer = new LightVolumeLayer(ls_fb);
 
+	for (const LightInfo& info : lightInfos)
+	{
+		// passing in the scene name, the material, and the index.
+		PostLight* light = new PostLight(GetName(), ls_material, info.Number); // light
 
-			// Color (r, g, b)
-			light->color.r = util::convertString<float>((comps[5]));
-			light->color.g = util::convertString<float>((comps[6]));
-			light->color.b = util::convertString<float>((comps[7]));
+		// Type (1 = sphere, 2 = cube, 3 = cone)
+		light->SetVolumeType(info.Type - 1);
 
-			// Attenuation
-			light->attenuation = util::convertString<float>((comps[8]));
+		light->position = info.Position;
+		light->color = info.Color;
+		light->attenuation = info.Attenuation;
+		light->shininess = info.Shininess;
 
-			// Shininess
-			light->shininess = util::convertString<float>((comps[9]));
-			// index++;
-			// }
-			light->path = Path(light->position);
-			light->path.SetClosedPath(true);
+		light->path = Path(light->position);
+		light->path.SetClosedPath(true);
 
-			// changing values in shader
-			light->Update(0);
+		// changing values in shader
+		light->Update(0);
 
-			// pushing back the light
-			lights.push_back(light);
-		}
+		// pushing back the light
+		lights.push_back(light);
 	}
 
-	file.close();
-
 	// enabled lights
 	enabledLights = lights.size();
+
+	if (fileEnabled >= 0)
+		SetEnabledLights(fileEnabled);
 }
 
 // loads objects into the scene.
@@ -1103,6 +1311,8 @@ void icg::ICG_MainScene::LoadObjects()
 
 	// objectMat = lightList->GenerateMaterial(STATIC_VS, STATIC_FS);
 	Material::Sptr objectMat = lightList->GenerateMaterial("res/shaders/shader.vs.glsl", "res/shaders/shader.fs.glsl");
+	objectMat->Set("a_MaterialId", 0);
+	objectMat->Set("a_Roughness", 0.5F);
 	// volumeMat = lightList->GenerateMaterial("res/shaders/shader.vs.glsl", "res/shaders/shader.fs.glsl");
 
 	// TODO: aesthetically pleasing scene
@@ -1211,17 +1421,42 @@ void icg::ICG_MainScene::LightActivation(bool activate)
 		break;
 	}
 
-	lights[0]->shader->SetUniform("a_EnabledLights", enabledLights);
+	// the enabled lights are the ones given to the light clusters in Update().
 }
 
 // sets whether to use the clear colour or not.
 void icg::ICG_MainScene::UseClearColor(bool useClear)
 {
+	// switches the variant of the lighting shader. The uniforms set on the shader are kept.
 	if(DEFAULT_LIGHT_ENABLED && postLight != nullptr)
-		postLight->shader->SetUniform("a_UseClearColor", (int)useClear);
+		postLight->shader->SetKeyword(USE_CLEAR_COLOR_KEYWORD, useClear);
 
 	if (lights.size() > 0)
-		lights[0]->shader->SetUniform("a_UseClearColor", (int)useClear);
+		lights[0]->shader->SetKeyword(USE_CLEAR_COLOR_KEYWORD, useClear);
+
+	if (lightVolumeLayer != nullptr)
+		lightVolumeLayer->SetUseClearColor(useClear);
+}
+
+// gets the layer used for lighting
+cherry::PostLayer* icg::ICG_MainScene::GetLightingLayer() const
+{
+	return (useLightVolumes && lightVolumeLayer != nullptr) ? lightVolumeLayer : lightLayer;
+}
+
+// switches between the light volumes and the full screen lighting.
+void icg::ICG_MainScene::SetLightVolumesEnabled(bool enabled)
+{
+	cherry::PostLayer* oldLayer = GetLightingLayer();
+
+	useLightVolumes = enabled;
+
+	// swaps the lighting layer if it's being used.
+	for (cherry::PostLayer*& layer : layers)
+	{
+		if (layer == oldLayer)
+			layer = GetLightingLayer();
+	}
 }
 
 // update
@@ -1277,5 +1512,44 @@ void icg::ICG_MainScene::Update(float deltaTime)
 	for (PostLight* light : lights)
 		light->Update(deltaTime);
 
+	// assigning the enabled lights to the clusters, or giving them to the light volumes.
+	if (!DEFAULT_LIGHT_ENABLED && lights.size() > 0)
+	{
+		std::vector<ClusterLight> clusterLights;
+		Camera::Sptr& camera = game->myCamera;
+
+		float nearPlane = camera->IsPerspectiveCamera() ? camera->GetNearPerspective() : camera->GetNearOrthographic();
+		float farPlane = camera->IsPerspectiveCamera() ? camera->GetFarPerspective() : camera->GetFarOrthographic();
+
+		clusterLights.reserve(enabledLights);
+
+		for (int i = 0; i < enabledLights && i < lights.size(); i++)
+		{
+			const PostLight* light = lights[i];
+			float radius = LightClusters::CalculateRadius(light->color, light->attenuation);
+
+			clusterLights.push_back({
+				glm::vec4(light->position, radius),
+				glm::vec4(light->color, light->attenuation),
+				glm::vec4(light->shininess, (float)light->GetVolumeType(), 0.0F, 0.0F) });
+		}
+
+		// the volumes are limited to the far plane, since lights with no attenuation have an infinite radius.
+		if (useLightVolumes && lightVolumeLayer != nullptr)
+		{
+			lightVolumeLayer->SetLights(clusterLights, farPlane);
+		}
+		else
+		{
+			lightClusters.Build(clusterLights, camera->GetView(), camera->GetProjection(), nearPlane, farPlane);
+			lightClusters.Upload();
+			lightClusters.Bind();
+
+			// the planes are clamped by the clusters, so they're taken from there.
+			lights[0]->shader->SetUniform("a_ClusterNear", lightClusters.GetNearPlane());
+			lights[0]->shader->SetUniform("a_ClusterFar", lightClusters.GetFarPlane());
+		}
+	}
+
 	key1 = false;
 }
@@ -14,10 +14,25 @@
 #pragma once
 #include "cherry/scenes/GameplayScene.h"
 #include "PostLight.h"
+#include "cherry/post/BloomLayer.h"
+#include "cherry/lights/LightClusters.h"
+#include "cherry/lights/LightClusterCheck.h"
+#include "cherry/post/LightVolumeLayer.h"
+#include "cherry/post/GBuffer.h"
+#include "cherry/physics/RayBenchmark.h"
+#include "cherry/physics/PhysicsBenchmark.h"
+#include "cherry/physics/WaveBenchmark.h"
+#include "cherry/objects/ObjectBenchmark.h"
 #include <vector>
 
 #define BLINN_PHONG_POST "res/shaders/post/blinn-phong-post.fs.glsl"
-#define BLINN_PHONG_POST_MULTI "res/shaders/post/blinn-phong-post-multi.fs.glsl"
+
+// the file the lights are loaded from if the default light isn't used.
+#define LIGHT_INFO_FILE "res/icg_2-asn02-light_info-04.txt"
+
+// the keywords for the variants of BLINN_PHONG_POST.
+#define SINGLE_LIGHT_KEYWORD "SINGLE_LIGHT" // uses the one light set by uniforms, instead of the light clusters.
+#define USE_CLEAR_COLOR_KEYWORD "USE_CLEAR_COLOR" // background pixels show the clear colour.
 
 namespace icg
 {
@@ -29,6 +44,9 @@ namespace icg
 
 
 
+		// reads the light file before the scene is opened.
+		void OnPreload() override;
+
 		// scene opening
 		void OnOpen() override;
 
@@ -93,6 +111,9 @@ namespace icg
 		// enables the second effect
 		void EnableEffect2();
 
+		// enables the bloom effect
+		void EnableBloom();
+
 		// update
 		void Update(float deltaTime) override;
 	
@@ -100,7 +121,22 @@ namespace icg
 		static const bool DEFAULT_LIGHT_ENABLED;
 
 	private:
-		// loads the lights from a file
+		// a light from a light file, which becomes a PostLight once the scene is opened.
+		struct LightInfo
+		{
+			int Number = 0;
+			int Type = 1; // 1 = sphere, 2 = cube, 3 = cone
+			glm::vec3 Position = glm::vec3(0.0F);
+			glm::vec3 Color = glm::vec3(1.0F);
+			float Attenuation = 0.0F;
+			float Shininess = 0.0F;
+		};
+
+		// reads the lights from a file. This doesn't use OpenGL, so it can be called while the scene is preloading.
+		// 'enabled' is set to the amount of enabled lights in the file, or -1 if the file doesn't have it.
+		static bool ReadLightFile(const std::string& filePath, std::vector<LightInfo>& lightInfos, int& enabled);
+
+		// loads the lights from a file. If the file was read in OnPreload(), it isn't read again.
 		void LoadFromFile(std::string filePath);
 
 		// loads the objects for the scene.
@@ -112,6 +148,12 @@ namespace icg
 		// if 'true', then the clear colour gets used.
 		void UseClearColor(bool useClear);
 
+		// gets the layer used for lighting, which is either the light layer or the light volume layer.
+		cherry::PostLayer* GetLightingLayer() const;
+
+		// if 'true', the lights are drawn as stencil tested volumes instead of in a full screen pass.
+		void SetLightVolumesEnabled(bool enabled);
+
 		// translation direction
 		glm::vec3 t_Dir = glm::vec3(0, 0, 0);
 
@@ -140,6 +182,9 @@ namespace icg
 		// the amount of enabled lights
 		int enabledLights = 0;
 
+		// the clusters the enabled lights are assigned to each frame.
+		cherry::LightClusters lightClusters;
+
 		// key related variables
 		bool key1 = false; // turns off all but the first light.
 
@@ -165,6 +210,35 @@ namespace icg
 		cherry::PostLayer* effectLayer1 = nullptr;
 		cherry::PostLayer* effectLayer2 = nullptr;
 
+		// the mip chain bloom, which replaces the 3x3 kernel in effect layer 2.
+		cherry::BloomLayer* bloomLayer = nullptr;
+
+		// draws the lights as volumes. This writes to the same buffer as the light layer.
+		cherry::LightVolumeLayer* lightVolumeLayer = nullptr;
+
+		// if 'true', the light volume layer is used instead of the light layer.
+		bool useLightVolumes = false;
+
+		// the last results of the raycast benchmarks.
+		cherry::RayBenchmarkResult meshBenchmark;
+		cherry::RayBenchmarkResult sceneBenchmark;
+
+		// the last results of the physics benchmark.
+		cherry::PhysicsBenchmarkResult physicsBenchmark;
+
+		// the last results of the object systems benchmark.
+		cherry::ObjectSystemsBenchmarkResult systemsBenchmark;
+
+		// the last results of the object list benchmark.
+		cherry::ObjectListBenchmarkResult listBenchmark;
+
+		// the last results of the wave and buoyancy benchmark.
+		cherry::WaveBenchmarkResult waveBenchmark;
+
+		// the last results of the light cluster checks, with the scene's lights and with scattered lights.
+		cherry::LightClusterCheckResult sceneClusterCheck;
+		cherry::LightClusterCheckResult scatteredClusterCheck;
+
 		// struct for object rotation.
 		typedef struct ObjectRotationBehaviour
 		{
@@ -179,6 +253,11 @@ namespace icg
 		std::vector<cherry::Path> paths;
 		bool pathsSet = false;
 
+		// the lights read by OnPreload(), which LoadFromFile() uses instead of reading the file again.
+		std::string preloadLightFile = "";
+		std::vector<LightInfo> preloadLights;
+		int preloadLightsEnabled = -1;
+
 	protected:
 
 	};
@@ -269,8 +269,8 @@ void icg::PostLight::Update(float deltaTime)
 	// changing position
 	if (pvtPosition != position)
 	{
-		(!ICG_MainScene::DEFAULT_LIGHT_ENABLED) ?
-			shader->SetUniform(("a_Lights[" + std::to_string(index) + "].position").c_str(), position) : 
+		// lights in the light list are given to the shader through the scene's light clusters.
+		if (ICG_MainScene::DEFAULT_LIGHT_ENABLED)
 			shader->SetUniform("a_LightPos", position);
 
 		pvtPosition = position;
@@ -287,8 +287,7 @@ void icg::PostLight::Update(float deltaTime)
 	// changing color
 	if (pvtColor != color)
 	{
-		(!ICG_MainScene::DEFAULT_LIGHT_ENABLED) ?
-			shader->SetUniform(("a_Lights[" + std::to_string(index) + "].color").c_str(), color) :
+		if (ICG_MainScene::DEFAULT_LIGHT_ENABLED)
 			shader->SetUniform("a_Color", color);
 
 		pvtColor = color;
@@ -297,8 +296,7 @@ void icg::PostLight::Update(float deltaTime)
 	// changing attenuation
 	if (pvtAttenuation != attenuation)
 	{
-		(!ICG_MainScene::DEFAULT_LIGHT_ENABLED) ?
-			shader->SetUniform(("a_Lights[" + std::to_string(index) + "].attenuation").c_str(), attenuation) :
+		if (ICG_MainScene::DEFAULT_LIGHT_ENABLED)
 			shader->SetUniform("a_Attenuation", color);
 
 		pvtAttenuation = attenuation;
@@ -307,8 +305,7 @@ void icg::PostLight::Update(float deltaTime)
 	// changing shininess
 	if (pvtShininess != shininess)
 	{
-		(!ICG_MainScene::DEFAULT_LIGHT_ENABLED) ?
-			shader->SetUniform(("a_Lights[" + std::to_string(index) + "].shininess").c_str(), shininess) :
+		if (ICG_MainScene::DEFAULT_LIGHT_ENABLED)
 			shader->SetUniform("a_MatShininess", shininess);
 	
 		pvtShininess = shininess;
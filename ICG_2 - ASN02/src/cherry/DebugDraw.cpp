@@ -0,0 +1,290 @@
+// DebugDraw (Source) - draws wireframe boxes, spheres, and lines for debugging (e.g. the physics bodies) using shared meshes.
+#include "DebugDraw.h"
+#include "GLState.h"
+#include "ShaderCache.h"
+
+#include <GLM/gtc/constants.hpp>
+#include <stddef.h>
+
+bool cherry::DebugDraw::enabled = true;
+bool cherry::DebugDraw::initialized = false;
+bool cherry::DebugDraw::dirty = false;
+
+std::vector<cherry::DebugDraw::Instance> cherry::DebugDraw::boxes;
+std::vector<cherry::DebugDraw::Instance> cherry::DebugDraw::spheres;
+std::vector<cherry::DebugDraw::LineVertex> cherry::DebugDraw::lines;
+
+cherry::Shader::Sptr cherry::DebugDraw::shader = nullptr;
+
+GLuint cherry::DebugDraw::shapeVao = 0;
+GLuint cherry::DebugDraw::lineVao = 0;
+GLuint cherry::DebugDraw::shapeBuffer = 0;
+GLuint cherry::DebugDraw::instanceBuffer = 0;
+GLuint cherry::DebugDraw::lineBuffer = 0;
+GLuint cherry::DebugDraw::identityBuffer = 0;
+
+GLsizei cherry::DebugDraw::boxVertexCount = 0;
+GLsizei cherry::DebugDraw::sphereVertexCount = 0;
+
+// sets whether the shapes are drawn
+void cherry::DebugDraw::SetEnabled(bool enable)
+{
+	enabled = enable;
+
+	// the shapes that were added are removed, since they won't be drawn.
+	if (!enabled)
+		Clear();
+}
+
+// checks if the shapes are drawn
+bool cherry::DebugDraw::IsEnabled() { return enabled; }
+
+// adds a box
+void cherry::DebugDraw::AddBox(const glm::mat4& transform, const glm::vec4& color)
+{
+	if (!enabled)
+		return;
+
+	boxes.push_back(Instance{ transform, color });
+	dirty = true;
+}
+
+// adds a sphere
+void cherry::DebugDraw::AddSphere(const glm::mat4& transform, const glm::vec4& color)
+{
+	if (!enabled)
+		return;
+
+	spheres.push_back(Instance{ transform, color });
+	dirty = true;
+}
+
+// adds a line
+void cherry::DebugDraw::AddLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color)
+{
+	if (!enabled)
+		return;
+
+	lines.push_back(LineVertex{ start, color });
+	lines.push_back(LineVertex{ end, color });
+	dirty = true;
+}
+
+// gets the amount of shapes
+size_t cherry::DebugDraw::GetShapeCount() { return boxes.size() + spheres.size() + lines.size() / 2; }
+
+// draws the shapes
+void cherry::DebugDraw::Draw(const glm::mat4& viewProjection)
+{
+	// nothing to draw.
+	if (!enabled || GetShapeCount() == 0)
+		return;
+
+	__Init();
+	__Upload();
+
+	shader->Bind();
+	shader->SetUniform("a_ViewProjection", viewProjection);
+
+	// the shapes are see through, and are tested against the scene without hiding what's behind them.
+	GLState::Enable(GL_DEPTH_TEST);
+	GLState::DepthMask(false);
+	GLState::Enable(GL_BLEND);
+	GLState::BlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE);
+
+	// one call for all the boxes, and one call for all the spheres.
+	GLState::BindVertexArray(shapeVao);
+
+	if (!boxes.empty())
+		glDrawArraysInstancedBaseInstance(GL_LINES, 0, boxVertexCount, (GLsizei)boxes.size(), 0);
+
+	if (!spheres.empty())
+		glDrawArraysInstancedBaseInstance(GL_LINES, boxVertexCount, sphereVertexCount, (GLsizei)spheres.size(), (GLuint)boxes.size());
+
+	// the lines are already in world space, so they use the identity instance.
+	if (!lines.empty())
+	{
+		GLState::BindVertexArray(lineVao);
+		glDrawArraysInstanced(GL_LINES, 0, (GLsizei)lines.size(), 1);
+	}
+
+	GLState::Disable(GL_BLEND);
+	GLState::DepthMask(true);
+}
+
+// removes all the shapes
+void cherry::DebugDraw::Clear()
+{
+	boxes.clear();
+	spheres.clear();
+	lines.clear();
+	dirty = true;
+}
+
+// deletes the meshes and buffers
+void cherry::DebugDraw::Release()
+{
+	Clear();
+
+	if (!initialized)
+		return;
+
+	GLState::ForgetVertexArray(shapeVao);
+	GLState::ForgetVertexArray(lineVao);
+
+	GLuint vaos[2] = { shapeVao, lineVao };
+	GLuint buffers[4] = { shapeBuffer, instanceBuffer, lineBuffer, identityBuffer };
+
+	glDeleteVertexArrays(2, vaos);
+	glDeleteBuffers(4, buffers);
+
+	shapeVao = lineVao = 0;
+	shapeBuffer = instanceBuffer = lineBuffer = identityBuffer = 0;
+
+	shader = nullptr;
+	initialized = false;
+}
+
+// makes the meshes and buffers
+void cherry::DebugDraw::__Init()
+{
+	if (initialized)
+		return;
+
+	std::vector<glm::vec3> vertices;
+
+	// the unit box. Each pair of vertices is an edge.
+	{
+		// the corners
+		const glm::vec3 c[8] = {
+			{ -0.5F, -0.5F, -0.5F }, { 0.5F, -0.5F, -0.5F }, { 0.5F, 0.5F, -0.5F }, { -0.5F, 0.5F, -0.5F },
+			{ -0.5F, -0.5F,  0.5F }, { 0.5F, -0.5F,  0.5F }, { 0.5F, 0.5F,  0.5F }, { -0.5F, 0.5F,  0.5F }
+		};
+
+		// the back face, the front face, then the edges connecting them.
+		const int edges[24] = { 0, 1, 1, 2, 2, 3, 3, 0, 4, 5, 5, 6, 6, 7, 7, 4, 0, 4, 1, 5, 2, 6, 3, 7 };
+
+		for (int i : edges)
+			vertices.push_back(c[i]);
+
+		boxVertexCount = (GLsizei)vertices.size();
+	}
+
+	// the unit sphere, which is a ring around each axis.
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			for (int i = 0; i < DEBUG_DRAW_SPHERE_SEGMENTS; i++)
+			{
+				float a0 = glm::two_pi<float>() * i / DEBUG_DRAW_SPHERE_SEGMENTS;
+				float a1 = glm::two_pi<float>() * (i + 1) / DEBUG_DRAW_SPHERE_SEGMENTS;
+
+				glm::vec2 p0(cosf(a0), sinf(a0));
+				glm::vec2 p1(cosf(a1), sinf(a1));
+
+				// xy, yz, then xz
+				switch (axis)
+				{
+				case 0:
+					vertices.push_back(glm::vec3(p0.x, p0.y, 0.0F));
+					vertices.push_back(glm::vec3(p1.x, p1.y, 0.0F));
+					break;
+				case 1:
+					vertices.push_back(glm::vec3(0.0F, p0.x, p0.y));
+					vertices.push_back(glm::vec3(0.0F, p1.x, p1.y));
+					break;
+				default:
+					vertices.push_back(glm::vec3(p0.x, 0.0F, p0.y));
+					vertices.push_back(glm::vec3(p1.x, 0.0F, p1.y));
+					break;
+				}
+			}
+		}
+
+		sphereVertexCount = (GLsizei)vertices.size() - boxVertexCount;
+	}
+
+	const Instance identity{ glm::mat4(1.0F), glm::vec4(1.0F) };
+
+	glCreateBuffers(1, &shapeBuffer);
+	glCreateBuffers(1, &instanceBuffer);
+	glCreateBuffers(1, &lineBuffer);
+	glCreateBuffers(1, &identityBuffer);
+
+	glNamedBufferStorage(shapeBuffer, sizeof(glm::vec3) * vertices.size(), vertices.data(), 0);
+	glNamedBufferStorage(identityBuffer, sizeof(Instance), &identity, 0);
+
+	// the boxes and spheres
+	// binding 0 is the unit mesh, and binding 1 is the instances.
+	glCreateVertexArrays(1, &shapeVao);
+	glVertexArrayVertexBuffer(shapeVao, 0, shapeBuffer, 0, sizeof(glm::vec3));
+	glVertexArrayVertexBuffer(shapeVao, 1, instanceBuffer, 0, sizeof(Instance));
+	glVertexArrayBindingDivisor(shapeVao, 1, 1);
+
+	// position (0)
+	glEnableVertexArrayAttrib(shapeVao, 0);
+	glVertexArrayAttribFormat(shapeVao, 0, 3, GL_FLOAT, GL_FALSE, 0);
+	glVertexArrayAttribBinding(shapeVao, 0, 0);
+
+	// colour (1)
+	glEnableVertexArrayAttrib(shapeVao, 1);
+	glVertexArrayAttribFormat(shapeVao, 1, 4, GL_FLOAT, GL_FALSE, offsetof(Instance, Color));
+	glVertexArrayAttribBinding(shapeVao, 1, 1);
+
+	// the lines
+	// binding 0 is the line vertices (position and colour), and binding 1 is the identity instance.
+	glCreateVertexArrays(1, &lineVao);
+	glVertexArrayVertexBuffer(lineVao, 0, lineBuffer, 0, sizeof(LineVertex));
+	glVertexArrayVertexBuffer(lineVao, 1, identityBuffer, 0, sizeof(Instance));
+	glVertexArrayBindingDivisor(lineVao, 1, 1);
+
+	// position (0)
+	glEnableVertexArrayAttrib(lineVao, 0);
+	glVertexArrayAttribFormat(lineVao, 0, 3, GL_FLOAT, GL_FALSE, offsetof(LineVertex, Position));
+	glVertexArrayAttribBinding(lineVao, 0, 0);
+
+	// colour (1)
+	glEnableVertexArrayAttrib(lineVao, 1);
+	glVertexArrayAttribFormat(lineVao, 1, 4, GL_FLOAT, GL_FALSE, offsetof(LineVertex, Color));
+	glVertexArrayAttribBinding(lineVao, 1, 0);
+
+	// model matrix (2 - 5), which takes up a location for each column.
+	for (GLuint i = 0; i < 4; i++)
+	{
+		for (GLuint vao : { shapeVao, lineVao })
+		{
+			glEnableVertexArrayAttrib(vao, 2 + i);
+			glVertexArrayAttribFormat(vao, 2 + i, 4, GL_FLOAT, GL_FALSE, offsetof(Instance, Model) + sizeof(glm::vec4) * i);
+			glVertexArrayAttribBinding(vao, 2 + i, 1);
+		}
+	}
+
+	shader = ShaderCache::Get("res/shaders/debug.vs.glsl", "res/shaders/debug.fs.glsl");
+
+	initialized = true;
+	dirty = true;
+}
+
+// uploads the shapes
+void cherry::DebugDraw::__Upload()
+{
+	if (!dirty)
+		return;
+
+	// the boxes, then the spheres, so that each shape's instances are next to each other.
+	if (!boxes.empty() || !spheres.empty())
+	{
+		glNamedBufferData(instanceBuffer, sizeof(Instance) * (boxes.size() + spheres.size()), nullptr, GL_STREAM_DRAW);
+
+		if (!boxes.empty())
+			glNamedBufferSubData(instanceBuffer, 0, sizeof(Instance) * boxes.size(), boxes.data());
+
+		if (!spheres.empty())
+			glNamedBufferSubData(instanceBuffer, sizeof(Instance) * boxes.size(), sizeof(Instance) * spheres.size(), spheres.data());
+	}
+
+	if (!lines.empty())
+		glNamedBufferData(lineBuffer, sizeof(LineVertex) * lines.size(), lines.data(), GL_STREAM_DRAW);
+
+	dirty = false;
+}
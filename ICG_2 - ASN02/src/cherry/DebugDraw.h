@@ -0,0 +1,92 @@
+// DebugDraw (Header) - draws wireframe boxes, spheres, and lines for debugging (e.g. the physics bodies) using shared meshes.
+#pragma once
+#include <glad/glad.h>
+#include <GLM/glm.hpp>
+#include <vector>
+
+#include "Shader.h"
+
+// the amount of line segments used for each of the sphere's rings.
+#define DEBUG_DRAW_SPHERE_SEGMENTS 32
+
+namespace cherry
+{
+	/*
+	 * Shapes are added once per frame, then drawn for every camera with Draw(), and cleared with Clear() at the end of the frame.
+	 * There is only one unit box ([-0.5, 0.5] on each axis) and one unit sphere (radius of 1), which are shared by every shape.
+	 * Each shape is an instance with its own transformation and colour, so all the boxes (or spheres) are drawn with one instanced call.
+	 * The meshes and buffers aren't made until something is drawn, so nothing is created if the debug view is never used.
+	*/
+	class DebugDraw
+	{
+	public:
+		// sets whether the shapes are drawn. If disabled, the shapes that are added are ignored.
+		static void SetEnabled(bool enable);
+
+		// returns 'true' if the shapes are drawn.
+		static bool IsEnabled();
+
+		// adds a box. The transformation scales the unit box, so the scale should include the box's dimensions.
+		static void AddBox(const glm::mat4& transform, const glm::vec4& color);
+
+		// adds a sphere. The transformation scales the unit sphere, so the scale should include the radius.
+		static void AddSphere(const glm::mat4& transform, const glm::vec4& color);
+
+		// adds a line in world space.
+		static void AddLine(const glm::vec3& start, const glm::vec3& end, const glm::vec4& color);
+
+		// gets the amount of shapes (boxes, spheres, and lines) that have been added.
+		static size_t GetShapeCount();
+
+		// draws the shapes that have been added. This can be called for multiple cameras in the same frame.
+		// the shapes are drawn over the scene with depth testing, but don't write to the depth buffer.
+		static void Draw(const glm::mat4& viewProjection);
+
+		// removes all of the shapes. This should be called once the frame has been drawn.
+		static void Clear();
+
+		// deletes the meshes, buffers, and shader. They'll be made again if something is drawn.
+		static void Release();
+
+	private:
+		// a shape that gets drawn
+		struct Instance
+		{
+			glm::mat4 Model;
+			glm::vec4 Color;
+		};
+
+		// a vertex for a line
+		struct LineVertex
+		{
+			glm::vec3 Position;
+			glm::vec4 Color;
+		};
+
+		// makes the meshes and buffers.
+		static void __Init();
+
+		// uploads the instances and lines if they've changed since they were last uploaded.
+		static void __Upload();
+
+		static bool enabled; // if 'false', shapes aren't added.
+		static bool initialized; // 'true' once the meshes and buffers have been made.
+		static bool dirty; // 'true' if the shapes have changed since they were uploaded.
+
+		static std::vector<Instance> boxes;
+		static std::vector<Instance> spheres;
+		static std::vector<LineVertex> lines;
+
+		static Shader::Sptr shader; // the shader used for all the shapes.
+
+		static GLuint shapeVao; // the vao for the boxes and spheres.
+		static GLuint lineVao; // the vao for the lines.
+		static GLuint shapeBuffer; // the unit box, then the unit sphere.
+		static GLuint instanceBuffer; // the boxes, then the spheres.
+		static GLuint lineBuffer; // the line vertices.
+		static GLuint identityBuffer; // a single instance with no transformation, which the lines use.
+
+		static GLsizei boxVertexCount; // the amount of vertices in the unit box.
+		static GLsizei sphereVertexCount; // the amount of vertices in the unit sphere.
+	};
+}
@@ -0,0 +1,66 @@
+// Frustum (Source) - the planes of a view frustum, used for culling bounding boxes and spheres
+#include "Frustum.h"
+
+// constructor
+cherry::Frustum::Frustum(const glm::mat4& viewProjection) { SetMatrix(viewProjection); }
+
+// sets the matrix
+void cherry::Frustum::SetMatrix(const glm::mat4& viewProjection)
+{
+	// the rows of the matrix (glm is column major).
+	glm::vec4 row0 = glm::vec4(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]);
+	glm::vec4 row1 = glm::vec4(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]);
+	glm::vec4 row2 = glm::vec4(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]);
+	glm::vec4 row3 = glm::vec4(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+
+	planes[PLANE_LEFT] = row3 + row0;
+	planes[PLANE_RIGHT] = row3 - row0;
+	planes[PLANE_BOTTOM] = row3 + row1;
+	planes[PLANE_TOP] = row3 - row1;
+	planes[PLANE_NEAR] = row3 + row2;
+	planes[PLANE_FAR] = row3 - row2;
+
+	// normalizing the planes so that the distances are correct for the sphere test.
+	for (glm::vec4& plane : planes)
+	{
+		float length = glm::length(glm::vec3(plane));
+
+		if (length > 0.0F)
+			plane /= length;
+	}
+}
+
+// checks for a box
+bool cherry::Frustum::ContainsBox(const glm::vec3& boxMin, const glm::vec3& boxMax) const
+{
+	for (const glm::vec4& plane : planes)
+	{
+		// the corner of the box that's the furthest along the plane's normal.
+		glm::vec3 corner = glm::vec3(
+			(plane.x >= 0.0F) ? boxMax.x : boxMin.x,
+			(plane.y >= 0.0F) ? boxMax.y : boxMin.y,
+			(plane.z >= 0.0F) ? boxMax.z : boxMin.z
+		);
+
+		// if that corner is behind the plane, the whole box is.
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0F)
+			return false;
+	}
+
+	return true;
+}
+
+// checks for a sphere
+bool cherry::Frustum::ContainsSphere(const glm::vec3& center, float radius) const
+{
+	for (const glm::vec4& plane : planes)
+	{
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+			return false;
+	}
+
+	return true;
+}
+
+// gets a plane
+const glm::vec4& cherry::Frustum::GetPlane(Plane plane) const { return planes[plane]; }
@@ -0,0 +1,44 @@
+// Frustum (Header) - the planes of a view frustum, used for culling bounding boxes and spheres
+#pragma once
+#include <GLM/glm.hpp>
+
+namespace cherry
+{
+	/*
+	 * The six planes of a frustum, taken from a (model) view projection matrix.
+	 * If the matrix includes a model transform, the planes are in that model's local space, so local bounds can be tested directly.
+	 * The tests are conservative: something that's close to a corner of the frustum may pass even though it's outside.
+	 * see: https://www.gamedevs.org/uploads/fast-extraction-viewing-frustum-planes-from-world-view-projection-matrix.pdf
+	*/
+	class Frustum
+	{
+	public:
+		// the planes
+		enum Plane { PLANE_LEFT = 0, PLANE_RIGHT, PLANE_BOTTOM, PLANE_TOP, PLANE_NEAR, PLANE_FAR };
+
+		// constructor. Nothing is culled until a matrix is set.
+		Frustum() = default;
+
+		// makes the frustum from a matrix.
+		Frustum(const glm::mat4& viewProjection);
+
+		// sets the matrix the planes are taken from.
+		void SetMatrix(const glm::mat4& viewProjection);
+
+		// returns 'true' if any part of the box may be inside of the frustum.
+		bool ContainsBox(const glm::vec3& boxMin, const glm::vec3& boxMax) const;
+
+		// returns 'true' if any part of the sphere may be inside of the frustum.
+		bool ContainsSphere(const glm::vec3& center, float radius) const;
+
+		// gets a plane (xyz = normal, w = distance). The normals point into the frustum.
+		const glm::vec4& GetPlane(Plane plane) const;
+
+	private:
+		// the planes, which start off facing every direction so that nothing is culled.
+		glm::vec4 planes[6] = {
+			glm::vec4(0.0F, 0.0F, 0.0F, 1.0F), glm::vec4(0.0F, 0.0F, 0.0F, 1.0F), glm::vec4(0.0F, 0.0F, 0.0F, 1.0F),
+			glm::vec4(0.0F, 0.0F, 0.0F, 1.0F), glm::vec4(0.0F, 0.0F, 0.0F, 1.0F), glm::vec4(0.0F, 0.0F, 0.0F, 1.0F)
+		};
+	};
+}
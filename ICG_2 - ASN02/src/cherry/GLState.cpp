@@ -0,0 +1,255 @@
+// GLState (Source) - shadows the OpenGL state so that redundant calls can be skipped
+#include "GLState.h"
+
+// the cached state starts off as unknown, so the first call of each type always goes through.
+GLuint cherry::GLState::program = cherry::GLState::UNKNOWN;
+GLuint cherry::GLState::vao = cherry::GLState::UNKNOWN;
+GLuint cherry::GLState::textures[GL_STATE_TEXTURE_UNITS];
+GLuint cherry::GLState::samplers[GL_STATE_TEXTURE_UNITS];
+int cherry::GLState::caps[4] = { -1, -1, -1, -1 };
+GLenum cherry::GLState::polygonMode = cherry::GLState::UNKNOWN;
+GLenum cherry::GLState::depthFunc = cherry::GLState::UNKNOWN;
+int cherry::GLState::depthMask = -1;
+glm::uvec4 cherry::GLState::blendFunc = glm::uvec4(cherry::GLState::UNKNOWN);
+glm::ivec4 cherry::GLState::viewport = glm::ivec4(-1);
+glm::ivec4 cherry::GLState::scissor = glm::ivec4(-1);
+
+uint64_t cherry::GLState::callsIssued = 0;
+uint64_t cherry::GLState::callsAvoided = 0;
+uint64_t cherry::GLState::frameIssued = 0;
+uint64_t cherry::GLState::frameAvoided = 0;
+uint64_t cherry::GLState::frameStartIssued = 0;
+uint64_t cherry::GLState::frameStartAvoided = 0;
+
+// checks if a value changed
+template<typename T>
+bool cherry::GLState::Changed(T& current, const T& value)
+{
+	if (current == value)
+	{
+		callsAvoided++;
+		return false;
+	}
+	else
+	{
+		current = value;
+		callsIssued++;
+		return true;
+	}
+}
+
+// binds a program
+void cherry::GLState::UseProgram(GLuint program)
+{
+	if (Changed(GLState::program, program))
+		glUseProgram(program);
+}
+
+// binds a vertex array
+void cherry::GLState::BindVertexArray(GLuint vao)
+{
+	if (Changed(GLState::vao, vao))
+		glBindVertexArray(vao);
+}
+
+// binds a texture
+void cherry::GLState::BindTextureUnit(GLuint unit, GLuint texture)
+{
+	// units that aren't tracked are always bound.
+	if (unit >= GL_STATE_TEXTURE_UNITS)
+	{
+		callsIssued++;
+		glBindTextureUnit(unit, texture);
+	}
+	else if (Changed(textures[unit], texture))
+	{
+		glBindTextureUnit(unit, texture);
+	}
+}
+
+// binds a sampler
+void cherry::GLState::BindSampler(GLuint unit, GLuint sampler)
+{
+	if (unit >= GL_STATE_TEXTURE_UNITS)
+	{
+		callsIssued++;
+		glBindSampler(unit, sampler);
+	}
+	else if (Changed(samplers[unit], sampler))
+	{
+		glBindSampler(unit, sampler);
+	}
+}
+
+// sets a capability
+void cherry::GLState::SetEnabled(GLenum cap, bool enabled)
+{
+	int index = GetCapIndex(cap);
+	int value = enabled ? 1 : 0;
+
+	// if the capability isn't cached, or if it has changed.
+	if (index < 0)
+		callsIssued++;
+	else if (!Changed(caps[index], value))
+		return;
+
+	(enabled) ? glEnable(cap) : glDisable(cap);
+}
+
+// enables a capability
+void cherry::GLState::Enable(GLenum cap) { SetEnabled(cap, true); }
+
+// disables a capability
+void cherry::GLState::Disable(GLenum cap) { SetEnabled(cap, false); }
+
+// polygon mode
+void cherry::GLState::PolygonMode(GLenum mode)
+{
+	if (Changed(polygonMode, mode))
+		glPolygonMode(GL_FRONT_AND_BACK, mode);
+}
+
+// depth function
+void cherry::GLState::DepthFunc(GLenum func)
+{
+	if (Changed(depthFunc, func))
+		glDepthFunc(func);
+}
+
+// depth mask
+void cherry::GLState::DepthMask(bool write)
+{
+	int value = write ? 1 : 0;
+
+	if (Changed(depthMask, value))
+		glDepthMask(write ? GL_TRUE : GL_FALSE);
+}
+
+// blend function
+void cherry::GLState::BlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha)
+{
+	if (Changed(blendFunc, glm::uvec4(srcRGB, dstRGB, srcAlpha, dstAlpha)))
+		glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+}
+
+// viewport
+void cherry::GLState::Viewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	if (Changed(viewport, glm::ivec4(x, y, width, height)))
+		glViewport(x, y, width, height);
+}
+
+// scissor
+void cherry::GLState::Scissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+	if (Changed(scissor, glm::ivec4(x, y, width, height)))
+		glScissor(x, y, width, height);
+}
+
+// invalidates the cache
+void cherry::GLState::Invalidate()
+{
+	program = UNKNOWN;
+	vao = UNKNOWN;
+
+	for (int i = 0; i < GL_STATE_TEXTURE_UNITS; i++)
+	{
+		textures[i] = UNKNOWN;
+		samplers[i] = UNKNOWN;
+	}
+
+	for (int i = 0; i < 4; i++)
+		caps[i] = -1;
+
+	polygonMode = UNKNOWN;
+	depthFunc = UNKNOWN;
+	depthMask = -1;
+	blendFunc = glm::uvec4(UNKNOWN);
+	viewport = glm::ivec4(-1);
+	scissor = glm::ivec4(-1);
+}
+
+// forgets a program
+void cherry::GLState::ForgetProgram(GLuint program)
+{
+	if (GLState::program == program)
+		GLState::program = UNKNOWN;
+}
+
+// forgets a vertex array
+void cherry::GLState::ForgetVertexArray(GLuint vao)
+{
+	if (GLState::vao == vao)
+		GLState::vao = UNKNOWN;
+}
+
+// forgets a texture
+void cherry::GLState::ForgetTexture(GLuint texture)
+{
+	for (int i = 0; i < GL_STATE_TEXTURE_UNITS; i++)
+	{
+		if (textures[i] == texture)
+			textures[i] = UNKNOWN;
+	}
+}
+
+// forgets a sampler
+void cherry::GLState::ForgetSampler(GLuint sampler)
+{
+	for (int i = 0; i < GL_STATE_TEXTURE_UNITS; i++)
+	{
+		if (samplers[i] == sampler)
+			samplers[i] = UNKNOWN;
+	}
+}
+
+// calls issued
+uint64_t cherry::GLState::GetCallsIssued() { return callsIssued; }
+
+// calls avoided
+uint64_t cherry::GLState::GetCallsAvoided() { return callsAvoided; }
+
+// calls issued last frame
+uint64_t cherry::GLState::GetFrameCallsIssued() { return frameIssued; }
+
+// calls avoided last frame
+uint64_t cherry::GLState::GetFrameCallsAvoided() { return frameAvoided; }
+
+// ends the frame
+void cherry::GLState::EndFrame()
+{
+	frameIssued = callsIssued - frameStartIssued;
+	frameAvoided = callsAvoided - frameStartAvoided;
+
+	frameStartIssued = callsIssued;
+	frameStartAvoided = callsAvoided;
+}
+
+// resets the counters
+void cherry::GLState::ResetCounters()
+{
+	callsIssued = 0;
+	callsAvoided = 0;
+	frameIssued = 0;
+	frameAvoided = 0;
+	frameStartIssued = 0;
+	frameStartAvoided = 0;
+}
+
+// gets the capability index
+int cherry::GLState::GetCapIndex(GLenum cap)
+{
+	switch (cap)
+	{
+	case GL_CULL_FACE:
+		return 0;
+	case GL_DEPTH_TEST:
+		return 1;
+	case GL_BLEND:
+		return 2;
+	case GL_SCISSOR_TEST:
+		return 3;
+	default:
+		return -1;
+	}
+}
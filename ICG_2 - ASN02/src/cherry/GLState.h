@@ -0,0 +1,122 @@
+// GLState (Header) - shadows the OpenGL state so that redundant calls can be skipped
+#pragma once
+#include <glad/glad.h>
+#include <GLM/glm.hpp>
+#include <stdint.h>
+
+// the amount of texture units that are tracked. Units above this are always passed through to OpenGL.
+#define GL_STATE_TEXTURE_UNITS 32
+
+namespace cherry
+{
+	/*
+	 * Keeps a copy of the OpenGL state that the engine changes, and only calls OpenGL when the value is different.
+	 * Anything that changes the state without going through this class (e.g. ImGui) must be followed by Invalidate().
+	 * Objects that are deleted should call the matching Forget function, since OpenGL can reuse their names.
+	*/
+	class GLState
+	{
+	public:
+		// binds a shader program.
+		static void UseProgram(GLuint program);
+
+		// binds a vertex array object.
+		static void BindVertexArray(GLuint vao);
+
+		// binds a texture to a texture unit.
+		static void BindTextureUnit(GLuint unit, GLuint texture);
+
+		// binds a sampler to a texture unit.
+		static void BindSampler(GLuint unit, GLuint sampler);
+
+		// enables or disables a capability. Only GL_CULL_FACE, GL_DEPTH_TEST, GL_BLEND, and GL_SCISSOR_TEST are cached.
+		static void SetEnabled(GLenum cap, bool enabled);
+
+		// enables a capability.
+		static void Enable(GLenum cap);
+
+		// disables a capability.
+		static void Disable(GLenum cap);
+
+		// sets the polygon mode for the front and back faces.
+		static void PolygonMode(GLenum mode);
+
+		// sets the depth function.
+		static void DepthFunc(GLenum func);
+
+		// sets if the depth buffer can be written to.
+		static void DepthMask(bool write);
+
+		// sets the blend function.
+		static void BlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha);
+
+		// sets the viewport.
+		static void Viewport(GLint x, GLint y, GLsizei width, GLsizei height);
+
+		// sets the scissor box.
+		static void Scissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+		// forgets all of the cached state, so the next call of every type goes to OpenGL.
+		static void Invalidate();
+
+		// called when a program is deleted.
+		static void ForgetProgram(GLuint program);
+
+		// called when a vertex array is deleted.
+		static void ForgetVertexArray(GLuint vao);
+
+		// called when a texture is deleted.
+		static void ForgetTexture(GLuint texture);
+
+		// called when a sampler is deleted.
+		static void ForgetSampler(GLuint sampler);
+
+		// gets the amount of calls that were sent to OpenGL since the counters were last reset.
+		static uint64_t GetCallsIssued();
+
+		// gets the amount of calls that were skipped since the counters were last reset.
+		static uint64_t GetCallsAvoided();
+
+		// gets the amount of calls that were sent to OpenGL during the last frame.
+		static uint64_t GetFrameCallsIssued();
+
+		// gets the amount of calls that were skipped during the last frame.
+		static uint64_t GetFrameCallsAvoided();
+
+		// saves the counters for this frame, and starts counting the next frame.
+		static void EndFrame();
+
+		// resets all of the counters.
+		static void ResetCounters();
+
+	private:
+		// the value used for state that isn't known.
+		static const GLuint UNKNOWN = 0xFFFFFFFF;
+
+		// gets the index of a cached capability, or -1 if the capability isn't cached.
+		static int GetCapIndex(GLenum cap);
+
+		// returns 'true' if the value changed, and updates the counters.
+		template<typename T>
+		static bool Changed(T& current, const T& value);
+
+		static GLuint program; // bound program
+		static GLuint vao; // bound vertex array
+		static GLuint textures[GL_STATE_TEXTURE_UNITS]; // bound textures per unit
+		static GLuint samplers[GL_STATE_TEXTURE_UNITS]; // bound samplers per unit
+		static int caps[4]; // capabilities (1 = on, 0 = off, -1 = unknown)
+		static GLenum polygonMode;
+		static GLenum depthFunc;
+		static int depthMask; // (1 = on, 0 = off, -1 = unknown)
+		static glm::uvec4 blendFunc;
+		static glm::ivec4 viewport;
+		static glm::ivec4 scissor;
+
+		static uint64_t callsIssued; // total calls sent
+		static uint64_t callsAvoided; // total calls skipped
+		static uint64_t frameIssued; // calls sent in the last frame
+		static uint64_t frameAvoided; // calls skipped in the last frame
+		static uint64_t frameStartIssued; // calls sent before this frame
+		static uint64_t frameStartAvoided; // calls skipped before this frame
+	};
+}
@@ -11,11 +11,17 @@
 #include <toolkit/Logging.h>
 
 #include "MeshRenderer.h"
+#include "GLState.h"
 #include "textures/Texture2D.h"
 
 #include "physics/PhysicsBody.h"
 #include "utils/Utils.h"
 #include "WorldTransform.h"
+#include "HotReload.h"
+#include "ShaderCache.h"
+#include "objects/PrimitiveCache.h"
+#include "DebugDraw.h"
+#include "textures/TextureAtlas.h"
 #include "scenes/EngineScene.h"
 
 #include<functional>
@@ -52,7 +58,7 @@ void GlfwWindowResizedCallback(GLFWwindow* window, int width, int height) {
 	// the width and height must be greater than 0
 	if (width > 0 && height > 0)
 	{
-		glViewport(0, 0, width, height);
+		cherry::GLState::Viewport(0, 0, width, height);
 
 		cherry::Game* game = (cherry::Game*)glfwGetWindowUserPointer(window);
 
@@ -606,6 +612,39 @@ const std::string& cherry::Game::GetCurrentSceneName() const
 		return std::string("");
 }
 
+// sets the current scene once it's preloaded
+bool cherry::Game::SetCurrentSceneWhenReady(std::string sceneName)
+{
+	Scene* scene = SceneManager::Get(sceneName);
+
+	if (scene == nullptr) // the scene doesn't exist.
+		return false;
+
+	// the scene is already open, so there's nothing to wait for.
+	if (scene == CurrentScene())
+	{
+		pendingScene = "";
+		return true;
+	}
+
+	// starts the preload if it hasn't been started already.
+	if (!scene->IsPreloaded() && !SceneManager::IsPreloading(sceneName))
+		SceneManager::PreloadScene(sceneName);
+
+	pendingScene = sceneName;
+	return true;
+}
+
+// gets the pending scene name
+const std::string& cherry::Game::GetPendingSceneName() const { return pendingScene; }
+
+// gets the pending scene's preload progress
+float cherry::Game::GetPendingSceneProgress() const
+{
+	Scene* scene = SceneManager::Get(pendingScene);
+	return (scene == nullptr) ? 1.0F : scene->GetPreloadProgress();
+}
+
 // destroys all scenes
 void cherry::Game::DestroyScenes() { SceneManager::DestroyScenes(); }
 
@@ -678,6 +717,34 @@ cherry::ObjectList* cherry::Game::GetSceneObjectList() const { return objectList
 // gets the object list for the provided scene.
 cherry::ObjectList* cherry::Game::GetSceneObjectList(std::string scene) { return ObjectManager::GetSceneObjectListByName(scene); }
 
+// gets the cursor ray
+cherry::Ray cherry::Game::GetCursorRay() const
+{
+	return Ray::FromScreen(glm::vec2(mousePos), glm::vec2(myWindowSize), myCamera->GetViewProjection());
+}
+
+// picks the object under the cursor
+cherry::Object* cherry::Game::PickObject(cherry::RayHit& hit)
+{
+	if (objectList == nullptr)
+		return nullptr;
+
+	std::vector<Object*> pickable;
+	pickable.reserve(objectList->objects.size());
+
+	for (Object* obj : objectList->objects)
+	{
+		if (obj != nullptr && obj->IsVisible() && !obj->IsWindowChild())
+			pickable.push_back(obj);
+	}
+
+	// the objects can move every frame, so the hierarchy over them is built for each pick. The mesh hierarchies are kept by the objects.
+	SceneBVH scene;
+	scene.Build(pickable);
+
+	return scene.Intersect(GetCursorRay(), hit) ? hit.Object : nullptr;
+}
+
 // gets an object from the current scene
 cherry::Object* cherry::Game::GetCurrentSceneObjectByIndex(unsigned int index) const
 {
@@ -704,18 +771,15 @@ cherry::Object* cherry::Game::GetSceneObjectByIndex(std::string scene, unsigned
 // gets a scene object by name
 cherry::Object* cherry::Game::GetCurrentSceneObjectByName(std::string name) const
 {
-	for (Object* obj : objectList->objects)
-	{
-		if (obj->GetName() == name && obj->GetSceneName() == GetCurrentSceneName())
-			return obj;
-	}
-	return nullptr;
+	return GetSceneObjectByName(GetCurrentSceneName(), name);
 }
 
 // gets a scene object from the provided scene, using its name
 cherry::Object* cherry::Game::GetSceneObjectByName(std::string scene, std::string name) const
 {
-	return ObjectManager::GetSceneObjectListByName(scene)->GetObjectByName(name);
+	ObjectList* list = ObjectManager::GetSceneObjectListByName(scene);
+
+	return (list != nullptr) ? list->GetObjectByName(name) : nullptr;
 }
 
 // adds an object to the m_Scene
@@ -776,7 +840,7 @@ void cherry::Game::Initialize() {
 
 	// Initialize GLFW
 	if (glfwInit() == GLFW_FALSE) {
-		std::cout << "Failed to initialize GLFW" << std::endl;
+		LOG_ERROR("Failed to initialize GLFW");
 		throw std::runtime_error("Failed to initialize GLFW");
 	}
 	// Enable transparent backbuffers for our windows (note that Windows expects our colors to be pre-multiplied with alpha)
@@ -793,7 +857,7 @@ void cherry::Game::Initialize() {
 	glfwMakeContextCurrent(myWindow);
 	// Let glad know what function loader we are using (will call gl commands via glfw)
 	if (gladLoadGLLoader((GLADloadproc)glfwGetProcAddress) == 0) {
-		std::cout << "Failed to initialize Glad" << std::endl;
+		LOG_ERROR("Failed to initialize Glad");
 		throw std::runtime_error("Failed to initialize GLAD");
 	}
 
@@ -828,9 +892,12 @@ void cherry::Game::Initialize() {
 	// without this, we end up getting seams in our textures.
 	glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
 
-	glEnable(GL_DEPTH_TEST);
-	glEnable(GL_CULL_FACE); // TODO: uncomment when showcasing game.
-	glEnable(GL_SCISSOR_TEST); // used for rendering multiple windows (TODO: maybe turn off if we aren't using multiple windows?)
+	// nothing is known about the state yet, so the cache is cleared.
+	GLState::Invalidate();
+
+	GLState::Enable(GL_DEPTH_TEST);
+	GLState::Enable(GL_CULL_FACE); // TODO: uncomment when showcasing game.
+	GLState::Enable(GL_SCISSOR_TEST); // used for rendering multiple windows (TODO: maybe turn off if we aren't using multiple windows?)
 
 	// seeding the randomizer
 	srand(time(0));
@@ -895,9 +962,39 @@ void cherry::Game::LoadContent()
 void cherry::Game::UnloadContent() {
 	audioEngine.Shutdown(); // shutdown the audio component.
 	SceneManager::DestroyScenes(); // destroys all the scenes.
+	DebugDraw::Release(); // deletes the debug meshes and buffers while the context still exists.
+	spriteBatch.Release(); // deletes the sprite buffers while the context still exists.
+	TextureAtlas::Clear(); // deletes the atlas pages, which the images were using.
+	ShaderCache::Clear(); // deletes the shared shaders while the context still exists.
+	PrimitiveCache::Clear(); // deletes the shared primitive meshes while the context still exists.
+	TextureCube::ClearLoaded(); // deletes the shared cube maps while the context still exists.
+	Skybox::ClearSharedMesh(); // deletes the shared skybox cube while the context still exists.
+	postGraph.Release(); // deletes the pooled frame buffers while the context still exists.
 }
 
 void cherry::Game::Update(float deltaTime) {
+	// reloads the shaders, materials, and meshes whose files have changed. This is done before anything uses them this frame.
+	HotReload::Update();
+
+	// continues preloading scenes, and switches to the pending scene once it's ready.
+	SceneManager::UpdatePreloads();
+
+	if (pendingScene != "")
+	{
+		Scene* pending = SceneManager::Get(pendingScene);
+
+		if (pending == nullptr) // the scene was removed.
+		{
+			pendingScene = "";
+		}
+		else if (pending->IsPreloaded())
+		{
+			std::string sceneName = pendingScene;
+			pendingScene = "";
+			SetCurrentScene(sceneName, false);
+		}
+	}
+
 	// calling the scene update
 	Scene* scene = CurrentScene();
 	if (scene != nullptr)
@@ -911,9 +1008,21 @@ void cherry::Game::Update(float deltaTime) {
 	for (int i = 0; i < exCameras.size(); i++)
 		exCameras[i]->Update(deltaTime);
 
-	// updates the object list
+	// the scene update has done its collision pass, so the bodies' positions are saved before anything else moves them.
+	// the next pass sweeps each body from here, so movement from the paths and targets is included.
+	for (Object* obj : objectList->objects)
+		obj->SavePhysicsBodyPositions();
+
+	// updates the paths and targets of all the objects in the scene, then the object list.
+	if (scene != nullptr)
+		ObjectSystems::Update(scene->Registry(), deltaTime);
+
 	objectList->Update(deltaTime);
 
+	// steps the scene's rigid bodies once the objects have moved.
+	if (scene != nullptr)
+		scene->GetPhysicsWorld().Update(deltaTime);
+
 	// moved to the bottom of the update.
 	// called to Update the position and rotation of the sceneLists.
 	// calling all of our functions for our Update behaviours.
@@ -1026,8 +1135,14 @@ void cherry::Game::Run()
 				ImGuiNewFrame();
 				DrawGui(deltaTime);
 				ImGuiEndFrame();
+
+				// ImGui changes the OpenGL state without going through GLState.
+				GLState::Invalidate();
 			}
 
+			// saves the amount of calls that were issued and avoided this frame.
+			GLState::EndFrame();
+
 			prevFrame = thisFrame;
 			frameTime = 0; // resetting frame time.
 
@@ -1140,6 +1255,35 @@ void cherry::Game::Resize(int newWidth, int newHeight)
 
 // draws to a given viewpoint. The code that was originally here was moved to _RenderScene
 void cherry::Game::Draw(float deltaTime) {
+	// adds the visible physics bodies to the debug view. They're added once, and drawn for each camera.
+	if (DebugDraw::IsEnabled() && PhysicsBody::GetVisibleCount() > 0 && objectList != nullptr)
+	{
+		for (Object* obj : objectList->objects)
+		{
+			for (PhysicsBody* body : obj->GetPhysicsBodies())
+			{
+				if (!body->IsVisible())
+					continue;
+
+				// the unit shapes are scaled up by the body's dimensions.
+				if (body->GetId() == 1) // box
+				{
+					PhysicsBodyBox* box = (PhysicsBodyBox*)body;
+
+					DebugDraw::AddBox(glm::scale(box->GetWorldTransform(),
+						glm::vec3(box->GetLocalWidth(), box->GetLocalHeight(), box->GetLocalDepth())), box->GetDebugColor());
+				}
+				else if (body->GetId() == 2) // sphere
+				{
+					PhysicsBodySphere* sphere = (PhysicsBodySphere*)body;
+
+					DebugDraw::AddSphere(glm::scale(sphere->GetWorldTransform(),
+						glm::vec3(sphere->GetLocalRadius())), sphere->GetDebugColor());
+				}
+			}
+		}
+	}
+
 	// if the camera exists
 	if (myCameraEnabled)
 	{
@@ -1158,6 +1302,12 @@ void cherry::Game::Draw(float deltaTime) {
 	// renders all the other cameras
 	for (Camera::Sptr cam : exCameras)
 		__RenderScene(cam);
+
+	// the debug shapes have been drawn for every camera.
+	DebugDraw::Clear();
+
+	// the sprites for this frame have been written, so the next frame uses a new part of the buffer.
+	spriteBatch.EndFrame();
 }
 
 // drawing ImGui
@@ -1216,11 +1366,6 @@ void cherry::Game::__RenderScene(glm::ivec4 viewport, const Camera::Sptr& camera
 	bool usingFrameBuffers = false; // if 'true', the frame buffer is being used.
 	std::vector<PostLayer*> layers;
 
-	// vector for post-post-process renders
-	std::vector<MeshRenderer> postRenders;
-	// vector for post-post-process transform
-	std::vector<TempTransform> postTransforms;
-
 	// no scene has been set to run.
 	if (scene == nullptr)
 		std::runtime_error("No scene is currently running.");
@@ -1239,7 +1384,7 @@ void cherry::Game::__RenderScene(glm::ivec4 viewport, const Camera::Sptr& camera
 
 	// Set viewport to entire region
 	// glViewport(viewport.x, viewport.y, viewport.z, viewport.w); // not neded since viewpoint doesn't change the clear call.
-	glScissor(viewport.x, viewport.y, viewport.z, viewport.w);
+	GLState::Scissor(viewport.x, viewport.y, viewport.z, viewport.w);
 
 	// Clear with the border color
 	glClearColor(borderColor.x, borderColor.y, borderColor.z, borderColor.w);
@@ -1249,8 +1394,8 @@ void cherry::Game::__RenderScene(glm::ivec4 viewport, const Camera::Sptr& camera
 
 	// Set viewport to be inset slightly (the amount is the border width)
 	// the offsets are used to move the border relative to the viewpoint.
-	glViewport(viewport.x + borderSize, viewport.y + borderSize, viewport.z - 2 * borderSize, viewport.w - 2 * borderSize);
-	glScissor(viewport.x + borderSize, viewport.y + borderSize, viewport.z - 2 * borderSize, viewport.w - 2 * borderSize);
+	GLState::Viewport(viewport.x + borderSize, viewport.y + borderSize, viewport.z - 2 * borderSize, viewport.w - 2 * borderSize);
+	GLState::Scissor(viewport.x + borderSize, viewport.y + borderSize, viewport.z - 2 * borderSize, viewport.w - 2 * borderSize);
 
 	// TODO: set border colour, border size, and clear colour in cameras instead. 
 	// Clear our new inset area with the scene clear color
@@ -1266,11 +1411,11 @@ void cherry::Game::__RenderScene(glm::ivec4 viewport, const Camera::Sptr& camera
 	if (scene->Skybox)
 	{
 		// Disable culling
-		glDisable(GL_CULL_FACE); // we disable face culling if the cube map is screwed up.
+		GLState::Disable(GL_CULL_FACE); // we disable face culling if the cube map is screwed up.
 		// Set our depth test to less or equal (because we are at 1.0f)
-		glDepthFunc(GL_LEQUAL);
+		GLState::DepthFunc(GL_LEQUAL);
 		// Disable depth writing
-		glDepthMask(GL_FALSE);
+		GLState::DepthMask(false);
 
 		// Make sure no samplers are bound to slot 0
 		TextureSampler::Unbind(0);
@@ -1291,172 +1436,105 @@ void cherry::Game::__RenderScene(glm::ivec4 viewport, const Camera::Sptr& camera
 			scene->SkyboxMesh->Draw();
 
 		// Restore our state
-		glDepthMask(GL_TRUE);
-		glEnable(GL_CULL_FACE);
-		glDepthFunc(GL_LESS);
+		GLState::DepthMask(true);
+		GLState::Enable(GL_CULL_FACE);
+		GLState::DepthFunc(GL_LESS);
 	}
 
 	// We'll grab a reference to the ecs to make things easier
 	auto& ecs = CurrentRegistry();
 
-	// copy past mesh renderer component and make ui rendere component?
-	ecs.sort<MeshRenderer>([&](const MeshRenderer& lhs, const MeshRenderer& rhs) {
-		if (rhs.Material == nullptr || rhs.Mesh == nullptr)
-			return false;
-		else if (lhs.Material == nullptr || lhs.Mesh == nullptr)
-			return true;
-		else if (lhs.Material->HasTransparency & !rhs.Material->HasTransparency) //
-			return false; // This section is new
-		else if (!lhs.Material->HasTransparency & rhs.Material->HasTransparency) // The order IS important
-			return true; //
-		else if (lhs.Material->GetShader() != rhs.Material->GetShader())
-			return lhs.Material->GetShader() < rhs.Material->GetShader();
-		else
-			return lhs.Material < rhs.Material;
-		});
-
+	// the queue is rebuilt for every camera, but its memory is reused.
+	renderQueue.Clear();
 
-	// These will keep track of the current shader and material that we have bound
-	Material::Sptr mat = nullptr;
-	Shader::Sptr boundShader = nullptr;
 	// A view will let us iterate over all of our entities that have the given component types
 	auto view = ecs.view<MeshRenderer>();
 
 	for (const auto& entity : view) {
-		// Get our shader 
 		const MeshRenderer& renderer = ecs.get<MeshRenderer>(entity);
 		// Early bail if mesh is invalid
 		if (renderer.Mesh == nullptr || renderer.Material == nullptr)
 			continue;
 
-		// if the mesh shouldn't be post processed, it's drawn after the post processed meshes.
-		if (!renderer.Mesh->postProcess)
-		{
-			postRenders.push_back(renderer); // gets the renderer
-			postTransforms.push_back(ecs.get_or_assign<TempTransform>(entity)); // getting the transformation
+		// invisible meshes don't need to be sorted or drawn.
+		if (!renderer.Mesh->IsVisible())
 			continue;
-		}
-
-		// If our shader has changed, we need to bind it and Update our frame-level uniforms
-		if (renderer.Material->GetShader() != boundShader) {
-			boundShader = renderer.Material->GetShader();
-			boundShader->Bind();
-
-			// if the object is to have a fixed screen position.
-			if (renderer.Mesh->GetWindowChild())
-				boundShader->SetUniform("a_CameraPos", myCameraX->GetPosition()); // uses Hud/UI camera
-			else
-				boundShader->SetUniform("a_CameraPos", camera->GetPosition()); // uses provided camera position.
-
-			boundShader->SetUniform("a_Time", static_cast<float>(glfwGetTime())); // passing in the time.
-		}
-		// If our material has changed, we need to apply it to the shader
-		if (renderer.Material != mat) {
-			mat = renderer.Material;
-			mat->Apply();
-		}
 
 		// We'll need some info about the entities position in the world
-		const TempTransform& transform = ecs.get_or_assign<TempTransform>(entity);
-
-		// Get the object's transformation
 		// TODO: set up parent system
-		glm::mat4 worldTransform = transform.GetWorldTransform();
-
-		// Our normal matrix is the inverse-transpose of our object's world rotation
-		// Recall that everything's backwards in GLM
-		glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(worldTransform)));
-
-		// Update the MVP using the item's transform
-		if (renderer.Mesh->GetWindowChild())
-		{
-			mat->GetShader()->SetUniform("a_ModelViewProjection", myCameraX->GetViewProjection() * worldTransform);
-		}
-		else
-		{
-			mat->GetShader()->SetUniform("a_ModelViewProjection", camera->GetViewProjection() * worldTransform);
-		}
+		glm::mat4 worldTransform = ecs.get_or_assign<TempTransform>(entity).GetWorldTransform();
 
+		// the squared distance from the camera, which is used to sort the item by depth.
+		glm::vec3 offset = glm::vec3(worldTransform[3]) -
+			((renderer.Mesh->GetWindowChild()) ? myCameraX->GetPosition() : camera->GetPosition());
 
-		// Update the model matrix to the item's world transform
-		mat->GetShader()->SetUniform("a_Model", worldTransform);
-		// Update the model matrix to the item's world transform
-		mat->GetShader()->SetUniform("a_NormalMatrix", normalMatrix);
-
-		// Draw the item
-		if (renderer.Mesh->IsVisible())
-		{
-			// if the mesh is in wireframe mode, and the draw call isn't set to that already.
-			if (renderer.Mesh->IsWireframe() != wireframe)
-			{
-				wireframe = !wireframe;
+		// if the mesh shouldn't be post processed, it's drawn after the post processed meshes.
+		renderQueue.Submit(renderer.Material.get(), renderer.Mesh.get(), worldTransform, glm::dot(offset, offset),
+			(renderer.Mesh->postProcess) ? RenderQueue::PASS_SCENE : RenderQueue::PASS_POST);
+	}
 
-				// switches between wireframe mode and fill mode.
-				(wireframe) ? glPolygonMode(GL_FRONT_AND_BACK, GL_LINE) : glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-			}
+	// sorts the draw calls by pass, transparency, shader, material, mesh, and depth.
+	renderQueue.Sort();
 
-			// if the mesh should be drawn in a different mode from what is currently set.
-			// if ((renderer.Mesh->IsPerspectiveMesh() && !camera->InPerspectiveMode()) ^
-			// 	renderer.Mesh->IsOrthographicMesh() && !camera->InOrthographicMode())
-			// {
-			// 	camera->SwitchViewMode();
-			// }
-
-			// the faces should or should not be culled. Since faces should be culled by default, it's turned back on.
-			if (!renderer.Mesh->cullFaces)
-			{
-				glDisable(GL_CULL_FACE);
-				renderer.Mesh->Draw();
-				glEnable(GL_CULL_FACE);
-			}
-			else // faces are set to be culled automatically
-			{
-				renderer.Mesh->Draw();
-			}
-		}
-		else
-		{
-			// std::cout << "INVISIBLE" << std::endl;
-		}
-	}
+	// draws the meshes that get post processed.
+	__DrawRenderPass(RenderQueue::PASS_SCENE, camera);
 
 	// post-processing layers
 	if (usingFrameBuffers && !layers.empty())
 	{
 		fb->UnBind();
-		FrameBuffer::Sptr& fbx = fb; // the most recent buffer
 
-		// applies each layer
+		// the graph is declared again every frame, since the layers can change.
+		postGraph.Reset();
+
+		RenderGraph::Resource sceneBuffer = postGraph.Import(fb); // the scene's buffer
+		RenderGraph::Resource lastBuffer = sceneBuffer; // the most recent buffer
+
+		// declares each layer
 		for (PostLayer* layer : layers)
 		{
-			// in order to use multiple layers (each with their own post passes), the last buffer used is saved in fbx.
-			// fbx then gives it to the new layer so that the image can continue to be changed.
+			// each layer reads from the scene's buffer (or its initialBuffer), and the last layer's output is what ends up on screen.
+			// passes from layers that don't lead to that output are skipped by the graph.
 
-			// layer->initialBuffer = fbx; // setting it to use the most recent buffer
-			layer->PostRender(camera);
-			fbx = layer->GetLastPassBuffer(); // saves the last frame buffer
-			
+			// lastBuffer = layer->DeclarePasses(postGraph, lastBuffer); // setting it to use the most recent buffer
+			lastBuffer = layer->DeclarePasses(postGraph, sceneBuffer);
 		}
-		
-	}
 
-	// making the bound shader null for the post draw.
-	boundShader = nullptr;
+		postGraph.Present(lastBuffer);
+		postGraph.Compile();
+		postGraph.Execute(camera, myWindowSize.x, myWindowSize.y);
+	}
 
 	// post-post processing renders
-	for (int i = 0; i < postRenders.size(); i++) {
-		// Early bail if mesh is invalid
-		const MeshRenderer& renderer = postRenders[i]; // getting the post render
-		if (renderer.Mesh == nullptr || renderer.Material == nullptr)
-			continue;
+	__DrawRenderPass(RenderQueue::PASS_POST, camera);
+
+	// the debug view (e.g. the physics bodies), which is drawn on top of the post processing.
+	DebugDraw::Draw(camera->GetViewProjection());
+}
+
+// draws a pass from the render queue
+void cherry::Game::__DrawRenderPass(uint32_t pass, const Camera::Sptr& camera)
+{
+	size_t start = 0, end = 0;
+
+	// These will keep track of the current shader and material that we have bound
+	Material* mat = nullptr;
+	Shader* boundShader = nullptr;
+
+	renderQueue.GetPassRange(pass, start, end);
+
+	for (size_t i = start; i < end; i++)
+	{
+		const RenderItem& item = renderQueue.GetSorted(i);
+		Shader* shader = item.material->GetShader().get();
 
 		// If our shader has changed, we need to bind it and Update our frame-level uniforms
-		if (renderer.Material->GetShader() != boundShader) {
-			boundShader = renderer.Material->GetShader();
+		if (shader != boundShader) {
+			boundShader = shader;
 			boundShader->Bind();
 
 			// if the object is to have a fixed screen position.
-			if (renderer.Mesh->GetWindowChild())
+			if (item.mesh->GetWindowChild())
 				boundShader->SetUniform("a_CameraPos", myCameraX->GetPosition()); // uses Hud/UI camera
 			else
 				boundShader->SetUniform("a_CameraPos", camera->GetPosition()); // uses provided camera position.
@@ -1464,61 +1542,71 @@ void cherry::Game::__RenderScene(glm::ivec4 viewport, const Camera::Sptr& camera
 			boundShader->SetUniform("a_Time", static_cast<float>(glfwGetTime())); // passing in the time.
 		}
 		// If our material has changed, we need to apply it to the shader
-		if (renderer.Material != mat) {
-			mat = renderer.Material;
+		if (item.material != mat) {
+			mat = item.material;
 			mat->Apply();
 		}
 
-		// We'll need some info about the entities position in the world
-		const TempTransform& transform = postTransforms[i];
+		// sprites are added to the batch, which is drawn once the next item can't be added to it.
+		// the batch is in world space, so the model matrix isn't used.
+		if (item.mesh->IsSprite())
+		{
+			spriteBatch.Add(item.mesh, item.transform);
 
-		// Get the object's transformation
-		// TODO: set up parent system
-		glm::mat4 worldTransform = transform.GetWorldTransform();
+			// the next item must be a sprite with the same material, and the same draw settings.
+			bool batchNext = false;
+
+			if (i + 1 < end)
+			{
+				const RenderItem& next = renderQueue.GetSorted(i + 1);
+
+				batchNext = next.mesh->IsSprite() && next.material == item.material &&
+					next.mesh->GetWindowChild() == item.mesh->GetWindowChild() &&
+					next.mesh->cullFaces == item.mesh->cullFaces && next.mesh->IsWireframe() == item.mesh->IsWireframe();
+			}
+
+			if (!batchNext)
+			{
+				boundShader->SetUniform("a_ModelViewProjection", 
+					(item.mesh->GetWindowChild()) ? myCameraX->GetViewProjection() : camera->GetViewProjection());
+				boundShader->SetUniform("a_Model", glm::mat4(1.0F));
+				boundShader->SetUniform("a_NormalMatrix", glm::mat3(1.0F));
+
+				GLState::PolygonMode((item.mesh->IsWireframe()) ? GL_LINE : GL_FILL);
+				GLState::SetEnabled(GL_CULL_FACE, item.mesh->cullFaces);
+				spriteBatch.Draw();
+			}
+
+			continue;
+		}
 
 		// Our normal matrix is the inverse-transpose of our object's world rotation
 		// Recall that everything's backwards in GLM
-		glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(worldTransform)));
+		glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(item.transform)));
 
 		// Update the MVP using the item's transform
-		if (renderer.Mesh->GetWindowChild())
+		if (item.mesh->GetWindowChild())
 		{
-			mat->GetShader()->SetUniform("a_ModelViewProjection", myCameraX->GetViewProjection() * worldTransform);
+			boundShader->SetUniform("a_ModelViewProjection", myCameraX->GetViewProjection() * item.transform);
 		}
 		else
 		{
-			mat->GetShader()->SetUniform("a_ModelViewProjection", camera->GetViewProjection() * worldTransform);
+			boundShader->SetUniform("a_ModelViewProjection", camera->GetViewProjection() * item.transform);
 		}
 
 		// Update the model matrix to the item's world transform
-		mat->GetShader()->SetUniform("a_Model", worldTransform);
+		boundShader->SetUniform("a_Model", item.transform);
 		// Update the model matrix to the item's world transform
-		mat->GetShader()->SetUniform("a_NormalMatrix", normalMatrix);
+		boundShader->SetUniform("a_NormalMatrix", normalMatrix);
 
-		// Draw the item
-		if (renderer.Mesh->IsVisible())
-		{
-			// if the mesh is in wireframe mode, and the draw call isn't set to that already.
-			if (renderer.Mesh->IsWireframe() != wireframe)
-			{
-				wireframe = !wireframe;
+		// switches between wireframe mode and fill mode. GLState skips the call if the mode is already set.
+		GLState::PolygonMode((item.mesh->IsWireframe()) ? GL_LINE : GL_FILL);
 
-				// switches between wireframe mode and fill mode.
-				(wireframe) ? glPolygonMode(GL_FRONT_AND_BACK, GL_LINE) : glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-			}
-
-			// the faces should or should not be culled. Since faces should be culled by default, it's turned back on.
-			if (!renderer.Mesh->cullFaces)
-			{
-				glDisable(GL_CULL_FACE);
-				renderer.Mesh->Draw();
-				glEnable(GL_CULL_FACE);
-			}
-			else // faces are set to be culled automatically 
-			{
-				renderer.Mesh->Draw(); 
-			}
-		}
+		// the faces should or should not be culled. Meshes that share a setting don't toggle culling between them.
+		GLState::SetEnabled(GL_CULL_FACE, item.mesh->cullFaces);
+		item.mesh->Draw();
 	}
-	
+
+	// faces should be culled by default, so it's turned back on.
+	GLState::Enable(GL_CULL_FACE);
 }
\ No newline at end of file
@@ -11,6 +11,9 @@
 #include "Camera.h" // camera
 #include "Shader.h"
 #include "Mesh.h"
+#include "RenderQueue.h"
+#include "SpriteBatch.h"
+#include "physics/BVH.h"
 
 // managers
 #include "scenes/SceneManager.h"
@@ -149,6 +152,17 @@ namespace cherry
 		// if 'createScene' is true, then a new scene is made if it doesn't exist, which causes 'true' to be returned.
 		bool SetCurrentScene(std::string sceneName, bool createScene);
 
+		// preloads the scene in the background, then switches to it once the preload is done.
+		// returns 'false' if the scene doesn't exist. If the scene has already been preloaded, it's switched to on the next update.
+		bool SetCurrentSceneWhenReady(std::string sceneName);
+
+		// gets the name of the scene that will be switched to once it's preloaded. If there isn't one, an empty string is returned.
+		const std::string& GetPendingSceneName() const;
+
+		// gets the preload progress of the pending scene (0 to 1), which can be used for a loading screen.
+		// if there is no pending scene, 1 is returned.
+		float GetPendingSceneProgress() const;
+
 		// returns the name of the current scene. If the scene doesn't exist, an empty string of "" is returned.
 		const std::string & GetCurrentSceneName() const;
 
@@ -183,6 +197,13 @@ namespace cherry
 		// returns the object list for the provided scene.
 		cherry::ObjectList* GetSceneObjectList(std::string scene);
 
+		// gets the ray going from the main camera through the cursor.
+		cherry::Ray GetCursorRay() const;
+
+		// finds the closest object in the current scene under the cursor. Objects that are hidden or are children of the window are skipped.
+		// the hit has the triangle and the point on it that was hit. Returns nullptr if there's nothing under the cursor.
+		cherry::Object* PickObject(cherry::RayHit& hit);
+
 		// replace with object manager
 		// gets an object from the current scene
 		cherry::Object * GetCurrentSceneObjectByIndex(unsigned int index) const;
@@ -307,6 +328,10 @@ namespace cherry
 		void __RenderScene(glm::ivec4 viewport, const Camera::Sptr& camera, bool drawSkybox = true,
 			int borderSize = 0, glm::vec4 borderColor = glm::vec4(1.0F, 1.0F, 1.0F, 1.0F), bool clear = true);
 
+		// draws all of the items in the render queue that belong to the provided pass.
+		// the render queue must be sorted before this is called.
+		void __DrawRenderPass(uint32_t pass, const Camera::Sptr& camera);
+
 
 		// list of scenes
 		// std::vector<std::string> scenes;
@@ -332,14 +357,23 @@ namespace cherry
 		// the opening scene of the game.
 		Scene* openingScene = nullptr;
 
+		// the scene that's switched to once it's been preloaded.
+		std::string pendingScene = "";
+
 		// object list
 		cherry::ObjectList* objectList = nullptr;
 
 		// light list
 		cherry::LightList* lightList = nullptr;
 
-		// checks for wireframe being active.
-		bool wireframe = false;
+		// the render queue, which sorts the draw calls for each camera.
+		RenderQueue renderQueue;
+
+		// the sprite batch, which draws the sprites that share a material together.
+		SpriteBatch spriteBatch;
+
+		// the render graph for the post processing layers.
+		RenderGraph postGraph;
 
 		// Model transformation matrix
 		glm::mat4 myModelTransform;
@@ -0,0 +1,71 @@
+// GpuTimer (Source) - measures how long the GPU takes to run a group of commands
+#include "GpuTimer.h"
+
+// destructor
+cherry::GpuTimer::~GpuTimer()
+{
+	if (queries[0] != 0)
+		glDeleteQueries(GPU_TIMER_QUERIES, queries);
+}
+
+// begins timing
+void cherry::GpuTimer::Begin()
+{
+	if (running)
+		return;
+
+	// the queries are made the first time they're needed.
+	if (queries[0] == 0)
+		glCreateQueries(GL_TIME_ELAPSED, GPU_TIMER_QUERIES, queries);
+
+	ReadResults();
+
+	glBeginQuery(GL_TIME_ELAPSED, queries[current]);
+	running = true;
+}
+
+// ends timing
+void cherry::GpuTimer::End()
+{
+	if (!running)
+		return;
+
+	glEndQuery(GL_TIME_ELAPSED);
+
+	pending[current] = true;
+	current = (current + 1) % GPU_TIMER_QUERIES;
+	running = false;
+}
+
+// gets the time
+float cherry::GpuTimer::GetMilliseconds() const { return milliseconds; }
+
+// reads the results
+void cherry::GpuTimer::ReadResults()
+{
+	// goes from the oldest query to the newest, so the newest result is the one that's kept.
+	for (uint32_t i = 0; i < GPU_TIMER_QUERIES; i++)
+	{
+		uint32_t index = (current + i) % GPU_TIMER_QUERIES;
+		GLint available = 0;
+
+		if (!pending[index])
+			continue;
+
+		glGetQueryObjectiv(queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+
+		if (available)
+		{
+			GLuint64 nanoseconds = 0;
+
+			glGetQueryObjectui64v(queries[index], GL_QUERY_RESULT, &nanoseconds);
+			milliseconds = nanoseconds / 1000000.0F;
+			pending[index] = false;
+		}
+		// a query that's being reused without a result loses its old result.
+		else if (index == current)
+		{
+			pending[index] = false;
+		}
+	}
+}
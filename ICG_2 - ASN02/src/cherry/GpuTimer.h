@@ -0,0 +1,45 @@
+// GpuTimer (Header) - measures how long the GPU takes to run a group of commands
+#pragma once
+#include <glad/glad.h>
+#include <stdint.h>
+
+// the amount of queries each timer cycles through, so that reading a result doesn't stall.
+#define GPU_TIMER_QUERIES 4
+
+namespace cherry
+{
+	/*
+	 * Times the commands between Begin() and End() with GL_TIME_ELAPSED queries.
+	 * The results are read a few frames later, once the GPU has finished with them, so the time is slightly behind.
+	 * Only one timer can be running at once, since OpenGL doesn't allow time elapsed queries to be nested.
+	*/
+	class GpuTimer
+	{
+	public:
+		// constructor. The queries are made on the first Begin(), since there may not be an OpenGL context yet.
+		GpuTimer() = default;
+
+		// deletes the queries.
+		~GpuTimer();
+
+		// starts timing.
+		void Begin();
+
+		// stops timing.
+		void End();
+
+		// gets the most recent time that the GPU has finished (in milliseconds).
+		float GetMilliseconds() const;
+
+	private:
+		// reads the results of the queries that are done.
+		void ReadResults();
+
+		GLuint queries[GPU_TIMER_QUERIES] = {}; // the queries
+		bool pending[GPU_TIMER_QUERIES] = {}; // 'true' if the query is waiting on a result.
+		uint32_t current = 0; // the query used for the next Begin()
+		bool running = false; // 'true' if between Begin() and End()
+
+		float milliseconds = 0.0F; // the last result
+	};
+}
@@ -0,0 +1,112 @@
+// HotReload (Source) - watches the resource files, and reloads the shaders, materials, and meshes that use them when they change.
+#include "HotReload.h"
+#include "Shader.h"
+#include "Material.h"
+#include "objects/ObjectManager.h"
+
+#include <GLFW/glfw3.h>
+#include <toolkit/Logging.h>
+#include <chrono>
+#include <vector>
+
+// release builds don't check the files unless it's turned on.
+#ifdef NDEBUG
+bool cherry::HotReload::enabled = false;
+#else
+bool cherry::HotReload::enabled = true;
+#endif // NDEBUG
+double cherry::HotReload::nextPoll = 0.0;
+std::unordered_map<std::string, std::filesystem::file_time_type> cherry::HotReload::files;
+
+// sets whether hot reloading is enabled
+void cherry::HotReload::SetEnabled(bool enable) { enabled = enable; }
+
+// checks if hot reloading is enabled
+bool cherry::HotReload::IsEnabled() { return enabled; }
+
+// watches a file
+void cherry::HotReload::Watch(const std::string& filePath)
+{
+	std::string path = NormalizePath(filePath);
+
+	if (path == "" || files.find(path) != files.end())
+		return;
+
+	std::error_code ec;
+	std::filesystem::file_time_type time = std::filesystem::last_write_time(path, ec);
+
+	// the file doesn't exist.
+	if (ec)
+		return;
+
+	files[path] = time;
+}
+
+// stops watching a file
+void cherry::HotReload::Unwatch(const std::string& filePath) { files.erase(NormalizePath(filePath)); }
+
+// gets the amount of watched files
+size_t cherry::HotReload::GetWatchCount() { return files.size(); }
+
+// update
+void cherry::HotReload::Update()
+{
+	if (!enabled || glfwGetTime() < nextPoll)
+		return;
+
+	Poll();
+	nextPoll = glfwGetTime() + HOT_RELOAD_INTERVAL;
+}
+
+// checks the files
+int cherry::HotReload::Poll()
+{
+	std::vector<std::pair<std::string, std::filesystem::file_time_type>> changed;
+
+	for (auto& kvp : files)
+	{
+		std::error_code ec;
+		std::filesystem::file_time_type time = std::filesystem::last_write_time(kvp.first, ec);
+
+		// the file can't be read (e.g. it's being saved), so it's checked again next time.
+		if (ec || time == kvp.second)
+			continue;
+
+		kvp.second = time;
+		changed.push_back({ kvp.first, time });
+	}
+
+	// the files are reloaded after the loop, since reloading can add more files to the map.
+	for (const auto& file : changed)
+	{
+		int count = Reload(file.first);
+
+		// the time from the file being saved to the new version being used.
+		float latency = std::chrono::duration<float, std::milli>(std::filesystem::file_time_type::clock::now() - file.second).count();
+
+		LOG_INFO("Hot reload: \"{}\" changed; {} resource(s) reloaded, {:.1f} ms after the file was saved.", file.first, count, latency);
+	}
+
+	return (int)changed.size();
+}
+
+// normalizes the path
+std::string cherry::HotReload::NormalizePath(const std::string& filePath)
+{
+	if (filePath == "")
+		return "";
+
+	return std::filesystem::path(filePath).lexically_normal().generic_string();
+}
+
+// reloads what uses the file
+int cherry::HotReload::Reload(const std::string& filePath)
+{
+	int count = 0;
+
+	count += Shader::ReloadFile(filePath);
+	count += Material::ReloadMtlFile(filePath);
+	count += ObjectManager::ReloadObjectFile(filePath);
+
+	return count;
+}
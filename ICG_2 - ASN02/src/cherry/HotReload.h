@@ -0,0 +1,57 @@
+// HotReload (Header) - watches the resource files, and reloads the shaders, materials, and meshes that use them when they change.
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <filesystem>
+
+// the amount of time (in seconds) between checks of the watched files.
+#define HOT_RELOAD_INTERVAL 0.5F
+
+namespace cherry
+{
+	/*
+	 * Files are watched once they've been loaded by a Shader, Material (.mtl), or Object (.obj).
+	 * Update() checks the last write time of each file every HOT_RELOAD_INTERVAL seconds, and reloads the resources that use the changed files.
+	 * Update() is called at the start of the game's update, so the changes are swapped in between frames.
+	 * If a reload fails (e.g. the shader doesn't compile), the old version is kept, and the file is tried again the next time it's saved.
+	*/
+	class HotReload
+	{
+	public:
+		// sets whether the files should be checked for changes.
+		// this is only on by default in debug builds, since release builds shouldn't be polling the disk.
+		static void SetEnabled(bool enable);
+
+		// returns 'true' if the files are being checked for changes.
+		static bool IsEnabled();
+
+		// starts watching a file. If the file is already being watched, nothing happens.
+		static void Watch(const std::string& filePath);
+
+		// stops watching a file.
+		static void Unwatch(const std::string& filePath);
+
+		// gets the amount of files being watched.
+		static size_t GetWatchCount();
+
+		// checks the files for changes, and reloads what uses the changed files.
+		// this should be called on the main thread, once per frame.
+		static void Update();
+
+		// checks all of the files right away, and reloads what uses the changed files. Returns the amount of files that changed.
+		static int Poll();
+
+		// gets the path in a common format, so that paths can be compared (e.g. "res/./a.obj" and "res\a.obj" are the same).
+		static std::string NormalizePath(const std::string& filePath);
+
+	private:
+		// reloads the resources using the file. Returns the amount of resources reloaded.
+		static int Reload(const std::string& filePath);
+
+		static bool enabled; // if 'true', the files are checked.
+		static double nextPoll; // the time of the next check.
+
+		// the last write time of each file being watched.
+		static std::unordered_map<std::string, std::filesystem::file_time_type> files;
+	};
+}
@@ -1,8 +1,65 @@
 // Material - used for adding materials to meshes
 #include "Material.h"
 #include "utils/Utils.h"
+#include "GLState.h"
+#include "HotReload.h"
+#include "ShaderCache.h"
 
 #include <fstream>
+#include <algorithm>
+#include <toolkit/Logging.h>
+
+// the amount of materials that have been made.
+uint32_t cherry::Material::materialCount = 0;
+
+// the materials that exist.
+std::unordered_set<cherry::Material*> cherry::Material::allMaterials;
+
+// constructor
+cherry::Material::Material(const Shader::Sptr& shader) : HasTransparency(false), sortId(++materialCount)
+{
+	myShader = shader;
+	allMaterials.insert(this);
+}
+
+// destructor
+cherry::Material::~Material() { allMaterials.erase(this); }
+
+// sets a keyword
+bool cherry::Material::SetKeyword(const std::string& keyword, bool enable)
+{
+	if (myShader == nullptr || std::string(myShader->GetVertexShader()) == "" || std::string(myShader->GetFragmentShader()) == "")
+		return false;
+
+	// the keywords for the new variant.
+	std::vector<std::string> keywords = myShader->GetKeywords();
+
+	if (enable)
+		keywords.push_back(keyword);
+	else
+		keywords.erase(std::remove(keywords.begin(), keywords.end(), keyword), keywords.end());
+
+	if (Shader::SortKeywords(keywords) == myShader->GetKeywords())
+		return true;
+
+	try
+	{
+		myShader = ShaderCache::Get(myShader->GetVertexShader(), myShader->GetFragmentShader(), keywords);
+	}
+	catch (const std::exception& e)
+	{
+		LOG_WARN("Material variant [{}] couldn't be compiled: {}", Shader::MakeVariantKey(keywords), e.what());
+		return false;
+	}
+
+	return true;
+}
+
+// checks for a keyword
+bool cherry::Material::HasKeyword(const std::string& keyword) const { return myShader != nullptr && myShader->HasKeyword(keyword); }
+
+// gets the variant key
+std::string cherry::Material::GetVariantKey() const { return (myShader != nullptr) ? myShader->GetVariantKey() : ""; }
 
 void cherry::Material::Apply() {
 
@@ -28,6 +85,7 @@ void cherry::Material::Apply() {
 	//}
 
 	// updated in tutorial 09 of Intro. to Computer Graphics
+	// the binds go through GLState, so slots that already have the same texture and sampler aren't rebound.
 	int slot = 0;
 	for (auto& kvp : myTextures) {
 		if (kvp.second.Sampler != nullptr)
@@ -49,15 +107,19 @@ void cherry::Material::Apply() {
 		myShader->SetUniform(kvp.first.c_str(), slot);
 	}
 
+	// the uniform buffers
+	for (auto& kvp : myUniformBuffers)
+		glBindBufferBase(GL_UNIFORM_BUFFER, kvp.first, kvp.second);
+
 	// mulitiplies everything by the source alpha so that transparent sceneLists don't blend with the clear colour.
 	if (HasTransparency) {
-		glEnable(GL_BLEND);
-		glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE);
-		glDisable(GL_DEPTH_TEST);
+		GLState::Enable(GL_BLEND);
+		GLState::BlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE);
+		GLState::Disable(GL_DEPTH_TEST);
 	}
 	else {
-		glDisable(GL_BLEND);
-		glEnable(GL_DEPTH_TEST);
+		GLState::Disable(GL_BLEND);
+		GLState::Enable(GL_DEPTH_TEST);
 	}
 }
 
@@ -229,15 +291,56 @@ bool cherry::Material::LoadMtl(std::string filePath, const TextureSampler::Sptr&
 
 	file.close(); // closing the file
 
+	// saved so that the material can be reloaded if the file changes.
+	mtlFile = filePath;
+	mtlSampler = sampler;
+	HotReload::Watch(filePath);
+
 	return true;
 }
 
+// gets the .mtl file
+const std::string& cherry::Material::GetMtlFile() const { return mtlFile; }
+
+// gets the uniform buffer
+GLuint cherry::Material::GetUniformBuffer(GLuint binding) const
+{
+	std::unordered_map<GLuint, GLuint>::const_iterator iter = myUniformBuffers.find(binding);
+	return (iter != myUniformBuffers.end()) ? iter->second : 0;
+}
+
+// reloads the materials using the .mtl file
+int cherry::Material::ReloadMtlFile(const std::string& filePath)
+{
+	const std::string path = HotReload::NormalizePath(filePath);
+	int count = 0;
+
+	for (Material* material : allMaterials)
+	{
+		if (material->mtlFile == "" || HotReload::NormalizePath(material->mtlFile) != path)
+			continue;
+
+		// values that aren't in the file are kept, the same as when the file was first loaded.
+		try
+		{
+			if (material->LoadMtl(material->mtlFile, material->mtlSampler))
+				count++;
+		}
+		catch (const std::exception& e)
+		{
+			LOG_WARN("Reloading material \"{}\" failed: {}", material->mtlFile, e.what());
+		}
+	}
+
+	return count;
+}
+
 // creates a material using and MTL file and returns it.
-cherry::Material::Sptr cherry::Material::GenerateMtl(std::string filePath, const TextureSampler::Sptr& sampler, std::string vs, std::string fs)
+cherry::Material::Sptr cherry::Material::GenerateMtl(std::string filePath, const TextureSampler::Sptr& sampler, std::string vs, std::string fs,
+	const std::vector<std::string>& keywords)
 {
-	// creates the material and gives it a shader
-	Shader::Sptr shader = std::make_shared<cherry::Shader>();
-	shader->Load(vs.c_str(), fs.c_str());
+	// creates the material and gives it a shader, which is shared with other materials using the same variant.
+	Shader::Sptr shader = ShaderCache::Get(vs, fs, keywords);
 
 	cherry::Material::Sptr tempMat = std::make_shared<cherry::Material>(shader);
 	
@@ -2,6 +2,7 @@
 #pragma once
 #include <GLM/glm.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
  
 #include "Shader.h"
@@ -23,15 +24,29 @@ namespace cherry
 		typedef std::shared_ptr<Material> Sptr;
 
 		// all sceneLists are opaque by default.
-		Material(const Shader::Sptr& shader) :HasTransparency(false) { myShader = shader; }
+		Material(const Shader::Sptr& shader);
 		
-		virtual ~Material() = default;
+		// destructor
+		virtual ~Material();
 
 		const Shader::Sptr& GetShader() const { return myShader; }
 
 		// sets the shader for the material
 		void SetShader(Shader::Sptr shader) { myShader = shader; }
 
+		// enables or disables a keyword for the material's shader. The material is given the variant from the ShaderCache.
+		// returns 'false' if the variant couldn't be compiled, or the shader wasn't loaded from files.
+		bool SetKeyword(const std::string& keyword, bool enable);
+
+		// returns 'true' if the material's shader variant has the keyword.
+		bool HasKeyword(const std::string& keyword) const;
+
+		// gets the variant key of the material's shader.
+		std::string GetVariantKey() const;
+
+		// gets the id used to sort draw calls by material.
+		uint32_t GetSortId() const { return sortId; }
+
 		// applies all uniforms to the shader.
 		virtual void Apply();
 
@@ -51,15 +66,31 @@ namespace cherry
 			myCubeMaps[name] = { value, sampler };
 		}
 
+		// sets a uniform buffer, which is bound to the provided binding point when the material is applied.
+		void SetUniformBuffer(GLuint binding, GLuint buffer) { myUniformBuffers[binding] = buffer; }
+
+		// gets the uniform buffer at the binding point. If there isn't one, 0 is returned.
+		GLuint GetUniformBuffer(GLuint binding) const;
+
+		// removes the uniform buffer at the binding point.
+		void RemoveUniformBuffer(GLuint binding) { myUniformBuffers.erase(binding); }
+
 		// loads a material from a MaterialTemplateLibrary (.mtl) file.
 		// this replaces the applicable values in this material with the ones from the .mtl file
 		// make sure the material has values already, since the .mtl file doesn't override every value for the Material class.
 		// You can also pass the sampler the material.
 		bool LoadMtl(std::string filePath, const TextureSampler::Sptr& sampler = nullptr);
 
+		// gets the .mtl file that was last loaded into the material. If none was loaded, an empty string is returned.
+		const std::string& GetMtlFile() const;
+
+		// loads every material that uses the provided .mtl file again. Returns the amount of materials reloaded.
+		static int ReloadMtlFile(const std::string& filePath);
+
 		// generates a material using a .mtl file, and returns said material. Make sure to set the lighting information.
-		// pass the sampler if you so choose. This also takes in a vertex shader and fragment shader
-		static cherry::Material::Sptr GenerateMtl(std::string filePath, const TextureSampler::Sptr& sampler = nullptr, std::string vs = STATIC_VS, std::string fs = STATIC_FS);
+		// pass the sampler if you so choose. This also takes in a vertex shader and fragment shader, and the keywords for the shader variant.
+		static cherry::Material::Sptr GenerateMtl(std::string filePath, const TextureSampler::Sptr& sampler = nullptr, std::string vs = STATIC_VS, std::string fs = STATIC_FS,
+			const std::vector<std::string>& keywords = std::vector<std::string>());
 
 
 	private:
@@ -74,6 +105,15 @@ namespace cherry
 		std::string name = ""; // name of material
 		std::string textureName = ""; // file for the texture
 
+		static uint32_t materialCount; // the amount of materials made, which is used to give each material a sort id.
+		uint32_t sortId; // the id used to sort draw calls.
+
+		std::string mtlFile = ""; // the .mtl file last loaded into the material.
+		TextureSampler::Sptr mtlSampler = nullptr; // the sampler the .mtl file was loaded with.
+
+		// all of the materials that currently exist, which is used for reloading.
+		static std::unordered_set<Material*> allMaterials;
+
 	protected:
 
 		struct Sampler2DInfo {
@@ -99,5 +139,7 @@ namespace cherry
 		std::unordered_map<std::string, int> myInts;
 
 		std::unordered_map<std::string, Sampler2DInfo> myTextures; // changed to use the struct.
+
+		std::unordered_map<GLuint, GLuint> myUniformBuffers; // the uniform buffers, found by their binding points.
 	};
 }
\ No newline at end of file
@@ -1,7 +1,10 @@
 // Vertex Structs, and Mesh Class (Source)
 // Loads in meshes for rendering to the screen
 #include "Mesh.h"
+#include "GLState.h"
 #include <toolkit/Logging.h>
+#include <string.h>
+#include <cstddef> // offsetof
 
 // constructor
 cherry::Mesh::Mesh(Vertex* vertices, size_t numVerts, uint32_t* indices, size_t numIndices) {
@@ -10,7 +13,7 @@ cherry::Mesh::Mesh(Vertex* vertices, size_t numVerts, uint32_t* indices, size_t
 
 	// Create and bind our vertex array
 	glCreateVertexArrays(1, &myVao);
-	glBindVertexArray(myVao);
+	GLState::BindVertexArray(myVao);
 	// Create 2 buffers, 1 for vertices and the other for indices
 	glCreateBuffers(2, myBuffers); // generates a name interally so you can use direct state access.
 
@@ -53,7 +56,7 @@ cherry::Mesh::Mesh(Vertex* vertices, size_t numVerts, uint32_t* indices, size_t
 	glVertexAttribPointer(3, 2, GL_FLOAT, false, sizeof(Vertex), &(vert->UV));
 
 	// Unbind our VAO (just ot be safe and make sure we don't modify it by accident)
-	glBindVertexArray(0);
+	GLState::BindVertexArray(0);
 }
 
 cherry::Mesh::Mesh(Vertex* vertices, size_t numVerts, uint32_t* indices, size_t numIndices, bool wireframe)
@@ -67,9 +70,12 @@ cherry::Mesh::Mesh(MorphVertex* vertices, size_t numVerts, uint32_t* indices, si
 {
 	myIndexCount = numIndices;
 	myVertexCount = numVerts;
+	myVertexStride = sizeof(MorphVertex);
+	morphMesh = true;
+
 	// Create and bind our vertex array
 	glCreateVertexArrays(1, &myVao);
-	glBindVertexArray(myVao);
+	GLState::BindVertexArray(myVao);
 	// Create 2 buffers, 1 for vertices and the other for indices
 	glCreateBuffers(2, myBuffers); // generates a name interally so you can use direct state access.
 
@@ -146,23 +152,47 @@ cherry::Mesh::Mesh(MorphVertex* vertices, size_t numVerts, uint32_t* indices, si
 	glVertexAttribPointer(11, 2, GL_FLOAT, false, sizeof(MorphVertex), &(vert->UV2));
 
 	// Unbind our VAO (just ot be safe and make sure we don't modify it by accident)
-	glBindVertexArray(0);
+	GLState::BindVertexArray(0);
+}
+
+// creates a mesh that shares the buffers of another mesh
+cherry::Mesh::Mesh(const Sptr& source)
+{
+	// the buffers always come from the mesh that made them.
+	sharedSource = (source->sharedSource != nullptr) ? source->sharedSource : source;
+
+	myVao = sharedSource->myVao;
+	myBuffers[0] = sharedSource->myBuffers[0];
+	myBuffers[1] = sharedSource->myBuffers[1];
+
+	myVertexCount = sharedSource->myVertexCount;
+	myIndexCount = sharedSource->myIndexCount;
+	myVertexStride = sharedSource->myVertexStride;
+	morphMesh = sharedSource->morphMesh;
+
+	cullFaces = source->cullFaces;
 }
 
 // destructor
 cherry::Mesh::~Mesh()
 {
+	// the source deletes the buffers once no other meshes are using them.
+	if (sharedSource != nullptr)
+		return;
+
 	// Clean up our buffers
 	glDeleteBuffers(2, myBuffers);
+	delete myStream;
 
 	// Clean up our VAO
+	GLState::ForgetVertexArray(myVao);
 	glDeleteVertexArrays(1, &myVao);
 }
 
 // drawing function for meshes
 void cherry::Mesh::Draw() {
 	// Bind the mesh
-	glBindVertexArray(myVao);
+	GLState::BindVertexArray(myVao);
 
 	// if we have indices, we enter this statement.
 	if (myIndexCount > 0)
@@ -178,6 +208,20 @@ void cherry::Mesh::Draw() {
 	}
 }
 
+// draws instances of the mesh
+void cherry::Mesh::DrawInstanced(uint32_t instances)
+{
+	if (instances == 0)
+		return;
+
+	GLState::BindVertexArray(myVao);
+
+	if (myIndexCount > 0)
+		glDrawElementsInstanced(GL_TRIANGLES, myIndexCount, GL_UNSIGNED_INT, nullptr, instances);
+	else
+		glDrawArraysInstanced(GL_TRIANGLES, 0, myVertexCount, instances);
+}
+
 // returns 'true' if the mesh is in wireframe mode. False otherwise.
 bool cherry::Mesh::IsWireframe() { return wireframe; }
 
@@ -229,11 +273,60 @@ bool cherry::Mesh::GetWindowChild() const { return windowChild; }
 // sets if the mesh has a fixed screen position or not.
 void cherry::Mesh::SetWindowChild(bool windowChild) { this->windowChild = windowChild; }
 
+// gets the vertex array object
+GLuint cherry::Mesh::GetVao() const { return myVao; }
+
+// sets the sprite data
+void cherry::Mesh::SetSpriteData(const Vertex* vertices, size_t numVerts, const uint32_t* indices, size_t numIndices)
+{
+	spriteVertices.assign(vertices, vertices + numVerts);
+	spriteIndices.assign(indices, indices + numIndices);
+}
+
+// checks if the mesh is a sprite
+bool cherry::Mesh::IsSprite() const { return !spriteVertices.empty(); }
+
+// gets the sprite vertices
+const std::vector<cherry::Vertex>& cherry::Mesh::GetSpriteVertices() const { return spriteVertices; }
+
+// gets the sprite indices
+const std::vector<uint32_t>& cherry::Mesh::GetSpriteIndices() const { return spriteIndices; }
+
+// sets the sprite frame
+void cherry::Mesh::SetSpriteFrame(const SpriteFrame& frame) { spriteFrame = frame; }
+
+// gets the sprite frame
+const cherry::SpriteFrame& cherry::Mesh::GetSpriteFrame() const { return spriteFrame; }
+
+
+// checks if shared
+bool cherry::Mesh::IsShared() const { return sharedSource != nullptr; }
 
 // morph for regular vertices
 void cherry::Mesh::Morph(Vertex* vertices, size_t numVerts)
 {
+	if (sharedSource != nullptr)
+	{
+		LOG_ERROR("Morph() was called on a shared mesh. The vertices belong to another mesh.");
+		return;
+	}
+
+	// if the size is the same, the vertices are streamed instead of reallocating the buffer.
+	if (!morphMesh && numVerts == myVertexCount)
+	{
+		UpdateVertices(vertices, 0, numVerts);
+		return;
+	}
+
 	glNamedBufferData(myBuffers[0], sizeof(Vertex) * numVerts, vertices, GL_DYNAMIC_DRAW);
+
+	// the stream buffer no longer matches the size of the vertices, so the original buffer is used again.
+	if (myStream != nullptr)
+	{
+		delete myStream;
+		myStream = nullptr;
+		__BindVertexBuffer(myBuffers[0], 0);
+	}
 }
 
 // gets the vertices and takes out the positions and normals for morphing the mesh
@@ -250,8 +343,69 @@ void cherry::Mesh::Morph(MorphVertex* vertices, size_t numVerts)
 
 	//Morph(positions, normals, numVerts);
 
+	if (sharedSource != nullptr)
+	{
+		LOG_ERROR("Morph() was called on a shared mesh. The vertices belong to another mesh.");
+		return;
+	}
+
+	// if the size is the same, the vertices are streamed instead of reallocating the buffer.
+	if (morphMesh && numVerts == myVertexCount)
+	{
+		UpdateVertices(vertices, 0, numVerts);
+		return;
+	}
+
 	glNamedBufferData(myBuffers[0], sizeof(MorphVertex) * numVerts, vertices, GL_DYNAMIC_DRAW);
 
+	if (myStream != nullptr)
+	{
+		delete myStream;
+		myStream = nullptr;
+		__BindVertexBuffer(myBuffers[0], 0);
+	}
+}
+
+// maps vertices
+cherry::Vertex* cherry::Mesh::MapVertices(size_t first, size_t count)
+{
+	if (morphMesh)
+	{
+		LOG_ERROR("MapVertices() was called on a mesh made of morph vertices. Use MapMorphVertices() instead.");
+		return nullptr;
+	}
+
+	return (Vertex*)__MapVertexRange(first, count);
+}
+
+// maps morph vertices
+cherry::MorphVertex* cherry::Mesh::MapMorphVertices(size_t first, size_t count)
+{
+	if (!morphMesh)
+	{
+		LOG_ERROR("MapMorphVertices() was called on a mesh made of regular vertices. Use MapVertices() instead.");
+		return nullptr;
+	}
+
+	return (MorphVertex*)__MapVertexRange(first, count);
+}
+
+// updates vertices
+void cherry::Mesh::UpdateVertices(const Vertex* vertices, size_t first, size_t count)
+{
+	Vertex* dest = MapVertices(first, count);
+
+	if (dest != nullptr && vertices != nullptr)
+		memcpy(dest, vertices, sizeof(Vertex) * count);
+}
+
+// updates morph vertices
+void cherry::Mesh::UpdateVertices(const MorphVertex* vertices, size_t first, size_t count)
+{
+	MorphVertex* dest = MapMorphVertices(first, count);
+
+	if (dest != nullptr && vertices != nullptr)
+		memcpy(dest, vertices, sizeof(MorphVertex) * count);
 }
 
 // converts from a regular vertex to a morph vertex
@@ -378,3 +532,70 @@ cherry::Mesh::Sptr cherry::Mesh::MakeSubdividedPlane(float size, int numSections
 	// Return the result
 	return result;
 }
+
+// maps a range of the vertices
+void* cherry::Mesh::__MapVertexRange(size_t first, size_t count)
+{
+	GLintptr prevOffset = 0; // the offset of the vertices currently being used.
+	GLintptr offset = 0; // the offset of the vertices being written to.
+	size_t last = first + count; // the vertex after the range.
+
+	if (sharedSource != nullptr)
+	{
+		LOG_ERROR("The vertices of a shared mesh can't be mapped, since they belong to another mesh.");
+		return nullptr;
+	}
+
+	if (count == 0 || last > myVertexCount)
+	{
+		LOG_ERROR("Vertex range [{}, {}) is out of bounds for a mesh with {} vertices.", first, last, myVertexCount);
+		return nullptr;
+	}
+
+	// the first time the vertices are mapped, the stream buffer is made and the original vertices are copied into it.
+	if (myStream == nullptr)
+	{
+		myStream = new StreamBuffer(myVertexCount * myVertexStride);
+		glCopyNamedBufferSubData(myBuffers[0], myStream->GetBuffer(), 0, myStream->GetRegionOffset(0), myVertexCount * myVertexStride);
+	}
+
+	prevOffset = myStream->GetRegionOffset(myStream->GetRegionIndex());
+
+	// moves onto the next region. The GPU may still be drawing from the previous ones.
+	myStream->Advance();
+	offset = myStream->GetRegionOffset(myStream->GetRegionIndex());
+
+	// the vertices outside of the range are copied on the GPU, so they never pass through the CPU.
+	if (first > 0)
+		glCopyNamedBufferSubData(myStream->GetBuffer(), myStream->GetBuffer(), prevOffset, offset, first * myVertexStride);
+
+	if (last < myVertexCount)
+		glCopyNamedBufferSubData(myStream->GetBuffer(), myStream->GetBuffer(),
+			prevOffset + last * myVertexStride, offset + last * myVertexStride, (myVertexCount - last) * myVertexStride);
+
+	__BindVertexBuffer(myStream->GetBuffer(), offset);
+
+	return (uint8_t*)myStream->GetRegionData(myStream->GetRegionIndex()) + first * myVertexStride;
+}
+
+// binds the vertex buffer
+void cherry::Mesh::__BindVertexBuffer(GLuint buffer, GLintptr offset)
+{
+	// glVertexAttribPointer gives each attribute its own binding, with the attribute's offset as the binding's offset.
+	// these are in the same order as the attributes set up in the constructors.
+	static const size_t vertexOffsets[] = {
+		offsetof(Vertex, Position), offsetof(Vertex, Color), offsetof(Vertex, Normal), offsetof(Vertex, UV)
+	};
+
+	static const size_t morphOffsets[] = {
+		offsetof(MorphVertex, Position), offsetof(MorphVertex, Color), offsetof(MorphVertex, Normal), offsetof(MorphVertex, UV),
+		offsetof(MorphVertex, Position1), offsetof(MorphVertex, Color1), offsetof(MorphVertex, Normal1), offsetof(MorphVertex, UV1),
+		offsetof(MorphVertex, Position2), offsetof(MorphVertex, Color2), offsetof(MorphVertex, Normal2), offsetof(MorphVertex, UV2)
+	};
+
+	const size_t* offsets = (morphMesh) ? morphOffsets : vertexOffsets;
+	int total = (morphMesh) ? 12 : 4;
+
+	for (int i = 0; i < total; i++)
+		glVertexArrayVertexBuffer(myVao, i, buffer, offset + offsets[i], myVertexStride);
+}
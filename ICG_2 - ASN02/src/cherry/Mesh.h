@@ -6,9 +6,11 @@
 #include <GLM/glm.hpp> // For vec3 and vec4
 #include <cstdint> // Needed for uint32_t
 #include <memory> // Needed for smart pointers
+#include <vector>
 
 #include "UtilsCRY.h"
 #include "VectorCRY.h"
+#include "StreamBuffer.h"
 
 namespace cherry
 {
@@ -20,6 +22,14 @@ namespace cherry
 		glm::vec2 UV; // texture UV coordinates
 	};
 
+	// Sprite Frame Struct - the part of an atlas page a batched sprite shows (see SpriteBatch).
+	// the sprite's uvs are moved into the frame's uvs, so (0, 0, 1, 1) leaves them as they are.
+	struct SpriteFrame {
+		glm::vec4 Frame = glm::vec4(0.0F, 0.0F, 1.0F, 1.0F); // the uvs (x0, y0, x1, y1) of the frame.
+		glm::vec4 NextFrame = glm::vec4(0.0F, 0.0F, 1.0F, 1.0F); // the uvs of the frame that's faded into.
+		float Blend = 0.0F; // how much of the next frame is shown (0 - 1).
+	};
+
 	// Morph Vertex Struct - used for morph targets
 	// Edit: morph targets don't need colour or UVs. They were added to try and do something else, but that didn't work.
 	struct MorphVertex {
@@ -59,12 +69,19 @@ namespace cherry
 		// NOTE: this should only be used if morph targets are being used.
 		Mesh(MorphVertex* vertices, size_t numVerts, uint32_t* indices, size_t numIndices);
 
+		// creates a mesh that draws the vertices and indices of the source mesh, which is kept alive for as long as this mesh is.
+		// the settings (wireframe, visibility, culling, etc.) aren't shared, but the vertices are, so shared meshes can't be morphed or mapped.
+		Mesh(const Sptr& source);
+
 		// destructor
 		~Mesh();
 
 		// Draws this mesh
 		void Draw();
 
+		// Draws the provided amount of instances of this mesh. The shader uses gl_InstanceID to tell them apart.
+		void DrawInstanced(uint32_t instances);
+
 		// Returns wireframe boolean to tell the caller if the mesh is to be drawn in wireframe mode.
 		bool IsWireframe();
 
@@ -117,6 +134,31 @@ namespace cherry
 		// if 'true', the mesh will say in the same place on screen.
 		void SetWindowChild(bool fixed);
 
+		// gets the handle of the vertex array object. This is also used to sort draw calls by mesh.
+		GLuint GetVao() const;
+
+		// keeps a copy of the vertices and indices on the CPU, so that the mesh is drawn as part of a sprite batch instead of on its own.
+		// sprites that share a material are drawn together (see SpriteBatch). The provided arrays are copied, not deleted.
+		void SetSpriteData(const Vertex* vertices, size_t numVerts, const uint32_t* indices, size_t numIndices);
+
+		// returns 'true' if the mesh is drawn as part of a sprite batch.
+		bool IsSprite() const;
+
+		// returns 'true' if the mesh draws the vertices of another mesh.
+		bool IsShared() const;
+
+		// gets the vertices used for the sprite batch.
+		const std::vector<Vertex>& GetSpriteVertices() const;
+
+		// gets the indices used for the sprite batch.
+		const std::vector<uint32_t>& GetSpriteIndices() const;
+
+		// sets the frame the sprite batch moves the sprite's uvs into. This is how batched images are animated without changing their vertices.
+		void SetSpriteFrame(const SpriteFrame& frame);
+
+		// gets the sprite's frame.
+		const SpriteFrame& GetSpriteFrame() const;
+
 
 		// morph for regular vertices.
 		// note that this does NOT delete the provided vertices array.
@@ -126,6 +168,20 @@ namespace cherry
 		// note that this does NOT delete the provided vertices array.
 		void Morph(MorphVertex* vertices, size_t numVerts);
 
+		// maps a range of the mesh's vertices so that they can be written to directly. The other vertices keep their values.
+		// the returned pointer is write-only, and is only valid until the next map. This is for meshes made from Vertex.
+		// returns nullptr if the range is out of bounds.
+		Vertex* MapVertices(size_t first, size_t count);
+
+		// maps a range of the mesh's morph vertices. This is for meshes made from MorphVertex.
+		MorphVertex* MapMorphVertices(size_t first, size_t count);
+
+		// updates a range of the mesh's vertices.
+		void UpdateVertices(const Vertex* vertices, size_t first, size_t count);
+
+		// updates a range of the mesh's morph vertices.
+		void UpdateVertices(const MorphVertex* vertices, size_t first, size_t count);
+
 		// converts an array of vertices to a morph vertex. Position1 and Normal1 are made the same as Position1 and Normal.
 		// remember to delete the original verts array once this function is finished.
 		static MorphVertex* ConvertToMorphVertexArray(const Vertex* const verts, const size_t numVerts);
@@ -144,6 +200,12 @@ namespace cherry
 		bool postProcess = true;
 
 	private:
+		// moves the vertices into the next region of the stream buffer, and returns the memory for the provided range.
+		void* __MapVertexRange(size_t first, size_t count);
+
+		// points all of the vertex attributes at the provided buffer, starting at the offset.
+		void __BindVertexBuffer(GLuint buffer, GLintptr offset);
+
 		// Our GL handle for the Vertex Array Object
 		GLuint myVao;
 
@@ -153,6 +215,18 @@ namespace cherry
 		// The number of vertices and indices in this mesh
 		size_t myVertexCount, myIndexCount;
 
+		// the size of a single vertex
+		size_t myVertexStride = sizeof(Vertex);
+
+		// if 'true', the mesh uses MorphVertex instead of Vertex.
+		bool morphMesh = false;
+
+		// the mesh whose buffers are drawn, if this mesh is shared. The buffers are deleted by the source.
+		Sptr sharedSource;
+
+		// the buffer used once the vertices start being updated. It's made the first time the vertices are mapped.
+		StreamBuffer* myStream = nullptr;
+
 		// Whether or not the mesh should be drawn in wireframe mode
 		bool wireframe = false;
 
@@ -166,6 +240,11 @@ namespace cherry
 		// if 'true', the screen positon is fixed regardless of the placement of the camera.
 		bool windowChild = false;
 
+		// the CPU copy of the mesh, which is used if the mesh is a sprite.
+		std::vector<Vertex> spriteVertices;
+		std::vector<uint32_t> spriteIndices;
+		SpriteFrame spriteFrame;
+
 		// TODO: implement method of redrawing the mesh in multiple locations
 		// cherry::Vec3 offset; // offset for each draw call
 		// unsigned int arrRows = 1; // y-axis
@@ -0,0 +1,142 @@
+// RenderQueue (Source) - sorts mesh renderers by a packed 64-bit key before they're drawn
+#include "RenderQueue.h"
+
+#include <string.h>
+#include <algorithm>
+
+// clears the queue
+void cherry::RenderQueue::Clear()
+{
+	// clear() keeps the capacity of the vectors, so no memory is freed.
+	items.clear();
+	entries.clear();
+}
+
+// submits an item
+void cherry::RenderQueue::Submit(Material* material, Mesh* mesh, const glm::mat4& transform, float depth, uint32_t pass)
+{
+	// bail out if the item can't be drawn.
+	if (material == nullptr || mesh == nullptr || material->GetShader() == nullptr)
+		return;
+
+	RenderItem item;
+	item.material = material;
+	item.mesh = mesh;
+	item.transform = transform;
+	item.pass = pass;
+
+	// the key is made now so that the sort never needs to look at the material or shader.
+	SortEntry entry;
+	entry.key = MakeKey(pass, material->HasTransparency, material->GetShader()->GetHandle(), material->GetSortId(), mesh->GetVao(), depth);
+	entry.index = (uint32_t)items.size();
+
+	items.push_back(item);
+	entries.push_back(entry);
+}
+
+// sorts the queue
+void cherry::RenderQueue::Sort()
+{
+	if (entries.size() > 1)
+		RadixSort();
+}
+
+// gets the size of the queue
+size_t cherry::RenderQueue::GetSize() const { return entries.size(); }
+
+// gets an item in sorted order
+const cherry::RenderItem& cherry::RenderQueue::GetSorted(size_t index) const { return items[entries[index].index]; }
+
+// gets the range of a pass
+void cherry::RenderQueue::GetPassRange(uint32_t pass, size_t& start, size_t& end) const
+{
+	start = 0;
+
+	// the pass is in the top bits of the key, so all items in a pass are next to each other once sorted.
+	while (start < entries.size() && (entries[start].key >> 62) < pass)
+		start++;
+
+	end = start;
+
+	while (end < entries.size() && (entries[end].key >> 62) == pass)
+		end++;
+}
+
+// makes the key
+uint64_t cherry::RenderQueue::MakeKey(uint32_t pass, bool transparent, uint32_t shaderId, uint32_t materialId, uint32_t meshId, float depth)
+{
+	uint32_t depthBits = 0;
+	uint64_t key = 0;
+
+	// positive floats keep their order when their bits are read as an unsigned integer.
+	// the sign bit is always 0, so the top 26 bits are taken after it.
+	if (depth > 0.0F)
+	{
+		memcpy(&depthBits, &depth, sizeof(float));
+		depthBits = (depthBits >> 5) & 0x3FFFFFF;
+	}
+
+	key |= ((uint64_t)(pass & 0x3)) << 62;
+	key |= ((uint64_t)(transparent ? 1 : 0)) << 61;
+
+	if (transparent) // back to front, then grouped by state.
+	{
+		key |= ((uint64_t)(~depthBits & 0x3FFFFFF)) << 35;
+		key |= ((uint64_t)(shaderId & 0x3FF)) << 25;
+		key |= ((uint64_t)(materialId & 0xFFF)) << 13;
+		key |= ((uint64_t)(meshId & 0x1FFF));
+	}
+	else // grouped by state, then front to back.
+	{
+		key |= ((uint64_t)(shaderId & 0x3FF)) << 51;
+		key |= ((uint64_t)(materialId & 0xFFF)) << 39;
+		key |= ((uint64_t)(meshId & 0x1FFF)) << 26;
+		key |= ((uint64_t)depthBits);
+	}
+
+	return key;
+}
+
+// radix sort
+void cherry::RenderQueue::RadixSort()
+{
+	const size_t count = entries.size();
+	size_t histogram[256];
+
+	scratch.resize(count);
+
+	SortEntry* src = entries.data();
+	SortEntry* dst = scratch.data();
+
+	// one pass per byte of the key.
+	for (int shift = 0; shift < 64; shift += 8)
+	{
+		memset(histogram, 0, sizeof(histogram));
+
+		for (size_t i = 0; i < count; i++)
+			histogram[(src[i].key >> shift) & 0xFF]++;
+
+		// if every key has the same digit, this pass wouldn't change anything.
+		if (histogram[(src[0].key >> shift) & 0xFF] == count)
+			continue;
+
+		// turns the histogram into starting offsets.
+		size_t offset = 0;
+		for (int i = 0; i < 256; i++)
+		{
+			size_t temp = histogram[i];
+			histogram[i] = offset;
+			offset += temp;
+		}
+
+		// the radix sort is stable, so items with equal digits keep the order from the previous pass.
+		for (size_t i = 0; i < count; i++)
+			dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+
+		std::swap(src, dst);
+	}
+
+	// if the sorted data ended up in the scratch buffer, it's swapped into the entries.
+	if (src != entries.data())
+		entries.swap(scratch);
+}
@@ -0,0 +1,78 @@
+// RenderQueue (Header) - sorts mesh renderers by a packed 64-bit key before they're drawn
+#pragma once
+#include <GLM/glm.hpp>
+#include <vector>
+#include <stdint.h>
+
+#include "Material.h"
+#include "Mesh.h"
+
+namespace cherry
+{
+	// a single draw call that has been submitted to the render queue.
+	// raw pointers are used since the queue is rebuilt every frame, and the renderers outlive it.
+	struct RenderItem
+	{
+		Material* material = nullptr; // the material (and through it, the shader)
+		Mesh* mesh = nullptr; // the mesh being drawn
+		glm::mat4 transform; // the world transform, calculated when the item was submitted.
+		uint32_t pass = 0; // the pass the item is drawn in (0 = before post processing, 1 = after post processing)
+	};
+
+	/*
+	 * The render queue builds a 64-bit key for each submitted item, then radix sorts the keys.
+	 * Layout (most significant bit first):
+		* opaque:		[pass 2][transparent 1][shader 10][material 12][mesh 13][depth 26] - front to back
+		* transparent:	[pass 2][transparent 1][inverted depth 26][shader 10][material 12][mesh 13] - back to front
+	 * The item storage is reused between frames, so nothing is reallocated once the queue has grown to fit the scene.
+	*/
+	class RenderQueue
+	{
+	public:
+		// the pass for meshes that get post processed.
+		static const uint32_t PASS_SCENE = 0;
+
+		// the pass for meshes that are drawn after post processing.
+		static const uint32_t PASS_POST = 1;
+
+		// constructor
+		RenderQueue() = default;
+
+		// clears the queue. The memory is kept so that it can be reused next frame.
+		void Clear();
+
+		// submits an item to the queue.
+		// depth: the squared distance from the camera to the item.
+		void Submit(Material* material, Mesh* mesh, const glm::mat4& transform, float depth, uint32_t pass);
+
+		// sorts the submitted items by their keys.
+		void Sort();
+
+		// gets the amount of items in the queue.
+		size_t GetSize() const;
+
+		// gets an item in sorted order. Sort() must be called first.
+		const RenderItem& GetSorted(size_t index) const;
+
+		// gets the range of sorted indexes [start, end) that belong to the provided pass.
+		void GetPassRange(uint32_t pass, size_t& start, size_t& end) const;
+
+		// builds the key for an item.
+		static uint64_t MakeKey(uint32_t pass, bool transparent, uint32_t shaderId, uint32_t materialId, uint32_t meshId, float depth);
+
+	private:
+		// a key and the index of the item it belongs to.
+		struct SortEntry
+		{
+			uint64_t key;
+			uint32_t index;
+		};
+
+		// radix sorts the entries using 8-bit digits, starting with the least significant digit.
+		void RadixSort();
+
+		std::vector<RenderItem> items; // the submitted items
+		std::vector<SortEntry> entries; // the keys, which are sorted
+		std::vector<SortEntry> scratch; // the buffer used for sorting
+	};
+}
@@ -1,7 +1,16 @@
 // Shader (Source) - renders meshes to the screen
 #include "Shader.h"
+#include "GLState.h"
+#include "HotReload.h"
 #include <toolkit/Logging.h>
 #include <fstream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+
+std::unordered_set<cherry::Shader*> cherry::Shader::allShaders;
+uint32_t cherry::Shader::variantCount = 0;
+float cherry::Shader::compileTime = 0.0F;
 
 // Reads the entire contents of a file
 char* readFile(const char* filename) {
@@ -41,28 +50,126 @@ char* readFile(const char* filename) {
 }
 
 // constructor
-cherry::Shader::Shader() { myShaderHandle = glCreateProgram(); }
+cherry::Shader::Shader()
+{
+	myShaderHandle = glCreateProgram();
+	allShaders.insert(this);
+}
 
 // destructor
-cherry::Shader::~Shader()  { glDeleteProgram(myShaderHandle); }
+cherry::Shader::~Shader()
+{
+	allShaders.erase(this);
+	__DeleteVariants();
+	GLState::ForgetProgram(myShaderHandle);
+	glDeleteProgram(myShaderHandle);
+}
 
 // loads the shaders
-void cherry::Shader::Load(const char* vsFile, const char* fsFile)
+void cherry::Shader::Load(const char* vsFile, const char* fsFile) { Load(vsFile, fsFile, std::vector<std::string>()); }
+
+// loads the shaders with keywords
+void cherry::Shader::Load(const char* vsFile, const char* fsFile, const std::vector<std::string>& keywords)
 {
-	// Load in our shaders (read the source)
-	char* vs_source = readFile(vsFile);
-	char* fs_source = readFile(fsFile);
+	// copied, since the file names could be from this shader's own strings.
+	const std::string vs = vsFile;
+	const std::string fs = fsFile;
+	const std::vector<std::string> sorted = SortKeywords(keywords);
 
-	// Compile our program
-	Compile(vs_source, fs_source);
+	__LoadFiles(vs, fs, sorted);
 
 	// saving the shader file paths
-	vertexShader = std::string(vsFile);
-	fragmentShader = std::string(fsFile);
+	vertexShader = vs;
+	fragmentShader = fs;
+
+	// the other variants were made from the old files.
+	__DeleteVariants();
+	this->keywords = sorted;
+	variants[MakeVariantKey(sorted)] = myShaderHandle;
+
+	// the files are checked for changes so that the shader can be reloaded.
+	HotReload::Watch(vertexShader);
+	HotReload::Watch(fragmentShader);
+}
+
+// reads, defines, and compiles the files
+void cherry::Shader::__LoadFiles(const std::string& vsFile, const std::string& fsFile, const std::vector<std::string>& keywords)
+{
+	// Load in our shaders (read the source)
+	char* vs_source = readFile(vsFile.c_str());
+	char* fs_source = readFile(fsFile.c_str());
+
+	// the keywords are added to both parts.
+	const std::string vs = __AddKeywords(vs_source, keywords);
+	const std::string fs = __AddKeywords(fs_source, keywords);
 
 	// Clean up our memory
 	delete[] fs_source;
 	delete[] vs_source;
+
+	// Compile our program
+	auto start = std::chrono::high_resolution_clock::now();
+	Compile(vs.c_str(), fs.c_str());
+	float time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	variantCount++;
+	compileTime += time;
+
+	LOG_TRACE("Compiled shader ({}, {}) [{}] in {:.2f} ms.", vsFile, fsFile, MakeVariantKey(keywords), time);
+}
+
+// adds the keywords to the source
+std::string cherry::Shader::__AddKeywords(const char* source, const std::vector<std::string>& keywords)
+{
+	std::string result = source;
+
+	if (keywords.empty())
+		return result;
+
+	std::string defines = "";
+
+	for (const std::string& keyword : keywords)
+		defines += "#define " + keyword + "\n";
+
+	// the #version must be the first line, so the defines go after it.
+	size_t index = result.find("#version");
+
+	if (index == std::string::npos)
+	{
+		index = 0;
+	}
+	else
+	{
+		index = result.find('\n', index);
+
+		if (index == std::string::npos)
+		{
+			result += "\n";
+			index = result.length();
+		}
+		else
+		{
+			index++;
+		}
+	}
+
+	result.insert(index, defines);
+	return result;
+}
+
+// deletes the other variants
+void cherry::Shader::__DeleteVariants()
+{
+	for (auto& kvp : variants)
+	{
+		if (kvp.second != myShaderHandle)
+		{
+			GLState::ForgetProgram(kvp.second);
+			glDeleteProgram(kvp.second);
+		}
+	}
+
+	variants.clear();
 }
 
 // mat3 ver.
@@ -127,7 +234,7 @@ void cherry::Shader::SetUniform(const char* name, const int& value) {
 // uses glUseProgram to use the shader for drawing.
 void cherry::Shader::Bind()
 {
-	glUseProgram(myShaderHandle);
+	GLState::UseProgram(myShaderHandle); // skipped if the program is already bound.
 }
 
 // gets the vertex shader.
@@ -136,6 +243,235 @@ const char* cherry::Shader::GetVertexShader() const { return vertexShader.c_str(
 // returns the file name for the fragment shader
 const char* cherry::Shader::GetFragmentShader() const { return fragmentShader.c_str(); }
 
+// gets the program handle
+GLuint cherry::Shader::GetHandle() const { return myShaderHandle; }
+
+// reloads the shader
+bool cherry::Shader::Reload()
+{
+	// the shader wasn't loaded from files.
+	if (vertexShader == "" || fragmentShader == "")
+		return false;
+
+	GLuint oldHandle = myShaderHandle;
+	myShaderHandle = glCreateProgram();
+
+	try
+	{
+		__LoadFiles(vertexShader, fragmentShader, keywords);
+	}
+	catch (const std::exception& e)
+	{
+		// the new program is deleted if linking didn't already delete it.
+		if (glIsProgram(myShaderHandle))
+			glDeleteProgram(myShaderHandle);
+
+		myShaderHandle = oldHandle;
+
+		LOG_WARN("Reloading shader ({}, {}) failed, so the old version is being kept: {}", vertexShader, fragmentShader, e.what());
+		return false;
+	}
+
+	__CopyUniforms(oldHandle, myShaderHandle);
+
+	// the other variants are compiled again when they're next used. The old program is deleted below.
+	variants.erase(GetVariantKey());
+	__DeleteVariants();
+	variants[GetVariantKey()] = myShaderHandle;
+
+	GLState::ForgetProgram(oldHandle);
+	glDeleteProgram(oldHandle);
+
+	return true;
+}
+
+// gets the keywords
+const std::vector<std::string>& cherry::Shader::GetKeywords() const { return keywords; }
+
+// checks for a keyword
+bool cherry::Shader::HasKeyword(const std::string& keyword) const
+{
+	return std::find(keywords.begin(), keywords.end(), keyword) != keywords.end();
+}
+
+// sets a keyword
+bool cherry::Shader::SetKeyword(const std::string& keyword, bool enable)
+{
+	std::vector<std::string> next = keywords;
+
+	if (enable)
+		next.push_back(keyword);
+	else
+		next.erase(std::remove(next.begin(), next.end(), keyword), next.end());
+
+	return SetKeywords(next);
+}
+
+// sets the keywords
+bool cherry::Shader::SetKeywords(const std::vector<std::string>& keywords)
+{
+	const std::vector<std::string> sorted = SortKeywords(keywords);
+
+	// already using this variant.
+	if (sorted == this->keywords)
+		return true;
+
+	// the shader wasn't loaded from files.
+	if (vertexShader == "" || fragmentShader == "")
+	{
+		LOG_WARN("The keywords of a shader can only be changed if it was loaded from files.");
+		return false;
+	}
+
+	const std::string key = MakeVariantKey(sorted);
+	GLuint oldHandle = myShaderHandle;
+
+	auto it = variants.find(key);
+
+	if (it != variants.end()) // the variant has been compiled before.
+	{
+		myShaderHandle = it->second;
+	}
+	else // the variant is compiled for the first time.
+	{
+		myShaderHandle = glCreateProgram();
+
+		try
+		{
+			__LoadFiles(vertexShader, fragmentShader, sorted);
+		}
+		catch (const std::exception& e)
+		{
+			if (glIsProgram(myShaderHandle))
+				glDeleteProgram(myShaderHandle);
+
+			myShaderHandle = oldHandle;
+
+			LOG_WARN("Compiling shader ({}, {}) with [{}] failed: {}", vertexShader, fragmentShader, key, e.what());
+			return false;
+		}
+
+		variants[key] = myShaderHandle;
+	}
+
+	// the values that were set on the old variant are kept.
+	__CopyUniforms(oldHandle, myShaderHandle);
+	this->keywords = sorted;
+
+	return true;
+}
+
+// gets the variant key
+std::string cherry::Shader::GetVariantKey() const { return MakeVariantKey(keywords); }
+
+// sorts the keywords
+std::vector<std::string> cherry::Shader::SortKeywords(const std::vector<std::string>& keywords)
+{
+	std::vector<std::string> sorted;
+
+	for (const std::string& keyword : keywords)
+	{
+		if (keyword != "")
+			sorted.push_back(keyword);
+	}
+
+	std::sort(sorted.begin(), sorted.end());
+	sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+	return sorted;
+}
+
+// makes a variant key
+std::string cherry::Shader::MakeVariantKey(const std::vector<std::string>& keywords)
+{
+	std::string key = "";
+
+	for (const std::string& keyword : SortKeywords(keywords))
+		key += (key == "") ? keyword : " " + keyword;
+
+	return key;
+}
+
+// gets the amount of compiled variants
+uint32_t cherry::Shader::GetCompiledVariantCount() { return variantCount; }
+
+// gets the compile time
+float cherry::Shader::GetCompileTime() { return compileTime; }
+
+// reloads the shaders using a file
+int cherry::Shader::ReloadFile(const std::string& filePath)
+{
+	const std::string path = HotReload::NormalizePath(filePath);
+	int count = 0;
+
+	for (Shader* shader : allShaders)
+	{
+		if (HotReload::NormalizePath(shader->vertexShader) == path || HotReload::NormalizePath(shader->fragmentShader) == path)
+		{
+			if (shader->Reload())
+				count++;
+		}
+	}
+
+	return count;
+}
+
+// copies the uniforms between programs
+void cherry::Shader::__CopyUniforms(GLuint source, GLuint dest)
+{
+	GLint uniformCount = 0;
+	GLint nameLength = 0;
+
+	glGetProgramiv(source, GL_ACTIVE_UNIFORMS, &uniformCount);
+	glGetProgramiv(source, GL_ACTIVE_UNIFORM_MAX_LENGTH, &nameLength);
+
+	std::vector<char> nameBuffer(nameLength + 1);
+
+	for (GLint i = 0; i < uniformCount; i++)
+	{
+		GLint size = 0;
+		GLenum type = 0;
+		glGetActiveUniform(source, i, (GLsizei)nameBuffer.size(), nullptr, &size, &type, nameBuffer.data());
+
+		// arrays are reported as "name[0]", so the elements are copied one at a time.
+		std::string name(nameBuffer.data());
+
+		if (name.length() > 3 && name.compare(name.length() - 3, 3, "[0]") == 0)
+			name = name.substr(0, name.length() - 3);
+
+		for (GLint j = 0; j < size; j++)
+		{
+			const std::string element = (size > 1) ? name + "[" + std::to_string(j) + "]" : name;
+
+			GLint from = glGetUniformLocation(source, element.c_str());
+			GLint to = glGetUniformLocation(dest, element.c_str());
+
+			// uniforms in blocks, and uniforms that were removed from the new shader, are skipped.
+			if (from == -1 || to == -1)
+				continue;
+
+			GLfloat f[16];
+			GLint n[4];
+
+			switch (type)
+			{
+			case GL_FLOAT: glGetUniformfv(source, from, f); glProgramUniform1fv(dest, to, 1, f); break;
+			case GL_FLOAT_VEC2: glGetUniformfv(source, from, f); glProgramUniform2fv(dest, to, 1, f); break;
+			case GL_FLOAT_VEC3: glGetUniformfv(source, from, f); glProgramUniform3fv(dest, to, 1, f); break;
+			case GL_FLOAT_VEC4: glGetUniformfv(source, from, f); glProgramUniform4fv(dest, to, 1, f); break;
+			case GL_FLOAT_MAT3: glGetUniformfv(source, from, f); glProgramUniformMatrix3fv(dest, to, 1, false, f); break;
+			case GL_FLOAT_MAT4: glGetUniformfv(source, from, f); glProgramUniformMatrix4fv(dest, to, 1, false, f); break;
+			case GL_INT_VEC2: glGetUniformiv(source, from, n); glProgramUniform2iv(dest, to, 1, n); break;
+			case GL_INT_VEC3: glGetUniformiv(source, from, n); glProgramUniform3iv(dest, to, 1, n); break;
+			case GL_INT_VEC4: glGetUniformiv(source, from, n); glProgramUniform4iv(dest, to, 1, n); break;
+
+			// ints, bools, and samplers are all set as a single int.
+			default: glGetUniformiv(source, from, n); glProgramUniform1iv(dest, to, 1, n); break;
+			}
+		}
+	}
+}
+
 // compiling the bits of our shader and checking for errors.
 GLuint cherry::Shader::__CompileShaderPart(const char* source, GLenum type) {
 	GLuint result = glCreateShader(type);
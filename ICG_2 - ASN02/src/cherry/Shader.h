@@ -3,11 +3,20 @@
 #include <glad/glad.h>
 #include <GLM/glm.hpp>
 #include <memory>
+#include <unordered_set>
+#include <unordered_map>
+#include <vector>
 
 #include "UtilsCRY.h"
 
 namespace cherry
 {
+	/*
+	 * Shaders can be loaded with keywords, which are added to both files as #defines after the #version line.
+	 * Each set of keywords is a variant of the shader. This lets features be turned on and off with #ifdefs, instead of branching on uniforms.
+	 * The keywords of a loaded shader can be changed with SetKeyword(), which switches to the variant's program (compiling it the first time).
+	 * For materials that need a different variant from other materials, use Material::SetKeyword(), which gets a separate shader from the ShaderCache.
+	*/
 	class Shader {
 	public:
 		GraphicsClass(Shader);
@@ -20,6 +29,9 @@ namespace cherry
 		// Loads a shader program from 2 files. vsFile is the path to the vertex shader, and fsFile is the path to the fragment shader
 		void Load(const char* vsFile, const char* fsFile);
 
+		// loads a shader program from 2 files, with the provided keywords defined in both files.
+		void Load(const char* vsFile, const char* fsFile, const std::vector<std::string>& keywords);
+
 		// mat3
 		void SetUniform(const char* name, const glm::mat3& value);
 		
@@ -51,13 +63,74 @@ namespace cherry
 
 		// returns the path and name of the fragment shader file being used.
 		const char* GetFragmentShader() const;
+
+		// returns the handle of the shader program. This is also used to sort draw calls by shader.
+		GLuint GetHandle() const;
+
+		// gets the keywords of the current variant (sorted).
+		const std::vector<std::string>& GetKeywords() const;
+
+		// returns 'true' if the keyword is defined in the current variant.
+		bool HasKeyword(const std::string& keyword) const;
+
+		// enables or disables a keyword, which switches to that variant of the shader. The variant is compiled the first time it's used.
+		// the uniform values from the previous variant are copied over. Returns 'false' if the variant couldn't be compiled.
+		// this only works for shaders that were loaded from files.
+		bool SetKeyword(const std::string& keyword, bool enable);
+
+		// switches to the variant with the provided keywords.
+		bool SetKeywords(const std::vector<std::string>& keywords);
+
+		// gets the key for the current variant, which is the keywords separated by spaces.
+		std::string GetVariantKey() const;
+
+		// sorts the keywords and removes duplicates and empty keywords, so that variants with the same keywords get the same key.
+		static std::vector<std::string> SortKeywords(const std::vector<std::string>& keywords);
+
+		// gets the variant key for a list of keywords.
+		static std::string MakeVariantKey(const std::vector<std::string>& keywords);
+
+		// gets the amount of programs (variants) that have been compiled.
+		static uint32_t GetCompiledVariantCount();
+
+		// gets the total time spent compiling and linking programs (in milliseconds).
+		static float GetCompileTime();
+
+		// reloads the shader from its files into a new program. The uniform values from the old program are copied over.
+		// if the new program fails to compile or link, the old program is kept and 'false' is returned.
+		bool Reload();
+
+		// reloads every shader that uses the provided file. Returns the amount of shaders reloaded.
+		static int ReloadFile(const std::string& filePath);
+
 	private:
 		GLuint __CompileShaderPart(const char* source, GLenum type);
 
+		// reads the files, adds the keywords, and compiles them into the current program.
+		void __LoadFiles(const std::string& vsFile, const std::string& fsFile, const std::vector<std::string>& keywords);
+
+		// adds the keywords to the source as #defines after the #version line.
+		static std::string __AddKeywords(const char* source, const std::vector<std::string>& keywords);
+
+		// deletes the programs of the variants that aren't being used.
+		void __DeleteVariants();
+
+		// copies the values of the active uniforms in one program to the uniforms with the same names in another program.
+		static void __CopyUniforms(GLuint source, GLuint dest);
+
+		// all of the shaders that currently exist, which is used for reloading.
+		static std::unordered_set<Shader*> allShaders;
+
 		GLuint myShaderHandle;
 
 		std::string vertexShader; // vertex shader file
 
 		std::string fragmentShader; // fragment shader file
+
+		std::vector<std::string> keywords; // the keywords of the current variant.
+		std::unordered_map<std::string, GLuint> variants; // the programs for each variant that's been used, by variant key.
+
+		static uint32_t variantCount; // the amount of programs compiled.
+		static float compileTime; // the time spent compiling programs (in milliseconds).
 	};
 }
\ No newline at end of file
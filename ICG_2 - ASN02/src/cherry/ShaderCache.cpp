@@ -0,0 +1,40 @@
+// ShaderCache (Source) - shares shaders between materials that use the same files and keywords.
+#include "ShaderCache.h"
+#include "HotReload.h"
+
+std::unordered_map<std::string, cherry::Shader::Sptr> cherry::ShaderCache::shaders;
+
+// gets a shader
+cherry::Shader::Sptr cherry::ShaderCache::Get(const std::string& vsFile, const std::string& fsFile, const std::vector<std::string>& keywords)
+{
+	const std::string key = MakeKey(vsFile, fsFile, keywords);
+	auto it = shaders.find(key);
+
+	if (it != shaders.end())
+		return it->second;
+
+	// the shader is only added once it's been compiled, so a failed compile is tried again next time.
+	Shader::Sptr shader = std::make_shared<Shader>();
+	shader->Load(vsFile.c_str(), fsFile.c_str(), keywords);
+
+	shaders[key] = shader;
+	return shader;
+}
+
+// checks if the variant is in the cache
+bool cherry::ShaderCache::Contains(const std::string& vsFile, const std::string& fsFile, const std::vector<std::string>& keywords)
+{
+	return shaders.find(MakeKey(vsFile, fsFile, keywords)) != shaders.end();
+}
+
+// gets the amount of shaders
+size_t cherry::ShaderCache::GetCount() { return shaders.size(); }
+
+// clears the cache
+void cherry::ShaderCache::Clear() { shaders.clear(); }
+
+// makes the key
+std::string cherry::ShaderCache::MakeKey(const std::string& vsFile, const std::string& fsFile, const std::vector<std::string>& keywords)
+{
+	return HotReload::NormalizePath(vsFile) + "|" + HotReload::NormalizePath(fsFile) + "|" + Shader::MakeVariantKey(keywords);
+}
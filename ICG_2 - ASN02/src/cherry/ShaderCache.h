@@ -0,0 +1,38 @@
+// ShaderCache (Header) - shares shaders between materials that use the same files and keywords.
+#pragma once
+#include "Shader.h"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace cherry
+{
+	/*
+	 * The cache keeps one shader for each set of files and keywords (variant), which is compiled the first time it's asked for.
+	 * Materials with the same variant share the shader, so they're drawn without switching programs.
+	 * Shaders from the cache are shared, so their keywords shouldn't be changed with Shader::SetKeyword(). Use Material::SetKeyword() instead.
+	*/
+	class ShaderCache
+	{
+	public:
+		// gets the shader for the provided files and keywords. If it hasn't been made yet, it's loaded and compiled.
+		static Shader::Sptr Get(const std::string& vsFile, const std::string& fsFile, const std::vector<std::string>& keywords = std::vector<std::string>());
+
+		// returns 'true' if the variant is in the cache.
+		static bool Contains(const std::string& vsFile, const std::string& fsFile, const std::vector<std::string>& keywords = std::vector<std::string>());
+
+		// gets the amount of shaders in the cache.
+		static size_t GetCount();
+
+		// removes all of the shaders from the cache. Shaders that are still being used by materials aren't deleted until they're no longer used.
+		static void Clear();
+
+	private:
+		// makes the key for a variant.
+		static std::string MakeKey(const std::string& vsFile, const std::string& fsFile, const std::vector<std::string>& keywords);
+
+		// the shaders, by their key.
+		static std::unordered_map<std::string, Shader::Sptr> shaders;
+	};
+}
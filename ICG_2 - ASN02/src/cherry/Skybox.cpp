@@ -1,7 +1,11 @@
 #include "Skybox.h"
 #include "scenes/Scene.h"
+#include "ShaderCache.h"
 #include <fstream>
 
+// the cube shared by the skybox meshes
+cherry::Mesh::Sptr cherry::Skybox::sharedMesh = nullptr;
+
 // default constructor
 cherry::Skybox::Skybox()
 {
@@ -25,6 +29,12 @@ cherry::Skybox::Skybox(std::string left, std::string right, std::string down, st
 	SetBack(back);
 }
 
+// uses a cube map file for the skybox.
+cherry::Skybox::Skybox(std::string cubeMapFile) : Skybox()
+{
+	SetCubeMapFile(cubeMapFile);
+}
+
 // gets the image for the left of the skybox.
 std::string cherry::Skybox::GetLeft() const { return files[0]; }
 
@@ -81,18 +91,64 @@ bool cherry::Skybox::SetFile(unsigned int index, std::string filePath)
 	return true;
 }
 
+// gets the cube map file.
+std::string cherry::Skybox::GetCubeMapFile() const { return cubeMapFile; }
+
+// sets the cube map file.
+bool cherry::Skybox::SetCubeMapFile(std::string filePath)
+{
+	std::ifstream file(filePath, std::ios::in | std::ios::binary); // opening for file checking
+
+	if (!file) // file not found
+	{
+		throw std::runtime_error("Cube map file not found.");
+		return false;
+	}
+
+	file.close();
+	cubeMapFile = filePath;
+
+	return true;
+}
+
+// bakes the images into a cube map file.
+bool cherry::Skybox::Bake(std::string filePath, InternalFormat format)
+{
+	if (!TextureCube::Bake(files, filePath, format))
+		return false;
+
+	cubeMapFile = filePath;
+	return true;
+}
+
 // generates the texture cube and returns it
-cherry::TextureCube::Sptr cherry::Skybox::GenerateTextureCube() const { return TextureCube::LoadFromFiles(files); }
+cherry::TextureCube::Sptr cherry::Skybox::GenerateTextureCube() const
+{
+	// if the file couldn't be loaded, the images are used instead.
+	if (cubeMapFile != "")
+	{
+		TextureCube::Sptr cube = TextureCube::LoadFromFile(cubeMapFile);
+
+		if (cube != nullptr)
+			return cube;
+	}
+
+	return TextureCube::LoadFromFiles(files);
+}
 
 cherry::Shader::Sptr cherry::Skybox::GenerateShader() const
 {
-	Shader::Sptr shader = std::make_shared<Shader>();
-	shader->Load("res/shaders/cubemap.vs.glsl", "res/shaders/cubemap.fs.glsl");
-	return shader;
+	return ShaderCache::Get("res/shaders/cubemap.vs.glsl", "res/shaders/cubemap.fs.glsl");
 }
 
 // generates and returns the skybox's mesh
-cherry::Mesh::Sptr cherry::Skybox::GenerateMesh() const { return Mesh::MakeInvertedCube(); }
+cherry::Mesh::Sptr cherry::Skybox::GenerateMesh() const
+{
+	if (sharedMesh == nullptr)
+		sharedMesh = Mesh::MakeInvertedCube();
+
+	return std::make_shared<Mesh>(sharedMesh);
+}
 
 // adds a skybox to a scene
 void cherry::Skybox::AddSkyboxToScene(cherry::Scene * scene) const
@@ -103,4 +159,7 @@ void cherry::Skybox::AddSkyboxToScene(cherry::Scene * scene) const
 	scene->Skybox = GenerateTextureCube();
 }
 
+// deletes the shared cube.
+void cherry::Skybox::ClearSharedMesh() { sharedMesh = nullptr; }
+
 
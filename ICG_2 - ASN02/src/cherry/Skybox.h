@@ -16,6 +16,9 @@ namespace cherry
 		// sets the images for the skybox.
 		Skybox(std::string left, std::string right, std::string down, std::string up, std::string front, std::string back);
 
+		// uses a cube map file for the skybox (see TextureCube::Bake()).
+		Skybox(std::string cubeMapFile);
+
 		// gets the image for the left of the skybox.
 		std::string GetLeft() const;
 
@@ -52,17 +55,32 @@ namespace cherry
 		// sets the image for the back side of the skybox. A 'true' is returned if the file was successfully found.
 		bool SetBack(std::string filePath);
 
+		// gets the cube map file for the skybox. If there isn't one, this is an empty string.
+		std::string GetCubeMapFile() const;
+
+		// sets the cube map file for the skybox, which is used instead of the six images. A 'true' is returned if the file was successfully found.
+		bool SetCubeMapFile(std::string filePath);
+
+		// bakes the six images into a cube map file, and then uses that file for the skybox (see TextureCube::Bake()).
+		// this is meant to be done ahead of time. A 'true' is returned if the file was written.
+		bool Bake(std::string filePath, InternalFormat format = InternalFormat::BC1);
+
 		// generates the texture cube and returns it
+		// if there's a cube map file, it's loaded instead of the images. Either way, skyboxes with the same files share a texture.
 		TextureCube::Sptr GenerateTextureCube() const;
 
-		// generates and returns the shader for the skybox.
+		// generates and returns the shader for the skybox. Every skybox shares the same shader (see ShaderCache).
 		Shader::Sptr GenerateShader() const;
 
 		// generates the mesh
+		// every skybox draws the same cube, but each one gets its own mesh so it can be hidden separately (see Mesh::Mesh(const Sptr&)).
 		Mesh::Sptr GenerateMesh() const;
 
 		// adds the skybox to the scene provided.
 		void AddSkyboxToScene(cherry::Scene * scene) const;
+
+		// deletes the cube that's shared by the skybox meshes. The meshes that are still being used keep it until they're deleted.
+		static void ClearSharedMesh();
 		
 
 	private:
@@ -81,6 +99,12 @@ namespace cherry
 		*/
 		std::string files[6];
 
+		// the cube map file, which is used instead of the files if it's set.
+		std::string cubeMapFile = "";
+
+		// the cube that's shared by the skybox meshes.
+		static Mesh::Sptr sharedMesh;
+
 	protected:
 	};
 }
\ No newline at end of file
@@ -0,0 +1,171 @@
+// SpriteBatch (Source) - streams the sprites that share a material into one buffer, so that they're drawn with a single call.
+#include "SpriteBatch.h"
+#include "GLState.h"
+
+#include <cstddef> // offsetof
+#include <string.h>
+
+// destructor
+cherry::SpriteBatch::~SpriteBatch()
+{
+	Release();
+}
+
+// adds a sprite
+void cherry::SpriteBatch::Add(const Mesh* mesh, const glm::mat4& transform)
+{
+	const std::vector<Vertex>& verts = mesh->GetSpriteVertices();
+	const std::vector<uint32_t>& inds = mesh->GetSpriteIndices();
+
+	// the normals are moved by the inverse-transpose, the same as the normal matrix.
+	glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(transform)));
+	uint32_t start = (uint32_t)vertices.size();
+
+	for (const Vertex& v : verts)
+	{
+		Vertex world = v;
+		world.Position = glm::vec3(transform * glm::vec4(v.Position, 1.0F));
+		world.Normal = normalMatrix * v.Normal;
+
+		vertices.push_back(world);
+	}
+
+	// every vertex of the sprite has the same frame.
+	frames.insert(frames.end(), verts.size(), mesh->GetSpriteFrame());
+
+	for (uint32_t i : inds)
+		indices.push_back(start + i);
+
+	sprites++;
+}
+
+// gets the amount of sprites
+size_t cherry::SpriteBatch::GetSpriteCount() const { return sprites; }
+
+// draws the batch
+void cherry::SpriteBatch::Draw()
+{
+	if (indices.empty())
+		return;
+
+	const size_t vertexSize = sizeof(Vertex) * vertices.size();
+	const size_t frameSize = sizeof(SpriteFrame) * frames.size();
+	const size_t indexSize = sizeof(uint32_t) * indices.size();
+
+	// the alignment can add up to one vertex (and one frame) worth of space between the vertices, the frames, and the indices.
+	const size_t totalSize = vertexSize + frameSize + indexSize + sizeof(Vertex) + sizeof(SpriteFrame);
+
+	// the buffer is made bigger if the batch doesn't fit in a region.
+	if (stream == nullptr || stream->GetRegionSize() < totalSize)
+	{
+		size_t regionSize = (stream == nullptr) ? SPRITE_BATCH_REGION_SIZE : stream->GetRegionSize();
+
+		while (regionSize < totalSize)
+			regionSize *= 2;
+
+		Release();
+		__Init(regionSize);
+	}
+
+	GLintptr vertexOffset = 0, frameOffset = 0, indexOffset = 0;
+	void* vertexData = stream->Allocate(vertexSize, vertexOffset, sizeof(Vertex));
+	void* frameData = (vertexData != nullptr) ? stream->Allocate(frameSize, frameOffset, sizeof(SpriteFrame)) : nullptr;
+	void* indexData = (frameData != nullptr) ? stream->Allocate(indexSize, indexOffset, sizeof(uint32_t)) : nullptr;
+
+	// the region is full, so the next one is used.
+	if (vertexData == nullptr || frameData == nullptr || indexData == nullptr)
+	{
+		stream->Advance();
+
+		vertexData = stream->Allocate(vertexSize, vertexOffset, sizeof(Vertex));
+		frameData = stream->Allocate(frameSize, frameOffset, sizeof(SpriteFrame));
+		indexData = stream->Allocate(indexSize, indexOffset, sizeof(uint32_t));
+	}
+
+	memcpy(vertexData, vertices.data(), vertexSize);
+	memcpy(frameData, frames.data(), frameSize);
+	memcpy(indexData, indices.data(), indexSize);
+
+	glVertexArrayVertexBuffer(vao, 0, stream->GetBuffer(), vertexOffset, sizeof(Vertex));
+	glVertexArrayVertexBuffer(vao, 1, stream->GetBuffer(), frameOffset, sizeof(SpriteFrame));
+
+	GLState::BindVertexArray(vao);
+	glDrawElements(GL_TRIANGLES, (GLsizei)indices.size(), GL_UNSIGNED_INT, (const void*)indexOffset);
+
+	used = true;
+	draws++;
+	drawnSprites += (uint32_t)sprites;
+
+	vertices.clear();
+	frames.clear();
+	indices.clear();
+	sprites = 0;
+}
+
+// ends the frame
+void cherry::SpriteBatch::EndFrame()
+{
+	// the next frame writes to a different region, so it doesn't have to wait for this frame's draws.
+	if (used)
+		stream->Advance();
+
+	used = false;
+
+	lastDraws = draws;
+	lastDrawnSprites = drawnSprites;
+	draws = 0;
+	drawnSprites = 0;
+}
+
+// gets the draw calls
+uint32_t cherry::SpriteBatch::GetDrawCount() const { return lastDraws; }
+
+// gets the sprites drawn
+uint32_t cherry::SpriteBatch::GetDrawnSpriteCount() const { return lastDrawnSprites; }
+
+// deletes the buffers
+void cherry::SpriteBatch::Release()
+{
+	if (vao != 0)
+	{
+		GLState::ForgetVertexArray(vao);
+		glDeleteVertexArrays(1, &vao);
+		vao = 0;
+	}
+
+	delete stream;
+	stream = nullptr;
+	used = false;
+}
+
+// makes the buffers
+void cherry::SpriteBatch::__Init(size_t regionSize)
+{
+	stream = new StreamBuffer(regionSize);
+
+	// the vertices and indices are in the same buffer. The vertex offset is changed for each draw.
+	glCreateVertexArrays(1, &vao);
+	glVertexArrayElementBuffer(vao, stream->GetBuffer());
+
+	// position (0), colour (1), normal (2), and uv (3); the same layout as Mesh.
+	const GLint sizes[] = { 3, 4, 3, 2 };
+	const GLuint offsets[] = { offsetof(Vertex, Position), offsetof(Vertex, Color), offsetof(Vertex, Normal), offsetof(Vertex, UV) };
+
+	for (GLuint i = 0; i < 4; i++)
+	{
+		glEnableVertexArrayAttrib(vao, i);
+		glVertexArrayAttribFormat(vao, i, sizes[i], GL_FLOAT, GL_FALSE, offsets[i]);
+		glVertexArrayAttribBinding(vao, i, 0);
+	}
+
+	// frame (4), next frame (5), and frame blend (6), which are read by the SPRITE_BATCH variant of the image shader.
+	const GLint frameSizes[] = { 4, 4, 1 };
+	const GLuint frameOffsets[] = { offsetof(SpriteFrame, Frame), offsetof(SpriteFrame, NextFrame), offsetof(SpriteFrame, Blend) };
+
+	for (GLuint i = 0; i < 3; i++)
+	{
+		glEnableVertexArrayAttrib(vao, 4 + i);
+		glVertexArrayAttribFormat(vao, 4 + i, frameSizes[i], GL_FLOAT, GL_FALSE, frameOffsets[i]);
+		glVertexArrayAttribBinding(vao, 4 + i, 1);
+	}
+}
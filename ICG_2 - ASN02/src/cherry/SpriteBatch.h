@@ -0,0 +1,69 @@
+// SpriteBatch (Header) - streams the sprites that share a material into one buffer, so that they're drawn with a single call.
+#pragma once
+#include <GLM/glm.hpp>
+#include <vector>
+
+#include "Mesh.h"
+#include "StreamBuffer.h"
+
+// the starting size (in bytes) of each region in the sprite batch's stream buffer. It grows if a batch doesn't fit.
+#define SPRITE_BATCH_REGION_SIZE (256 * 1024)
+
+namespace cherry
+{
+	/*
+	 * Sprites are meshes that keep a copy of their vertices on the CPU (see Mesh::SetSpriteData()).
+	 * When a sprite is added, its vertices are moved into world space, and added to the batch.
+	 * Each vertex also gets the sprite's frame (see Mesh::SetSpriteFrame()), which the shader moves the uvs into.
+	 * Drawing the batch writes all of the vertices and indices into a stream buffer, then draws them with one call.
+	 * The render queue sorts items by material, so the sprites on the same atlas page end up next to each other.
+	*/
+	class SpriteBatch
+	{
+	public:
+		// constructor
+		SpriteBatch() = default;
+
+		// deletes the buffers
+		~SpriteBatch();
+
+		// adds a sprite, using the transformation to move its vertices into world space.
+		void Add(const Mesh* mesh, const glm::mat4& transform);
+
+		// gets the amount of sprites that are waiting to be drawn.
+		size_t GetSpriteCount() const;
+
+		// draws the sprites that have been added, then empties the batch.
+		// the shader and material must already be bound, and the model matrix should be the identity, since the vertices are in world space.
+		void Draw();
+
+		// fences the part of the buffer that was used this frame. This should be called once everything has been drawn.
+		void EndFrame();
+
+		// gets the amount of draw calls made last frame.
+		uint32_t GetDrawCount() const;
+
+		// gets the amount of sprites drawn last frame.
+		uint32_t GetDrawnSpriteCount() const;
+
+		// deletes the buffers. They'll be made again the next time a batch is drawn.
+		void Release();
+
+	private:
+		// makes the stream buffer and vertex array, with the provided region size.
+		void __Init(size_t regionSize);
+
+		std::vector<Vertex> vertices; // the vertices in world space
+		std::vector<SpriteFrame> frames; // the frame of each vertex's sprite
+		std::vector<uint32_t> indices; // the indices, which are offset for each sprite
+		size_t sprites = 0; // the amount of sprites in the batch
+
+		StreamBuffer* stream = nullptr; // the buffer the vertices and indices are written to
+		GLuint vao = 0;
+		bool used = false; // 'true' if the buffer was written to this frame
+
+		// the draw calls and sprites for this frame, and the last frame.
+		uint32_t draws = 0, drawnSprites = 0;
+		uint32_t lastDraws = 0, lastDrawnSprites = 0;
+	};
+}
@@ -0,0 +1,120 @@
+// StreamBuffer (Source) - a persistently mapped buffer split into fenced regions for dynamic data
+#include "StreamBuffer.h"
+#include <toolkit/Logging.h>
+#include <stdexcept>
+
+// constructor
+cherry::StreamBuffer::StreamBuffer(size_t regionSize, uint32_t regionCount)
+	: regionSize(regionSize), regionCount(regionCount)
+{
+	// the flags for the storage and the mapping. The buffer is coherent, so writes don't need to be flushed.
+	const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	if (regionSize == 0 || regionCount == 0)
+		throw std::runtime_error("A stream buffer needs at least one region with a size greater than 0.");
+
+	glCreateBuffers(1, &buffer);
+	glNamedBufferStorage(buffer, regionSize * regionCount, nullptr, flags);
+
+	// the buffer stays mapped until it's deleted.
+	mapped = (uint8_t*)glMapNamedBufferRange(buffer, 0, regionSize * regionCount, flags);
+
+	if (mapped == nullptr)
+		LOG_ERROR("Failed to persistently map stream buffer {}.", buffer);
+
+	fences.resize(regionCount, nullptr);
+}
+
+// destructor
+cherry::StreamBuffer::~StreamBuffer()
+{
+	for (GLsync& fence : fences)
+	{
+		if (fence != nullptr)
+			glDeleteSync(fence);
+	}
+
+	glUnmapNamedBuffer(buffer);
+	glDeleteBuffers(1, &buffer);
+}
+
+// allocates from the current region
+void* cherry::StreamBuffer::Allocate(size_t size, GLintptr& offset, size_t alignment)
+{
+	// rounds the head up to the alignment.
+	size_t start = (alignment > 1) ? ((head + alignment - 1) / alignment) * alignment : head;
+
+	// not enough space
+	if (mapped == nullptr || start + size > regionSize)
+		return nullptr;
+
+	head = start + size;
+	offset = GetRegionOffset(region) + start;
+
+	return mapped + offset;
+}
+
+// moves onto the next region
+void cherry::StreamBuffer::Advance()
+{
+	// anything that reads from this region has already been submitted, so the fence covers it.
+	if (fences[region] != nullptr)
+		glDeleteSync(fences[region]);
+
+	fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+	region = (region + 1) % regionCount;
+	head = 0;
+
+	WaitForRegion(region);
+}
+
+// gets the buffer
+GLuint cherry::StreamBuffer::GetBuffer() const { return buffer; }
+
+// gets the region size
+size_t cherry::StreamBuffer::GetRegionSize() const { return regionSize; }
+
+// gets the region count
+uint32_t cherry::StreamBuffer::GetRegionCount() const { return regionCount; }
+
+// gets the current region
+uint32_t cherry::StreamBuffer::GetRegionIndex() const { return region; }
+
+// gets a region's offset
+GLintptr cherry::StreamBuffer::GetRegionOffset(uint32_t index) const { return (GLintptr)(regionSize * index); }
+
+// gets a region's memory
+void* cherry::StreamBuffer::GetRegionData(uint32_t index) const { return (mapped != nullptr) ? mapped + GetRegionOffset(index) : nullptr; }
+
+// gets the stall count
+uint32_t cherry::StreamBuffer::GetStallCount() const { return stalls; }
+
+// waits for a region
+void cherry::StreamBuffer::WaitForRegion(uint32_t index)
+{
+	GLsync& fence = fences[index];
+
+	if (fence == nullptr)
+		return;
+
+	// checks the fence without waiting first, so that stalls can be counted.
+	GLenum result = glClientWaitSync(fence, 0, 0);
+
+	if (result == GL_TIMEOUT_EXPIRED)
+	{
+		stalls++;
+
+		// the commands are flushed so that the fence is guaranteed to be signaled eventually.
+		do
+		{
+			result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 millisecond
+		} while (result == GL_TIMEOUT_EXPIRED);
+	}
+
+	if (result == GL_WAIT_FAILED)
+		LOG_ERROR("Waiting on a stream buffer fence failed.");
+
+	glDeleteSync(fence);
+	fence = nullptr;
+}
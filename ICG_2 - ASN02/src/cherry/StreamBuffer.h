@@ -0,0 +1,72 @@
+// StreamBuffer (Header) - a persistently mapped buffer split into fenced regions for dynamic data
+#pragma once
+#include <glad/glad.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+// the amount of regions used by default (triple buffering).
+#define STREAM_BUFFER_REGIONS 3
+
+namespace cherry
+{
+	/*
+	 * A buffer made with glBufferStorage that stays mapped for its whole life.
+	 * The buffer is split into regions. Data is written into the current region while the GPU reads from the others.
+	 * Advance() puts a fence on the current region and moves to the next one, waiting for its fence if the GPU is still using it.
+	 * Data can be sub-allocated from the current region with Allocate(), which is reset every time the buffer advances.
+	*/
+	class StreamBuffer
+	{
+	public:
+		// creates the buffer with the provided region size (in bytes) and amount of regions.
+		StreamBuffer(size_t regionSize, uint32_t regionCount = STREAM_BUFFER_REGIONS);
+
+		// unmaps and deletes the buffer.
+		~StreamBuffer();
+
+		// sub-allocates space from the current region. The offset is from the start of the buffer, not the region.
+		// returns nullptr if there isn't enough space left in the region.
+		void* Allocate(size_t size, GLintptr& offset, size_t alignment = 16);
+
+		// fences the current region and moves onto the next one. This stalls if the GPU is still reading from the next region.
+		void Advance();
+
+		// gets the OpenGL buffer handle.
+		GLuint GetBuffer() const;
+
+		// gets the size of a region in bytes.
+		size_t GetRegionSize() const;
+
+		// gets the amount of regions.
+		uint32_t GetRegionCount() const;
+
+		// gets the index of the region currently being written to.
+		uint32_t GetRegionIndex() const;
+
+		// gets the offset of a region from the start of the buffer.
+		GLintptr GetRegionOffset(uint32_t index) const;
+
+		// gets the mapped memory of a region.
+		void* GetRegionData(uint32_t index) const;
+
+		// gets the amount of times the buffer had to wait for the GPU.
+		uint32_t GetStallCount() const;
+
+	private:
+		// waits for the fence on a region to be signaled, then deletes it.
+		void WaitForRegion(uint32_t index);
+
+		GLuint buffer = 0; // the buffer
+		uint8_t* mapped = nullptr; // the mapped memory for the whole buffer
+
+		size_t regionSize = 0; // the size of each region
+		uint32_t regionCount = 0; // the amount of regions
+		uint32_t region = 0; // the current region
+		size_t head = 0; // the next free byte in the current region
+
+		std::vector<GLsync> fences; // the fence for each region (nullptr if the region is free)
+
+		uint32_t stalls = 0; // the amount of times the CPU waited on the GPU
+	};
+}
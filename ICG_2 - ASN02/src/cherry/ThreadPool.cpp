@@ -0,0 +1,102 @@
+// ThreadPool (Source) - a group of worker threads that split a job into tasks, and run them alongside the calling thread.
+#include "ThreadPool.h"
+
+// constructor
+cherry::ThreadPool::ThreadPool(uint32_t threadCount)
+{
+	if (threadCount == 0)
+		threadCount = std::thread::hardware_concurrency();
+
+	// hardware_concurrency() can return 0 if it doesn't know.
+	if (threadCount == 0)
+		threadCount = 1;
+
+	// the calling thread is the first thread, so it isn't made.
+	for (uint32_t i = 1; i < threadCount; i++)
+		threads.push_back(std::thread(&ThreadPool::__Work, this, i));
+}
+
+// destructor
+cherry::ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+
+	jobReady.notify_all();
+
+	for (std::thread& thread : threads)
+		thread.join();
+}
+
+// gets the thread count
+uint32_t cherry::ThreadPool::GetThreadCount() const { return (uint32_t)threads.size() + 1; }
+
+// runs a job
+void cherry::ThreadPool::Run(uint32_t taskCount, const std::function<void(uint32_t, uint32_t)>& task)
+{
+	if (taskCount == 0)
+		return;
+
+	// a single task (or no workers) isn't worth waking the threads up for.
+	if (taskCount == 1 || threads.empty())
+	{
+		for (uint32_t i = 0; i < taskCount; i++)
+			task(i, 0);
+
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		job = &task;
+		this->taskCount = taskCount;
+		nextTask = 0;
+		workersBusy = (uint32_t)threads.size();
+		jobNumber++;
+	}
+
+	jobReady.notify_all();
+
+	// the calling thread helps out, then waits for the workers to finish their last tasks.
+	__RunTasks(0);
+
+	std::unique_lock<std::mutex> lock(mutex);
+	jobDone.wait(lock, [this]() { return workersBusy == 0; });
+	job = nullptr;
+}
+
+// runs tasks
+void cherry::ThreadPool::__RunTasks(uint32_t thread)
+{
+	for (uint32_t i = nextTask++; i < taskCount; i = nextTask++)
+		(*job)(i, thread);
+}
+
+// worker loop
+void cherry::ThreadPool::__Work(uint32_t thread)
+{
+	uint64_t lastJob = 0;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			jobReady.wait(lock, [this, lastJob]() { return stopping || jobNumber != lastJob; });
+
+			if (stopping)
+				return;
+
+			lastJob = jobNumber;
+		}
+
+		__RunTasks(thread);
+
+		std::lock_guard<std::mutex> lock(mutex);
+		workersBusy--;
+
+		if (workersBusy == 0)
+			jobDone.notify_one();
+	}
+}
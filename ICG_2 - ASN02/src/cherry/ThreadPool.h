@@ -0,0 +1,59 @@
+// ThreadPool (Header) - a group of worker threads that split a job into tasks, and run them alongside the calling thread.
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <vector>
+#include <stdint.h>
+
+namespace cherry
+{
+	/*
+	 * The threads are made once, and wait for jobs between uses, so they can be used every frame.
+	 * A job is split into tasks that the threads take in order until there are none left. The calling thread takes tasks too.
+	 * Run() doesn't return until every task is done. Which thread runs which task changes between jobs.
+	 * Only one job can be run at a time.
+	*/
+	class ThreadPool
+	{
+	public:
+		// the amount of threads, including the calling thread. If this is 0, one is used for each core.
+		ThreadPool(uint32_t threadCount = 0);
+
+		// stops the threads.
+		~ThreadPool();
+
+		// the threads can't be copied.
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// gets the amount of threads, including the calling thread.
+		uint32_t GetThreadCount() const;
+
+		// runs the job, calling task(taskIndex, thread) for each task. The calling thread is thread 0.
+		void Run(uint32_t taskCount, const std::function<void(uint32_t, uint32_t)>& task);
+
+	private:
+		// takes tasks until there are none left.
+		void __RunTasks(uint32_t thread);
+
+		// the loop each worker thread runs.
+		void __Work(uint32_t thread);
+
+		std::vector<std::thread> threads;
+
+		std::mutex mutex;
+		std::condition_variable jobReady; // signalled when there's a new job (or when stopping).
+		std::condition_variable jobDone; // signalled when the last worker finishes.
+
+		const std::function<void(uint32_t, uint32_t)>* job = nullptr;
+		uint32_t taskCount = 0;
+		std::atomic<uint32_t> nextTask{ 0 };
+
+		uint64_t jobNumber = 0; // goes up for each job, so the workers know when there's a new one.
+		uint32_t workersBusy = 0; // the workers still working on the current job.
+		bool stopping = false;
+	};
+}
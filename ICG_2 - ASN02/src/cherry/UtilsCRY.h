@@ -30,8 +30,8 @@
 #define STATIC_VS ("res/shaders/lighting.vs.glsl")
 #define STATIC_FS ("res/shaders/blinn-phong.fs.glsl")
 
-#define DYNAMIC_VS ("res/shaders/lighting-morph.vs.glsl")
-#define DYNAMIC_FS ("res/shaders/blinn-phong-morph.fs.glsl")
+// the keyword for the variant of the static shaders that uses morph targets.
+#define MORPH_KEYWORD ("MORPH")
 
 // POST
 #define POST_VS ("res/shaders/post/post.vs.glsl")
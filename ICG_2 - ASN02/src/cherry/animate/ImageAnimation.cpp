@@ -4,92 +4,216 @@
 #include "..\objects\Image.h"
 
 #include <fstream>
+#include <toolkit/Logging.h>
+
+std::vector<std::string> cherry::ImageAnimationFrame::files;
+std::unordered_map<std::string, uint32_t> cherry::ImageAnimationFrame::fileIndexes;
 
 // TEXTURE ANIMATION
 cherry::ImageAnimation::ImageAnimation() : Animation(3) { }
 
+// destructor
+cherry::ImageAnimation::~ImageAnimation()
+{
+	// the material shouldn't bind the buffer once it's deleted.
+	if (frameMaterial != nullptr && frameMaterial->GetUniformBuffer(IMAGE_ANIMATION_FRAME_BINDING) == frameBuffer)
+		frameMaterial->RemoveUniformBuffer(IMAGE_ANIMATION_FRAME_BINDING);
+
+	if (frameBuffer != 0)
+		glDeleteBuffers(1, &frameBuffer);
+}
+
+// sets whether the frames fade into each other
+void cherry::ImageAnimation::SetCrossfade(bool fade) { crossfade = fade; }
+
+// checks if the frames fade into each other
+bool cherry::ImageAnimation::IsCrossfading() const { return crossfade; }
+
 // update loop
 void cherry::ImageAnimation::Update(float deltaTime)
 {
-	if (isPlaying() == false || object == nullptr)
+	if (isPlaying() == false || object == nullptr || GetFrameCount() == 0)
 		return;
 
 	Image* image = (Image*)object;
-	cherry::ImageAnimationFrame* currFrame = (ImageAnimationFrame*)GetCurrentFrame();
-	cherry::ImageAnimationFrame* nextFrame = nullptr;
-	
-	Vertex* newVerts = nullptr; // vertices
-	float vertsTotal = 0;
-	float t = 0; // current time
-
-	// checks to see what frame to get next.
-	if (GetCurrentFrameIndex() + 1 >= GetFrameCount())
-		nextFrame = (ImageAnimationFrame*)GetFrame(0);	
-	else
-		nextFrame = (ImageAnimationFrame*)GetFrame(GetCurrentFrameIndex() + 1);
-	
-	// checks for null values.
-	if (currFrame == nullptr || nextFrame == nullptr)
+
+	// the frames are set up the first time, and again if frames were added or removed.
+	if (uploadedFrames != GetFrameCount())
+	{
+		if (image->IsBatched())
+			__SetupBatchedFrames();
+		else
+			__SetupFrames();
+	}
+
+	Animation::Update(deltaTime);
+
+	// how far into the frame the animation is (0 - 1), which is how much of the next frame is shown.
+	float delay = GetCurrentFrame()->GetDelayUnits();
+	float t = (crossfade && delay > 0.0F) ? glm::clamp(GetElapsedTime() / delay, 0.0F, 1.0F) : 0.0F;
+
+	// batched images share their material, so the frame is given to the sprite batch instead. No vertices are rewritten.
+	if (image->IsBatched())
+	{
+		SpriteFrame spriteFrame;
+
+		spriteFrame.Frame = batchedFrames[GetCurrentFrameIndex()];
+		spriteFrame.NextFrame = batchedFrames[(GetCurrentFrameIndex() + 1 >= (int)GetFrameCount()) ? 0 : GetCurrentFrameIndex() + 1];
+		spriteFrame.Blend = t;
+
+		object->GetMesh()->SetSpriteFrame(spriteFrame);
 		return;
+	}
+
+	// the current frame, and the frame after it.
+	int frame = glm::min(GetCurrentFrameIndex(), IMAGE_ANIMATION_MAX_FRAMES - 1);
+	int nextFrame = (GetCurrentFrameIndex() + 1 >= (int)GetFrameCount()) ? 0 : glm::min(GetCurrentFrameIndex() + 1, IMAGE_ANIMATION_MAX_FRAMES - 1);
 
-	// Image img2(nextFrame->GetFilePath(), "", image->IsDoubleSided(), image->HasDuplicatedFront()); // the second  iamge
-	// const Vertex* verts2 = img2.GetVertices();
-																										  // Image* img; // the third image
-	// totals up time passed
-	// gets how long the frame has been on screen, divided by how long the frame will stay on screen.
-	t = (GetElapsedTime() + deltaTime) / GetCurrentFrame()->GetDelayUnits();
+	Material::Sptr material = object->GetMaterial();
 
-	if (t >= 1.0F) // time
+	// another animation on the image may have used the material since this one was last updated (see AnimationManager::SetCurrentAnimation()).
+	// if so, this animation's frames are bound again, and its textures are set again.
+	if (material->GetUniformBuffer(IMAGE_ANIMATION_FRAME_BINDING) != frameBuffer)
 	{
-		t = 1.0F; // capping
+		material->SetUniformBuffer(IMAGE_ANIMATION_FRAME_BINDING, frameBuffer);
+		lastFrame = -1;
+	}
 
-		// vertices total, and 
-		vertsTotal = image->GetVerticesTotal();
-		newVerts = new Vertex[vertsTotal]; // allocating space for the new set of vertices.
+	material->Set("a_Frame", frame);
+	material->Set("a_NextFrame", nextFrame);
+	material->Set("a_FrameBlend", t);
 
-		// copying the other values.
-		for (int i = 0; i < vertsTotal; i++)
-		{
-			newVerts[i].Position = image->GetVertices()[i].Position;
-			newVerts[i].Color = image->GetVertices()[i].Color;
-			newVerts[i].Normal = image->GetVertices()[i].Normal;
-		}
+	// the textures only change if the frames use different files.
+	if (frame != lastFrame)
+		__SetFrameTextures(frame, nextFrame);
+}
+
+// sets up the frames
+void cherry::ImageAnimation::__SetupFrames()
+{
+	Image* image = (Image*)object;
+	unsigned int count = GetFrameCount();
+
+	if (count > IMAGE_ANIMATION_MAX_FRAMES)
+	{
+		LOG_WARN("Image animation has {} frames, but only the first {} are used.", count, IMAGE_ANIMATION_MAX_FRAMES);
+		count = IMAGE_ANIMATION_MAX_FRAMES;
+	}
+
+	// the uvs of each frame. Unused frames show the whole image.
+	std::vector<glm::vec4> uvs(IMAGE_ANIMATION_MAX_FRAMES, glm::vec4(0.0F, 0.0F, 1.0F, 1.0F));
+
+	// each file is loaded once, rather than every time a frame using it is shown.
+	std::unordered_map<uint32_t, Texture2D::Sptr> textures;
+	frameTextures.clear();
+
+	for (unsigned int i = 0; i < count; i++)
+	{
+		ImageAnimationFrame* frame = (ImageAnimationFrame*)GetFrame(i);
+		uvs[i] = glm::vec4(frame->GetUVMinimum(), frame->GetUVMaxium());
+
+		std::unordered_map<uint32_t, Texture2D::Sptr>::iterator iter = textures.find(frame->GetFileIndex());
+
+		if (iter == textures.end())
+			iter = textures.emplace(frame->GetFileIndex(), Texture2D::LoadFromFile(frame->GetFilePath())).first;
 
-		// the four vertices (guaranteed)
-		newVerts[0].UV = nextFrame->GetUVMinimum(); // bottom-left ~ default: (0, 0)
-		newVerts[1].UV = glm::vec2(nextFrame->GetUMaximum(), nextFrame->GetVMinimum()); // bottom-right ~ default: (1, 0)
-		
-		newVerts[2].UV = glm::vec2(nextFrame->GetUMinimum(), nextFrame->GetVMaximum()); // top-left ~ default: (0, 1)
-		newVerts[3].UV = nextFrame->GetUVMaxium(); // top-right ~ default: (1, 1)
-			
-		// extra four vertices (only present if front is duplicated on the back)
-		if (image->HasDuplicatedFront())
+		frameTextures.push_back(iter->second);
+	}
+
+	if (frameBuffer == 0)
+	{
+		glCreateBuffers(1, &frameBuffer);
+		glNamedBufferStorage(frameBuffer, sizeof(glm::vec4) * uvs.size(), uvs.data(), GL_DYNAMIC_STORAGE_BIT);
+	}
+	else
+	{
+		glNamedBufferSubData(frameBuffer, 0, sizeof(glm::vec4) * uvs.size(), uvs.data());
+	}
+
+	// the mesh's uvs become the corners of the quad, which the shader moves into the frame's uvs.
+	// this is only done once, since the corners are the same for every frame.
+	if (uploadedFrames == 0)
+	{
+		unsigned int vertsTotal = image->GetVerticesTotal();
+		Vertex* newVerts = object->GetMesh()->MapVertices(0, vertsTotal);
+
+		if (newVerts != nullptr)
 		{
+			// copying the other values.
+			for (unsigned int i = 0; i < vertsTotal; i++)
+				newVerts[i] = image->GetVertices()[i];
 
-			newVerts[4].UV = newVerts[1].UV; // bottom right (1, 0)
-			newVerts[5].UV = newVerts[0].UV; // bottom left (0, 0)
+			// the four vertices (guaranteed)
+			newVerts[0].UV = glm::vec2(0.0F, 0.0F); // bottom left
+			newVerts[1].UV = glm::vec2(1.0F, 0.0F); // bottom right
+			newVerts[2].UV = glm::vec2(0.0F, 1.0F); // top left
+			newVerts[3].UV = glm::vec2(1.0F, 1.0F); // top right
 
-			newVerts[6].UV = newVerts[3].UV; // top right (1, 1)
-			newVerts[7].UV = newVerts[2].UV; // top left (0 1)
+			// extra four vertices (only present if front is duplicated on the back)
+			if (image->HasDuplicatedFront())
+			{
+				newVerts[4].UV = glm::vec2(1.0F, 0.0F); // bottom right
+				newVerts[5].UV = glm::vec2(0.0F, 0.0F); // bottom left
+				newVerts[6].UV = glm::vec2(1.0F, 1.0F); // top right
+				newVerts[7].UV = glm::vec2(0.0F, 1.0F); // top left
+			}
 		}
+	}
+
+	Material::Sptr material = object->GetMaterial();
+
+	if (!material->SetKeyword(IMAGE_ANIMATION_KEYWORD, true))
+		LOG_WARN("The animated image shader couldn't be used for \"{}\".", image->GetFilePath());
+
+	material->SetUniformBuffer(IMAGE_ANIMATION_FRAME_BINDING, frameBuffer);
+	frameMaterial = material;
 
-		// TODO: check for no image being used. 
-		// if the two images are not the same
-		if (currFrame->GetFilePath() != nextFrame->GetFilePath())
+	sampler = image->GetTextureSampler();
+	uploadedFrames = GetFrameCount();
+	lastFrame = -1;
+}
+
+// sets up the batched frames
+void cherry::ImageAnimation::__SetupBatchedFrames()
+{
+	Image* image = (Image*)object;
+	const AtlasRegion& imageRegion = image->GetAtlasRegion();
+
+	batchedFrames.clear();
+
+	for (unsigned int i = 0; i < GetFrameCount(); i++)
+	{
+		ImageAnimationFrame* frame = (ImageAnimationFrame*)GetFrame(i);
+		AtlasRegion frameRegion;
+
+		// the image can't switch pages, since the page is its material. The frame shows the whole image instead.
+		if (!TextureAtlas::Add(frame->GetFilePath(), frameRegion) || frameRegion.Page != imageRegion.Page)
 		{
-			Texture2D::Sptr txtr = Texture2D::LoadFromFile(nextFrame->GetFilePath());
-			object->GetMaterial()->Set("s_Albedos[0]", txtr, image->GetTextureSampler());
-			object->GetMaterial()->Set("s_Albedos[1]", txtr, image->GetTextureSampler());
-			object->GetMaterial()->Set("s_Albedos[2]", txtr, image->GetTextureSampler());
+			LOG_WARN("Frame \"{}\" isn't on the same atlas page as its image.", frame->GetFilePath());
+			batchedFrames.push_back(TextureAtlas::ConvertToPageUVs(imageRegion, glm::vec4(0.0F, 0.0F, 1.0F, 1.0F)));
+			continue;
 		}
 
-		// gets the uvs of the image.
-		object->GetMesh()->Morph(newVerts, vertsTotal); // morphs the vertices.
-		delete[] newVerts;
+		batchedFrames.push_back(TextureAtlas::ConvertToPageUVs(frameRegion, glm::vec4(frame->GetUVMinimum(), frame->GetUVMaxium())));
 	}
 
-	// updates the animation.
-	Animation::Update(deltaTime);
+	// the mesh's uvs become the corners of the quad. This is only done once, since the corners are the same for every frame.
+	if (uploadedFrames == 0)
+		image->UseBatchedFrames();
+
+	uploadedFrames = GetFrameCount();
+}
+
+// sets the frame textures
+void cherry::ImageAnimation::__SetFrameTextures(int frame, int nextFrame)
+{
+	Material::Sptr material = object->GetMaterial();
+
+	// the current frame is sampled from the first texture, and the next frame from the second.
+	material->Set("s_Albedos[0]", frameTextures[frame], sampler);
+	material->Set("s_Albedos[1]", frameTextures[nextFrame], sampler);
+
+	lastFrame = frame;
 }
 
 // TEXTURE ANIMATION FRAME
@@ -112,7 +236,7 @@ cherry::ImageAnimationFrame::ImageAnimationFrame(std::string filePath, glm::vec4
 
 // uv coordinates as a vec4
 cherry::ImageAnimationFrame::ImageAnimationFrame(std::string filePath, cherry::Vec4 uvs, float units)
-	: AnimationFrame(units), image(filePath), uvCoords(uvs.v.x, uvs.v.y, uvs.v.z, uvs.v.w)
+	: AnimationFrame(units), uvCoords(uvs.v.x, uvs.v.y, uvs.v.z, uvs.v.w)
 {
 	std::ifstream file(filePath, std::ios::in); // opens the file
 
@@ -131,10 +255,24 @@ cherry::ImageAnimationFrame::ImageAnimationFrame(std::string filePath, cherry::V
 
 	// closes the file since it was only opened for this check.
 	file.close();
+
+	// the frames using the same file share its path.
+	std::unordered_map<std::string, uint32_t>::iterator iter = fileIndexes.find(filePath);
+
+	if (iter == fileIndexes.end())
+	{
+		iter = fileIndexes.emplace(filePath, (uint32_t)files.size()).first;
+		files.push_back(filePath);
+	}
+
+	image = iter->second;
 }
 
 // gets the file path of the image for this frame.
-const std::string cherry::ImageAnimationFrame::GetFilePath() const { return image; }
+const std::string& cherry::ImageAnimationFrame::GetFilePath() const { return files[image]; }
+
+// gets the index of the file
+uint32_t cherry::ImageAnimationFrame::GetFileIndex() const { return image; }
 
 // gets the minimum uv values.
 glm::vec2 cherry::ImageAnimationFrame::GetUVMinimum() const { return glm::vec2(uvCoords.x, uvCoords.y); }
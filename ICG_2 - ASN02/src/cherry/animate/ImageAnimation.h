@@ -1,23 +1,71 @@
 #pragma once
 #include "Animation.h"
+#include "..\textures\Texture2D.h"
+#include "..\Material.h"
+
+#include <unordered_map>
+
+// the maximum amount of frames the shader can take. This must match the size of a_Frames in image.vs.glsl.
+#define IMAGE_ANIMATION_MAX_FRAMES 64
+
+// the uniform buffer binding the frames are put in. This must match the binding of FrameBlock in image.vs.glsl.
+#define IMAGE_ANIMATION_FRAME_BINDING 0
+
+// the keyword for the image shader variant that reads the frames from the uniform buffer.
+#define IMAGE_ANIMATION_KEYWORD ("SPRITE_ANIMATION")
 
 namespace cherry
 {
-	// Texture Animation; used for the image class.
+	/*
+	 * Texture Animation; used for the image class.
+	 * The uvs of each frame are put into a uniform buffer once, and the image's mesh uvs are changed to the corners of the quad (0 - 1).
+	 * The vertex shader moves the corners into the current frame's uvs, so changing frames only changes a few uniforms (no vertices are rewritten).
+	 * If crossfading is on, the fragment shader blends the current frame into the next frame over the length of the frame.
+	 * Images in the texture atlas share their material, so the uvs of each frame on the atlas page are worked out once instead.
+	 * The current frame is given to the sprite batch (see Mesh::SetSpriteFrame()), which moves the uvs in the shader the same way.
+	*/
 	class ImageAnimation : public Animation
 	{
 	public:
 		// constructor.
 		ImageAnimation();
 
+		// deletes the frame buffer.
+		~ImageAnimation();
+
+		// sets whether the frames fade into each other.
+		void SetCrossfade(bool fade);
+
+		// returns 'true' if the frames fade into each other.
+		bool IsCrossfading() const;
+
 		// updates the texture animation.
 		void Update(float deltaTime);
 
 	private:
+		// puts the frames into the uniform buffer, loads their textures, and switches the image to the animated shader.
+		// this is done again if the amount of frames changes.
+		void __SetupFrames();
+
+		// puts the uvs of each frame on the atlas page into a list, and changes the image's uvs to the corners of the quad.
+		// this is used instead of __SetupFrames() for batched images.
+		void __SetupBatchedFrames();
+
+		// sets the textures for the current and next frames.
+		void __SetFrameTextures(int frame, int nextFrame);
+
+		GLuint frameBuffer = 0; // the uniform buffer with the frame uvs.
+		Material::Sptr frameMaterial = nullptr; // the material the uniform buffer was given to.
+		unsigned int uploadedFrames = 0; // the amount of frames in the uniform buffer.
+
+		std::vector<Texture2D::Sptr> frameTextures; // the texture for each frame.
+		std::vector<glm::vec4> batchedFrames; // the uvs of each frame on the atlas page, which are used if the image is batched.
+		TextureSampler::Sptr sampler = nullptr; // the sampler used for the textures.
+
+		int lastFrame = -1; // the frame the textures were last set for.
+		bool crossfade = false; // if 'true', the frames fade into each other.
 
-		// TODO: add option to blend frames.
 		// TODO: add size, orientation, and orientation changes.
-		// SwitchFrames();
 
 	protected:
 	};
@@ -46,7 +94,10 @@ namespace cherry
 		// ImageAnimationFrame(int row, int column, float width, float height);
 
 		// gets the file path of the image used for the current frame.
-		const std::string GetFilePath() const;
+		const std::string& GetFilePath() const;
+
+		// gets the index of the frame's file. Frames using the same file have the same index.
+		uint32_t GetFileIndex() const;
 
 		// gets the minimum UV values
 		glm::vec2 GetUVMinimum() const;
@@ -68,9 +119,14 @@ namespace cherry
 
 	private:
 	protected:
-		std::string image = "";
+		// the index of the file in the list of files, which is shared by all frames.
+		uint32_t image = 0;
 
 		glm::vec4 uvCoords; // (x_min, y_min, x_max, y_max)
 
+		// the file paths used by the frames, and their indexes.
+		static std::vector<std::string> files;
+		static std::unordered_map<std::string, uint32_t> fileIndexes;
+
 	} ImageFrame;
 }
@@ -29,9 +29,15 @@ cherry::MorphVertex* cherry::MorphAnimation::GeneratePose() const
 {
 	// the pose
 	MorphVertex* pose = new MorphVertex[object->GetVerticesTotal()];
-	pose = Mesh::ConvertToMorphVertexArray(object->GetVertices(), object->GetVerticesTotal()); // copies the object
+	GeneratePose(pose);
 
-	// const Vertex* verts = object->GetVertices(); // the vertices of the object
+	return pose;
+}
+
+// generates the pose into the provided array.
+void cherry::MorphAnimation::GeneratePose(MorphVertex* pose) const
+{
+	const Vertex* verts = object->GetVertices(); // the vertices of the object
 	int nextFrameIndex = GetCurrentFrameIndex() + 1; // gets the index of the previous frame.
 
 	MorphAnimationFrame* currFrame = (MorphAnimationFrame*)(GetCurrentFrame()); // the current frame
@@ -61,27 +67,25 @@ cherry::MorphVertex* cherry::MorphAnimation::GeneratePose() const
 			ind1 = valsTtl - ind1;
 
 		// position
-		// pose[i].Position = verts[i].Position;
+		pose[i].Position = verts[i].Position;
 		pose[i].Position1 = currPose[i].Position;
 		pose[i].Position2 = nextPose[i].Position;
 
 		// colour
-		// pose[i].Color = verts[i].Color;
+		pose[i].Color = verts[i].Color;
 		pose[i].Color1 = currPose[i].Color;
 		pose[i].Color2 = nextPose[i].Color;
 
 		// normals
-		// pose[i].Normal = verts[i].Normal;
+		pose[i].Normal = verts[i].Normal;
 		pose[i].Normal1 = currPose[i].Normal;
 		pose[i].Normal2 = nextPose[i].Normal;
 
 		// uvs
-		// pose[i].UV = verts[i].UV;
+		pose[i].UV = verts[i].UV;
 		pose[i].UV1 = currPose[i].UV;
 		pose[i].UV2 = nextPose[i].UV;
 	}
-
-	return pose;
 }
 
 // updating hte morphing animation.
@@ -95,6 +99,7 @@ void cherry::MorphAnimation::Update(float deltaTime)
 
 	// TODO: fix so that the morphing happens from the second animation
 	MorphVertex* morphVerts = nullptr;
+	unsigned int valsTtl = 0;
 	
 	if (isPlaying() == false)
 		return;
@@ -107,13 +112,15 @@ void cherry::MorphAnimation::Update(float deltaTime)
 		t = 1.0F;
 
 	// getting the frame of animation
-	// TODO: optimize so that a pose isn't generated every frame.
-	morphVerts = GeneratePose();
-	
-	object->GetMesh()->Morph(GeneratePose(), ((MorphAnimationFrame*)(GetCurrentFrame()))->GetValueAmount());
-	object->GetMaterial()->GetShader()->SetUniform("a_T", t);
-	
-	delete[] morphVerts;
+	// the pose is written straight into the mesh's mapped vertex buffer, so nothing is allocated per frame.
+	valsTtl = object->GetVerticesTotal();
+	morphVerts = object->GetMesh()->MapMorphVertices(0, valsTtl);
+
+	if (morphVerts != nullptr)
+		GeneratePose(morphVerts);
+
+	// set on the material, since its shader can be shared with other objects.
+	object->GetMaterial()->Set("a_T", t);
 
 	// switches the frame if at the end of the animation.
 	Animation::Update(deltaTime);
@@ -20,6 +20,9 @@ namespace cherry
 		// generates a mesh for the current pose, with position1 and normal1 being the targets.
 		MorphVertex* GeneratePose() const;
 
+		// generates the pose into the provided array, which must have room for all of the object's vertices.
+		void GeneratePose(MorphVertex* pose) const;
+
 		// updates the morphing animation
 		void Update(float deltaTime);
 
@@ -1,6 +1,7 @@
 // Code edited from: https://codyclaborn.me/tutorials/making-a-basic-fmod-audio-engine-in-c/
 
 #include "AudioEngine.h"
+#include <toolkit/Logging.h>
 
 cherry::Implementation::Implementation()
 {
@@ -303,7 +304,7 @@ int cherry::AudioEngine::ErrorCheck(FMOD_RESULT result)
 {
 	if (result != FMOD_OK)
 	{
-		std::cout << "FMOD ERROR: " << FMOD_ErrorString(result) << std::endl;
+		LOG_WARN("FMOD ERROR: {}", FMOD_ErrorString(result));
 		return 1;
 	}
 
@@ -0,0 +1,141 @@
+// LightClusterCheck (Source) - compares the light clusters against a brute force search of the lights, and times the cluster build.
+#include "LightClusterCheck.h"
+
+#include <toolkit/Logging.h>
+#include <GLM/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+// checks the clusters
+cherry::LightClusterCheckResult cherry::LightClusterCheck::Run(const std::vector<ClusterLight>& lights, const glm::mat4& view, const glm::mat4& projection,
+	float nearPlane, float farPlane, uint32_t samples, float cutoff)
+{
+	LightClusterCheckResult result;
+	LightClusters clusters;
+
+	result.Lights = (uint32_t)lights.size();
+	result.Samples = samples;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	clusters.Build(lights, view, projection, nearPlane, farPlane);
+	result.BuildTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	// the clusters clamp the planes, so the samples use the same ones.
+	nearPlane = clusters.GetNearPlane();
+	farPlane = clusters.GetFarPlane();
+
+	const glm::mat4 inverseProjection = glm::inverse(projection);
+	const glm::mat4 inverseView = glm::inverse(view);
+	const std::vector<uint32_t>& indices = clusters.GetLightIndices();
+
+	// the sample points, saved so the reference can be timed on its own.
+	std::vector<glm::vec3> points;
+	std::vector<uint32_t> pointClusters;
+
+	points.reserve(samples);
+	pointClusters.reserve(samples);
+
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> unit(0.0F, 1.0F);
+
+	for (uint32_t i = 0; i < samples; i++)
+	{
+		// the depth is spread evenly over the exponential slices, so every slice gets samples.
+		glm::vec2 uv(unit(random), unit(random));
+		float depth = nearPlane * glm::pow(farPlane / nearPlane, unit(random));
+
+		// the point at the depth is found along the line between the near and far planes, like LightClusters::CalculateBounds().
+		glm::vec4 n = inverseProjection * glm::vec4(uv * 2.0F - 1.0F, -1.0F, 1.0F);
+		glm::vec4 f = inverseProjection * glm::vec4(uv * 2.0F - 1.0F, 1.0F, 1.0F);
+		glm::vec3 nearPoint = glm::vec3(n) / n.w;
+		glm::vec3 farPoint = glm::vec3(f) / f.w;
+
+		float t = (depth + nearPoint.z) / (nearPoint.z - farPoint.z);
+
+		points.push_back(glm::vec3(inverseView * glm::vec4(glm::mix(nearPoint, farPoint, t), 1.0F)));
+		pointClusters.push_back(LightClusters::FindCluster(uv, depth, nearPlane, farPlane));
+	}
+
+	uint64_t clusterLights = 0;
+	uint64_t reachingLights = 0;
+
+	start = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t i = 0; i < samples; i++)
+	{
+		const glm::uvec2& cluster = clusters.GetCluster(pointClusters[i]);
+		clusterLights += cluster.y;
+
+		for (uint32_t l = 0; l < lights.size(); l++)
+		{
+			// the most the light can give at the point is its brightest channel for both the diffuse and specular terms.
+			// the cutoff gets a small margin, so that rounding right at the edge of the radius isn't counted.
+			const glm::vec3 color = glm::vec3(lights[l].color);
+			const glm::vec3 diff = points[i] - glm::vec3(lights[l].position);
+			float brightest = 2.0F * glm::max(color.r, glm::max(color.g, color.b));
+			float contribution = brightest / (1.0F + glm::max(lights[l].color.w, 0.0F) * glm::dot(diff, diff));
+
+			if (contribution <= cutoff * 1.001F)
+				continue;
+
+			reachingLights++;
+
+			// the lists are sorted by light index.
+			auto first = indices.begin() + cluster.x;
+			auto last = first + cluster.y;
+
+			if (!std::binary_search(first, last, l))
+				result.MissingLights++;
+		}
+	}
+
+	result.ReferenceTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	result.AverageClusterLights = (samples > 0) ? clusterLights / (float)samples : 0.0F;
+	result.AverageReachingLights = (samples > 0) ? reachingLights / (float)samples : 0.0F;
+	result.Passed = result.MissingLights == 0;
+
+	LOG_INFO("Light cluster check: {} lights, {} samples, built in {:.3f} ms (brute force: {:.3f} ms).",
+		result.Lights, result.Samples, result.BuildTime, result.ReferenceTime);
+	LOG_INFO("Light cluster check: {:.2f} lights per sample in the clusters, {:.2f} reach the sample.",
+		result.AverageClusterLights, result.AverageReachingLights);
+
+	if (result.Passed)
+		LOG_INFO("Light cluster check: every light that reaches a sample is in its cluster.");
+	else
+		LOG_ERROR("Light cluster check: {} lights reached a sample without being in its cluster.", result.MissingLights);
+
+	return result;
+}
+
+// scatters lights and checks them
+cherry::LightClusterCheckResult cherry::LightClusterCheck::Run(uint32_t lightCount, uint32_t samples)
+{
+	const float nearPlane = 0.1F;
+	const float farPlane = 500.0F;
+
+	// the camera sits at the origin looking down the y-axis, with z as up.
+	const glm::mat4 view = glm::lookAt(glm::vec3(0.0F), glm::vec3(0.0F, 1.0F, 0.0F), glm::vec3(0.0F, 0.0F, 1.0F));
+	const glm::mat4 projection = glm::perspective(glm::radians(60.0F), 16.0F / 9.0F, nearPlane, farPlane);
+
+	std::vector<ClusterLight> lights;
+	lights.reserve(lightCount);
+
+	std::mt19937 random(5678);
+	std::uniform_real_distribution<float> unit(0.0F, 1.0F);
+
+	for (uint32_t i = 0; i < lightCount; i++)
+	{
+		// the lights are spread through a box in front of the camera, which goes a bit past the sides of the frustum.
+		glm::vec3 position((unit(random) * 2.0F - 1.0F) * 200.0F, unit(random) * 300.0F, (unit(random) * 2.0F - 1.0F) * 120.0F);
+		glm::vec3 color(unit(random), unit(random), unit(random));
+		float attenuation = 0.01F + unit(random) * 0.5F;
+
+		lights.push_back({
+			glm::vec4(position, LightClusters::CalculateRadius(color, attenuation)),
+			glm::vec4(color, attenuation),
+			glm::vec4(16.0F, 0.0F, 0.0F, 0.0F) });
+	}
+
+	return Run(lights, view, projection, nearPlane, farPlane, samples);
+}
@@ -0,0 +1,40 @@
+// LightClusterCheck (Header) - compares the light clusters against a brute force search of the lights, and times the cluster build.
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+#include "LightClusters.h"
+
+namespace cherry
+{
+	// the results of a check.
+	struct LightClusterCheckResult
+	{
+		uint32_t Lights = 0;
+		uint32_t Samples = 0;
+		float BuildTime = 0.0F; // how long LightClusters::Build() took (in milliseconds).
+		float ReferenceTime = 0.0F; // how long the brute force search took for all of the samples (in milliseconds).
+
+		float AverageClusterLights = 0.0F; // the lights the shader loops over for a sample.
+		float AverageReachingLights = 0.0F; // the lights that actually reach a sample.
+		uint64_t MissingLights = 0; // the lights that reach a sample, but aren't in its cluster. This should be 0.
+		bool Passed = false; // 'true' if no lights were missing.
+	};
+
+	/*
+	 * The check picks random points in the view frustum, and finds the cluster for each one the same way the lighting shader does (LightClusters::FindCluster()).
+	 * The reference goes through every light, and keeps the ones whose largest possible contribution at the point is above the cutoff.
+	 * Every one of those lights must be in the cluster's list, or the shader would drop light that it should draw.
+	 * The check only runs on the CPU, so no OpenGL context is needed. The results are printed to the log.
+	*/
+	class LightClusterCheck
+	{
+	public:
+		// checks the lights with the provided camera. Each light's radius must be set in position.w (see LightClusters::CalculateRadius()).
+		static LightClusterCheckResult Run(const std::vector<ClusterLight>& lights, const glm::mat4& view, const glm::mat4& projection,
+			float nearPlane, float farPlane, uint32_t samples = 65536, float cutoff = 1.0F / 256.0F);
+
+		// scatters the provided amount of lights in front of a perspective camera with random colours and attenuations, then checks them.
+		static LightClusterCheckResult Run(uint32_t lightCount = 4096, uint32_t samples = 65536);
+	};
+}
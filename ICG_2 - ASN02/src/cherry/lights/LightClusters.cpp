@@ -0,0 +1,262 @@
+// LightClusters - assigns point lights to a froxel (frustum voxel) grid for clustered lighting
+#include "LightClusters.h"
+#include <limits>
+
+// destructor
+cherry::LightClusters::~LightClusters()
+{
+	if (lightBuffer != 0)
+	{
+		glDeleteBuffers(1, &lightBuffer);
+		glDeleteBuffers(1, &gridBuffer);
+		glDeleteBuffers(1, &indexBuffer);
+	}
+}
+
+// calculates a light radius
+float cherry::LightClusters::CalculateRadius(const glm::vec3& color, float attenuation, float cutoff)
+{
+	// the shader adds the diffuse and specular terms, which are both at most the light's colour.
+	float brightest = 2.0F * glm::max(color.r, glm::max(color.g, color.b));
+
+	if (brightest <= cutoff)
+		return 0.0F;
+
+	// no attenuation, so the light never fades out.
+	if (attenuation <= 0.0F)
+		return std::numeric_limits<float>::max();
+
+	// brightest / (1 + attenuation * d^2) = cutoff
+	return glm::sqrt((brightest / cutoff - 1.0F) / attenuation);
+}
+
+// builds the clusters
+void cherry::LightClusters::Build(const std::vector<ClusterLight>& lights, const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane)
+{
+	const uint32_t CLUSTER_COUNT = LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y * LIGHT_CLUSTERS_Z;
+
+	// the cluster each light touches, saved so the lists can be filled after their sizes are known.
+	std::vector<uint32_t> touched;
+	std::vector<uint32_t> touchedCount(lights.size(), 0);
+
+	if (bounds.empty() || projection != boundsProjection || nearPlane != this->nearPlane || farPlane != this->farPlane)
+		CalculateBounds(projection, nearPlane, farPlane);
+
+	lightData = lights;
+	grid.assign(CLUSTER_COUNT, glm::uvec2(0, 0));
+	indices.clear();
+	maxPerCluster = 0;
+
+	// counts the lights in each cluster.
+	for (uint32_t i = 0; i < lights.size(); i++)
+	{
+		const glm::vec3 center = glm::vec3(view * glm::vec4(glm::vec3(lights[i].position), 1.0F));
+		const float radius = lights[i].position.w;
+		const float depth = -center.z;
+
+		// the light is fully in front of or behind the frustum.
+		if (radius <= 0.0F || depth + radius < this->nearPlane || depth - radius > this->farPlane)
+			continue;
+
+		const int firstSlice = glm::max(GetSlice(depth - radius), 0);
+		const int lastSlice = glm::min(GetSlice(glm::min(depth + radius, this->farPlane)), LIGHT_CLUSTERS_Z - 1);
+
+		for (int z = firstSlice; z <= lastSlice; z++)
+		{
+			for (uint32_t y = 0; y < LIGHT_CLUSTERS_Y; y++)
+			{
+				for (uint32_t x = 0; x < LIGHT_CLUSTERS_X; x++)
+				{
+					const uint32_t cluster = GetClusterIndex(x, y, z);
+					const Bounds& box = bounds[cluster];
+
+					// sphere and box overlap test, using the closest point on the box to the sphere.
+					glm::vec3 closest = glm::clamp(center, box.min, box.max);
+					glm::vec3 diff = closest - center;
+
+					if (glm::dot(diff, diff) <= radius * radius)
+					{
+						grid[cluster].y++;
+						touched.push_back(cluster);
+						touchedCount[i]++;
+					}
+				}
+			}
+		}
+	}
+
+	// gives each cluster its offset in the index list.
+	uint32_t offset = 0;
+
+	for (glm::uvec2& cluster : grid)
+	{
+		cluster.x = offset;
+		offset += cluster.y;
+		maxPerCluster = glm::max(maxPerCluster, cluster.y);
+
+		cluster.y = 0; // the count is rebuilt while filling.
+	}
+
+	indices.resize(offset);
+
+	// fills in the lists. The lights are added in order, so each list is sorted by light index.
+	for (uint32_t i = 0, t = 0; i < lights.size(); i++)
+	{
+		for (uint32_t j = 0; j < touchedCount[i]; j++, t++)
+		{
+			glm::uvec2& cluster = grid[touched[t]];
+			indices[cluster.x + cluster.y] = i;
+			cluster.y++;
+		}
+	}
+}
+
+// uploads the buffers
+void cherry::LightClusters::Upload()
+{
+	// the buffers can't be empty, so a single element is uploaded if there's nothing to put in them.
+	static const ClusterLight EMPTY_LIGHT = ClusterLight();
+	static const uint32_t EMPTY_INDEX = 0;
+
+	if (lightBuffer == 0)
+	{
+		glCreateBuffers(1, &lightBuffer);
+		glCreateBuffers(1, &gridBuffer);
+		glCreateBuffers(1, &indexBuffer);
+	}
+
+	// the data is replaced every frame, so the buffers are re-specified instead of updated.
+	// this lets the driver give a new allocation instead of waiting on the GPU.
+	if (lightData.empty())
+		glNamedBufferData(lightBuffer, sizeof(ClusterLight), &EMPTY_LIGHT, GL_STREAM_DRAW);
+	else
+		glNamedBufferData(lightBuffer, sizeof(ClusterLight) * lightData.size(), lightData.data(), GL_STREAM_DRAW);
+
+	glNamedBufferData(gridBuffer, sizeof(glm::uvec2) * grid.size(), grid.data(), GL_STREAM_DRAW);
+
+	if (indices.empty())
+		glNamedBufferData(indexBuffer, sizeof(uint32_t), &EMPTY_INDEX, GL_STREAM_DRAW);
+	else
+		glNamedBufferData(indexBuffer, sizeof(uint32_t) * indices.size(), indices.data(), GL_STREAM_DRAW);
+}
+
+// binds the buffers
+void cherry::LightClusters::Bind() const
+{
+	if (lightBuffer == 0)
+		return;
+
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_CLUSTERS_LIGHT_BINDING, lightBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_CLUSTERS_GRID_BINDING, gridBuffer);
+	glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_CLUSTERS_INDEX_BINDING, indexBuffer);
+}
+
+// gets a cluster index
+uint32_t cherry::LightClusters::GetClusterIndex(uint32_t x, uint32_t y, uint32_t z)
+{
+	return x + LIGHT_CLUSTERS_X * (y + LIGHT_CLUSTERS_Y * z);
+}
+
+// finds a cluster
+uint32_t cherry::LightClusters::FindCluster(const glm::vec2& uv, float viewDepth, float nearPlane, float farPlane)
+{
+	// this must match the lighting shader (blinn-phong-post.fs.glsl).
+	int slice = (int)glm::floor(glm::log(glm::max(viewDepth, nearPlane) / nearPlane) / glm::log(farPlane / nearPlane) * LIGHT_CLUSTERS_Z);
+	int x = glm::clamp((int)(uv.x * LIGHT_CLUSTERS_X), 0, LIGHT_CLUSTERS_X - 1);
+	int y = glm::clamp((int)(uv.y * LIGHT_CLUSTERS_Y), 0, LIGHT_CLUSTERS_Y - 1);
+
+	return GetClusterIndex(x, y, glm::clamp(slice, 0, LIGHT_CLUSTERS_Z - 1));
+}
+
+// gets a cluster
+const glm::uvec2& cherry::LightClusters::GetCluster(uint32_t index) const { return grid.at(index); }
+
+// gets the light indices
+const std::vector<uint32_t>& cherry::LightClusters::GetLightIndices() const { return indices; }
+
+// gets the light count
+uint32_t cherry::LightClusters::GetLightCount() const { return lightData.size(); }
+
+// gets the lights
+const std::vector<cherry::ClusterLight>& cherry::LightClusters::GetLights() const { return lightData; }
+
+// gets the most lights in a cluster
+uint32_t cherry::LightClusters::GetMaxLightsPerCluster() const { return maxPerCluster; }
+
+// gets the near plane
+float cherry::LightClusters::GetNearPlane() const { return nearPlane; }
+
+// gets the far plane
+float cherry::LightClusters::GetFarPlane() const { return farPlane; }
+
+// calculates the bounds
+void cherry::LightClusters::CalculateBounds(const glm::mat4& projection, float nearPlane, float farPlane)
+{
+	const glm::mat4 inverse = glm::inverse(projection);
+
+	boundsProjection = projection;
+	this->nearPlane = glm::max(nearPlane, 0.001F);
+	this->farPlane = glm::max(farPlane, this->nearPlane + 0.001F);
+
+	bounds.resize(LIGHT_CLUSTERS_X * LIGHT_CLUSTERS_Y * LIGHT_CLUSTERS_Z);
+
+	for (uint32_t y = 0; y < LIGHT_CLUSTERS_Y; y++)
+	{
+		for (uint32_t x = 0; x < LIGHT_CLUSTERS_X; x++)
+		{
+			// the corners of the tile on the near and far planes, in view space.
+			// the point at a depth is found along the line between them, which works for both perspective and orthographic projections.
+			glm::vec3 nearCorners[4];
+			glm::vec3 farCorners[4];
+
+			for (int c = 0; c < 4; c++)
+			{
+				glm::vec2 ndc = glm::vec2(
+					(x + (c & 1)) / (float)LIGHT_CLUSTERS_X * 2.0F - 1.0F,
+					(y + (c >> 1)) / (float)LIGHT_CLUSTERS_Y * 2.0F - 1.0F);
+
+				glm::vec4 n = inverse * glm::vec4(ndc, -1.0F, 1.0F);
+				glm::vec4 f = inverse * glm::vec4(ndc, 1.0F, 1.0F);
+
+				nearCorners[c] = glm::vec3(n) / n.w;
+				farCorners[c] = glm::vec3(f) / f.w;
+			}
+
+			for (uint32_t z = 0; z < LIGHT_CLUSTERS_Z; z++)
+			{
+				Bounds& box = bounds[GetClusterIndex(x, y, z)];
+
+				box.min = glm::vec3(std::numeric_limits<float>::max());
+				box.max = glm::vec3(-std::numeric_limits<float>::max());
+
+				for (float depth : { GetSliceDepth(z), GetSliceDepth(z + 1) })
+				{
+					for (int c = 0; c < 4; c++)
+					{
+						float t = (depth + nearCorners[c].z) / (nearCorners[c].z - farCorners[c].z);
+						glm::vec3 point = glm::mix(nearCorners[c], farCorners[c], t);
+
+						box.min = glm::min(box.min, point);
+						box.max = glm::max(box.max, point);
+					}
+				}
+			}
+		}
+	}
+}
+
+// gets a slice's depth
+float cherry::LightClusters::GetSliceDepth(uint32_t slice) const
+{
+	return nearPlane * glm::pow(farPlane / nearPlane, slice / (float)LIGHT_CLUSTERS_Z);
+}
+
+// gets the slice for a depth
+int cherry::LightClusters::GetSlice(float depth) const
+{
+	if (depth <= nearPlane)
+		return 0;
+
+	// inverse of GetSliceDepth(). This must match the lighting shader.
+	return (int)glm::floor(glm::log(depth / nearPlane) / glm::log(farPlane / nearPlane) * LIGHT_CLUSTERS_Z);
+}
@@ -0,0 +1,118 @@
+// LightClusters - assigns point lights to a froxel (frustum voxel) grid for clustered lighting
+#pragma once
+#include <glad/glad.h>
+#include <GLM/glm.hpp>
+#include <stdint.h>
+#include <vector>
+
+// the size of the cluster grid. The screen is split into tiles, and the view depth is split into exponential slices.
+#define LIGHT_CLUSTERS_X 16
+#define LIGHT_CLUSTERS_Y 9
+#define LIGHT_CLUSTERS_Z 24
+
+// the storage buffer bindings used by the lighting shader.
+#define LIGHT_CLUSTERS_LIGHT_BINDING 0
+#define LIGHT_CLUSTERS_GRID_BINDING 1
+#define LIGHT_CLUSTERS_INDEX_BINDING 2
+
+namespace cherry
+{
+	// a light as it's stored in the shader storage buffer (std430 layout).
+	struct ClusterLight
+	{
+		glm::vec4 position; // xyz = world position, w = radius of influence
+		glm::vec4 color; // rgb = colour, w = attenuation
+		glm::vec4 material; // x = shininess, yzw = unused
+	};
+
+	/*
+	 * Builds a list of the lights that touch each cluster of the view frustum.
+	 * Build() only runs on the CPU, so it can be used without an OpenGL context. Upload() and Bind() need one.
+	 * The shader finds its cluster from the screen position and view depth, and only loops over the lights in that cluster's list.
+	 * The grid is stored as (offset, count) pairs into one compacted index list.
+	*/
+	class LightClusters
+	{
+	public:
+		// constructor
+		LightClusters() = default;
+
+		// deletes the buffers.
+		~LightClusters();
+
+		// gets the distance at which a light's contribution drops below the cutoff, based on its colour and attenuation.
+		// the attenuation is 1 / (1 + attenuation * distance^2), so a light with no attenuation reaches everything.
+		// the diffuse and specular terms can each be as bright as the light's colour, so the brightest channel is doubled.
+		static float CalculateRadius(const glm::vec3& color, float attenuation, float cutoff = 1.0F / 256.0F);
+
+		// assigns the lights to the clusters. The radius of each light must be set in position.w.
+		// the near plane must be greater than 0, since the depth slices are exponential.
+		void Build(const std::vector<ClusterLight>& lights, const glm::mat4& view, const glm::mat4& projection, float nearPlane, float farPlane);
+
+		// uploads the lights, grid, and index list to their storage buffers.
+		void Upload();
+
+		// binds the storage buffers to the bindings the lighting shader uses.
+		void Bind() const;
+
+		// gets the index of a cluster in the grid.
+		static uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t z);
+
+		// finds the cluster of a pixel from its screen position ([0, 1] range) and view depth, the same way the lighting shader does.
+		// the planes should be the ones from GetNearPlane() and GetFarPlane().
+		static uint32_t FindCluster(const glm::vec2& uv, float viewDepth, float nearPlane, float farPlane);
+
+		// gets the (offset, count) of a cluster's light list.
+		const glm::uvec2& GetCluster(uint32_t index) const;
+
+		// gets the compacted list of light indices.
+		const std::vector<uint32_t>& GetLightIndices() const;
+
+		// gets the amount of lights given to the last build.
+		uint32_t GetLightCount() const;
+
+		// gets the lights given to the last build.
+		const std::vector<ClusterLight>& GetLights() const;
+
+		// gets the largest amount of lights in a single cluster.
+		uint32_t GetMaxLightsPerCluster() const;
+
+		// gets the near plane used for the depth slices.
+		float GetNearPlane() const;
+
+		// gets the far plane used for the depth slices.
+		float GetFarPlane() const;
+
+	private:
+		// a cluster's bounds in view space.
+		struct Bounds
+		{
+			glm::vec3 min;
+			glm::vec3 max;
+		};
+
+		// remakes the bounds of the clusters. This only happens when the projection changes.
+		void CalculateBounds(const glm::mat4& projection, float nearPlane, float farPlane);
+
+		// gets the view depth at the start of a slice.
+		float GetSliceDepth(uint32_t slice) const;
+
+		// gets the slice that a view depth is in.
+		int GetSlice(float depth) const;
+
+		std::vector<Bounds> bounds; // the view space bounds of each cluster
+		std::vector<glm::uvec2> grid; // (offset, count) for each cluster
+		std::vector<uint32_t> indices; // the light indices of every cluster, one after another
+		std::vector<ClusterLight> lightData; // the lights from the last build
+
+		glm::mat4 boundsProjection = glm::mat4(0.0F); // the projection the bounds were made with
+		float nearPlane = 0.0F;
+		float farPlane = 0.0F;
+		uint32_t maxPerCluster = 0;
+
+		// the storage buffers (0 until Upload() is called)
+		GLuint lightBuffer = 0;
+		GLuint gridBuffer = 0;
+		GLuint indexBuffer = 0;
+	};
+}
@@ -3,9 +3,13 @@
 
 #include "..\objects/ObjectManager.h"
 #include "..\utils/Utils.h"
+#include "..\ShaderCache.h"
 
 std::vector<cherry::LightList*> cherry::LightManager::lightLists = std::vector<cherry::LightList*>();
 
+// light lists by scene name
+std::unordered_map<std::string, cherry::LightList*> cherry::LightManager::lightListMap = std::unordered_map<std::string, cherry::LightList*>();
+
 // destructor
 cherry::LightManager::~LightManager()
 {
@@ -15,20 +19,11 @@ cherry::LightManager::~LightManager()
 	}
 
 	lightLists.clear();
+	lightListMap.clear();
 }
 
 // checks if a scene name has been taken.
-bool cherry::LightManager::SceneLightListExists(const std::string sceneName)
-{
-	// checks if the scene name has been used.
-	for (cherry::LightList * ll : lightLists)
-	{
-		if (ll->GetSceneName() == sceneName)
-			return true;
-	}
-
-	return false;
-}
+bool cherry::LightManager::SceneLightListExists(const std::string sceneName) { return lightListMap.count(sceneName) != 0; }
 
 // gets a light list via its index in the list.
 cherry::LightList* cherry::LightManager::GetSceneLightListByIndex(unsigned int index)
@@ -43,16 +38,9 @@ cherry::LightList* cherry::LightManager::GetSceneLightListByIndex(unsigned int i
 cherry::LightList* cherry::LightManager::GetSceneLightListByName(std::string sceneName)
 {
 	// finds if a scene exists
-	for (cherry::LightList* ll : lightLists)
-	{
-		if (ll->GetSceneName() == sceneName) // if the scene exists
-		{
-			return ll; // returns a pointer to the light list.
-			break;
-		}
-	}
+	std::unordered_map<std::string, LightList*>::iterator iter = lightListMap.find(sceneName);
 
-	return nullptr;
+	return (iter != lightListMap.end()) ? iter->second : nullptr;
 }
 
 // adds a scene to the light manager.
@@ -66,7 +54,9 @@ bool cherry::LightManager::CreateSceneLightList(const std::string sceneName)
 	else // if the scene doesn't exist in the list.
 	{
 		// adds a scene, and an associated list of lights.
-		lightLists.push_back(new LightList(sceneName));
+		LightList* ll = new LightList(sceneName);
+		lightLists.push_back(ll);
+		lightListMap[sceneName] = ll;
 		return true;
 	}
 }
@@ -79,14 +69,12 @@ bool cherry::LightManager::AddLightToSceneLightList(cherry::Light * light, bool
 
 	std::string sceneName = light->GetScene();
 	// finds the scene
-	for (cherry::LightList* ll : lightLists)
+	cherry::LightList* ll = GetSceneLightListByName(sceneName);
+
+	if (ll != nullptr) // if the scene exists
 	{
-		if (ll->GetSceneName() == sceneName) // if the scene exists
-		{
-			ll->AddLight(light); // returns a pointer to the light list.
-			return true;
-			break;
-		}
+		ll->AddLight(light);
+		return true;
 	}
 
 	// if the scene should be added if it doesn't already exist.
@@ -147,10 +135,7 @@ bool cherry::LightManager::DestroySceneLightListByIndex(unsigned int index)
 
 	if (lgtList != nullptr) // if the object isn't a nullptr
 	{
-		util::removeFromVector(lightLists, lgtList);
-		delete lgtList;
-
-		return true;
+		return DestroySceneLightListByPointer(lgtList);
 	}
 	else // if the object is a nullptr
 	{
@@ -163,6 +148,7 @@ bool cherry::LightManager::DestroySceneLightListByPointer(cherry::LightList* ll)
 {
 	if (util::removeFromVector(lightLists, ll)) // in list
 	{
+		lightListMap.erase(ll->GetSceneName());
 		delete ll;
 		return true;
 	}
@@ -261,12 +247,18 @@ cherry::Material::Sptr cherry::LightList::GenerateMaterial(std::string vs, std::
 
 // generates the material
 cherry::Material::Sptr cherry::LightList::GenerateMaterial(std::string vs, std::string fs, const TextureSampler::Sptr& sampler) const
+{
+	return GenerateMaterial(vs, fs, sampler, std::vector<std::string>());
+}
+
+// generates the material with keywords
+cherry::Material::Sptr cherry::LightList::GenerateMaterial(std::string vs, std::string fs, const TextureSampler::Sptr& sampler, const std::vector<std::string>& keywords) const
 {
 	if(lights.size() == 0) // no lights
 		return cherry::Material::Sptr();
 
 	Material::Sptr material; // the material
-	Shader::Sptr phong = std::make_shared<Shader>(); // shader
+	Shader::Sptr phong = ShaderCache::Get(vs, fs, keywords); // shader, which is shared by materials with the same variant
 	Texture2D::Sptr albedo = Texture2D::LoadFromFile("res/images/default.png"); // texture
 
 	glm::vec3 temp; // temporary vector
@@ -278,7 +270,6 @@ cherry::Material::Sptr cherry::LightList::GenerateMaterial(std::string vs, std::
 	lightCount = (lights.size() > MAX_LIGHTS) ? MAX_LIGHTS : lights.size();
 
 	// used to make the albedo // TODO: fix shaders
-	phong->Load(vs.c_str(), fs.c_str()); // the shader
 	material = std::make_shared<Material>(phong); // loads in the shader.
 	 
 	material->Set("a_LightCount", lightCount);
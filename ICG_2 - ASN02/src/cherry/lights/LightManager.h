@@ -3,6 +3,7 @@
 
 #include "Light.h"
 #include <vector>
+#include <unordered_map>
 
 // the maximum amount of lights
 // if changed, make sure it is adjusted in the shaders as well.
@@ -65,6 +66,9 @@ namespace cherry
 		// a vector of light list
 		static std::vector<cherry::LightList *> lightLists;
 
+		// the light lists by the name of their scene, which is kept in sync with lightLists.
+		static std::unordered_map<std::string, cherry::LightList*> lightListMap;
+
 	protected:
 
 	};
@@ -100,6 +104,9 @@ namespace cherry
 		// generates the material, providing it with the sampler.
 		cherry::Material::Sptr GenerateMaterial(std::string vs, std::string fs, const TextureSampler::Sptr& sampler) const;
 
+		// generates the material with the sampler, using the variant of the shader with the provided keywords.
+		cherry::Material::Sptr GenerateMaterial(std::string vs, std::string fs, const TextureSampler::Sptr& sampler, const std::vector<std::string>& keywords) const;
+
 		// applies all the lights in the list.
 		void ApplyLights(cherry::Material::Sptr& material);
 
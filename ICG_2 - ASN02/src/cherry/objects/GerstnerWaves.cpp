@@ -0,0 +1,245 @@
+// GerstnerWaves (Source) - evaluates the water shader's gerstner waves on the CPU
+#include "GerstnerWaves.h"
+#include "..\utils\math\Consts.h"
+#include <math.h>
+
+// constructor
+cherry::GerstnerWaves::GerstnerWaves()
+{
+	// flat waves have no steepness, so they don't move the surface.
+	for (unsigned int i = 0; i < GERSTNER_MAX_WAVES; i++)
+		SetWave(i, glm::vec4(1.0F, 0.0F, 0.0F, 1.0F));
+}
+
+// sets a wave
+void cherry::GerstnerWaves::SetWave(unsigned int index, const glm::vec4& wave)
+{
+	if (index >= GERSTNER_MAX_WAVES)
+		return;
+
+	waves[index] = wave;
+	UpdateConstants(index);
+}
+
+// gets a wave
+const glm::vec4& cherry::GerstnerWaves::GetWave(unsigned int index) const { return waves[glm::min(index, (unsigned int)GERSTNER_MAX_WAVES - 1)]; }
+
+// sets the enabled waves
+void cherry::GerstnerWaves::SetEnabledWaves(int waveCount) { enabledWaves = glm::clamp(waveCount, 0, GERSTNER_MAX_WAVES); }
+
+// gets the enabled waves
+int cherry::GerstnerWaves::GetEnabledWaves() const { return enabledWaves; }
+
+// sets the gravity
+void cherry::GerstnerWaves::SetGravity(float gravity)
+{
+	// the shader is given the absolute value.
+	this->gravity = fabsf(gravity);
+
+	for (unsigned int i = 0; i < GERSTNER_MAX_WAVES; i++)
+		UpdateConstants(i);
+}
+
+// gets the gravity
+float cherry::GerstnerWaves::GetGravity() const { return gravity; }
+
+// displaces a point
+glm::vec3 cherry::GerstnerWaves::Displace(const glm::vec2& point, float time, glm::vec3* normal) const
+{
+	glm::vec3 result = glm::vec3(point, 0.0F);
+	glm::vec3 tangent = glm::vec3(1.0F, 0.0F, 0.0F);
+	glm::vec3 binorm = glm::vec3(0.0F, 1.0F, 0.0F);
+
+	for (int ix = 0; ix < enabledWaves; ix++)
+	{
+		const WaveConstants& wave = constants[ix];
+
+		if (!wave.active)
+			continue;
+
+		const glm::vec2& dir = wave.direction;
+
+		// f is how far along in the direction the wave is at the given time
+		float f = wave.k * (glm::dot(dir, point) - wave.speed * time);
+		float sinF = sinf(f);
+		float cosF = cosf(f);
+
+		tangent += glm::vec3(-dir.x * dir.x * (wave.steepness * sinF), -dir.x * dir.y * (wave.steepness * sinF), dir.x * (wave.steepness * cosF));
+		binorm += glm::vec3(-dir.x * dir.y * (wave.steepness * sinF), -dir.y * dir.y * (wave.steepness * sinF), dir.y * (wave.steepness * cosF));
+
+		result += glm::vec3(dir.x * (wave.amplitude * cosF), dir.y * (wave.amplitude * cosF), wave.amplitude * sinF);
+	}
+
+	if (normal != nullptr)
+		*normal = glm::normalize(glm::cross(tangent, binorm));
+
+	return result;
+}
+
+// gets the height above a point
+float cherry::GerstnerWaves::GetHeight(const glm::vec2& point, float time, glm::vec3* normal, int iterations) const
+{
+	// the guess starts at the point, and is moved back by how far the waves moved it.
+	glm::vec2 guess = point;
+
+	for (int i = 0; i < iterations; i++)
+	{
+		glm::vec3 moved = Displace(guess, time);
+		guess -= glm::vec2(moved) - point;
+	}
+
+	return Displace(guess, time, normal).z;
+}
+
+// gets the heights for a batch of points
+void cherry::GerstnerWaves::GetHeights(const float* x, const float* y, size_t count, float time, float* heights,
+	float* normalX, float* normalY, float* normalZ, int iterations) const
+{
+	for (size_t start = 0; start < count; start += GERSTNER_BATCH_SIZE)
+	{
+		size_t blockCount = glm::min(count - start, (size_t)GERSTNER_BATCH_SIZE);
+
+		GetHeightsBlock(x + start, y + start, blockCount, time, heights + start,
+			(normalX != nullptr) ? normalX + start : nullptr,
+			(normalY != nullptr) ? normalY + start : nullptr,
+			(normalZ != nullptr) ? normalZ + start : nullptr, iterations);
+	}
+}
+
+// updates the constants for a wave
+void cherry::GerstnerWaves::UpdateConstants(unsigned int index)
+{
+	const glm::vec4& info = waves[index];
+	WaveConstants& wave = constants[index];
+
+	float dirLength = glm::length(glm::vec2(info));
+
+	// waves without a direction or length can't be normalized, so they're skipped.
+	wave.active = dirLength > 0.0F && info.w != 0.0F && info.z != 0.0F;
+	wave.direction = (dirLength > 0.0F) ? glm::vec2(info) / dirLength : glm::vec2(1.0F, 0.0F);
+	wave.steepness = info.z;
+	wave.k = (info.w != 0.0F) ? 2.0F * (float)M_PI / info.w : 0.0F;
+	wave.speed = (wave.k != 0.0F) ? sqrtf(gravity / wave.k) : 0.0F;
+	wave.amplitude = (wave.k != 0.0F) ? wave.steepness / wave.k : 0.0F;
+}
+
+// does a block of points
+void cherry::GerstnerWaves::GetHeightsBlock(const float* x, const float* y, size_t count, float time, float* heights,
+	float* normalX, float* normalY, float* normalZ, int iterations) const
+{
+	// the guesses for the points on the flat surface.
+	float guessX[GERSTNER_BATCH_SIZE];
+	float guessY[GERSTNER_BATCH_SIZE];
+
+	// the sum of the waves.
+	float offsetX[GERSTNER_BATCH_SIZE];
+	float offsetY[GERSTNER_BATCH_SIZE];
+	float offsetZ[GERSTNER_BATCH_SIZE];
+
+	// the tangent and binormal, minus the z-axis of the tangent and the x-axis of the binormal.
+	// the shader adds the same value to the tangent's y and the binormal's x, so only one of them is kept.
+	float tangentX[GERSTNER_BATCH_SIZE];
+	float tangentZ[GERSTNER_BATCH_SIZE];
+	float binormXY[GERSTNER_BATCH_SIZE];
+	float binormY[GERSTNER_BATCH_SIZE];
+	float binormZ[GERSTNER_BATCH_SIZE];
+
+	for (size_t i = 0; i < count; i++)
+	{
+		guessX[i] = x[i];
+		guessY[i] = y[i];
+	}
+
+	// the last pass also gets the height and normal.
+	for (int pass = 0; pass <= iterations; pass++)
+	{
+		bool last = pass == iterations;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			offsetX[i] = offsetY[i] = offsetZ[i] = 0.0F;
+			tangentX[i] = 1.0F;
+			tangentZ[i] = 0.0F;
+			binormXY[i] = 0.0F;
+			binormY[i] = 1.0F;
+			binormZ[i] = 0.0F;
+		}
+
+		for (int ix = 0; ix < enabledWaves; ix++)
+		{
+			const WaveConstants& wave = constants[ix];
+
+			if (!wave.active)
+				continue;
+
+			const float dirX = wave.direction.x;
+			const float dirY = wave.direction.y;
+			const float k = wave.k;
+			const float phase = wave.speed * time;
+			const float amplitude = wave.amplitude;
+			const float steepness = wave.steepness;
+
+			if (!last)
+			{
+				// only the sideways offset is needed to correct the guesses.
+				for (size_t i = 0; i < count; i++)
+				{
+					float cosF = cosf(k * (dirX * guessX[i] + dirY * guessY[i] - phase));
+
+					offsetX[i] += dirX * (amplitude * cosF);
+					offsetY[i] += dirY * (amplitude * cosF);
+				}
+			}
+			else
+			{
+				for (size_t i = 0; i < count; i++)
+				{
+					float f = k * (dirX * guessX[i] + dirY * guessY[i] - phase);
+					float sinF = sinf(f);
+					float cosF = cosf(f);
+
+					offsetZ[i] += amplitude * sinF;
+
+					tangentX[i] += -dirX * dirX * (steepness * sinF);
+					tangentZ[i] += dirX * (steepness * cosF);
+					binormXY[i] += -dirX * dirY * (steepness * sinF);
+					binormY[i] += -dirY * dirY * (steepness * sinF);
+					binormZ[i] += dirY * (steepness * cosF);
+				}
+			}
+		}
+
+		if (!last)
+		{
+			// moves each guess back by how far it ended up from the point.
+			for (size_t i = 0; i < count; i++)
+			{
+				guessX[i] = x[i] - offsetX[i];
+				guessY[i] = y[i] - offsetY[i];
+			}
+		}
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		heights[i] = offsetZ[i];
+
+		if (normalX == nullptr && normalY == nullptr && normalZ == nullptr)
+			continue;
+
+		// cross(tangent, binorm), where tangent = (tangentX, binormXY, tangentZ) and binorm = (binormXY, binormY, binormZ).
+		glm::vec3 normal = glm::normalize(glm::cross(
+			glm::vec3(tangentX[i], binormXY[i], tangentZ[i]),
+			glm::vec3(binormXY[i], binormY[i], binormZ[i])
+		));
+
+		if (normalX != nullptr)
+			normalX[i] = normal.x;
+
+		if (normalY != nullptr)
+			normalY[i] = normal.y;
+
+		if (normalZ != nullptr)
+			normalZ[i] = normal.z;
+	}
+}
@@ -0,0 +1,84 @@
+// GerstnerWaves (Header) - evaluates the water shader's gerstner waves on the CPU
+#pragma once
+#include <GLM/glm.hpp>
+#include <stddef.h>
+
+// the maximum amount of waves.
+// NOTE: make sure this value aligns with the macro 'MAX_WAVES' in the 'water-shader.vs.glsl'
+#define GERSTNER_MAX_WAVES 8
+
+// the amount of points the batched functions work on at once. The points are done in blocks so that the working data stays on the stack.
+#define GERSTNER_BATCH_SIZE 64
+
+namespace cherry
+{
+	/*
+	 * Mirrors GerstnerWave() in 'water-shader.vs.glsl', so that the surface the GPU draws can be found on the CPU.
+	 * Everything here is in the liquid's local space, where the flat surface is on the xy plane.
+	 * The waves move points sideways as well as up, so finding the height above a point means finding the point on the
+	 * flat surface that moves there. This is done by repeatedly moving the guess back by its sideways offset.
+	 * The batched functions take the points as separate arrays for each axis, and loop over the points inside of each wave.
+	 * This keeps the inner loops simple enough for the compiler to vectorize them (sin and cos included).
+	*/
+	class GerstnerWaves
+	{
+	public:
+		// constructor. All of the waves start off flat.
+		GerstnerWaves();
+
+		// sets a wave (x = x-direction, y = y-direction, z = steepness, w = wave length), which is the same layout as 'a_Waves'.
+		void SetWave(unsigned int index, const glm::vec4& wave);
+
+		// gets a wave.
+		const glm::vec4& GetWave(unsigned int index) const;
+
+		// sets the amount of waves that are used.
+		void SetEnabledWaves(int waveCount);
+
+		// gets the amount of waves that are used.
+		int GetEnabledWaves() const;
+
+		// sets the gravity, which decides how fast the waves move.
+		void SetGravity(float gravity);
+
+		// gets the gravity.
+		float GetGravity() const;
+
+		// moves a point on the flat surface by the waves, which is exactly what the vertex shader does.
+		// if provided, the normal is also calculated.
+		glm::vec3 Displace(const glm::vec2& point, float time, glm::vec3* normal = nullptr) const;
+
+		// gets the height of the surface above a point, and its normal if requested.
+		// 'iterations' is how many times the sideways offset is corrected for.
+		float GetHeight(const glm::vec2& point, float time, glm::vec3* normal = nullptr, int iterations = 3) const;
+
+		// gets the heights and normals for a batch of points. The normal arrays can be nullptr if they're not needed.
+		void GetHeights(const float* x, const float* y, size_t count, float time, float* heights,
+			float* normalX = nullptr, float* normalY = nullptr, float* normalZ = nullptr, int iterations = 3) const;
+
+	private:
+		// the values of a wave that don't change with time.
+		struct WaveConstants
+		{
+			glm::vec2 direction; // normalized direction
+			float steepness;
+			float k; // frequency
+			float speed; // the speed of the wave (c in the shader)
+			float amplitude; // steepness / k (a in the shader)
+			bool active; // 'false' if the wave doesn't move the surface
+		};
+
+		// updates the constants for a wave.
+		void UpdateConstants(unsigned int index);
+
+		// does a block of points (count <= GERSTNER_BATCH_SIZE).
+		void GetHeightsBlock(const float* x, const float* y, size_t count, float time, float* heights,
+			float* normalX, float* normalY, float* normalZ, int iterations) const;
+
+		glm::vec4 waves[GERSTNER_MAX_WAVES];
+		WaveConstants constants[GERSTNER_MAX_WAVES];
+
+		int enabledWaves = GERSTNER_MAX_WAVES;
+		float gravity = 9.807F;
+	};
+}
@@ -0,0 +1,137 @@
+// HeightField (Source) - a height map decoded onto the CPU so that heights can be looked up without the GPU
+#include "HeightField.h"
+#include <stbs/stb_image.h>
+#include <toolkit/Logging.h>
+#include <math.h>
+#include <algorithm>
+
+// loads the height map
+bool cherry::HeightField::LoadFromFile(const std::string& filePath)
+{
+	int w = 0, h = 0, numChannels = 0;
+
+	// the file is read the same way as Texture2D::LoadFromFile() reads it, so that the rows are in the same order.
+	unsigned char* data = stbi_load(filePath.c_str(), &w, &h, &numChannels, 3);
+
+	if (data == nullptr || w <= 0 || h <= 0)
+	{
+		LOG_WARN("Failed to load height field from \"{}\"", filePath);
+
+		if (data != nullptr)
+			stbi_image_free(data);
+
+		return false;
+	}
+
+	width = w;
+	height = h;
+	values.resize((size_t)width * height);
+
+	// only the red channel is used, which is what the terrain shader reads.
+	// the rows are flipped the same way Texture2D::DecodeFile() flips them (see Texture2D::FlipImage()).
+	for (int y = 0; y < height; y++)
+	{
+		const unsigned char* row = data + (size_t)(height - 1 - y) * width * 3;
+
+		for (int x = 0; x < width; x++)
+			values[(size_t)y * width + x] = row[x * 3] / 255.0F;
+	}
+
+	stbi_image_free(data);
+	return true;
+}
+
+// gets a texel
+float cherry::HeightField::GetValue(int x, int y) const
+{
+	if (values.empty())
+		return 0.0F;
+
+	// wrapping the indexes (repeat)
+	x %= width;
+	y %= height;
+
+	if (x < 0)
+		x += width;
+
+	if (y < 0)
+		y += height;
+
+	return values[(size_t)y * width + x];
+}
+
+// samples the field
+float cherry::HeightField::Sample(float u, float v) const
+{
+	if (values.empty())
+		return 0.0F;
+
+	// texel centers are at half texel offsets, which is how linear filtering finds its four texels.
+	float x = u * width - 0.5F;
+	float y = v * height - 0.5F;
+
+	float x0 = floorf(x);
+	float y0 = floorf(y);
+	float tx = x - x0;
+	float ty = y - y0;
+
+	int ix = (int)x0;
+	int iy = (int)y0;
+
+	float bottom = GetValue(ix, iy) * (1.0F - tx) + GetValue(ix + 1, iy) * tx;
+	float top = GetValue(ix, iy + 1) * (1.0F - tx) + GetValue(ix + 1, iy + 1) * tx;
+
+	return bottom * (1.0F - ty) + top * ty;
+}
+
+// gets the range of a region
+void cherry::HeightField::GetRange(float u0, float v0, float u1, float v1, float& minValue, float& maxValue) const
+{
+	minValue = 0.0F;
+	maxValue = 0.0F;
+
+	if (values.empty())
+		return;
+
+	// the texels that can be touched when sampling the region.
+	int x0 = (int)floorf(std::min(u0, u1) * width - 0.5F);
+	int x1 = (int)floorf(std::max(u0, u1) * width - 0.5F) + 1;
+	int y0 = (int)floorf(std::min(v0, v1) * height - 0.5F);
+	int y1 = (int)floorf(std::max(v0, v1) * height - 0.5F) + 1;
+
+	// a region that wraps all of the way around covers every texel.
+	if (x1 - x0 + 1 > width)
+	{
+		x0 = 0;
+		x1 = width - 1;
+	}
+
+	if (y1 - y0 + 1 > height)
+	{
+		y0 = 0;
+		y1 = height - 1;
+	}
+
+	minValue = 1.0F;
+	maxValue = 0.0F;
+
+	for (int y = y0; y <= y1; y++)
+	{
+		for (int x = x0; x <= x1; x++)
+		{
+			float value = GetValue(x, y);
+
+			minValue = std::min(minValue, value);
+			maxValue = std::max(maxValue, value);
+		}
+	}
+}
+
+// gets the width
+uint32_t cherry::HeightField::GetWidth() const { return width; }
+
+// gets the height
+uint32_t cherry::HeightField::GetHeight() const { return height; }
+
+// checks if empty
+bool cherry::HeightField::IsEmpty() const { return values.empty(); }
@@ -0,0 +1,46 @@
+// HeightField (Header) - a height map decoded onto the CPU so that heights can be looked up without the GPU
+#pragma once
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace cherry
+{
+	/*
+	 * The red channel of a height map, stored as values from 0 to 1.
+	 * Sampling matches a texture using linear filtering and repeat wrapping, so the results line up with what the terrain shader reads.
+	*/
+	class HeightField
+	{
+	public:
+		// constructor. The field is empty until a file is loaded.
+		HeightField() = default;
+
+		// loads the height map. Returns 'false' if the image couldn't be loaded, which leaves the field empty.
+		bool LoadFromFile(const std::string& filePath);
+
+		// gets the value of a texel. The indexes wrap around.
+		float GetValue(int x, int y) const;
+
+		// samples the field with bilinear filtering. The coordinates wrap around, like a texture does.
+		// an empty field returns 0.
+		float Sample(float u, float v) const;
+
+		// gets the lowest and highest values that sampling the provided range can return.
+		void GetRange(float u0, float v0, float u1, float v1, float& minValue, float& maxValue) const;
+
+		// gets the width in texels.
+		uint32_t GetWidth() const;
+
+		// gets the height in texels.
+		uint32_t GetHeight() const;
+
+		// returns 'true' if nothing has been loaded.
+		bool IsEmpty() const;
+
+	private:
+		std::vector<float> values; // the values, row by row
+		int width = 0;
+		int height = 0;
+	};
+}
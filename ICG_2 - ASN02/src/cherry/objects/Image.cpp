@@ -1,6 +1,10 @@
 #include "Image.h"
 #include "..\utils\Utils.h"
 
+#include <toolkit/Logging.h>
+
+bool cherry::Image::batching = true;
+
 // TODO: save scene to a string so that UI can carry over
 // creates an iamge by taking in a file path. Images call CreateEntity automatically.
 cherry::Image::Image(std::string filePath, std::string scene, bool doubleSided, bool duplicateFront, bool camLock) :
@@ -119,11 +123,94 @@ const cherry::TextureSampler::Sptr const cherry::Image::GetTextureSampler() cons
 	return sampler;
 }
 
+// sets whether images are batched
+void cherry::Image::SetBatching(bool batch) { batching = batch; }
+
+// checks if images are batched
+bool cherry::Image::IsBatching() { return batching; }
+
+// checks if this image is batched
+bool cherry::Image::IsBatched() const { return region.Page >= 0; }
+
+// gets the atlas region
+const cherry::AtlasRegion& cherry::Image::GetAtlasRegion() const { return region; }
+
+// sets the uvs of a batched image
+bool cherry::Image::SetBatchedUVs(const std::string& file, const glm::vec4& uvs)
+{
+	AtlasRegion fileRegion;
+
+	if (!IsBatched() || !TextureAtlas::Add(file, fileRegion))
+		return false;
+
+	// the image can't switch pages, since the page is its material.
+	if (fileRegion.Page != region.Page)
+		return false;
+
+	glm::vec4 pageUVs = TextureAtlas::ConvertToPageUVs(fileRegion, uvs);
+
+	// the four vertices (guaranteed)
+	vertices[0].UV = glm::vec2(pageUVs.x, pageUVs.y); // bottom left
+	vertices[1].UV = glm::vec2(pageUVs.z, pageUVs.y); // bottom right
+	vertices[2].UV = glm::vec2(pageUVs.x, pageUVs.w); // top left
+	vertices[3].UV = glm::vec2(pageUVs.z, pageUVs.w); // top right
+
+	// extra four vertices (only present if front is duplicated on the back)
+	if (duplicatedFront)
+	{
+		vertices[4].UV = vertices[1].UV;
+		vertices[5].UV = vertices[0].UV;
+		vertices[6].UV = vertices[3].UV;
+		vertices[7].UV = vertices[2].UV;
+	}
+
+	mesh->SetSpriteData(vertices, verticesTotal, indices, indicesTotal);
+	mesh->SetSpriteFrame(SpriteFrame()); // the uvs are already on the page.
+	return true;
+}
+
+// uses batched frames
+bool cherry::Image::UseBatchedFrames()
+{
+	if (!IsBatched())
+		return false;
+
+	// the four vertices (guaranteed)
+	vertices[0].UV = glm::vec2(0.0F, 0.0F); // bottom left
+	vertices[1].UV = glm::vec2(1.0F, 0.0F); // bottom right
+	vertices[2].UV = glm::vec2(0.0F, 1.0F); // top left
+	vertices[3].UV = glm::vec2(1.0F, 1.0F); // top right
+
+	// extra four vertices (only present if front is duplicated on the back)
+	if (duplicatedFront)
+	{
+		vertices[4].UV = vertices[1].UV;
+		vertices[5].UV = vertices[0].UV;
+		vertices[6].UV = vertices[3].UV;
+		vertices[7].UV = vertices[2].UV;
+	}
+
+	mesh->SetSpriteData(vertices, verticesTotal, indices, indicesTotal);
+	return true;
+}
+
 // sets the alpha value for the image.
 void cherry::Image::SetAlpha(float a)
 {
 	alpha = (a < 0.0F) ? 0.0F : (a > 1.0F) ? 1.0F : a;
 
+	// batched images share their material, so the alpha is put in the vertex colours instead.
+	if (IsBatched())
+	{
+		for (unsigned int i = 0; i < verticesTotal; i++)
+			vertices[i].Color.a = alpha;
+
+		if (mesh != nullptr)
+			mesh->SetSpriteData(vertices, verticesTotal, indices, indicesTotal);
+
+		return;
+	}
+
 	// if the image doesn't have a 100% alpha value, then it won't need to be sorted for proper transparency.
 	// however, if the image inherently has transparency (i.e. if it's a png), then transparency is left on.
 	if (alpha < 1.0F || util::equalsIgnoreCase(filePath.substr(filePath.find_last_of(".") + 1), "png"))
@@ -137,15 +224,34 @@ void cherry::Image::SetAlpha(float a)
 // loads an image
 bool cherry::Image::LoadImage(std::string scene, cherry::Vec2 size, cherry::Vec4 uvs)
 {
-	// gets the iamge
-	// NOTE: if the image is too large, the process will fail.
-	Texture2D::Sptr img = Texture2D::LoadFromFile(filePath);
+	Texture2D::Sptr img = nullptr;
+	glm::u32vec2 imageSize; // the size of the whole image.
+
+	// small images are put into the atlas, so that they share a texture (and a material) with the other images on the page.
+	if (batching && TextureAtlas::Add(filePath, region))
+	{
+		imageSize = region.Size;
+	}
+	else
+	{
+		// gets the iamge
+		// NOTE: if the image is too large, the process will fail.
+		img = Texture2D::LoadFromFile(filePath);
+		imageSize = glm::u32vec2(img->GetWidth(), img->GetHeight());
+		region = AtlasRegion();
+	}
+
+	// the uvs for the texture. If the image is in the atlas, they're moved to its region of the page.
+	glm::vec4 texUVs = glm::vec4(uvs.v.x, uvs.v.y, uvs.v.z, uvs.v.w);
+
+	if (IsBatched())
+		texUVs = TextureAtlas::ConvertToPageUVs(region, texUVs);
 
 	// the four uvs
-	glm::vec2 uvBL(uvs.v.x, uvs.v.y); // (0, 0)
-	glm::vec2 uvBR(uvs.v.z, uvs.v.y); // (1, 0)
-	glm::vec2 uvTL(uvs.v.x, uvs.v.w); // (0, 1)
-	glm::vec2 uvTR(uvs.v.z, uvs.v.w); // (1, 1)
+	glm::vec2 uvBL(texUVs.x, texUVs.y); // (0, 0)
+	glm::vec2 uvBR(texUVs.z, texUVs.y); // (1, 0)
+	glm::vec2 uvTL(texUVs.x, texUVs.w); // (0, 1)
+	glm::vec2 uvTR(texUVs.z, texUVs.w); // (1, 1)
 
 	// TODO: make a shader that doesn't use lighting but has textures?
 	// mapping the image to the plane
@@ -160,18 +266,18 @@ bool cherry::Image::LoadImage(std::string scene, cherry::Vec2 size, cherry::Vec4
 		(uvs.v.x != 0 || uvs.v.y != 0 || uvs.v.z != 1 || uvs.v.w != 1))
 	{
 		// if the whole image isn't being used, then the uvs are used to make the image size. 
-		dimensions.x = img->GetWidth() * uvs.v.z - img->GetWidth() * uvs.v.x;
-		dimensions.y = img->GetHeight() * uvs.v.w - img->GetHeight() * uvs.v.y;
+		dimensions.x = imageSize.x * uvs.v.z - imageSize.x * uvs.v.x;
+		dimensions.y = imageSize.y * uvs.v.w - imageSize.y * uvs.v.y;
 	}
 	else // whole image is to be used.
 	{
-		dimensions = glm::u32vec2(img->GetWidth(), img->GetHeight());
+		dimensions = imageSize;
 	}
 	
 	// image is too large to be loaded.
 	if(dimensions.x > GetMaximumSideLength() || dimensions.y > GetMaximumSideLength())
 	{
-		std::cout << "File too large to be read." << std::endl;
+		LOG_WARN("Image \"{}\" is too large to be read ({} x {}).", filePath, dimensions.x, dimensions.y);
 		safe = false;
 	}
 
@@ -253,39 +359,47 @@ bool cherry::Image::LoadImage(std::string scene, cherry::Vec2 size, cherry::Vec4
 	
 	
 	// MAPPING THE TEXTURE
-	// texture description and sampler
-	description = SamplerDesc();
-	description.MinFilter = MinFilter::LinearMipNearest;
-	description.MagFilter = MagFilter::Linear;
+	if (IsBatched())
+	{
+		// batched images are drawn from a copy of the mesh, using the material of their atlas page.
+		mesh->SetSpriteData(vertices, verticesTotal, indices, indicesTotal);
+		material = TextureAtlas::GetPageMaterial(region.Page);
+	}
+	else
+	{
+		// texture description and sampler
+		description = SamplerDesc();
+		description.MinFilter = MinFilter::LinearMipNearest;
+		description.MagFilter = MagFilter::Linear;
 
-	sampler = std::make_shared<TextureSampler>(description);
+		sampler = std::make_shared<TextureSampler>(description);
 
 
-	shader = std::make_shared<Shader>();
-	
-	// no lighting is applied.
-	// TODO: remove this?
-	if (cameraLock)
-	{
-		shader->Load("res/shaders/image.vs.glsl", "res/shaders/image.fs.glsl");
+		shader = std::make_shared<Shader>();
 
-		material = std::make_shared<Material>(shader);
+		// no lighting is applied.
+		// TODO: remove this?
+		if (cameraLock)
+		{
+			shader->Load("res/shaders/image.vs.glsl", "res/shaders/image.fs.glsl");
 
-		material->Set("s_Albedos[0]", img, sampler);
-		material->Set("s_Albedos[1]", img, sampler);
-		material->Set("s_Albedos[2]", img, sampler);
-	}
-	else
-	{
-		shader->Load("res/shaders/image.vs.glsl", "res/shaders/image.fs.glsl");
+			material = std::make_shared<Material>(shader);
 
-		material = std::make_shared<Material>(shader);
+			material->Set("s_Albedos[0]", img, sampler);
+			material->Set("s_Albedos[1]", img, sampler);
+			material->Set("s_Albedos[2]", img, sampler);
+		}
+		else
+		{
+			shader->Load("res/shaders/image.vs.glsl", "res/shaders/image.fs.glsl");
 
-		material->Set("s_Albedos[0]", img, sampler);
-		material->Set("s_Albedos[1]", img, sampler);
-		material->Set("s_Albedos[2]", img, sampler);
-	}
+			material = std::make_shared<Material>(shader);
 
+			material->Set("s_Albedos[0]", img, sampler);
+			material->Set("s_Albedos[1]", img, sampler);
+			material->Set("s_Albedos[2]", img, sampler);
+		}
+	}
 
 	// TODO: should probably do error checking, but this is fine for now.
 	if (util::equalsIgnoreCase(filePath.substr(filePath.find_last_of(".") + 1), "png"))
@@ -1,6 +1,7 @@
 // Image (Header) - loads in an image, which is mapped to a plane.
 #pragma once
 #include "Object.h"
+#include "..\textures\TextureAtlas.h"
 
 namespace cherry
 {
@@ -97,8 +98,33 @@ namespace cherry
 		bool HasDuplicatedFront() const;
 
 		// gets the texture sampler
+		// if the image is batched, this is nullptr, since the atlas page has its own sampler.
 		const cherry::TextureSampler::Sptr const GetTextureSampler() const;
 
+		// sets whether new images should be put into the texture atlas and drawn in sprite batches.
+		// images that are too large for the atlas (see TEXTURE_ATLAS_MAX_SIDE) always get their own texture.
+		static void SetBatching(bool batch);
+
+		// returns 'true' if new images are put into the texture atlas.
+		static bool IsBatching();
+
+		// returns 'true' if this image is in the texture atlas, and is drawn in a sprite batch.
+		bool IsBatched() const;
+
+		// gets the atlas region the image is in. If the image isn't batched, the page is -1.
+		const cherry::AtlasRegion& GetAtlasRegion() const;
+
+		// sets the uvs of a batched image to part of the provided file, which is put into the atlas if it isn't already.
+		// the uvs are (x0, y0, x1, y1) for the file (0 - 1), and are converted to the atlas page.
+		// returns 'false' if the image isn't batched, or if the file isn't on the same atlas page as the image.
+		// this also resets the mesh's sprite frame (see UseBatchedFrames()).
+		bool SetBatchedUVs(const std::string& file, const glm::vec4& uvs);
+
+		// changes the uvs of a batched image to the corners of the quad (0 - 1), which the sprite batch moves into the mesh's sprite frame.
+		// after this, the image is changed with Mesh::SetSpriteFrame() (using uvs on the atlas page) instead of rewriting the vertices.
+		// returns 'false' if the image isn't batched.
+		bool UseBatchedFrames();
+
 		// sets the alpha value.
 		void SetAlpha(float a) override;
 
@@ -121,6 +147,12 @@ namespace cherry
 
 		TextureSampler::Sptr sampler;
 
+		// the region of the atlas the image is in.
+		cherry::AtlasRegion region;
+
+		// if 'true', new images are put into the atlas.
+		static bool batching;
+
 		// becomes 'true' if the image is double sided.
 		bool doubleSided = false;
 
@@ -1,9 +1,10 @@
 #include "Liquid.h"
+#include <GLFW/glfw3.h>
 #include <string>
 
 // the maximum amount of waves.
 // NOTE: make sure this value aligns with the macro 'MAX_WAVES' in the 'water-shader.vs.glsl'
-const int cherry::Liquid::MAX_WAVES = 8;
+const int cherry::Liquid::MAX_WAVES = GERSTNER_MAX_WAVES;
 
 // constructor
 cherry::Liquid::Liquid(std::string scene, float size, float numSections, bool worldUVs)
@@ -26,6 +27,13 @@ cherry::Liquid::Liquid(std::string scene, float size, float numSections, bool wo
 	material = std::make_shared<Material>(liquidShader);
 	material->HasTransparency = true;
 
+	// the shader's wave values are set so that they start off the same as the CPU's (flat waves).
+	SetGravity(gravity);
+	SetEnabledWaves(enabledWaves);
+
+	for (int i = 0; i < MAX_WAVES; i++)
+		SetWave(i, 1.0F, 0.0F, 0.0F, 1.0F);
+
 
 	// the wave calculation doesn't save the vertices, so the calculation is done here.
 	// the mesh body
@@ -64,6 +72,7 @@ void cherry::Liquid::SetEnabledWaves(int waveCount)
 
 	material->Set("a_EnabledWaves", waveCount);
 	enabledWaves = waveCount;
+	waves.SetEnabledWaves(waveCount);
 }
 
 // returns the gravity value
@@ -74,6 +83,7 @@ void cherry::Liquid::SetGravity(float gravity)
 {
 	material->Set("a_Gravity", abs(gravity));
 	this->gravity = gravity;
+	waves.SetGravity(gravity);
 }
 
 // gets the maximum amount of waves allowed.
@@ -86,7 +96,85 @@ void cherry::Liquid::SetWave(unsigned int waveNum, float xDir, float yDir, float
 		return;
 
 	material->Set("a_Waves[" + std::to_string(waveNum) + "]", {xDir, yDir, steepness, waveLength});
+	waves.SetWave(waveNum, glm::vec4(xDir, yDir, steepness, waveLength));
+}
+
+// gets the waves
+const cherry::GerstnerWaves& cherry::Liquid::GetWaves() const { return waves; }
+
+// gets the wave time
+float cherry::Liquid::GetWaveTime() { return static_cast<float>(glfwGetTime()); }
+
+// gets the height at a world position
+float cherry::Liquid::GetHeightAt(float x, float y) const
+{
+	float height = 0.0F;
 
+	GetHeightsAt(&x, &y, 1, &height);
+	return height;
+}
+
+// gets the normal at a world position
+glm::vec3 cherry::Liquid::GetNormalAt(float x, float y) const
+{
+	float height = 0.0F;
+	glm::vec3 normal;
+
+	GetHeightsAt(&x, &y, 1, &height, &normal.x, &normal.y, &normal.z);
+	return normal;
+}
+
+// gets the heights at a batch of world positions
+void cherry::Liquid::GetHeightsAt(const float* x, const float* y, size_t count, float* heights,
+	float* normalX, float* normalY, float* normalZ) const
+{
+	glm::mat4 world = CalculateWorldTransformation();
+	glm::mat4 worldInv = glm::inverse(world);
+	glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(world)));
+	bool normals = normalX != nullptr || normalY != nullptr || normalZ != nullptr;
+	float time = GetWaveTime();
+
+	// the points are moved into local space in blocks, so that the waves can do each block at once.
+	float localX[GERSTNER_BATCH_SIZE];
+	float localY[GERSTNER_BATCH_SIZE];
+	float localHeights[GERSTNER_BATCH_SIZE];
+	float localNormalX[GERSTNER_BATCH_SIZE];
+	float localNormalY[GERSTNER_BATCH_SIZE];
+	float localNormalZ[GERSTNER_BATCH_SIZE];
+
+	for (size_t start = 0; start < count; start += GERSTNER_BATCH_SIZE)
+	{
+		size_t blockCount = glm::min(count - start, (size_t)GERSTNER_BATCH_SIZE);
+
+		for (size_t i = 0; i < blockCount; i++)
+		{
+			localX[i] = worldInv[0][0] * x[start + i] + worldInv[1][0] * y[start + i] + worldInv[3][0];
+			localY[i] = worldInv[0][1] * x[start + i] + worldInv[1][1] * y[start + i] + worldInv[3][1];
+		}
+
+		waves.GetHeights(localX, localY, blockCount, time, localHeights,
+			(normals) ? localNormalX : nullptr, (normals) ? localNormalY : nullptr, (normals) ? localNormalZ : nullptr);
+
+		for (size_t i = 0; i < blockCount; i++)
+		{
+			// the surface point is above the local point, so only the height needs to be put back into world space.
+			heights[start + i] = world[0][2] * localX[i] + world[1][2] * localY[i] + world[2][2] * localHeights[i] + world[3][2];
+
+			if (!normals)
+				continue;
+
+			glm::vec3 normal = glm::normalize(normalMatrix * glm::vec3(localNormalX[i], localNormalY[i], localNormalZ[i]));
+
+			if (normalX != nullptr)
+				normalX[start + i] = normal.x;
+
+			if (normalY != nullptr)
+				normalY[start + i] = normal.y;
+
+			if (normalZ != nullptr)
+				normalZ[start + i] = normal.z;
+		}
+	}
 }
 
 // gets the alpha value of the wave.
@@ -1,6 +1,7 @@
 // used for creating liquids
 #pragma once
 #include "Object.h"
+#include "GerstnerWaves.h"
 
 namespace cherry
 {
@@ -43,6 +44,24 @@ namespace cherry
 		*/
 		void SetWave(unsigned int waveNum, float xDir, float yDir, float steepness, float waveLength);
 
+		// gets the waves, which find the surface on the CPU using the same maths as the shader (in local space).
+		const cherry::GerstnerWaves& GetWaves() const;
+
+		// gets the time the waves are at, which is the same value the shader gets as 'a_Time'.
+		static float GetWaveTime();
+
+		// gets the height of the surface (in world space) above the provided world position.
+		// the liquid is on its local xy plane, so (x, y) are the world coordinates on the surface. This assumes the liquid hasn't been tilted.
+		float GetHeightAt(float x, float y) const;
+
+		// gets the normal of the surface (in world space) above the provided world position.
+		glm::vec3 GetNormalAt(float x, float y) const;
+
+		// gets the heights (and normals) of the surface above a batch of world positions. The normal arrays can be nullptr.
+		// this is much faster than calling GetHeightAt() for each point.
+		void GetHeightsAt(const float* x, const float* y, size_t count, float* heights,
+			float* normalX = nullptr, float* normalY = nullptr, float* normalZ = nullptr) const;
+
 		// gets the alpha value of the wave
 		float GetAlpha() const override;
 
@@ -90,6 +109,7 @@ namespace cherry
 		cherry::TextureCube::Sptr GetEnvironment() const;
 
 		// sets the environment (skybox) the water part of.
+		// the reflections and refractions are sampled from the cube map's mipmaps (see TextureCube), so the waves don't make them shimmer.
 		void SetEnvironment(TextureCube::Sptr skyboxTexture); // the environment (skybox) for the water.
 
 		// update
@@ -106,6 +126,8 @@ namespace cherry
 
 		float gravity = 9.807F; // wave gravity
 
+		cherry::GerstnerWaves waves; // the waves on the CPU
+
 		// save vertex count and wave count?
 		// float size
 		// float numSections
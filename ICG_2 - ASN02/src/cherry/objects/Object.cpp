@@ -3,10 +3,13 @@
 #include "..\utils\Utils.h"
 #include "..\utils\math\Rotation.h"
 #include "..\physics/PhysicsBody.h"
+#include "..\physics/PhysicsWorld.h"
+#include "..\physics/BVH.h"
 #include "..\WorldTransform.h"
 
 #include "..\scenes/SceneManager.h"
 #include "..\MeshRenderer.h"
+#include "..\HotReload.h"
 #include "ObjectManager.h"
 
 #include <iostream>
@@ -14,6 +17,7 @@
 #include <glm/gtc/quaternion.hpp> 
 #include <glm/gtx/quaternion.hpp>
 #include <GLM/gtc/matrix_transform.hpp>
+#include <toolkit/Logging.h>
 
 #include "..\Game.h"
 
@@ -23,9 +27,12 @@ const unsigned int cherry::Object::VERTICES_MAX = pow(2, 32);
 // the maximum amount of indices; this value isn't used
 const unsigned int cherry::Object::INDICES_MAX = pow(2, 32);
 
+// the .obj files that have been read by scene preloads
+std::unordered_map<std::string, cherry::ObjFileData> cherry::Object::preloadedObjFiles;
+
 // constructor - gets the filename and opens it.
 cherry::Object::Object(std::string filePath, bool loadMtl, bool dynamicObj) 
-	: position(), vertices(nullptr), indices(nullptr), dynamicObject(dynamicObj)
+	: vertices(nullptr), indices(nullptr), dynamicObject(dynamicObj)
 {
 	this->filePath = filePath; // saves the file path
 
@@ -121,8 +128,7 @@ cherry::Object::Object(const cherry::Object& obj)
 	memcpy(vertices, obj.GetVertices(), sizeof(Vertex) * verticesTotal);
 	memcpy(indices, obj.GetIndices(), sizeof(uint32_t) * indicesTotal);
 
-	path = obj.GetPath();
-	followPath = obj.followPath;
+	localPath = obj.GetComponent(obj.localPath);
 	dynamicObject = obj.IsDynamicObject();
 
 	meshBodyMax = obj.GetMeshBodyMaximum();
@@ -130,9 +136,7 @@ cherry::Object::Object(const cherry::Object& obj)
 
 	filePath = obj.GetFilePath();
 
-	position = obj.GetPosition();
-	scale = obj.GetScale();
-	rotation = obj.GetRotationDegrees();
+	localTransform = obj.GetTransform();
 	
 	// copying the animation manager.
 	animations = obj.animations;
@@ -172,7 +176,7 @@ cherry::Object::Object(const cherry::Object& obj)
 }
 
 // the protected constructor used for default primitives
-cherry::Object::Object() : position(), vertices(nullptr), indices(nullptr) { filePath = ""; }
+cherry::Object::Object() : vertices(nullptr), indices(nullptr) { filePath = ""; }
 
 cherry::Object::~Object()
 {
@@ -183,11 +187,16 @@ cherry::Object::~Object()
 	delete[] indices; 
 	// indices = nullptr;
 
+	delete meshBVH;
+
 	// deleting all of the physics bodies
 	for (PhysicsBody* body : bodies)
 		delete body;
 
 	bodies.clear();
+
+	// removes the entity so that it's no longer drawn.
+	DestroyEntity();
 }
 
 
@@ -213,7 +222,14 @@ void cherry::Object::SetScene(std::string newScene)
 std::string cherry::Object::GetName() const { return name; }
 
 // sets the name of the object.
-void cherry::Object::SetName(std::string newName) { name = newName; }
+void cherry::Object::SetName(std::string newName)
+{
+	std::string oldName = name;
+	name = newName;
+
+	// the object list finds objects by name, so it needs to know the name has changed.
+	ObjectManager::UpdateObjectName(this, oldName);
+}
 
 // gets the object description
 std::string cherry::Object::GetDescription() const { return description; }
@@ -254,6 +270,89 @@ unsigned int cherry::Object::GetIndicesTotal() const { return indicesTotal; }
 // returns a pointer to the mesh.
 cherry::Mesh::Sptr& cherry::Object::GetMesh() { return mesh; }
 
+// reloads the mesh
+bool cherry::Object::ReloadMesh()
+{
+	if (filePath == "")
+		return false;
+
+	// the morph targets were made from the old vertices.
+	if (dynamicObject)
+	{
+		LOG_WARN("Object \"{}\" has morph targets, so it wasn't reloaded.", name);
+		return false;
+	}
+
+	// the old values, which are put back if the load fails.
+	Vertex* oldVertices = vertices;
+	uint32_t* oldIndices = indices;
+	unsigned int oldVerticesTotal = verticesTotal;
+	unsigned int oldIndicesTotal = indicesTotal;
+	Mesh::Sptr oldMesh = mesh;
+	cherry::Vec3 oldMax = meshBodyMax;
+	cherry::Vec3 oldMin = meshBodyMin;
+
+	// the name is used to find the object in its list, so it shouldn't be changed by the file.
+	const std::string oldName = name;
+	const std::string oldDesc = description;
+
+	vertices = nullptr;
+	indices = nullptr;
+	bool loaded = false;
+
+	try
+	{
+		loaded = LoadObject(false);
+	}
+	catch (const std::exception& e)
+	{
+		LOG_WARN("Reloading \"{}\" failed: {}", filePath, e.what());
+		loaded = false;
+	}
+
+	name = oldName;
+	description = oldDesc;
+
+	if (!loaded)
+	{
+		delete[] vertices;
+		delete[] indices;
+
+		vertices = oldVertices;
+		indices = oldIndices;
+		verticesTotal = oldVerticesTotal;
+		indicesTotal = oldIndicesTotal;
+		mesh = oldMesh;
+		meshBodyMax = oldMax;
+		meshBodyMin = oldMin;
+		safe = true;
+
+		return false;
+	}
+
+	delete[] oldVertices;
+	delete[] oldIndices;
+
+	// the hierarchy was built from the old triangles.
+	delete meshBVH;
+	meshBVH = nullptr;
+
+	// the entity draws the new mesh from the next frame onwards.
+	if (registry != nullptr && registry->valid(entity))
+		registry->get<MeshRenderer>(entity).Mesh = mesh;
+
+	return true;
+}
+
+// gets the mesh hierarchy
+const cherry::MeshBVH* cherry::Object::GetMeshBVH()
+{
+	if (meshBVH == nullptr && vertices != nullptr && indices != nullptr && indicesTotal >= 3)
+		meshBVH = new MeshBVH(vertices, verticesTotal, indices, indicesTotal);
+
+	return meshBVH;
+}
+
 // gets the material
 const cherry::Material::Sptr& cherry::Object::GetMaterial() const { return material; }
 
@@ -319,11 +418,11 @@ void cherry::Object::SetPostProcess(bool postProcess)
 
 
 // creates the object.
-bool cherry::Object::LoadObject(bool loadMtl)
+// reads a .obj file
+bool cherry::Object::ParseObjFile(const std::string& filePath, ObjFileData& data)
 {
 	std::ifstream file; // file
 	std::string line = ""; // the current line of the file.
-	std::string mtllib = ""; // if 'mtllib' isn't empty, then that means a material was found and can be created.
 
 	std::vector<float> tempVecFlt; // a temporary float vector. Used to save the results of a parsing operation.
 	std::vector<uint32_t>tempVecUint; // temporary vector for uin32_t data. Saves information from parsing operation.
@@ -345,9 +444,8 @@ bool cherry::Object::LoadObject(bool loadMtl)
 	// if the file is closed.
 	if (!file || !file.is_open())
 	{
-		std::cout << "File not open. Error encountered." << std::endl;
-		safe = false;
-		return safe;
+		LOG_WARN("Object file \"{}\" could not be opened.", filePath);
+		return false;
 	}
 
 	// while there are still lines to receive from the file.
@@ -360,18 +458,18 @@ bool cherry::Object::LoadObject(bool loadMtl)
 		if(line.substr(0, line.find_first_of(" ")) == "o")
 		{
 			// if the line gotten is the name, it is saved into the name string.
-			name = line.substr(2);
+			data.Name = line.substr(2);
 		}
 		// comment; this is added to the object description
 		else if (line.substr(0, line.find_first_of(" ")) == "#")
 		{
-			description += line.substr(2);
+			data.Description += line.substr(2);
 			continue;
 		}
 		// material template library
 		else if (line.substr(0, line.find_first_of(" ")) == "mtllib")
 		{
-			mtllib = line.substr(line.find_first_of(" ") + 1); // saving the material
+			data.MtlLib = line.substr(line.find_first_of(" ") + 1); // saving the material
 		}
 		// vertex
 		else if (line.substr(0, line.find_first_of(" ")) == "v")
@@ -440,14 +538,13 @@ bool cherry::Object::LoadObject(bool loadMtl)
 
 	// vertices and indices
 	{
-		verticesTotal = vertIndices.size(); // gets the total amount of vertices, which is currenty based on the total amount of indices.
-		vertices = new Vertex[verticesTotal]; // making the dynamic array of vertices
+		// the amount of vertices is currently based on the total amount of indices.
+		data.Vertices.resize(vertIndices.size());
 
 		// if (verticesTotal > VERTICES_MAX) // if it exceeds the limit, it is set at the limit; not used
 			// verticesTotal = VERTICES_MAX;
 
-		indicesTotal = vertIndices.size(); // gets the total number of indices.
-		indices = new uint32_t[indicesTotal]; // creates the dynamic array
+		data.Indices.resize(vertIndices.size());
 
 		// if (indicesTotal > INDICES_MAX) // if it exceeds the limit, it is set at the limit; not used
 		// indicesTotal > INDICES_MAX;
@@ -455,8 +552,8 @@ bool cherry::Object::LoadObject(bool loadMtl)
 		// puts the vertices into the dynamic vertex buffer array.
 		for (int i = 0; i < vertIndices.size(); i++)
 		{
-			vertices[i] = vertVec[vertIndices[i] - 1];
-			indices[i] = vertIndices[i]; // vector.data() caused issues with deletion, so this version is being used instead.
+			data.Vertices[i] = vertVec[vertIndices[i] - 1];
+			data.Indices[i] = vertIndices[i];
 		}
 	}
 
@@ -467,7 +564,7 @@ bool cherry::Object::LoadObject(bool loadMtl)
 		for (int i = 0; i < normIndices.size(); i++)
 		{
 			// adding the normal to the vertex
-			vertices[i].Normal = vnVec.at(normIndices[i] - 1);
+			data.Vertices[i].Normal = vnVec.at(normIndices[i] - 1);
 		}
 	}
 
@@ -478,12 +575,53 @@ bool cherry::Object::LoadObject(bool loadMtl)
 		for (int i = 0; i < textIndices.size(); i++)
 		{
 			// adding the uvs to the designated vertices
-			vertices[i].UV = vtVec.at(textIndices.at(i) - 1);
+			data.Vertices[i].UV = vtVec.at(textIndices.at(i) - 1);
 		}
 	}
 
+	return true;
+}
+
+bool cherry::Object::LoadObject(bool loadMtl)
+{
+	std::string mtllib = ""; // if 'mtllib' isn't empty, then that means a material was found and can be created.
+	ObjFileData data;
+
+	// the file was already read by a scene preload.
+	std::unordered_map<std::string, ObjFileData>::iterator iter = preloadedObjFiles.find(filePath);
+
+	if (iter != preloadedObjFiles.end())
+	{
+		data = iter->second;
+	}
+	else if (!ParseObjFile(filePath, data))
+	{
+		safe = false;
+		return safe;
+	}
+
+	name = data.Name;
+	description += data.Description;
+	mtllib = data.MtlLib;
+
+	// vertices and indices
+	{
+		verticesTotal = data.Vertices.size(); // gets the total amount of vertices, which is currenty based on the total amount of indices.
+		vertices = new Vertex[verticesTotal]; // making the dynamic array of vertices
+
+		indicesTotal = data.Indices.size(); // gets the total number of indices.
+		indices = new uint32_t[indicesTotal]; // creates the dynamic array
+
+		// vector.data() caused issues with deletion, so the values are copied instead.
+		std::copy(data.Vertices.begin(), data.Vertices.end(), vertices);
+		std::copy(data.Indices.begin(), data.Indices.end(), indices);
+	}
+
 	CalculateMeshBody(); // calculates the limits of the mesh body.
 
+	// the file is checked for changes so that the mesh can be reloaded.
+	HotReload::Watch(filePath);
+
 	// creates the mesh
 	// unlike with the default primitives, the amount of vertices corresponds to how many Indices there are, and the values are set accordingly.
 	
@@ -503,13 +641,19 @@ bool cherry::Object::LoadObject(bool loadMtl)
 
 		// generates the material. The version generated depends on whether the object uses morph targets or not.
 		material = (dynamicObject) ?
-			Material::GenerateMtl(mtllib, nullptr, DYNAMIC_VS, DYNAMIC_FS) :
+			Material::GenerateMtl(mtllib, nullptr, STATIC_VS, STATIC_FS, { MORPH_KEYWORD }) :
 			Material::GenerateMtl(mtllib, nullptr, STATIC_VS, STATIC_FS);
 	}
 
 	return (safe = true); // returns whether the object was safely loaded.
 }
 
+// adds a preloaded .obj file
+void cherry::Object::AddPreloadedObjFile(const std::string& filePath, ObjFileData data) { preloadedObjFiles[filePath] = std::move(data); }
+
+// removes a preloaded .obj file
+void cherry::Object::RemovePreloadedObjFile(const std::string& filePath) { preloadedObjFiles.erase(filePath); }
+
 // parses a string to get all the values from it as data type (T).
 template<typename T>
 const std::vector<T> cherry::Object::parseStringForTemplate(std::string str, bool containsSymbol)
@@ -530,87 +674,110 @@ const std::vector<T> cherry::Object::parseStringForTemplate(std::string str, boo
 // creates an entity with the provided m_Scene.
 void cherry::Object::CreateEntity(std::string scene, cherry::Material::Sptr material)
 {
+	// removes the entity from the previous scene. Its transform, path, and target are saved to the object's own copies.
+	DestroyEntity();
+
 	this->scene = scene; // saves the scene
 	this->material = material; // saves the material.
 	
 	SetAlpha(alpha); // sets the alpha for the entity, which is by default 1.0 (full opacity).
 
-	// sets up the Update function for the entity. This gets automatically called.
 	auto& ecs = GetRegistry(scene);
 
 	// the entity to be set.
-	entt::entity entity = ecs.create();
-
+	entity = ecs.create();
+	registry = &ecs;
 
 	MeshRenderer& mr = ecs.assign<MeshRenderer>(entity);
 	mr.Material = this->material;
 	
 	mr.Mesh = mesh;
 
-	auto tform = [&](entt::entity e, float dt) 
+	// the transform, path, and target are stored on the entity, and are updated by ObjectSystems.
+	ecs.assign<TempTransform>(entity, localTransform);
+	ecs.assign<PathFollower>(entity, localPath);
+	ecs.assign<TargetFollower>(entity, localTarget);
+	ObjectSystems::UpdateTags(ecs, entity);
+}
+
+// destroys the entity
+void cherry::Object::DestroyEntity()
+{
+	// the registry is deleted with the scene, so it can only be used if the scene still exists.
+	if (registry != nullptr && SceneManager::HasScene(scene) && registry->valid(entity))
 	{
-		auto& transform = CurrentRegistry().get_or_assign<TempTransform>(e);
+		// the object's own copies are updated, in case the entity is made again.
+		localTransform = registry->get<TempTransform>(entity);
+		localPath = registry->get<PathFollower>(entity);
+		localTarget = registry->get<TargetFollower>(entity);
 
-		transform.Position = glm::vec3(position.v.x, position.v.y, position.v.z); // updates the position
-		transform.EulerRotation = glm::vec3(rotation.v.x, rotation.v.y, rotation.v.z); // updates the rotation
-		transform.Scale = glm::vec3(scale.v.x, scale.v.y, scale.v.z); // sets the scale
-		
-		worldTransform = transform.GetWorldTransform();
-		// does the same thing, except all in one line (for rotation)
-		// CurrentRegistry().get_or_assign<TempTransform>(e).EulerRotation += glm::vec3(0, 0, 90 * dt);
-	};
+		registry->destroy(entity);
+	}
 
-	auto& up = ecs.get_or_assign<UpdateBehaviour>(entity);
-	up.Function = tform;
+	registry = nullptr;
+	entity = entt::null;
 }
 
+// gets the entity
+entt::entity cherry::Object::GetEntity() const { return entity; }
+
+// gets the transform
+cherry::TempTransform& cherry::Object::GetTransform() { return GetComponent(localTransform); }
+
+// gets the transform
+const cherry::TempTransform& cherry::Object::GetTransform() const { return GetComponent(localTransform); }
+
 // gets the transformation into world space.
-glm::mat4 cherry::Object::GetWorldTransformation() const { return worldTransform; }
+glm::mat4 cherry::Object::GetWorldTransformation() const { return GetTransform().GetWorldTransform(); }
+
+// calculates the transformation into world space.
+glm::mat4 cherry::Object::CalculateWorldTransformation() const { return GetWorldTransformation(); }
 
 // gets the entity of the object
 // entt::entity& cherry::Object::getEntity() { return entity; }
 
 
-cherry::Vec3 cherry::Object::GetPosition() const { return position; }
+cherry::Vec3 cherry::Object::GetPosition() const { return cherry::Vec3(GetTransform().Position); }
 
 // gets the object's position as a glm vector
-glm::vec3 cherry::Object::GetPositionGLM() const { return glm::vec3(position.v.x, position.v.y, position.v.z); }
+glm::vec3 cherry::Object::GetPositionGLM() const { return GetTransform().Position; }
 
 // sets the position
 void cherry::Object::SetPosition(float x, float y, float z) { SetPosition(glm::vec3(x, y, z)); }
 
 // setting a new position
-void cherry::Object::SetPosition(cherry::Vec3 newPos) { position = newPos; }
+void cherry::Object::SetPosition(cherry::Vec3 newPos) { GetTransform().Position = glm::vec3(newPos.v.x, newPos.v.y, newPos.v.z); }
 
 // sets the position
-void cherry::Object::SetPosition(glm::vec3 newPos) { position = cherry::Vec3(newPos); }
+void cherry::Object::SetPosition(glm::vec3 newPos) { GetTransform().Position = newPos; }
 
 // gets the x-position
-float cherry::Object::GetPositionX() const { return position.v.x; }
+float cherry::Object::GetPositionX() const { return GetTransform().Position.x; }
 
 // sets the x-position
-void cherry::Object::SetPositionX(float x) { position.v.x = x; }
+void cherry::Object::SetPositionX(float x) { GetTransform().Position.x = x; }
 
 // gets the y-position
-float cherry::Object::GetPositionY() const { return position.v.y; }
+float cherry::Object::GetPositionY() const { return GetTransform().Position.y; }
 
 // sets the y-position
-void cherry::Object::SetPositionY(float y) { position.v.y = y; }
+void cherry::Object::SetPositionY(float y) { GetTransform().Position.y = y; }
 
 // gets the z-position
-float cherry::Object::GetPositionZ() const { return position.v.z; }
+float cherry::Object::GetPositionZ() const { return GetTransform().Position.z; }
 
 // sets the z-position
-void cherry::Object::SetPositionZ(float z) { position.v.z = z; }
+void cherry::Object::SetPositionZ(float z) { GetTransform().Position.z = z; }
 
 // sets the position by the screen portion.
 void cherry::Object::SetPositionByWindowSize(const cherry::Vec2 windowPos, const cherry::Vec2 camOrigin)
 {
 	// gets the size of the window.
 	glm::vec2 windowSize = Game::GetRunningGame()->GetWindowSize();
+	glm::vec3& position = GetTransform().Position;
 
-	position.v.x = (windowSize.x * windowPos.v.x) - windowSize.x * camOrigin.v.x;
-	position.v.y = (windowSize.y * windowPos.v.y) - windowSize.y * camOrigin.v.y;
+	position.x = (windowSize.x * windowPos.v.x) - windowSize.x * camOrigin.v.x;
+	position.y = (windowSize.y * windowPos.v.y) - windowSize.y * camOrigin.v.y;
 }
 
 // sets the window size
@@ -643,13 +810,13 @@ glm::vec3 cherry::Object::GetRotationDegreesGLM() const
 }
 
 // returns rotation in degrees, which is the storage default.
-cherry::Vec3 cherry::Object::GetRotationDegrees() const { return rotation; }
+cherry::Vec3 cherry::Object::GetRotationDegrees() const { return cherry::Vec3(GetTransform().EulerRotation); }
 
 // sets the rotation in degrees
 void cherry::Object::SetRotationDegrees(glm::vec3 theta) { SetRotationDegrees(cherry::Vec3(theta)); }
 
 // sets the rotation in degrees
-void cherry::Object::SetRotationDegrees(cherry::Vec3 theta) { rotation = theta; }
+void cherry::Object::SetRotationDegrees(cherry::Vec3 theta) { GetTransform().EulerRotation = glm::vec3(theta.v.x, theta.v.y, theta.v.z); }
 
 // gets the rotation in radians as a GLM vector
 glm::vec3 cherry::Object::GetRotationRadiansGLM() const
@@ -661,11 +828,13 @@ glm::vec3 cherry::Object::GetRotationRadiansGLM() const
 // gets the rotation in radians
 cherry::Vec3 cherry::Object::GetRotationRadians() const
 {
+	const glm::vec3& rotation = GetTransform().EulerRotation;
+
 	// returns the rotation in radians
 	return cherry::Vec3(
-		util::math::degreesToRadians(rotation.v.x),
-		util::math::degreesToRadians(rotation.v.y),
-		util::math::degreesToRadians(rotation.v.z)
+		util::math::degreesToRadians(rotation.x),
+		util::math::degreesToRadians(rotation.y),
+		util::math::degreesToRadians(rotation.z)
 	);
 }
 
@@ -676,7 +845,7 @@ void cherry::Object::SetRotationRadians(glm::vec3 theta) { SetRotationRadians(ch
 void cherry::Object::SetRotationRadians(cherry::Vec3 theta)
 {
 	// converts to degrees due to being stored as degrees.
-	rotation = cherry::Vec3(
+	GetTransform().EulerRotation = glm::vec3(
 		util::math::radiansToDegrees(theta.v.x),
 		util::math::radiansToDegrees(theta.v.y),
 		util::math::radiansToDegrees(theta.v.z)
@@ -684,85 +853,85 @@ void cherry::Object::SetRotationRadians(cherry::Vec3 theta)
 }
 
 // gets the rotation on the x-axis in degrees
-float cherry::Object::GetRotationXDegrees() const { return rotation.v.x; }
+float cherry::Object::GetRotationXDegrees() const { return GetTransform().EulerRotation.x; }
 
 // sets the rotation on the x-axis in degrees.
-void cherry::Object::SetRotationXDegrees(float degrees) { rotation.v.x = degrees; }
+void cherry::Object::SetRotationXDegrees(float degrees) { GetTransform().EulerRotation.x = degrees; }
 
 // gets the rotation on the x-axis in radians
-float cherry::Object::GetRotationXRadians() const { return util::math::degreesToRadians(rotation.v.x); }
+float cherry::Object::GetRotationXRadians() const { return util::math::degreesToRadians(GetTransform().EulerRotation.x); }
 
 // sets the rotation on the x-axis in radians.
-void cherry::Object::SetRotationXRadians(float radians) { rotation.v.x = util::math::radiansToDegrees(radians); }
+void cherry::Object::SetRotationXRadians(float radians) { GetTransform().EulerRotation.x = util::math::radiansToDegrees(radians); }
 
 
 // gets the rotation on the y-axis in degrees
-float cherry::Object::GetRotationYDegrees() const { return rotation.v.y; }
+float cherry::Object::GetRotationYDegrees() const { return GetTransform().EulerRotation.y; }
 
 // sets the rotation on the y-axis in degrees.
-void cherry::Object::SetRotationYDegrees(float degrees) { rotation.v.y = degrees; }
+void cherry::Object::SetRotationYDegrees(float degrees) { GetTransform().EulerRotation.y = degrees; }
 
 // gets the rotation on the y-axis in radians
-float cherry::Object::GetRotationYRadians() const { return util::math::degreesToRadians(rotation.v.y); }
+float cherry::Object::GetRotationYRadians() const { return util::math::degreesToRadians(GetTransform().EulerRotation.y); }
 
 // sets the rotation on the y-axis in radians.
-void cherry::Object::SetRotationYRadians(float radians) { rotation.v.y = util::math::radiansToDegrees(radians); }
+void cherry::Object::SetRotationYRadians(float radians) { GetTransform().EulerRotation.y = util::math::radiansToDegrees(radians); }
 
 
 // gets the rotation on the z-axis in degrees
-float cherry::Object::GetRotationZDegrees() const { return rotation.v.z; }
+float cherry::Object::GetRotationZDegrees() const { return GetTransform().EulerRotation.z; }
 
 // sets the rotation on the z-axis in degrees.
-void cherry::Object::SetRotationZDegrees(float degrees) { rotation.v.z = degrees; }
+void cherry::Object::SetRotationZDegrees(float degrees) { GetTransform().EulerRotation.z = degrees; }
 
 // gets the rotation on the z-axis in radians
-float cherry::Object::GetRotationZRadians() const { return util::math::degreesToRadians(rotation.v.z); }
+float cherry::Object::GetRotationZRadians() const { return util::math::degreesToRadians(GetTransform().EulerRotation.z); }
 
 // sets the rotation on the z-axis in radians.
-void cherry::Object::SetRotationZRadians(float radians) { rotation.v.y = util::math::radiansToDegrees(radians); }
+void cherry::Object::SetRotationZRadians(float radians) { GetTransform().EulerRotation.y = util::math::radiansToDegrees(radians); }
 
 
 
 // gets the scale as a glm vector
-glm::vec3 cherry::Object::GetScaleGLM() const { return glm::vec3(scale.v.x, scale.v.y, scale.v.z); }
+glm::vec3 cherry::Object::GetScaleGLM() const { return GetTransform().Scale; }
 
 // gets the scale of the object
-cherry::Vec3 cherry::Object::GetScale() const { return scale; }
+cherry::Vec3 cherry::Object::GetScale() const { return cherry::Vec3(GetTransform().Scale); }
 
 // sets the scale
-void cherry::Object::SetScale(float scl) { scale = Vec3(scl, scl, scl); }
+void cherry::Object::SetScale(float scl) { GetTransform().Scale = glm::vec3(scl, scl, scl); }
 
 // sets scale
-void cherry::Object::SetScale(float scaleX, float scaleY, float scaleZ) { scale = { scaleX, scaleY, scaleZ }; }
+void cherry::Object::SetScale(float scaleX, float scaleY, float scaleZ) { GetTransform().Scale = glm::vec3(scaleX, scaleY, scaleZ); }
 
 // sets the scale
-void cherry::Object::SetScale(glm::vec3 newScale) { scale = newScale; }
+void cherry::Object::SetScale(glm::vec3 newScale) { GetTransform().Scale = newScale; }
 
 // sets the scale
-void cherry::Object::SetScale(cherry::Vec3 newScale) { scale = newScale; }
+void cherry::Object::SetScale(cherry::Vec3 newScale) { GetTransform().Scale = glm::vec3(newScale.v.x, newScale.v.y, newScale.v.z); }
 
 // gets the scale on the x-axis
-float cherry::Object::GetScaleX() const { return scale.v.x; }
+float cherry::Object::GetScaleX() const { return GetTransform().Scale.x; }
 
 // sets the scale on the x-axis
-void cherry::Object::SetScaleX(float scaleX) { scale.v.x = scaleX; }
+void cherry::Object::SetScaleX(float scaleX) { GetTransform().Scale.x = scaleX; }
 
 // gets the y-axis scale
-float cherry::Object::GetScaleY() const { return scale.v.y; }
+float cherry::Object::GetScaleY() const { return GetTransform().Scale.y; }
 
 // sets the scale on the y-axis
-void cherry::Object::SetScaleY(float scaleY) { scale.v.y = scaleY; }
+void cherry::Object::SetScaleY(float scaleY) { GetTransform().Scale.y = scaleY; }
 
 // gets the z-axis scale
-float cherry::Object::GetScaleZ() const { return scale.v.z; }
+float cherry::Object::GetScaleZ() const { return GetTransform().Scale.z; }
 
 // sets the z-axis scale
-void cherry::Object::SetScaleZ(float scaleZ) { scale.v.z = scaleZ; }
+void cherry::Object::SetScaleZ(float scaleZ) { GetTransform().Scale.z = scaleZ; }
 
 
 
 // translates the object
-void cherry::Object::Translate(cherry::Vec3 translation) { position += translation; }
+void cherry::Object::Translate(cherry::Vec3 translation) { GetTransform().Position += glm::vec3(translation.v.x, translation.v.y, translation.v.z); }
 
 // translates the object
 void cherry::Object::Translate(float x, float y, float z) { Translate(Vec3(x, y, z)); }
@@ -770,15 +939,17 @@ void cherry::Object::Translate(float x, float y, float z) { Translate(Vec3(x, y,
 // rotates in the order of x-y-z
 void cherry::Object::Rotate(cherry::Vec3 theta, bool inDegrees) 
 { 
+	glm::vec3& rotation = GetTransform().EulerRotation;
+
 	if (inDegrees) // in degrees
 	{
-		rotation += theta; // rotation is stored in radians.
+		rotation += glm::vec3(theta.v.x, theta.v.y, theta.v.z); // rotation is stored in degrees.
 	}
 	else // in radians
 	{
-		rotation.v.x += util::math::radiansToDegrees(theta.v.x);
-		rotation.v.y += util::math::radiansToDegrees(theta.v.y);
-		rotation.v.z += util::math::radiansToDegrees(theta.v.z);
+		rotation.x += util::math::radiansToDegrees(theta.v.x);
+		rotation.y += util::math::radiansToDegrees(theta.v.y);
+		rotation.z += util::math::radiansToDegrees(theta.v.z);
 	}	
 }
 
@@ -886,7 +1057,14 @@ bool cherry::Object::RemovePhysicsBody(cherry::PhysicsBody* body)
 	if (body == nullptr)
 		return false;
 
-	return util::removeFromVector(bodies, body); 
+	if (!util::removeFromVector(bodies, body))
+		return false;
+
+	// the body is no longer part of the object, so it's taken out of the world.
+	if (body->GetPhysicsWorld() != nullptr)
+		body->GetPhysicsWorld()->RemoveBody(body);
+
+	return true;
 }
 
 // removes physics body based on index
@@ -894,7 +1072,13 @@ bool cherry::Object::RemovePhysicsBody(unsigned int index)
 {
 	if (index >= 0 && index < bodies.size()) // erases the body
 	{
+		cherry::PhysicsBody* body = bodies[index];
 		bodies.erase(bodies.begin() + index);
+
+		// the body is no longer part of the object, so it's taken out of the world.
+		if (body->GetPhysicsWorld() != nullptr)
+			body->GetPhysicsWorld()->RemoveBody(body);
+
 		return true;
 	}
 
@@ -907,6 +1091,13 @@ unsigned int cherry::Object::GetPhysicsBodyCount() const { return bodies.size();
 // returns hte physics bodies
 std::vector<cherry::PhysicsBody*> cherry::Object::GetPhysicsBodies() const { return bodies; }
 
+// saves the physics body positions
+void cherry::Object::SavePhysicsBodyPositions()
+{
+	for (cherry::PhysicsBody* body : bodies)
+		body->SaveLastWorldPosition();
+}
+
 // gets if intersection is happening.
 bool cherry::Object::GetIntersection() const { return intersection; }
 
@@ -941,9 +1132,7 @@ bool cherry::Object::AddAnimation(Animation * anime, bool current)
 	if (anime->GetId() == 1 && dynamicObject == true)
 	{
 		// checking for proper shaders
-		std::string dvs = DYNAMIC_VS;
-		std::string dfs = DYNAMIC_FS;
-		if (std::string(material->GetShader()->GetVertexShader()) != dvs || std::string(material->GetShader()->GetFragmentShader()) != dfs)
+		if (!material->HasKeyword(MORPH_KEYWORD))
 		{
 			// TODO: runtime error?
 			// ERROR: cannot run with set shaders
@@ -976,27 +1165,81 @@ void cherry::Object::SetCurrentAnimation(unsigned int index) { animations.SetCur
 
 
 // gets the path
-cherry::Path cherry::Object::GetPath() const { return path; }
+cherry::Path cherry::Object::GetPath() const { return GetComponent(localPath).Path; }
 
 // sets the path the object follows.
-void cherry::Object::SetPath(cherry::Path newPath) { path = newPath; }
+void cherry::Object::SetPath(cherry::Path newPath) { GetComponent(localPath).Path = newPath; }
 
 // attaching a path.
 void cherry::Object::SetPath(cherry::Path newPath, bool attachPath)
 {
 	SetPath(newPath);
 
-	followPath = attachPath;
+	UsePath(attachPath);
 }
 
 // removes the path from the object. It still exists in memory.
-void cherry::Object::ClearPath() { path = Path(); }
+void cherry::Object::ClearPath() { GetComponent(localPath).Path = Path(); }
 
 // determines whether the object should use the path.
-void cherry::Object::UsePath(bool follow) { followPath = follow; }
+void cherry::Object::UsePath(bool follow)
+{
+	GetComponent(localPath).Enabled = follow;
+
+	if (registry != nullptr)
+		ObjectSystems::SetTag<FollowingPath>(*registry, entity, follow);
+}
+
+// checks if the object is following the path.
+bool cherry::Object::IsFollowingPath() const { return GetComponent(localPath).Enabled; }
+
+// gets the target
+std::shared_ptr<cherry::Target> cherry::Object::GetTarget() const { return GetComponent(localTarget).Target; }
+
+// sets the target
+void cherry::Object::SetTarget(std::shared_ptr<cherry::Target> newTarget) { GetComponent(localTarget).Target = newTarget; }
+
+// gets the target offset
+cherry::Vec3 cherry::Object::GetTargetOffset() const { return cherry::Vec3(GetComponent(localTarget).Offset); }
+
+// sets the target offset
+void cherry::Object::SetTargetOffset(cherry::Vec3 offset) { GetComponent(localTarget).Offset = glm::vec3(offset.v.x, offset.v.y, offset.v.z); }
+
+// checks if the object is following the target.
+bool cherry::Object::IsFollowingTarget() const { return GetComponent(localTarget).Enabled; }
+
+// sets if the target is followed.
+void cherry::Object::SetFollowingTarget(bool follow)
+{
+	GetComponent(localTarget).Enabled = follow;
+
+	if (registry != nullptr)
+		ObjectSystems::SetTag<FollowingTarget>(*registry, entity, follow);
+}
 
 // gets the object as a target. The target is updated each frame to match up with the current position.
-const std::shared_ptr<cherry::Target>& cherry::Object::GetObjectAsTarget() const { return leaderTarget; }
+const std::shared_ptr<cherry::Target>& cherry::Object::GetObjectAsTarget() const
+{
+	// the leader target is only moved each update once something can follow it, so it's brought up to date here.
+	if (registry != nullptr)
+	{
+		TargetFollower& follower = registry->get<TargetFollower>(entity);
+
+		if (!follower.Leading)
+		{
+			follower.Leading = true;
+			follower.Leader->SetPosition(GetTransform().Position);
+			ObjectSystems::SetTag<LeadingTarget>(*registry, entity, true);
+		}
+
+		return follower.Leader;
+	}
+
+	// the entity gets the tag once it's created.
+	localTarget.Leading = true;
+	localTarget.Leader->SetPosition(localTransform.Position);
+	return localTarget.Leader;
+}
 
 // gets the mesh body maximum.
 const cherry::Vec3 & cherry::Object::GetMeshBodyMaximum() const { return meshBodyMax; }
@@ -1066,9 +1309,7 @@ void cherry::Object::Update(float deltaTime)
 	// rotation.SetX(rotation.GetX() + 15.0F * deltaTime);
 	// rotation.SetZ(rotation.GetZ() + 90.0F * deltaTime);
 
-	// runs the path and sets the new position
-	if (followPath)
-		position = path.Run(deltaTime);
+	// the path, target, and leader target are updated for every object by ObjectSystems::Update().
 
 	// if the animation is playing
 	if (animations.GetCurrentAnimation() != nullptr)
@@ -1077,21 +1318,15 @@ void cherry::Object::Update(float deltaTime)
 			animations.GetCurrentAnimation()->Update(deltaTime);
 	}	
 
-	// if the object is meant to follow a target.
-	if (followTarget)
-		position = target->GetPosition() + targetOffset;
-
 	// updating the physics bodies
 	for (cherry::PhysicsBody* body : bodies)
 		body->Update(deltaTime);
 
-	// updating the leader target.
-	leaderTarget->SetPosition(position);
 	// SetRotationDegrees(GetRotationDegrees() + Vec3(30.0F, 10.0F, 5.0F) * deltaTime);
 }
 
 // returns a string representing the object
 std::string cherry::Object::ToString() const
 {
-	return "Name: " + name + " | Description: " + description + " | Position: " + position.ToString();
+	return "Name: " + name + " | Description: " + description + " | Position: " + GetPosition().ToString();
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <string>
 #include <fstream> // uses the fstream file reading method.
 #include <vector>
+#include <unordered_map>
 #include <math.h>
 
 #include <entt/entt.hpp>
@@ -17,11 +18,24 @@
 #include "..\animate\AnimationManager.h"
 #include "..\animate\Path.h"
 #include "..\Target.h"
+#include "ObjectComponents.h"
 
 
 namespace cherry
 {
 	class PhysicsBody;
+	class MeshBVH;
+
+	// the contents of a .obj file, which are read without using OpenGL (see Object::ParseObjFile()).
+	struct ObjFileData
+	{
+		std::string Name = "";
+		std::string Description = "";
+		std::string MtlLib = ""; // the material template library named by the file.
+
+		std::vector<Vertex> Vertices; // a vertex for each index, with its normal and UV filled in.
+		std::vector<uint32_t> Indices; // the vertex indices from the file.
+	};
 
 	class Object
 	{
@@ -112,6 +126,14 @@ namespace cherry
 		// returns a reference to the mesh.
 		Mesh::Sptr& GetMesh();
 
+		// reads the .obj file again and replaces the mesh. The name, description, and material are kept.
+		// objects with morph targets aren't reloaded, since their animations use the old vertices. If the file can't be read, the old mesh is kept.
+		bool ReloadMesh();
+
+		// gets the hierarchy over the mesh's triangles, which is used for raycasts. It's built the first time it's requested.
+		// returns nullptr if the object doesn't have any triangles.
+		const cherry::MeshBVH* GetMeshBVH();
+
 		// gets the material for the object.
 		const Material::Sptr& GetMaterial() const;
 
@@ -161,10 +183,25 @@ namespace cherry
 		void SetPostProcess(bool postProcess);
 
 		// creates the entity with the provided m_Scene and material.
+		// if the object already has an entity, its transform, path, and target are moved to the new entity, and the old one is destroyed.
 		void CreateEntity(std::string scene, cherry::Material::Sptr material);
 
+		// gets the entity of the object. This is entt::null if CreateEntity() hasn't been called.
+		entt::entity GetEntity() const;
+
+		// gets the transform of the object, which is stored as a component on the entity.
+		// if the entity hasn't been made yet, the object's own copy is returned, which is moved to the entity when it's created.
+		cherry::TempTransform& GetTransform();
+
+		// gets the transform of the object.
+		const cherry::TempTransform& GetTransform() const;
+
 		// gets the transformation from local space to world space.
 		glm::mat4 GetWorldTransformation() const;
+
+		// calculates the transformation from local space to world space using the current position, rotation, and scale.
+		// this is the same as GetWorldTransformation(), since the transform is no longer copied over to the entity.
+		glm::mat4 CalculateWorldTransformation() const;
 		
 		// gets the position as an engine vector
 		cherry::Vec3 GetPosition() const;
@@ -393,9 +430,10 @@ namespace cherry
 		bool AddPhysicsBody(cherry::PhysicsBody * body);
 
 		// removes a physics body; returns 'true' if successful.
+		// the body is also taken out of its physics world.
 		bool RemovePhysicsBody(cherry::PhysicsBody * body);
 
-		// removes a physics body based on its index.
+		// removes a physics body based on its index. The body is also taken out of its physics world.
 		bool RemovePhysicsBody(unsigned int index);
 
 		// gets the amount of physics bodies
@@ -403,6 +441,9 @@ namespace cherry
 
 		// gets the physics bodies
 		std::vector<cherry::PhysicsBody *> GetPhysicsBodies() const;
+
+		// saves the world position of each physics body for the swept collisions (see PhysicsBody::SaveLastWorldPosition()).
+		void SavePhysicsBodyPositions();
 		
 		// gets whether the object intersects with another object.
 		bool GetIntersection() const;
@@ -449,16 +490,34 @@ namespace cherry
 		// clears all nodes from the path.
 		void ClearPath();
 
-		// TODO: add function for following a target.
-
 		// if 'true' is passed, the object follows the path, if it exists.
 		void UsePath(bool follow);
 
-		// gets the object as a target. This target gets updated each frame to match up with the current position.
-		const std::shared_ptr<cherry::Target>& GetObjectAsTarget() const;
+		// returns 'true' if the object is following its path.
+		bool IsFollowingPath() const;
+
+		/// TARGET ///
+		// gets the target the object can follow.
+		std::shared_ptr<cherry::Target> GetTarget() const;
+
+		// sets the target the object can follow.
+		void SetTarget(std::shared_ptr<cherry::Target> newTarget);
+
+		// gets the offset from the target's position.
+		cherry::Vec3 GetTargetOffset() const;
+
+		// sets the offset from the target's position.
+		void SetTargetOffset(cherry::Vec3 offset);
 
 		// returns 'true' if the object is following a target.
-		// void FollowTarget(bool tgt);
+		bool IsFollowingTarget() const;
+
+		// sets whether the object follows its target.
+		void SetFollowingTarget(bool follow);
+
+		// gets the object as a target. This target gets updated each frame to match up with the current position.
+		// the target is only updated once it's been asked for, so objects that nothing follows aren't visited by the update.
+		const std::shared_ptr<cherry::Target>& GetObjectAsTarget() const;
 
 		// get mesh body maximum.
 		const cherry::Vec3 & GetMeshBodyMaximum() const;
@@ -478,28 +537,22 @@ namespace cherry
 		// toString
 		virtual std::string ToString() const;
 
+		// reads a .obj file without using OpenGL, so that it can be done on a worker thread (see Scene::PreloadObjFile()).
+		// a 'false' is returned if the file couldn't be opened.
+		static bool ParseObjFile(const std::string& filePath, ObjFileData& data);
+
+		// adds a .obj file that objects use when they load the file, rather than reading the file again.
+		static void AddPreloadedObjFile(const std::string& filePath, ObjFileData data);
+
+		// removes a preloaded .obj file, so that objects read the file again.
+		static void RemovePreloadedObjFile(const std::string& filePath);
+
 		// the maximum amount of vertices one object can have. This doesn't get used.
 		const static unsigned int VERTICES_MAX;
 
 		// the maximum amount of indices one object can have. This doesn't get used.
 		const static unsigned int INDICES_MAX;
 
-		// the path the object follows
-		// std::shared_ptr <Path> path = nullptr;
-		Path path = Path();
-
-		// following the path
-		bool followPath = false;
-
-		// a target to be followed by the object.
-		std::shared_ptr<cherry::Target> target = std::make_shared<cherry::Target>();
-
-		// the offset from the target's position.
-		cherry::Vec3 targetOffset{};
-
-		// if 'true', the target is followed.
-		bool followTarget = false;
-
 	private:
 		// void setMesh(Mesh::sptr);
 
@@ -510,8 +563,10 @@ namespace cherry
 		// containsSymbol: tells the function if the string passed still contains the symbol at the start. If so, it is removed before the parsing begins.
 		// *** the symbol at the start is what's used to determine what the values in a given line of a .obj are for.
 		template<typename T>
-		const std::vector<T> parseStringForTemplate(std::string str, bool containsSymbol = true);
+		static const std::vector<T> parseStringForTemplate(std::string str, bool containsSymbol = true);
 
+		// the .obj files that have been read by scene preloads, by their file path.
+		static std::unordered_map<std::string, ObjFileData> preloadedObjFiles;
 
 		// template<typename T>
 		// void CalculateNormals(std::vector<);
@@ -532,8 +587,28 @@ namespace cherry
 		// the string for the file path
 		std::string filePath = "";
 
-		// transformation into world coordinate space.
-		glm::mat4 worldTransform;
+		// the registry of the scene the entity is in (nullptr if there's no entity).
+		entt::registry* registry = nullptr;
+
+		// the entity of the object.
+		entt::entity entity = entt::null;
+
+		// the transform, path, and target of the object before its entity is created.
+		// once the entity exists, these aren't used, since the components on the entity are used instead.
+		cherry::TempTransform localTransform;
+		cherry::PathFollower localPath;
+		mutable cherry::TargetFollower localTarget; // GetObjectAsTarget() marks the leader target as used.
+
+		// gets a component from the object's entity, or the object's own copy if there's no entity.
+		template<typename T>
+		T& GetComponent(T& local) { return (registry != nullptr) ? registry->get<T>(entity) : local; }
+
+		// gets a component from the object's entity, or the object's own copy if there's no entity.
+		template<typename T>
+		const T& GetComponent(const T& local) const { return (registry != nullptr) ? registry->get<T>(entity) : local; }
+
+		// destroys the entity, if the scene it's in still exists.
+		void DestroyEntity();
 
 		// a vector of physics bodies
 		std::vector<cherry::PhysicsBody*> bodies;
@@ -541,12 +616,6 @@ namespace cherry
 		// becomes 'true' when an object intersects something.
 		bool intersection = false;
 
-		// saves the rotation on the x, y, and z axis in DEGREES.
-		cherry::Vec3 rotation = { 0.0F, 0.0F, 0.0F };
-
-		// the object as a target.
-		std::shared_ptr<cherry::Target> leaderTarget = std::make_shared<cherry::Target>();
-
 	protected:
 		// constructor used for default primitives
 		Object();
@@ -584,6 +653,9 @@ namespace cherry
 
 		cherry::Vec3 meshBodyMax; // maximum vertex positions
 
+		// the hierarchy over the triangles (see GetMeshBVH()).
+		cherry::MeshBVH* meshBVH = nullptr;
+
 		// the color of the model.
 		// cherry::Vec4 color;
 
@@ -593,12 +665,6 @@ namespace cherry
 		// the alpha value for the mesh.
 		float alpha = 1.0F;
 
-		// the position of the object.
-		cherry::Vec3 position = { 0.0F, 0.0F, 0.0F };
-
-		// the scale of the object
-		cherry::Vec3 scale = { 1.0F, 1.0F, 1.0F };
-
 		// the animation
 		// TODO: repalce with an animation manager
 		cherry::AnimationManager animations = cherry::AnimationManager();
@@ -0,0 +1,238 @@
+// ObjectBenchmark (Source) - times the object systems on a large registry, and the object list on a large amount of objects.
+#include "ObjectBenchmark.h"
+#include "ObjectComponents.h"
+#include "ObjectManager.h"
+
+#include <toolkit/Logging.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+namespace cherry
+{
+	// an object without a mesh, which is all the list needs. The object's default constructor is protected, so it's used through this.
+	class BenchmarkObject : public cherry::Object
+	{
+	public:
+		BenchmarkObject(const std::string& name) : Object() { SetName(name); }
+	};
+}
+
+// runs the systems benchmark
+cherry::ObjectSystemsBenchmarkResult cherry::ObjectBenchmark::RunSystems(uint32_t entityCount, uint32_t frames)
+{
+	ObjectSystemsBenchmarkResult result;
+	entt::registry tagged;
+	entt::registry untagged;
+
+	result.Entities = entityCount;
+	result.Frames = frames;
+	result.Moving = __FillRegistry(tagged, entityCount);
+	__FillRegistry(untagged, entityCount);
+
+	const float deltaTime = 1.0F / 60.0F;
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t i = 0; i < frames; i++)
+		ObjectSystems::Update(tagged, deltaTime);
+
+	result.TaggedTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t i = 0; i < frames; i++)
+		__UpdateUntagged(untagged, deltaTime);
+
+	result.UntaggedTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	if (frames > 0)
+	{
+		result.TaggedTime /= frames;
+		result.UntaggedTime /= frames;
+	}
+
+	// both registries made their entities in the same order, so the entities line up.
+	result.Matching = true;
+
+	tagged.view<TempTransform>().each([&](const entt::entity e, const TempTransform& transform)
+	{
+		if (!untagged.valid(e) || untagged.get<TempTransform>(e).Position != transform.Position)
+			result.Matching = false;
+	});
+
+	LOG_INFO("Object systems benchmark: {} entities ({} moving), {:.3f} ms per frame ({:.3f} ms visiting every entity).",
+		result.Entities, result.Moving, result.TaggedTime, result.UntaggedTime);
+
+	if (!result.Matching)
+		LOG_ERROR("Object systems benchmark: the tagged and untagged updates ended with different positions.");
+
+	return result;
+}
+
+// runs the list benchmark
+cherry::ObjectListBenchmarkResult cherry::ObjectBenchmark::RunList(uint32_t objectCount, uint32_t lookups)
+{
+	ObjectListBenchmarkResult result;
+	std::vector<Object*> objects;
+
+	// the list isn't registered with the object manager, so it isn't part of any scene.
+	ObjectList* list = new ObjectList("Object List Benchmark");
+
+	result.Objects = objectCount;
+	result.Lookups = (objectCount > 0) ? lookups : 0;
+	result.Correct = true;
+
+	objects.reserve(objectCount);
+
+	for (uint32_t i = 0; i < objectCount; i++)
+		objects.push_back(new BenchmarkObject("object_" + std::to_string(i)));
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (Object* obj : objects)
+		list->AddObject(obj);
+
+	result.InsertTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	// the lookups are spread evenly through the list.
+	std::vector<std::string> names;
+	std::vector<uint32_t> picks;
+
+	for (uint32_t i = 0; i < result.Lookups; i++)
+	{
+		picks.push_back((uint32_t)(((uint64_t)i * objectCount) / result.Lookups));
+		names.push_back(objects[picks.back()]->GetName());
+	}
+
+	start = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t i = 0; i < result.Lookups; i++)
+	{
+		if (list->GetObjectByName(names[i]) != objects[picks[i]])
+			result.Correct = false;
+	}
+
+	result.NameLookupTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	start = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t i = 0; i < result.Lookups; i++)
+	{
+		if (list->GetObjectByIndex(list->GetObjectIndex(objects[picks[i]])) != objects[picks[i]])
+			result.Correct = false;
+	}
+
+	result.IndexLookupTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	// the objects are removed in a random order, so that they aren't always the last one in the list.
+	std::vector<Object*> order = objects;
+	std::shuffle(order.begin(), order.end(), std::mt19937(1234));
+
+	start = std::chrono::high_resolution_clock::now();
+
+	for (Object* obj : order)
+	{
+		if (list->RemoveObjectByPointer(obj) != obj)
+			result.Correct = false;
+	}
+
+	result.RemoveTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	if (list->GetObjectCount() != 0)
+		result.Correct = false;
+
+	// the list is empty, so deleting it doesn't delete the objects.
+	delete list;
+
+	for (Object* obj : objects)
+		delete obj;
+
+	LOG_INFO("Object list benchmark: {} objects, {:.3f} ms to add, {:.3f} ms to remove.", result.Objects, result.InsertTime, result.RemoveTime);
+	LOG_INFO("Object list benchmark: {} lookups, {:.3f} ms by name, {:.3f} ms by pointer.", result.Lookups, result.NameLookupTime, result.IndexLookupTime);
+
+	if (!result.Correct)
+		LOG_ERROR("Object list benchmark: the list gave back the wrong objects.");
+
+	return result;
+}
+
+// fills a registry
+uint32_t cherry::ObjectBenchmark::__FillRegistry(entt::registry& registry, uint32_t entityCount)
+{
+	std::vector<entt::entity> entities;
+	uint32_t moving = 0;
+
+	entities.reserve(entityCount);
+
+	for (uint32_t i = 0; i < entityCount; i++)
+	{
+		entt::entity e = registry.create();
+		TempTransform& transform = registry.assign<TempTransform>(e);
+		PathFollower& path = registry.assign<PathFollower>(e);
+		TargetFollower& target = registry.assign<TargetFollower>(e);
+
+		transform.Position = glm::vec3((float)(i % 250), (float)(i / 250), 0.0F);
+
+		// one in twenty follows a short loop.
+		if (i % 20 == 0)
+		{
+			path.Path = Path(cherry::Vec3(transform.Position));
+			path.Path.AddNode(transform.Position.x + 1.0F, transform.Position.y, 0.0F);
+			path.Path.AddNode(transform.Position.x + 1.0F, transform.Position.y + 1.0F, 0.0F);
+			path.Enabled = true;
+		}
+		// one in twenty follows the entity before it, which leads.
+		else if (i % 20 == 10)
+		{
+			TargetFollower& leader = registry.get<TargetFollower>(entities.back());
+
+			leader.Leading = true;
+			target.Target = leader.Leader;
+			target.Offset = glm::vec3(0.0F, 0.0F, 1.0F);
+			target.Enabled = true;
+		}
+
+		if (path.Enabled || target.Enabled)
+			moving++;
+
+		ObjectSystems::UpdateTags(registry, e);
+		entities.push_back(e);
+	}
+
+	// the leaders were marked after their tags were set.
+	for (entt::entity e : entities)
+		ObjectSystems::UpdateTags(registry, e);
+
+	return moving;
+}
+
+// updates every entity
+void cherry::ObjectBenchmark::__UpdateUntagged(entt::registry& registry, float deltaTime)
+{
+	auto paths = registry.view<PathFollower, TempTransform>();
+
+	for (const auto& e : paths)
+	{
+		PathFollower& follower = paths.get<PathFollower>(e);
+
+		if (follower.Enabled)
+		{
+			cherry::Vec3 pos = follower.Path.Run(deltaTime);
+			paths.get<TempTransform>(e).Position = glm::vec3(pos.v.x, pos.v.y, pos.v.z);
+		}
+	}
+
+	auto targets = registry.view<TargetFollower, TempTransform>();
+
+	for (const auto& e : targets)
+	{
+		TargetFollower& follower = targets.get<TargetFollower>(e);
+		TempTransform& transform = targets.get<TempTransform>(e);
+
+		if (follower.Enabled && follower.Target != nullptr)
+			transform.Position = follower.Target->GetPositionGLM() + follower.Offset;
+
+		follower.Leader->SetPosition(transform.Position);
+	}
+}
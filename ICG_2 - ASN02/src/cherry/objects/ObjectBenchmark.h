@@ -0,0 +1,54 @@
+// ObjectBenchmark (Header) - times the object systems on a large registry, and the object list on a large amount of objects.
+#pragma once
+#include <stdint.h>
+#include <entt/entt.hpp>
+
+namespace cherry
+{
+	// the results of the systems benchmark.
+	struct ObjectSystemsBenchmarkResult
+	{
+		uint32_t Entities = 0;
+		uint32_t Moving = 0; // the entities following a path or a target.
+		uint32_t Frames = 0;
+		float TaggedTime = 0.0F; // ObjectSystems::Update(), which only visits the tagged entities (in milliseconds per frame).
+		float UntaggedTime = 0.0F; // a walk over every entity that checks the flags instead (in milliseconds per frame).
+		bool Matching = false; // 'true' if both ended with the same positions.
+	};
+
+	// the results of the object list benchmark.
+	struct ObjectListBenchmarkResult
+	{
+		uint32_t Objects = 0;
+		uint32_t Lookups = 0;
+		float InsertTime = 0.0F; // adding every object (in milliseconds).
+		float NameLookupTime = 0.0F; // finding objects by name (in milliseconds).
+		float IndexLookupTime = 0.0F; // finding the index of objects by pointer (in milliseconds).
+		float RemoveTime = 0.0F; // removing every object in a random order (in milliseconds).
+		bool Correct = false; // 'true' if every lookup found the right object, and the list ended up empty.
+	};
+
+	/*
+	 * The systems benchmark makes entities with the same components as objects, without making the objects themselves.
+	 * One in twenty follows a path, and one in twenty follows another entity, so most of them stand still like most of a scene does.
+	 * The same registry is made twice, so that the tagged update can be compared with walking every entity.
+	 * The list benchmark fills an ObjectList with objects that have no mesh, looks some of them up, then removes them all in a random order.
+	 * Nothing is drawn, so no OpenGL context is needed. The results are printed to the log.
+	*/
+	class ObjectBenchmark
+	{
+	public:
+		// runs the systems on the provided amount of entities for the provided amount of frames.
+		static ObjectSystemsBenchmarkResult RunSystems(uint32_t entityCount = 50000, uint32_t frames = 100);
+
+		// adds the provided amount of objects to a list, does the lookups by name and by pointer, then removes the objects.
+		static ObjectListBenchmarkResult RunList(uint32_t objectCount = 100000, uint32_t lookups = 1000);
+
+	private:
+		// fills a registry with the benchmark's entities. Returns the amount of moving entities.
+		static uint32_t __FillRegistry(entt::registry& registry, uint32_t entityCount);
+
+		// updates every entity with a path or target component, checking their flags. This is how the systems worked before the tags.
+		static void __UpdateUntagged(entt::registry& registry, float deltaTime);
+	};
+}
@@ -0,0 +1,54 @@
+// ObjectComponents (Source) - the per-object state that's stored in the registry, and the systems that update it.
+#include "ObjectComponents.h"
+
+// updates all of the object components
+void cherry::ObjectSystems::Update(entt::registry& registry, float deltaTime)
+{
+	UpdatePaths(registry, deltaTime);
+	UpdateTargets(registry);
+}
+
+// updates the paths
+void cherry::ObjectSystems::UpdatePaths(entt::registry& registry, float deltaTime)
+{
+	auto view = registry.view<FollowingPath, PathFollower, TempTransform>();
+
+	// runs the path and sets the new position
+	for (const auto& e : view)
+	{
+		cherry::Vec3 pos = view.get<PathFollower>(e).Path.Run(deltaTime);
+		view.get<TempTransform>(e).Position = glm::vec3(pos.v.x, pos.v.y, pos.v.z);
+	}
+}
+
+// updates the targets
+void cherry::ObjectSystems::UpdateTargets(entt::registry& registry)
+{
+	auto followers = registry.view<FollowingTarget, TargetFollower, TempTransform>();
+
+	// the entities that are meant to follow a target.
+	for (const auto& e : followers)
+	{
+		const TargetFollower& follower = followers.get<TargetFollower>(e);
+
+		if (follower.Target != nullptr)
+			followers.get<TempTransform>(e).Position = follower.Target->GetPositionGLM() + follower.Offset;
+	}
+
+	auto leaders = registry.view<LeadingTarget, TargetFollower, TempTransform>();
+
+	// updating the leader targets, which is done after the followers so that they have their new positions.
+	for (const auto& e : leaders)
+		leaders.get<TargetFollower>(e).Leader->SetPosition(leaders.get<TempTransform>(e).Position);
+}
+
+// updates the tags
+void cherry::ObjectSystems::UpdateTags(entt::registry& registry, entt::entity entity)
+{
+	const PathFollower& path = registry.get<PathFollower>(entity);
+	const TargetFollower& target = registry.get<TargetFollower>(entity);
+
+	SetTag<FollowingPath>(registry, entity, path.Enabled);
+	SetTag<FollowingTarget>(registry, entity, target.Enabled);
+	SetTag<LeadingTarget>(registry, entity, target.Leading);
+}
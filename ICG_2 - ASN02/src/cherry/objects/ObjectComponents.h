@@ -0,0 +1,66 @@
+// ObjectComponents (Header) - the per-object state that's stored in the registry, and the systems that update it.
+#pragma once
+#include <entt/entt.hpp>
+#include <memory>
+
+#include "..\WorldTransform.h"
+#include "..\animate\Path.h"
+#include "..\Target.h"
+
+namespace cherry
+{
+	// a path that the entity moves along.
+	struct PathFollower {
+		cherry::Path Path = cherry::Path();
+		bool Enabled = false;
+	};
+
+	// a target that the entity moves to, and the target that others can use to follow the entity.
+	struct TargetFollower {
+		std::shared_ptr<cherry::Target> Target = std::make_shared<cherry::Target>();
+		glm::vec3 Offset = glm::vec3(0.0f); // the offset from the target's position.
+		bool Enabled = false;
+
+		// the entity as a target. This is moved to the entity's position every update once it's been given out (see Object::GetObjectAsTarget()).
+		std::shared_ptr<cherry::Target> Leader = std::make_shared<cherry::Target>();
+		bool Leading = false;
+	};
+
+	// tags for the entities that the systems need to visit. They mirror the flags in the components above.
+	// the views are led by the tags, so entities that aren't moving or being followed are never touched.
+	struct FollowingPath {};
+	struct FollowingTarget {};
+	struct LeadingTarget {};
+
+	/*
+	 * Objects keep their transform (TempTransform), path, and target in components on their entity, so the state for every object sits in the registry's arrays.
+	 * The systems here walk those arrays once per update, instead of each object being visited through its pointer.
+	 * Each system only goes through the entities with its tag, and looks up the components for those.
+	 * Anything that needs the rest of the object (animations, physics bodies) is still done in Object::Update().
+	*/
+	class ObjectSystems
+	{
+	public:
+		// updates the paths, then the targets, then the leader targets for every entity in the registry.
+		static void Update(entt::registry& registry, float deltaTime);
+
+		// moves the entities that are following a path.
+		static void UpdatePaths(entt::registry& registry, float deltaTime);
+
+		// moves the entities that are following a target, and moves the leader targets to their entity.
+		static void UpdateTargets(entt::registry& registry);
+
+		// adds or removes a tag from an entity.
+		template<typename Tag>
+		static void SetTag(entt::registry& registry, entt::entity entity, bool enabled)
+		{
+			if (enabled && !registry.has<Tag>(entity))
+				registry.assign<Tag>(entity);
+			else if (!enabled && registry.has<Tag>(entity))
+				registry.remove<Tag>(entity);
+		}
+
+		// gives an entity the tags that match the flags in its path and target components.
+		static void UpdateTags(entt::registry& registry, entt::entity entity);
+	};
+}
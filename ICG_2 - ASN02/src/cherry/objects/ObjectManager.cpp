@@ -3,10 +3,14 @@
 #include "..\utils\Utils.h"
 #include "..\physics/PhysicsBody.h"
 #include "..\Game.h"
+#include "..\HotReload.h"
 
 // object manager
 std::vector<cherry::ObjectList*> cherry::ObjectManager::objectLists = std::vector<cherry::ObjectList*>();
 
+// object lists by scene name
+std::unordered_map<std::string, cherry::ObjectList*> cherry::ObjectManager::objectListMap = std::unordered_map<std::string, cherry::ObjectList*>();
+
 // destructor
 cherry::ObjectManager::~ObjectManager()
 {
@@ -17,20 +21,11 @@ cherry::ObjectManager::~ObjectManager()
 	}
 
 	objectLists.clear();
+	objectListMap.clear();
 }
 
 // checks to see if a scene object list already exists.
-bool cherry::ObjectManager::SceneObjectListExists(std::string sceneName)
-{
-	// checks to see if a scene exist.
-	for (ObjectList* list : objectLists)
-	{
-		if (list->GetSceneName() == sceneName)
-			return true;
-	}
-
-	return false;
-}
+bool cherry::ObjectManager::SceneObjectListExists(std::string sceneName) { return objectListMap.count(sceneName) != 0; }
 
 // gets the object list by index
 cherry::ObjectList* cherry::ObjectManager::GetSceneObjectListByIndex(unsigned int index)
@@ -44,27 +39,21 @@ cherry::ObjectList* cherry::ObjectManager::GetSceneObjectListByIndex(unsigned in
 // gets list of objects for a provided scene. A nullptr is returned if the scene doesn't have a list.
 cherry::ObjectList* cherry::ObjectManager::GetSceneObjectListByName(std::string sceneName)
 {
-	// goes through the sceneLists to get the right object list.
-	for (cherry::ObjectList* objList : objectLists)
-	{
-		if (objList->GetSceneName() == sceneName) // if the objectList for the provided scene has been found.
-			return objList;
-	}
-	return nullptr;
+	std::unordered_map<std::string, ObjectList*>::iterator iter = objectListMap.find(sceneName);
+
+	return (iter != objectListMap.end()) ? iter->second : nullptr;
 }
 
 // add scene object list. 
 bool cherry::ObjectManager::CreateSceneObjectList(std::string scene)
 {
-	for (cherry::ObjectList* objList : objectLists)
-	{
-		if (objList->GetSceneName() == scene) // a list for this scene already exists.
-			return false;
-	}
+	if (SceneObjectListExists(scene)) // a list for this scene already exists.
+		return false;
 
 	// adds an object to the list.
 	ObjectList* list = new ObjectList(scene);
 	objectLists.push_back(list);
+	objectListMap[scene] = list;
 
 	return true;
 }
@@ -77,20 +66,16 @@ bool cherry::ObjectManager::AddObjectToSceneObjectList(cherry::Object* obj, bool
 
 	std::string scene = obj->GetSceneName();
 
-	// goes thorugh the object lists to see if an appropriate scene exists.
-	for (cherry::ObjectList* objList : objectLists)
-	{
-		if (objList->GetSceneName() == obj->GetSceneName()) // if the object is part of a scene that already has a list.
-		{
-			return objList->AddObject(obj); // adds the object to the list.
-		}
-	}
+	// if the object is part of a scene that already has a list.
+	ObjectList* objList = GetSceneObjectListByName(scene);
+
+	if (objList != nullptr)
+		return objList->AddObject(obj); // adds the object to the list.
 
 	if (addSceneList) // if true, a new scene list is created.
 	{
-		ObjectList* objList = new ObjectList(obj->GetSceneName());
-		objList->AddObject(obj);
-		objectLists.push_back(objList);
+		CreateSceneObjectList(scene);
+		GetSceneObjectListByName(scene)->AddObject(obj);
 		return true;
 	}
 	else
@@ -138,10 +123,7 @@ bool cherry::ObjectManager::DestroySceneObjectListByIndex(unsigned int index)
 
 	if (objList != nullptr) // if the object isn't a nullptr
 	{
-		util::removeFromVector(objectLists, objList);
-		delete objList;
-
-		return true;
+		return DestroySceneObjectListByPointer(objList);
 	}
 	else // if the object is a nullptr
 	{
@@ -154,6 +136,7 @@ bool cherry::ObjectManager::DestroySceneObjectListByPointer(cherry::ObjectList*
 {
 	if (util::removeFromVector(objectLists, objList)) // in list
 	{
+		objectListMap.erase(objList->GetSceneName());
 		delete objList;
 		return true;
 	}
@@ -206,6 +189,36 @@ void cherry::ObjectManager::UpdateWindowChild(cherry::Object* object)
 	}
 }
 
+// updates the name of the object in its list.
+void cherry::ObjectManager::UpdateObjectName(cherry::Object* object, const std::string& oldName)
+{
+	if (object == nullptr) // safety check
+		return;
+
+	ObjectList* list = ObjectManager::GetSceneObjectListByName(object->GetSceneName()); // gets its object list.
+
+	if (list != nullptr)
+		list->RenameObject(object, oldName);
+}
+
+// reloads the objects using a file
+int cherry::ObjectManager::ReloadObjectFile(const std::string& filePath)
+{
+	const std::string path = HotReload::NormalizePath(filePath);
+	int count = 0;
+
+	for (ObjectList* list : objectLists)
+	{
+		for (Object* obj : list->objects)
+		{
+			if (obj->GetFilePath() != "" && HotReload::NormalizePath(obj->GetFilePath()) == path && obj->ReloadMesh())
+				count++;
+		}
+	}
+
+	return count;
+}
+
 // reading of an index
 // const cherry::ObjectList & cherry::ObjectManager::operator[](const int index) const { return *objectLists[index]; }
 
@@ -228,6 +241,8 @@ cherry::ObjectList::~ObjectList()
 
 	objects.clear();
 	windowChildren.clear(); // has objects that are also in objects vector.
+	objectIndexes.clear();
+	objectNames.clear();
 }
 
 // returns the scene for the object list.
@@ -248,16 +263,24 @@ cherry::Object* cherry::ObjectList::GetObjectByIndex(unsigned int index)
 	return objects.at(index);
 }
 
+// gets the index of an object.
+int cherry::ObjectList::GetObjectIndex(cherry::Object* obj)
+{
+	CheckIndexes();
+
+	std::unordered_map<Object*, size_t>::iterator iter = objectIndexes.find(obj);
+
+	return (iter != objectIndexes.end()) ? (int)iter->second : -1;
+}
+
 // gets an object using its name.
 cherry::Object* cherry::ObjectList::GetObjectByName(std::string name)
 {
-	for (Object* obj : objects) // finds object by name
-	{
-		if (obj->GetName() == name)
-			return obj;
-	}
+	CheckIndexes();
+
+	std::unordered_multimap<std::string, Object*>::iterator iter = objectNames.find(name);
 
-	return nullptr;
+	return (iter != objectNames.end()) ? iter->second : nullptr;
 }
 
 // adds an object to the list.
@@ -266,15 +289,23 @@ bool cherry::ObjectList::AddObject(cherry::Object* obj)
 	if (obj == nullptr)
 		return false;
 
+	CheckIndexes();
+
+	// the object is already in the list.
+	if (objectIndexes.count(obj) != 0)
+		return false;
+
 	// adds the object to the vector.
-	bool added = util::addToVector(objects, obj);
+	objectIndexes[obj] = objects.size();
+	objects.push_back(obj);
+	objectNames.emplace(obj->GetName(), obj);
 
-	// if the object was added, and is a window child.
-	if (added == true && obj->IsWindowChild()) // remembering the child
+	// if the object is a window child.
+	if (obj->IsWindowChild()) // remembering the child
 		util::addToVector(windowChildren, obj);
 	
 
-	return added;
+	return true;
 }
 
 // removes an object from the list based on if it is the correct index.
@@ -283,18 +314,10 @@ cherry::Object* cherry::ObjectList::RemoveObjectByIndex(unsigned int index)
 	if (index >= objects.size())
 		return nullptr;
 
-	// gets a pointer to the object, removes it, and then returns said object.
-	cherry::Object* obj = objects[index];
-
-	if (obj != nullptr)
-	{
-		util::removeFromVector(objects, obj);
-
-		if (obj->IsWindowChild()) // if the object is a window child, it is removed.
-			util::removeFromVector(windowChildren, obj);
-	}
+	CheckIndexes();
 
-	return obj;
+	// removes the object, and then returns said object.
+	return RemoveObjectAt(index);
 }
 
 // removes the object based on a pointer to said object.
@@ -303,32 +326,86 @@ cherry::Object* cherry::ObjectList::RemoveObjectByPointer(cherry::Object* obj)
 	if (obj == nullptr)
 		return nullptr;
 
-	if (util::removeFromVector(objects, obj)) // if the object was found and removed
-	{
-		if (obj->IsWindowChild()) // if the object is a window child, it is removed.
-			util::removeFromVector(windowChildren, obj);
+	int index = GetObjectIndex(obj);
 
-		return obj;
-	}
+	if (index >= 0) // if the object was found
+		return RemoveObjectAt(index);
 	else // object wasn't in the list.
-	{
 		return nullptr;
-	}
 }
 
 // removes an object by its name.
 cherry::Object* cherry::ObjectList::RemoveObjectByName(std::string name)
 {
-	for (Object* obj : objects) // searches for object with a given name.
+	// searches for object with a given name.
+	Object* obj = GetObjectByName(name);
+
+	// if the object wasn't found, a nullptr is returned.
+	return (obj != nullptr) ? RemoveObjectByPointer(obj) : nullptr;
+}
+
+// rebuilds the indexes
+void cherry::ObjectList::CheckIndexes()
+{
+	// the indexes are still up to date.
+	if (objectIndexes.size() == objects.size())
+		return;
+
+	objectIndexes.clear();
+	objectNames.clear();
+
+	for (size_t i = 0; i < objects.size(); i++)
 	{
-		if (obj->GetName() == name) // object with proper name found.
+		objectIndexes[objects[i]] = i;
+		objectNames.emplace(objects[i]->GetName(), objects[i]);
+	}
+}
+
+// removes the object at the index
+cherry::Object* cherry::ObjectList::RemoveObjectAt(size_t index)
+{
+	cherry::Object* obj = objects[index];
+
+	// the last object takes the place of the removed object.
+	objects[index] = objects.back();
+	objectIndexes[objects[index]] = index;
+	objects.pop_back();
+
+	objectIndexes.erase(obj);
+	RemoveObjectName(obj, obj->GetName());
+
+	if (obj->IsWindowChild()) // if the object is a window child, it is removed.
+		util::removeFromVector(windowChildren, obj);
+
+	return obj;
+}
+
+// removes the object's name
+void cherry::ObjectList::RemoveObjectName(cherry::Object* object, const std::string& name)
+{
+	auto range = objectNames.equal_range(name);
+
+	for (auto iter = range.first; iter != range.second; iter++)
+	{
+		if (iter->second == object)
 		{
-			return RemoveObjectByPointer(obj);
+			objectNames.erase(iter);
+			return;
 		}
 	}
+}
+
+// renames an object
+void cherry::ObjectList::RenameObject(cherry::Object* object, const std::string& oldName)
+{
+	CheckIndexes();
+
+	// the object isn't in this list.
+	if (objectIndexes.count(object) == 0)
+		return;
 
-	// no object with said name found.
-	return nullptr;
+	RemoveObjectName(object, oldName);
+	objectNames.emplace(object->GetName(), object);
 }
 
 // deletes an object from memory via its index in the list.
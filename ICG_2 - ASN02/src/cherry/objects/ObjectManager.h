@@ -1,6 +1,7 @@
 #pragma once
 
 // #include "Object.h"
+#include <unordered_map>
 #include "Primitives.h"
 #include "Image.h"
 #include "Liquid.h"
@@ -65,11 +66,20 @@ namespace cherry
 		// updates the object when a window child is added or removed.
 		static void UpdateWindowChild(cherry::Object* object);
 
+		// updates the name the object is found by in its scene object list.
+		static void UpdateObjectName(cherry::Object* object, const std::string& oldName);
+
+		// reloads the meshes of all objects (in every scene) that were loaded from the provided .obj file. Returns the amount of objects reloaded.
+		static int ReloadObjectFile(const std::string& filePath);
+
 	private:
 
 		// a vector that contains a series of pointer vectors that all contain teir list of sceneLists
 		static std::vector<cherry::ObjectList *> objectLists;
 
+		// the object lists by the name of their scene, which is kept in sync with objectLists.
+		static std::unordered_map<std::string, cherry::ObjectList*> objectListMap;
+
 	protected:
 
 	};
@@ -95,9 +105,10 @@ namespace cherry
 		// finds and returns an object via its index. Returns a nullptr if no object is found.
 		cherry::Object* GetObjectByIndex(unsigned int index);
 
-		// TODO: add 'get object index'?
+		// gets the index of the object in the list. If the object isn't in the list, -1 is returned.
+		int GetObjectIndex(cherry::Object* obj);
 		
-		// gets the first object found with the provided name.
+		// gets an object with the provided name. If more than one object has the name, any one of them may be returned.
 		cherry::Object* GetObjectByName(std::string name);
 
 
@@ -105,6 +116,7 @@ namespace cherry
 		bool AddObject(cherry::Object * obj);
 
 		// removes an object from the list, and returns it. This is based on the index of the object.
+		// the last object in the list is moved into the removed object's index, so the order of the list isn't kept.
 		// this does not delete the object from memory. To do so, use DeleteObject.
 		cherry::Object * RemoveObjectByIndex(unsigned int index);
 
@@ -146,6 +158,9 @@ namespace cherry
 		// this does not remove the window child from the overall object list.
 		void ForgetWindowChild(cherry::Object* object);
 
+		// called when an object in the list has been renamed, so that it can be found by its new name.
+		void RenameObject(cherry::Object* object, const std::string& oldName);
+
 		// called when the window is being resized for window children.
 		void OnWindowResize(int newWidth, int newHeight);
 
@@ -156,11 +171,28 @@ namespace cherry
 		// bool checkCollision = true;
 
 		// this should REALLY be private, but there's no time to change that.
+		// objects should be added and removed using the functions above so that the indexes below are kept up to date.
+		// if the vector is changed directly, the indexes are rebuilt the next time they're used and don't match its size.
 		std::vector<cherry::Object*> objects; // the vector of sceneLists
 
 	private:
+		// rebuilds the indexes if the object vector was changed without using the list's functions.
+		void CheckIndexes();
+
+		// removes the object at the index by moving the last object into its place.
+		cherry::Object* RemoveObjectAt(size_t index);
+
+		// removes an object from the name index.
+		void RemoveObjectName(cherry::Object* object, const std::string& name);
+
 		std::string scene = ""; // the scene te object is in. TODO: make consts?
 
+		// the index of each object in the objects vector.
+		std::unordered_map<cherry::Object*, size_t> objectIndexes;
+
+		// the objects by their names.
+		std::unordered_multimap<std::string, cherry::Object*> objectNames;
+
 		std::vector<cherry::Object*> windowChildren;
 
 	protected:
@@ -15,84 +15,133 @@ cherry::Primitive::Primitive() : cherry::Object()
 // destructor
 cherry::Primitive::~Primitive()
 {
-	// delete[] indices; // TODO: fix deletions
+	// the vertices and indices from the cache are shared, so they're left for the cache to delete.
+	if (shape != nullptr)
+	{
+		if (vertices == shape->Vertices.data())
+			vertices = nullptr;
+
+		if (indices == shape->Indices.data())
+			indices = nullptr;
+	}
 }
 
 // gets the base colour of the primitive.
 cherry::Vec4 cherry::Primitive::GetColor() const { return color; }
 
 // calculates the normals of the primitive.
-void cherry::Primitive::CalculateNormals()
-{
-	// dynamic array of surface normals.
-	// float* surfaceNormals = new float[round(indicesTotal / 3.0F)];
-	unsigned int* vertexNormals = new unsigned int[verticesTotal] {0}; // gets the vertex normals
-
+void cherry::Primitive::CalculateNormals() { CalculateNormals(vertices, verticesTotal, indices, indicesTotal); }
 
-	// setting up the normals
-	glm::vec3 uVec;
-	glm::vec3 vVec;
-	glm::vec3 uvVec;
+// calculates the normals of the vertices.
+void cherry::Primitive::CalculateNormals(Vertex* vertices, unsigned int verticesTotal, const uint32_t* indices, unsigned int indicesTotal)
+{
+	if (vertices == nullptr || indices == nullptr)
+		return;
 
-	// goes through each triangle and calculates the normal
-	for (int i = 0; i < indicesTotal; i += 3)
-	{
-		glm::vec3 tempVec;
-		// u = p2 - p1
-		uVec = vertices[indices[i + 1]].Position - vertices[indices[i]].Position;
-		
-		// v = p3 - p1
-		vVec = vertices[indices[i + 2]].Position - vertices[indices[i]].Position;
-		
-
-		// gets the normal vector, which uses cross product.
-		// uvVec = uVec.cross(vVec);
-		uvVec.x = uVec.y * vVec.z - uVec.z * vVec.y;
-		uvVec.y = uVec.z * vVec.x - uVec.x * vVec.z;
-		uvVec.z = uVec.x * vVec.y - uVec.y * vVec.x;
-
-		// saves the normals, and how many faces connect to the given vertex
-		vertices[indices[i]].Normal += uvVec;
-		vertexNormals[indices[i]]++;
-
-		vertices[indices[i + 1]].Normal += uvVec;
-		vertexNormals[indices[i + 1]]++;
-
-		vertices[indices[i + 2]].Normal += uvVec;
-		vertexNormals[indices[i + 2]]++;
-	}
+	// the normals are added up in their own array, so the second loop goes through memory in order.
+	std::vector<glm::vec3> normals(verticesTotal, glm::vec3(0.0F));
 
-	// averages and normalizes each vertex normal.
-	for (int i = 0; i < verticesTotal; i++)
+	// the cross product of two edges is the normal of the triangle scaled by twice its area, so it isn't normalized here.
+	// this also means the normals are still correct once the primitive is scaled, since the normal matrix scales each triangle the same way.
+	for (unsigned int i = 0; i + 2 < indicesTotal; i += 3)
 	{
-		glm::vec3 x = vertices[i].Normal;
-		int y = vertexNormals[i];
-
-		// gets the average of the normals
-		vertices[i].Normal = glm::vec3(
-			vertices[i].Normal.x / vertexNormals[i], 
-			vertices[i].Normal.y / vertexNormals[i], 
-			vertices[i].Normal.z / vertexNormals[i]);
+		const uint32_t i0 = indices[i];
+		const uint32_t i1 = indices[i + 1];
+		const uint32_t i2 = indices[i + 2];
 
-		x = vertices[i].Normal;
+		const glm::vec3 p0 = vertices[i0].Position;
+		const glm::vec3 faceNormal = glm::cross(vertices[i1].Position - p0, vertices[i2].Position - p0);
 
-		// normalizes the normal (v / ||v||)
-		vertices[i].Normal = glm::vec3(
-			vertices[i].Normal.x / vertices[i].Normal.length(), 
-			vertices[i].Normal.y / vertices[i].Normal.length(), 
-			vertices[i].Normal.z / vertices[i].Normal.length());
+		normals[i0] += faceNormal;
+		normals[i1] += faceNormal;
+		normals[i2] += faceNormal;
+	}
 
-		x = vertices[i].Normal;
-		y = vertexNormals[i];
+	// normalizes each vertex normal (v / ||v||). Vertices that aren't part of a triangle are given a normal of zero.
+	for (unsigned int i = 0; i < verticesTotal; i++)
+	{
+		const float lengthSquared = glm::dot(normals[i], normals[i]);
+		vertices[i].Normal = (lengthSquared > 0.0F) ? normals[i] * glm::inversesqrt(lengthSquared) : glm::vec3(0.0F);
 	}
 }
 
 // flip the normals
-void cherry::Primitive::InvertNormals()
+void cherry::Primitive::InvertNormals() { InvertNormals(vertices, verticesTotal); }
+
+// flips the normals of the vertices
+void cherry::Primitive::InvertNormals(Vertex* vertices, unsigned int verticesTotal)
 {
 	if (vertices == nullptr)
 		return;
 
-	for (int i = 0; i < verticesTotal; i++)
-		vertices[i].Normal *= -1;
+	for (unsigned int i = 0; i < verticesTotal; i++)
+		vertices[i].Normal = -vertices[i].Normal;
+}
+
+// loads the shape
+void cherry::Primitive::LoadShape(const std::string& type, std::initializer_list<float> settings, glm::vec3 size, bool normals, const PrimitiveCache::Generator& generate)
+{
+	const glm::vec4 clr(color.v.x, color.v.y, color.v.z, color.v.w);
+
+	shape = PrimitiveCache::Get(PrimitiveCache::MakeKey(type, settings, clr), clr, normals, generate);
+
+	// the primitive only reads its vertices and indices, so it uses the ones in the cache instead of a copy.
+	vertices = const_cast<Vertex*>(shape->Vertices.data());
+	verticesTotal = shape->Vertices.size();
+
+	indices = const_cast<uint32_t*>(shape->Indices.data());
+	indicesTotal = shape->Indices.size();
+
+	meshBodyMin = shape->Min;
+	meshBodyMax = shape->Max;
+
+	// the mesh draws the shape's buffers, but has its own settings.
+	mesh = std::make_shared<Mesh>(shape->SourceMesh);
+
+	SetScale(size);
 }
+
+// makes a cone
+void cherry::Primitive::MakeCone(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, unsigned int segments, float ringHeight)
+{
+	std::vector<float> sines, cosines; // the angles around the z-axis
+	MakeSegmentAngles(segments, sines, cosines);
+
+	// the top vertex, the ring, and the bottom vertex.
+	vertices.assign(segments + 2, Vertex{ glm::vec3(0.0F), glm::vec4(1.0F), glm::vec3(0.0F), glm::vec2(0.0F) });
+
+	// three indices per triangle, needed for the top and bottom of the cone.
+	indices.clear();
+	indices.reserve(segments * 2 * 3);
+
+	const uint32_t bottomIndex = segments + 1;
+
+	vertices[0].Position = glm::vec3(0.0F, 0.0F, 1.0F);
+	vertices[bottomIndex].Position = glm::vec3(0.0F, 0.0F, -1.0F);
+
+	for (unsigned int i = 0; i < segments; i++)
+		vertices[i + 1].Position = glm::vec3(cosines[i], sines[i], ringHeight);
+
+	// draws the triangles from the highest point down.
+	for (uint32_t i = 1; i <= segments; i++)
+		indices.insert(indices.end(), { 0, i, (i == segments) ? 1 : i + 1 });
+
+	// the base (or the lower half of a diamond).
+	for (uint32_t i = 1; i <= segments; i++)
+		indices.insert(indices.end(), { i, bottomIndex, (i == segments) ? 1 : i + 1 });
+}
+
+// gets the sines and cosines
+void cherry::Primitive::MakeSegmentAngles(unsigned int segments, std::vector<float>& sines, std::vector<float>& cosines)
+{
+	const float inc = glm::radians(360.0F / (float)segments); // increment for rotations around the z-axis
+
+	sines.resize(segments);
+	cosines.resize(segments);
+
+	for (unsigned int i = 0; i < segments; i++)
+	{
+		sines[i] = sinf(inc * i);
+		cosines[i] = cosf(inc * i);
+	}
+}
\ No newline at end of file
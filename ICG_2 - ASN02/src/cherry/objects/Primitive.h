@@ -2,11 +2,17 @@
 #pragma once
 
 #include "Object.h"
+#include "PrimitiveCache.h"
 
 namespace cherry
 {
 	// all primitives inherit from this
 	// TODO: make abstract class
+	/*
+	 * Primitives get their vertices and mesh from the PrimitiveCache, so primitives with the same settings share them.
+	 * The shapes are made at a size of 1, so the size of a primitive is its scale. Setting the scale replaces the size it was made with.
+	 * Physics bodies are scaled with their object, so bodies added to a primitive should be sized for a primitive with a size of 1.
+	*/
 	class Primitive : public cherry::Object
 	{
 	public:
@@ -23,6 +29,13 @@ namespace cherry
 		// would this work?
 		// virtual std::string ToString() = 0;
 
+		// calculates the normals of the vertices from their triangles.
+		// each triangle adds its normal to its vertices, weighted by its area, and then the normals are normalized.
+		static void CalculateNormals(Vertex* vertices, unsigned int verticesTotal, const uint32_t* indices, unsigned int indicesTotal);
+
+		// changes the direction of the normals.
+		static void InvertNormals(Vertex* vertices, unsigned int verticesTotal);
+
 	private:
 		// cherry::Vec4 baseColor; // the base color of the object.
 
@@ -36,7 +49,74 @@ namespace cherry
 		// changes the direction of the normals. Only call this if vertices are set.
 		void InvertNormals();
 
+		// sets the primitive up using the shape for the provided type and settings, which is generated if it isn't in the cache yet.
+		// the shape is made at a size of 1, so the scale is set to the provided size.
+		void LoadShape(const std::string& type, std::initializer_list<float> settings, glm::vec3 size, bool normals, const PrimitiveCache::Generator& generate);
+
+		// makes a shape out of rings around the z-axis, with a point at the top and bottom (e.g. spheres, capsules, and cylinders).
+		// the position function gives the position of a vertex from its row (1 to rows - 1, from the top down) and segment.
+		template<typename T>
+		static void MakeRings(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, unsigned int rows, unsigned int segments,
+			glm::vec3 top, glm::vec3 bottom, T position);
+
+		// makes a ring around the z-axis with a point at the top (z = 1) and bottom (z = -1), with the ring at the provided height (e.g. cones and diamonds).
+		// for cones, the ring is at the bottom, so the bottom point is the centre of the base.
+		static void MakeCone(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, unsigned int segments, float ringHeight);
+
+		// gets the sine and cosine of the angles around the z-axis for each segment, so they aren't recalculated for every vertex.
+		static void MakeSegmentAngles(unsigned int segments, std::vector<float>& sines, std::vector<float>& cosines);
+
+		// the shape from the cache.
+		std::shared_ptr<const PrimitiveShape> shape;
+
 		// colour
 		cherry::Vec4 color{ 1.0F, 1.0F, 1.0F, 1.0F }; // the base color of the object.
 	};
+
+	// makes the rings
+	template<typename T>
+	void Primitive::MakeRings(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices, unsigned int rows, unsigned int segments,
+		glm::vec3 top, glm::vec3 bottom, T position)
+	{
+		// the top and bottom points, plus a ring for each row between them.
+		vertices.assign((rows - 1) * segments + 2, Vertex{ glm::vec3(0.0F), glm::vec4(1.0F), glm::vec3(0.0F), glm::vec2(0.0F) });
+
+		// the top and bottom rows are single triangles that come to a point, while the rest use two triangles per segment.
+		indices.clear();
+		indices.reserve((segments * 2 + (rows - 2) * segments * 2) * 3);
+
+		const uint32_t bottomIndex = vertices.size() - 1;
+
+		// gets the index of the vertex in the provided row and segment. The segments wrap around.
+		auto ring = [segments](unsigned int row, unsigned int seg) { return (uint32_t)(1 + (row - 1) * segments + seg % segments); };
+
+		vertices[0].Position = top;
+		vertices[bottomIndex].Position = bottom;
+
+		for (unsigned int row = 1; row < rows; row++)
+		{
+			for (unsigned int seg = 0; seg < segments; seg++)
+				vertices[ring(row, seg)].Position = position(row, seg);
+		}
+
+		// top point -> bottom left -> bottom right
+		for (unsigned int seg = 0; seg < segments; seg++)
+			indices.insert(indices.end(), { 0, ring(1, seg), ring(1, seg + 1) });
+
+		for (unsigned int row = 1; row < rows - 1; row++)
+		{
+			for (unsigned int seg = 0; seg < segments; seg++)
+			{
+				// triangle 1 (top left -> bottom left -> top right)
+				indices.insert(indices.end(), { ring(row, seg), ring(row + 1, seg), ring(row, seg + 1) });
+
+				// triangle 2 (bottom left -> bottom right -> top right)
+				indices.insert(indices.end(), { ring(row + 1, seg), ring(row + 1, seg + 1), ring(row, seg + 1) });
+			}
+		}
+
+		// top left -> bottom point -> top right
+		for (unsigned int seg = 0; seg < segments; seg++)
+			indices.insert(indices.end(), { ring(rows - 1, seg), bottomIndex, ring(rows - 1, seg + 1) });
+	}
 }
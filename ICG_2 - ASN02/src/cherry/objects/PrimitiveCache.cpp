@@ -0,0 +1,64 @@
+// PrimitiveCache (Source) - shares the vertices and meshes of primitives that are made with the same settings.
+#include "PrimitiveCache.h"
+#include "Primitive.h"
+
+#include <string.h>
+
+std::unordered_map<std::string, std::shared_ptr<const cherry::PrimitiveShape>> cherry::PrimitiveCache::shapes;
+
+// gets a shape
+std::shared_ptr<const cherry::PrimitiveShape> cherry::PrimitiveCache::Get(const std::string& key, const glm::vec4& color, bool normals, const Generator& generate)
+{
+	auto it = shapes.find(key);
+
+	if (it != shapes.end())
+		return it->second;
+
+	std::shared_ptr<PrimitiveShape> shape = std::make_shared<PrimitiveShape>();
+	generate(shape->Vertices, shape->Indices);
+
+	for (Vertex& vertex : shape->Vertices)
+		vertex.Color = color;
+
+	// the triangles are wound counter-clockwise when seen from the outside, so the normals face outwards.
+	if (normals)
+		Primitive::CalculateNormals(shape->Vertices.data(), shape->Vertices.size(), shape->Indices.data(), shape->Indices.size());
+
+	shape->Min = Object::CalculateMeshBodyMinimum(shape->Vertices.data(), shape->Vertices.size());
+	shape->Max = Object::CalculateMeshBodyMaximum(shape->Vertices.data(), shape->Vertices.size());
+
+	shape->SourceMesh = std::make_shared<Mesh>(shape->Vertices.data(), shape->Vertices.size(), shape->Indices.data(), shape->Indices.size());
+
+	shapes[key] = shape;
+	return shape;
+}
+
+// checks if the shape is in the cache
+bool cherry::PrimitiveCache::Contains(const std::string& key) { return shapes.find(key) != shapes.end(); }
+
+// gets the amount of shapes
+size_t cherry::PrimitiveCache::GetCount() { return shapes.size(); }
+
+// clears the cache
+void cherry::PrimitiveCache::Clear() { shapes.clear(); }
+
+// makes the key
+std::string cherry::PrimitiveCache::MakeKey(const std::string& type, std::initializer_list<float> settings, const glm::vec4& color)
+{
+	std::string key = type;
+	uint32_t bits = 0;
+
+	for (float value : settings)
+	{
+		memcpy(&bits, &value, sizeof(float));
+		key += "|" + std::to_string(bits);
+	}
+
+	for (int i = 0; i < 4; i++)
+	{
+		memcpy(&bits, &color[i], sizeof(float));
+		key += "|" + std::to_string(bits);
+	}
+
+	return key;
+}
@@ -0,0 +1,58 @@
+// PrimitiveCache (Header) - shares the vertices and meshes of primitives that are made with the same settings.
+#pragma once
+#include "..\Mesh.h"
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include <initializer_list>
+
+namespace cherry
+{
+	// the shape of a primitive at a size of 1, which is shared by every primitive made with the same settings.
+	struct PrimitiveShape
+	{
+		std::vector<Vertex> Vertices;
+		std::vector<uint32_t> Indices;
+
+		cherry::Vec3 Min, Max; // the limits of the vertices (see Object::CalculateMeshBody()).
+
+		// the mesh made from the vertices. Primitives draw it through a mesh of their own (see Mesh::Mesh(const Sptr&)), so their settings aren't shared.
+		Mesh::Sptr SourceMesh;
+	};
+
+	/*
+	 * The cache keeps one shape for each key (the type of primitive, its segments, and its colour), which is generated the first time it's asked for.
+	 * The shapes are made at a size of 1, and each primitive is stretched to the size it was given by its scale.
+	 * Making a primitive that's already in the cache doesn't generate any vertices or upload anything to the GPU.
+	*/
+	class PrimitiveCache
+	{
+	public:
+		// fills in the positions, normals, and UVs of a shape's vertices, and its indices. The colours are filled in by the cache.
+		typedef std::function<void(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)> Generator;
+
+		// gets the shape with the provided key. If it hasn't been made yet, it's generated and its mesh is made.
+		// if 'normals' is true, the normals are calculated from the triangles (see Primitive::CalculateNormals()).
+		static std::shared_ptr<const PrimitiveShape> Get(const std::string& key, const glm::vec4& color, bool normals, const Generator& generate);
+
+		// returns 'true' if the shape is in the cache.
+		static bool Contains(const std::string& key);
+
+		// gets the amount of shapes in the cache.
+		static size_t GetCount();
+
+		// removes all of the shapes from the cache. Shapes that are still being used by primitives aren't deleted until they're no longer used.
+		static void Clear();
+
+		// makes the key for a shape from the type of primitive, its settings, and its colour.
+		// the bits of each value are used, so shapes that are only slightly different don't share a key.
+		static std::string MakeKey(const std::string& type, std::initializer_list<float> settings, const glm::vec4& color);
+
+	private:
+		// the shapes, by their key.
+		static std::unordered_map<std::string, std::shared_ptr<const PrimitiveShape>> shapes;
+	};
+}
@@ -1,6 +1,5 @@
 // PrimitiveCircle - used for making circles
 #include "PrimitiveCircle.h"
-#include "..\utils\math\Rotation.h"
 
 // creates a circle
 cherry::PrimitiveCircle::PrimitiveCircle(float radius, unsigned int edges, bool doubleSided, cherry::Vec4 color) : radius(abs(radius))
@@ -18,53 +17,29 @@ cherry::PrimitiveCircle::PrimitiveCircle(float radius, unsigned int edges, bool
 
 	this->color = color; // saving the colour.
 
-	float rFactor = 0; // the rotation factor
-	float rInc = glm::radians(360.0F / (float)edges);
-
-	unsigned int indiIndex = 0; // the index used for the indices
-
-	// vertices
-	verticesTotal = edges + 1; // centre vertex, plush a certain amount of edges
-	vertices = new Vertex[verticesTotal];
-
-	// indices
-	indicesTotal = edges * 3; // three indices per triangle
-	indices = new uint32_t[indicesTotal];
-	
-	// centre vertex (position, colour, and normal)
-	vertices[0] = { { 0.0F, 0.0F, 0.0F}, {color.v.x, color.v.y, color.v.z, color.v.w}, {0.0F, 0.0F, 1.0F} };
-
-	// adds in all the vertices
-	for (int i = 1; i < verticesTotal && indiIndex < indicesTotal; i++)
+	// the circle is made with a radius of 1, and is scaled to the radius.
+	LoadShape("circle", { (float)edges }, glm::vec3(radius, radius, 1.0F), false, [edges](std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
 	{
-		// rotates the vector
-		// NOTE: as long as radius is set for (x) or (y), it doesn't matter.
-		cherry::Vec3 tempVec = util::math::rotateZ(util::math::Vec3(radius, 0.0F, 0.0F), rFactor, false);
+		std::vector<float> sines, cosines; // the angles around the z-axis
+		MakeSegmentAngles(edges, sines, cosines);
+
+		// centre vertex, plus a certain amount of edges. Every vertex faces upwards.
+		vertices.assign(edges + 1, Vertex{ glm::vec3(0.0F), glm::vec4(1.0F), glm::vec3(0.0F, 0.0F, 1.0F), glm::vec2(0.0F) });
 
-		// vertex (position, colour, and normal)
-		vertices[i] = { {tempVec.v.x, tempVec.v.y, tempVec.v.z}, {color.v.x, color.v.y, color.v.z, color.v.w}, {0.0F, 0.0F, 1.0F} };
-		
-		// centre -> top left -> top right
-		indices[indiIndex] = 0;
-		indices[++indiIndex] = i;
+		// three indices per triangle
+		indices.clear();
+		indices.reserve(edges * 3);
 
-		// final triangle
-		if (i == verticesTotal - 1)
-			indices[++indiIndex] = 1;
-		else // other trangles
-			indices[++indiIndex] = i + 1;
-		
-		rFactor += rInc; // increases the rotation factor
-		indiIndex++; // increases the index for indices
-	}
+		for (uint32_t i = 1; i <= edges; i++)
+		{
+			vertices[i].Position = glm::vec3(cosines[i - 1], sines[i - 1], 0.0F);
 
-	CalculateMeshBody(); // calculates the limits of the mesh body.
+			// centre -> top left -> top right
+			indices.insert(indices.end(), { 0, i, (i == edges) ? 1 : i + 1 });
+		}
+	});
 
-	// creating the mesh
-	mesh = std::make_shared<Mesh>(vertices, verticesTotal, indices, indicesTotal);
 	mesh->cullFaces = !doubleSided;
-	// setting the position
-	// setPosition(pos.v->x, pos.v->y, pos.v->z);
 }
 
 // gets the radius
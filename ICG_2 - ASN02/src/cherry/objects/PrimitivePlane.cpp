@@ -15,28 +15,26 @@ cherry::PrimitivePlane::PrimitivePlane(float width, float height, bool doubleSid
 
 	this->color = color; // saving the colour.
 
-	// Position and Colour
-	verticesTotal = 4;
-	vertices = new Vertex [verticesTotal] 
+	// the plane is made from -1 to 1, and is scaled to the width and height.
+	LoadShape("plane", {}, glm::vec3(width / 2.0F, height / 2.0F, 1.0F), false, [](std::vector<Vertex>& vertices, std::vector<uint32_t>& indices)
 	{
-		//  x			  y				  z		   r	 g	   b	 a		 // normals
-		{{ -width / 2.0F, -height / 2.0F, 0.0f }, { color.v.x, color.v.y, color.v.z, color.v.w }, {0.0F, 0.0F, 1.0F}, {0.0F, 0.0F}}, // bottom left
-		{{  width / 2.0F, -height / 2.0F, 0.0f }, { color.v.x, color.v.y, color.v.z, color.v.w }, {0.0F, 0.0F, 1.0F}, {1.0F, 0.0F}}, // bottom right
-		{{ -width / 2.0F,  height / 2.0F, 0.0f }, { color.v.x, color.v.y, color.v.z, color.v.w }, {0.0F, 0.0F, 1.0F}, {0.0F, 1.0F}}, // top left
-		{{  width / 2.0F,  height / 2.0F, 0.0f }, { color.v.x, color.v.y, color.v.z, color.v.w }, {0.0F, 0.0F, 1.0F}, {1.0F, 1.0F}}, // top right
-	};
-
-	// indices
-	indicesTotal = 6;
-	indices = new uint32_t[indicesTotal] {
-		0, 1, 2,
-		2, 1, 3
-	}; 
-
-	CalculateMeshBody(); // calculates the limits of the mesh body.
-
-	// Create a new mesh from the data
-	mesh = std::make_shared<Mesh>(vertices, verticesTotal, indices, indicesTotal);
+		// Position, Normals, and UVs. The colours are filled in by the cache.
+		vertices =
+		{
+			//  x	   y	  z			 // normals
+			{{ -1.0F, -1.0F, 0.0f }, {}, {0.0F, 0.0F, 1.0F}, {0.0F, 0.0F}}, // bottom left
+			{{  1.0F, -1.0F, 0.0f }, {}, {0.0F, 0.0F, 1.0F}, {1.0F, 0.0F}}, // bottom right
+			{{ -1.0F,  1.0F, 0.0f }, {}, {0.0F, 0.0F, 1.0F}, {0.0F, 1.0F}}, // top left
+			{{  1.0F,  1.0F, 0.0f }, {}, {0.0F, 0.0F, 1.0F}, {1.0F, 1.0F}}, // top right
+		};
+
+		// indices
+		indices = {
+			0, 1, 2,
+			2, 1, 3
+		};
+	});
+
 	mesh->cullFaces = !doubleSided;
 }
 
@@ -1,4 +1,9 @@
 #include "Terrain.h"
+#include "..\Game.h"
+#include "..\Frustum.h"
+#include "..\MeshRenderer.h"
+#include "..\WorldTransform.h"
+#include "..\scenes\SceneManager.h"
 #include <fstream>
 
 const int cherry::Terrain::TEXTURES_MAX = 3;
@@ -13,6 +18,7 @@ cherry::Terrain::Terrain(std::string scene, std::string heightMap, float size, f
 
 	this->size = size;
 	this->numSections = numSections;
+	this->worldUVs = worldUVs;
 
 	std::ifstream file(heightMap, std::ios::in); // opens the file
 	// file.open(filePath, std::ios::in); // opens file
@@ -36,7 +42,18 @@ cherry::Terrain::Terrain(std::string scene, std::string heightMap, float size, f
 	file.close();
 	this->heightMap = heightMap;
 
-	mesh = Mesh::MakeSubdividedPlane(size, numSections, worldUVs);
+	// the height map is decoded on the CPU once, which is used for the patch bounds and height queries.
+	heightField.LoadFromFile(heightMap);
+
+	// adds levels until the smallest patches have at least as many quads across the terrain as requested.
+	lodCount = 1;
+	while (lodCount < TERRAIN_MAX_LODS && (TERRAIN_PATCH_SECTIONS << (lodCount - 1)) < this->numSections)
+		lodCount++;
+
+	BuildPatches();
+
+	// the root patch's mesh is used as the object's mesh, so its settings (visibility, wireframe, etc.) are used for every patch.
+	mesh = patches[0].mesh;
 
 	Shader::Sptr terrainShader = std::make_shared<Shader>();
 	terrainShader->Load("res/shaders/terrain.vs.glsl", "res/shaders/terrain.fs.glsl");
@@ -56,7 +73,24 @@ cherry::Terrain::Terrain(std::string scene, std::string heightMap, float size, f
 	material->Set("s_Albedos[1]", albedo); // grass: medium terrain height
 	material->Set("s_Albedos[2]", albedo); // rocks: highest terrain (originally 'snow')
 
-	CreateEntity(scene, material); 
+	CreateEntity(scene, material); // the entity for the root patch
+	CreatePatchEntities(scene);
+}
+
+// destructor
+cherry::Terrain::~Terrain()
+{
+	// the root patch's entity is destroyed by the object.
+	if (!SceneManager::HasScene(GetSceneName()))
+		return;
+
+	auto& ecs = GetRegistry(GetSceneName());
+
+	for (size_t i = 1; i < patches.size(); i++)
+	{
+		if (ecs.valid(patches[i].entity))
+			ecs.destroy(patches[i].entity);
+	}
 }
 
 // returns the height map.
@@ -78,6 +112,22 @@ bool cherry::Terrain::SetHeightMap(std::string hm)
 
 	heightMap = hm;
 	material->Set("a_TextureSampler", Texture2D::LoadFromFile(hm));
+
+	// the bounds and skirts of the patches depend on the heights, so the patch meshes are made again.
+	Mesh::Sptr oldRoot = mesh;
+	heightField.LoadFromFile(hm);
+
+	for (Patch& patch : patches)
+	{
+		heightField.GetRange(GetLocalUV(patch.min).x, GetLocalUV(patch.min).y, GetLocalUV(patch.max).x, GetLocalUV(patch.max).y,
+			patch.valueMin, patch.valueMax);
+
+		patch.mesh = MakePatchMesh(patch);
+	}
+
+	mesh = patches[0].mesh;
+	CopyMeshSettings(oldRoot, mesh);
+
 	return true;
 }
 
@@ -124,8 +174,361 @@ bool cherry::Terrain::SetTexture(unsigned int index, std::string filePath)
 	return true;
 }
 
+// gets the height at a world position
+float cherry::Terrain::GetHeightAt(float x, float y) const
+{
+	glm::mat4 world = CalculateWorldTransformation();
+	glm::vec4 local = glm::inverse(world) * glm::vec4(x, y, 0.0F, 1.0F);
+
+	// points off of the terrain use the closest edge.
+	glm::vec2 localPos = glm::clamp(glm::vec2(local), glm::vec2(-size / 2.0F), glm::vec2(size / 2.0F));
+	glm::vec2 uv = GetLocalUV(localPos);
+
+	float localHeight = GetLocalHeight(heightField.Sample(uv.x, uv.y));
+
+	return (world * glm::vec4(localPos, localHeight, 1.0F)).z;
+}
+
+// gets the normal at a world position
+glm::vec3 cherry::Terrain::GetNormalAt(float x, float y) const
+{
+	glm::mat4 world = CalculateWorldTransformation();
+	glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(world)));
+
+	if (heightField.IsEmpty())
+		return glm::normalize(normalMatrix * glm::vec3(0.0F, 0.0F, 1.0F));
+
+	glm::vec4 local = glm::inverse(world) * glm::vec4(x, y, 0.0F, 1.0F);
+	glm::vec2 localPos = glm::clamp(glm::vec2(local), glm::vec2(-size / 2.0F), glm::vec2(size / 2.0F));
+	glm::vec2 uv = GetLocalUV(localPos);
+
+	// the size of a texel in uv coordinates and in local space.
+	glm::vec2 texel = glm::vec2(1.0F / heightField.GetWidth(), 1.0F / heightField.GetHeight());
+	glm::vec2 texelLocal = (worldUVs) ? texel : texel * size;
+
+	// central differences
+	float left = GetLocalHeight(heightField.Sample(uv.x - texel.x, uv.y));
+	float right = GetLocalHeight(heightField.Sample(uv.x + texel.x, uv.y));
+	float down = GetLocalHeight(heightField.Sample(uv.x, uv.y - texel.y));
+	float up = GetLocalHeight(heightField.Sample(uv.x, uv.y + texel.y));
+
+	glm::vec3 localNormal = glm::normalize(glm::vec3(
+		-(right - left) / (2.0F * texelLocal.x),
+		-(up - down) / (2.0F * texelLocal.y),
+		1.0F
+	));
+
+	return glm::normalize(normalMatrix * localNormal);
+}
+
+// gets the lod distance
+float cherry::Terrain::GetLodDistance() const { return lodDistance; }
+
+// sets the lod distance
+void cherry::Terrain::SetLodDistance(float distance) { lodDistance = (distance < 0.0F) ? 0.0F : distance; }
+
+// gets the amount of levels of detail.
+int cherry::Terrain::GetLodCount() const { return lodCount; }
+
+// gets the amount of patches
+int cherry::Terrain::GetPatchCount() const { return (int)patches.size(); }
+
+// gets the amount of drawn patches
+int cherry::Terrain::GetDrawnPatchCount() const { return drawnPatches; }
+
+// gets the amount of culled patches
+int cherry::Terrain::GetCulledPatchCount() const { return culledPatches; }
+
 // updates the object.
 void cherry::Terrain::Update(float deltaTime)
 {
 	Object::Update(deltaTime);
+	SelectPatches();
+}
+
+// builds the patches
+void cherry::Terrain::BuildPatches()
+{
+	patches.clear();
+	patches.reserve(((1 << (2 * lodCount)) - 1) / 3); // 1 + 4 + 16 + ...
+
+	AddPatch(glm::vec2(-size / 2.0F), glm::vec2(size / 2.0F), 0);
 }
+
+// adds a patch
+int cherry::Terrain::AddPatch(const glm::vec2& min, const glm::vec2& max, int level)
+{
+	Patch patch;
+	patch.min = min;
+	patch.max = max;
+	patch.level = level;
+	patch.children[0] = patch.children[1] = patch.children[2] = patch.children[3] = -1;
+	patch.entity = entt::null;
+
+	glm::vec2 uvMin = GetLocalUV(min);
+	glm::vec2 uvMax = GetLocalUV(max);
+	heightField.GetRange(uvMin.x, uvMin.y, uvMax.x, uvMax.y, patch.valueMin, patch.valueMax);
+
+	patch.mesh = MakePatchMesh(patch);
+
+	// the index is saved, since adding the children moves the vector.
+	int index = (int)patches.size();
+	patches.push_back(patch);
+
+	// splits the patch into quarters.
+	if (level + 1 < lodCount)
+	{
+		glm::vec2 mid = (min + max) / 2.0F;
+
+		int child0 = AddPatch(min, mid, level + 1);
+		int child1 = AddPatch(glm::vec2(mid.x, min.y), glm::vec2(max.x, mid.y), level + 1);
+		int child2 = AddPatch(glm::vec2(min.x, mid.y), glm::vec2(mid.x, max.y), level + 1);
+		int child3 = AddPatch(mid, max, level + 1);
+
+		patches[index].children[0] = child0;
+		patches[index].children[1] = child1;
+		patches[index].children[2] = child2;
+		patches[index].children[3] = child3;
+	}
+
+	return index;
+}
+
+// makes the mesh for a patch
+cherry::Mesh::Sptr cherry::Terrain::MakePatchMesh(const Patch& patch) const
+{
+	const int sections = TERRAIN_PATCH_SECTIONS;
+	const int numEdgeVerts = sections + 1;
+
+	// the grid, then a row of skirt vertices under each of the four edges.
+	size_t gridCount = numEdgeVerts * numEdgeVerts;
+	size_t vertexCount = gridCount + 4 * numEdgeVerts;
+	size_t indexCount = (sections * sections + 4 * sections) * 6;
+
+	Vertex* vertices = new Vertex[vertexCount];
+	uint32_t* indices = new uint32_t[indexCount];
+
+	glm::vec2 step = (patch.max - patch.min) / (float)sections;
+
+	// the skirt hangs down by the patch's range of heights, which is as far as a neighbouring patch's edge can be from this one.
+	// the shader multiplies the z position by the terrain's height range, so the depth is given as a fraction of that range.
+	float skirtDepth = (patch.valueMax - patch.valueMin) + 0.01F;
+
+	// grid vertices, which are laid out the same way as Mesh::MakeSubdividedPlane().
+	for (int ix = 0; ix <= sections; ix++)
+	{
+		for (int iy = 0; iy <= sections; iy++)
+		{
+			Vertex& vert = vertices[ix * numEdgeVerts + iy];
+
+			vert.Position = glm::vec3(patch.min.x + ix * step.x, patch.min.y + iy * step.y, 0.0F);
+			vert.Normal = glm::vec3(0, 0, 1);
+			vert.UV = GetLocalUV(glm::vec2(vert.Position));
+			vert.Color = glm::vec4(1.0F);
+		}
+	}
+
+	uint32_t index = 0;
+
+	// grid indices
+	for (int ix = 0; ix < sections; ix++)
+	{
+		for (int iy = 0; iy < sections; iy++)
+		{
+			uint32_t p1 = (ix + 0) * numEdgeVerts + (iy + 0);
+			uint32_t p2 = (ix + 1) * numEdgeVerts + (iy + 0);
+			uint32_t p3 = (ix + 0) * numEdgeVerts + (iy + 1);
+			uint32_t p4 = (ix + 1) * numEdgeVerts + (iy + 1);
+
+			indices[index++] = p1;
+			indices[index++] = p2;
+			indices[index++] = p3;
+			indices[index++] = p3;
+			indices[index++] = p2;
+			indices[index++] = p4;
+		}
+	}
+
+	// skirts. Each edge is walked counter-clockwise (seen from above), so that the skirt faces outwards.
+	for (int edge = 0; edge < 4; edge++)
+	{
+		uint32_t skirtStart = (uint32_t)(gridCount + edge * numEdgeVerts);
+		uint32_t previous = 0; // the previous edge vertex
+
+		for (int i = 0; i <= sections; i++)
+		{
+			int ix = 0, iy = 0;
+
+			switch (edge)
+			{
+			case 0: // bottom (lowest y)
+				ix = i;
+				iy = 0;
+				break;
+			case 1: // right (highest x)
+				ix = sections;
+				iy = i;
+				break;
+			case 2: // top (highest y)
+				ix = sections - i;
+				iy = sections;
+				break;
+			case 3: // left (lowest x)
+				ix = 0;
+				iy = sections - i;
+				break;
+			}
+
+			uint32_t current = (uint32_t)(ix * numEdgeVerts + iy);
+
+			// the skirt vertex is a copy of the edge vertex that's moved down.
+			vertices[skirtStart + i] = vertices[current];
+			vertices[skirtStart + i].Position.z = -skirtDepth;
+
+			if (i > 0)
+			{
+				indices[index++] = previous;
+				indices[index++] = skirtStart + i - 1;
+				indices[index++] = current;
+				indices[index++] = current;
+				indices[index++] = skirtStart + i - 1;
+				indices[index++] = skirtStart + i;
+			}
+
+			previous = current;
+		}
+	}
+
+	Mesh::Sptr result = std::make_shared<Mesh>(vertices, vertexCount, indices, indexCount);
+	delete[] vertices;
+	delete[] indices;
+
+	return result;
+}
+
+// creates the patch entities
+void cherry::Terrain::CreatePatchEntities(const std::string& scene)
+{
+	auto& ecs = GetRegistry(scene);
+
+	// the root patch uses the entity made by CreateEntity().
+	patches[0].entity = GetEntity();
+
+	// the rest of the patches get their own entities, which are given the terrain's transform when the patches are selected.
+	for (size_t i = 1; i < patches.size(); i++)
+	{
+		entt::entity entity = ecs.create();
+
+		// nothing is drawn until the patches are selected.
+		MeshRenderer& mr = ecs.assign<MeshRenderer>(entity);
+		mr.Material = material;
+		mr.Mesh = nullptr;
+
+		ecs.assign<TempTransform>(entity, GetTransform());
+
+		patches[i].entity = entity;
+	}
+}
+
+// selects the patches
+void cherry::Terrain::SelectPatches()
+{
+	drawnPatches = 0;
+	culledPatches = 0;
+
+	if (patches.empty() || patches[0].entity == entt::null)
+		return;
+
+	auto& ecs = GetRegistry(GetSceneName());
+
+	// hides all of the patches, and gives them the root's settings and transform.
+	for (Patch& patch : patches)
+	{
+		ecs.get<MeshRenderer>(patch.entity).Mesh = nullptr;
+
+		if (patch.mesh != mesh)
+		{
+			CopyMeshSettings(mesh, patch.mesh);
+			ecs.get<TempTransform>(patch.entity) = GetTransform();
+		}
+	}
+
+	// the whole terrain is hidden.
+	if (!mesh->IsVisible())
+		return;
+
+	Game* const game = Game::GetRunningGame();
+	Camera::Sptr camera = (game != nullptr) ? game->myCamera : nullptr;
+
+	// the frustum and camera position are put in the terrain's local space, so that the patch bounds can be used as they are.
+	glm::mat4 world = CalculateWorldTransformation();
+	Frustum frustum;
+	glm::vec3 cameraPos = glm::vec3(0.0F);
+
+	if (camera != nullptr)
+	{
+		frustum.SetMatrix(camera->GetViewProjection() * world);
+		cameraPos = glm::vec3(glm::inverse(world) * glm::vec4(camera->GetPosition(), 1.0F));
+	}
+
+	patchStack.clear();
+	patchStack.push_back(0);
+
+	while (!patchStack.empty())
+	{
+		const Patch& patch = patches[patchStack.back()];
+		patchStack.pop_back();
+
+		// the bounds of the patch, using the current height range.
+		float heightA = GetLocalHeight(patch.valueMin);
+		float heightB = GetLocalHeight(patch.valueMax);
+		glm::vec3 boundsMin = glm::vec3(patch.min, glm::min(heightA, heightB));
+		glm::vec3 boundsMax = glm::vec3(patch.max, glm::max(heightA, heightB));
+
+		// the patch (and all of its children) can't be seen.
+		if (camera != nullptr && !frustum.ContainsBox(boundsMin, boundsMax))
+		{
+			culledPatches++;
+			continue;
+		}
+
+		// the patch is split if the camera is close enough to it. Without a camera, the most detailed patches are used.
+		bool split = patch.children[0] != -1;
+
+		if (split && camera != nullptr)
+		{
+			glm::vec3 closest = glm::clamp(cameraPos, boundsMin, boundsMax);
+			split = glm::distance(cameraPos, closest) < (patch.max.x - patch.min.x) * lodDistance;
+		}
+
+		if (split)
+		{
+			for (int child : patch.children)
+				patchStack.push_back(child);
+		}
+		else
+		{
+			ecs.get<MeshRenderer>(patch.entity).Mesh = patch.mesh;
+			drawnPatches++;
+		}
+	}
+}
+
+// copies the mesh settings
+void cherry::Terrain::CopyMeshSettings(const Mesh::Sptr& source, const Mesh::Sptr& dest) const
+{
+	dest->SetVisible(source->IsVisible());
+	dest->SetWireframe(source->IsWireframe());
+	dest->postProcess = source->postProcess;
+	dest->cullFaces = source->cullFaces;
+}
+
+// gets the local uvs
+glm::vec2 cherry::Terrain::GetLocalUV(const glm::vec2& localPos) const
+{
+	// this matches the uvs made by Mesh::MakeSubdividedPlane().
+	return (worldUVs) ? localPos : localPos / size;
+}
+
+// gets the local height
+float cherry::Terrain::GetLocalHeight(float value) const { return (1.0F - value) * heightMin + value * heightMax; }
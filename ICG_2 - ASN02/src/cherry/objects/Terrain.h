@@ -1,17 +1,34 @@
 #pragma once
 
 #include "Object.h"
+#include "HeightField.h"
+
+// the amount of quads along each side of a terrain patch. Every patch has the same amount, so larger patches are less detailed.
+#define TERRAIN_PATCH_SECTIONS 16
+
+// the most levels of detail a terrain can have.
+#define TERRAIN_MAX_LODS 6
 
 namespace cherry
 {
+	/*
+	 * The terrain is split into square patches, which are stored in a quadtree.
+	 * The root patch covers the whole terrain, and each level down splits a patch into four with the same amount of quads.
+	 * Patches close to the camera are split further, and the patches outside of the camera's view are skipped.
+	 * Each patch has a skirt hanging down from its edges, which hides the cracks between patches with different levels of detail.
+	 * The height map is kept on the CPU as well, so that the height and normal can be found at any point on the terrain.
+	*/
 	class Terrain : public Object
 	{
 	public:
 		// heightMap: the file path for the height map
 		// if 'worldUvs' is set to 'true', then each face of the terrain will have its own heightmap, rather than using one overall heightmap.
+		// the amount of levels of detail is chosen so that the closest patches have at least numSections quads along the terrain.
 		// NOTE: terrains do not support lighting.
 		Terrain(std::string scene, std::string heightMap, float size, float numSections, bool worldUVs = false);
 
+		// destroys the entities of the patches.
+		~Terrain();
 
 		// gets the height map
 		const std::string& GetHeightMap() const;
@@ -37,26 +54,109 @@ namespace cherry
 		// check TEXTURES_MAX to see the maximum amount of textures allowed.
 		bool SetTexture(unsigned int index, std::string filePath);
 
+		// gets the height of the terrain (in world space) at the provided world position.
+		// the terrain is on its local xy plane with the height on the z-axis, so (x, y) are the world coordinates on the ground.
+		// points outside of the terrain use the height at the closest edge. This assumes the terrain hasn't been tilted.
+		float GetHeightAt(float x, float y) const;
+
+		// gets the normal of the terrain (in world space) at the provided world position.
+		glm::vec3 GetNormalAt(float x, float y) const;
+
+		// gets the distance, as a multiple of a patch's size, that a patch has to be within to be split into smaller patches.
+		float GetLodDistance() const;
+
+		// sets the distance multiple for splitting patches. Larger values keep more detail further away.
+		void SetLodDistance(float distance);
+
+		// gets the amount of levels of detail.
+		int GetLodCount() const;
+
+		// gets the total amount of patches in the quadtree.
+		int GetPatchCount() const;
+
+		// gets the amount of patches drawn in the last update.
+		int GetDrawnPatchCount() const;
+
+		// gets the amount of patches skipped by frustum culling in the last update.
+		int GetCulledPatchCount() const;
+
 		// Texture1
 		// Texture2
 		//Texture 3
 
-		// update
+		// update. This chooses the patches that get drawn for the game's main camera.
 		void Update(float deltaTime);
 
 		// maximum amount of textures
 		static const int TEXTURES_MAX;
 
 	private:
+		// a patch in the quadtree
+		struct Patch
+		{
+			glm::vec2 min; // the corner with the lowest x and y (local space)
+			glm::vec2 max; // the corner with the highest x and y (local space)
+			float valueMin; // the lowest height map value in the patch (0 - 1)
+			float valueMax; // the highest height map value in the patch (0 - 1)
+			int level; // the level of detail (0 = root)
+			int children[4]; // the indexes of the child patches (-1 if this is a leaf)
+			Mesh::Sptr mesh; // the mesh for the patch
+			entt::entity entity; // the entity that draws the patch
+		};
+
+		// makes the patches and their meshes. The height field must be loaded first.
+		void BuildPatches();
+
+		// adds a patch and its children to the quadtree. Returns the index of the patch.
+		int AddPatch(const glm::vec2& min, const glm::vec2& max, int level);
+
+		// makes the mesh for a patch, including its skirt.
+		Mesh::Sptr MakePatchMesh(const Patch& patch) const;
+
+		// makes the entities that draw the patches.
+		void CreatePatchEntities(const std::string& scene);
+
+		// chooses the patches that get drawn this frame.
+		void SelectPatches();
+
+		// copies the settings (visibility, wireframe, etc.) from one mesh to another.
+		void CopyMeshSettings(const Mesh::Sptr& source, const Mesh::Sptr& dest) const;
+
+		// gets the uv coordinates (for the height map) of a position in local space.
+		glm::vec2 GetLocalUV(const glm::vec2& localPos) const;
+
+		// gets the height (in local space) of a height map value.
+		float GetLocalHeight(float value) const;
+
 		// the height map
 		std::string heightMap = "";
 
-		
+		// the height map on the CPU
+		HeightField heightField;
 
 		std::string textures[3]{ "", "", "" };
 
 		// the size of the terrain
-		int size = 0;
+		float size = 0;
+
+		// if 'true', the height map repeats for every unit, instead of covering the whole terrain.
+		bool worldUVs = false;
+
+		// the quadtree, with the root at index 0.
+		std::vector<Patch> patches;
+
+		// the amount of levels of detail.
+		int lodCount = 1;
+
+		// the distance multiple used for splitting patches.
+		float lodDistance = 1.5F;
+
+		// the patches waiting to be checked when selecting patches. This is kept so that it isn't reallocated every frame.
+		std::vector<int> patchStack;
+
+		// the patches drawn and culled in the last update.
+		int drawnPatches = 0;
+		int culledPatches = 0;
 
 		// the number of sections the terrain has.
 		int numSections = 0;
@@ -15,8 +15,6 @@ const int cherry::Text::CHAR_COUNT = 256;
  		glm::clamp(color.v.w, 0.0F, 1.0F)
  	);
  
- 	SetPosition(position);
- 
  	// saving the font size.
  	fontSize = size > 0 ? size : 1;
  
@@ -247,8 +245,8 @@ const int cherry::Text::CHAR_COUNT = 256;
      CreateEntity(scene, textMaterial); // empty material
      SetVisible(false);
 
-     worldPos = position + Vec3(1, 1, 1);
-     worldScale = scale;
+     worldPos = GetPosition() + Vec3(1, 1, 1);
+     worldScale = GetScale();
      worldRotDeg = GetRotationDegrees();
  }
 
@@ -257,15 +255,17 @@ const int cherry::Text::CHAR_COUNT = 256;
  {
      Object::Update(deltaTime);
 
+     Vec3 currPos = GetPosition();
+     Vec3 currScale = GetScale();
      Vec3 currRotDeg = GetRotationDegrees();
 
      // TODO: optimize.
 
      // updating scale
-     if (worldScale != scale)
+     if (worldScale != currScale)
      {
          // the scale of the text.
-         Vec3 textScale = GetScale();
+         Vec3 textScale = currScale;
 
          // setting the scale proportional to the body.
          for (Character* chr : textChars)
@@ -293,7 +293,7 @@ const int cherry::Text::CHAR_COUNT = 256;
      }
 
      // updating position if any of the values have been changed.
-     if (worldPos != position || worldScale != scale || worldRotDeg != currRotDeg)
+     if (worldPos != currPos || worldScale != currScale || worldRotDeg != currRotDeg)
      {
          // the text box is the parent.
          glm::mat4 parent = glm::mat4(1.0F);
@@ -317,9 +317,9 @@ const int cherry::Text::CHAR_COUNT = 256;
          util::math::Mat3 rotZ = rotScale;
 
          // translation
-         parent[0][3] = position.v.x;
-         parent[1][3] = position.v.y;
-         parent[2][3] = position.v.z;
+         parent[0][3] = currPos.v.x;
+         parent[1][3] = currPos.v.y;
+         parent[2][3] = currPos.v.z;
          parent[3][3] = 1.0F;
 
          // rotation
@@ -328,9 +328,9 @@ const int cherry::Text::CHAR_COUNT = 256;
          rotZ = util::math::getRotationMatrixZ(GetRotationZDegrees(), true);
 
          // scale
-         scale[0][0] = Object::scale.v.x;
-         scale[1][1] = Object::scale.v.y;
-         scale[2][2] = Object::scale.v.z;
+         scale[0][0] = currScale.v.x;
+         scale[1][1] = currScale.v.y;
+         scale[2][2] = currScale.v.z;
 
          // rotation and scale.
          rotScale = scale * (rotZ * rotX * rotY);
@@ -369,8 +369,8 @@ const int cherry::Text::CHAR_COUNT = 256;
      }
 
      // saving the values.
-     worldPos = position;
-     worldScale = scale;
+     worldPos = currPos;
+     worldScale = currScale;
      worldRotDeg = currRotDeg;
 
      // update loop.
@@ -0,0 +1,737 @@
+// BVH (Source) - bounding volume hierarchies over mesh triangles and scene objects, used for raycasts and mouse picking.
+#include "BVH.h"
+#include "..\objects\Object.h"
+
+#include <algorithm>
+#include <numeric>
+
+// gets the surface area of a box, which is how likely a random ray is to hit it.
+static float SurfaceArea(const glm::vec3& min, const glm::vec3& max)
+{
+	glm::vec3 size = max - min;
+	return 2.0F * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+// RAY //
+// makes a ray
+cherry::Ray::Ray(const glm::vec3& origin, const glm::vec3& direction) : Origin(origin), Direction(direction)
+{
+	// a very large value is used instead of infinity for flat directions, since infinity times 0 isn't a number.
+	for (int i = 0; i < 3; i++)
+		InverseDirection[i] = (direction[i] != 0.0F) ? 1.0F / direction[i] : FLT_MAX;
+}
+
+// makes a ray through the screen
+cherry::Ray cherry::Ray::FromScreen(const glm::vec2& screenPos, const glm::vec2& windowSize, const glm::mat4& viewProjection)
+{
+	// the screen position in normalized device coordinates. The y-axis is flipped, since the screen's y goes down.
+	glm::vec2 ndc = glm::vec2(screenPos.x / windowSize.x * 2.0F - 1.0F, 1.0F - screenPos.y / windowSize.y * 2.0F);
+	glm::mat4 inverse = glm::inverse(viewProjection);
+
+	// the points on the near and far planes.
+	glm::vec4 nearPoint = inverse * glm::vec4(ndc, -1.0F, 1.0F);
+	glm::vec4 farPoint = inverse * glm::vec4(ndc, 1.0F, 1.0F);
+
+	glm::vec3 start = glm::vec3(nearPoint) / nearPoint.w;
+	glm::vec3 end = glm::vec3(farPoint) / farPoint.w;
+
+	return Ray(start, glm::normalize(end - start));
+}
+
+// gets a point along the ray
+glm::vec3 cherry::Ray::GetPoint(float distance) const { return Origin + Direction * distance; }
+
+// checks if something was hit
+bool cherry::RayHit::IsHit() const { return Triangle != UINT32_MAX; }
+
+// makes a packet
+cherry::RayPacket::RayPacket(const Ray rays[4])
+{
+	for (int i = 0; i < 4; i++)
+		Rays[i] = rays[i];
+}
+
+// checks if the node is a leaf
+bool cherry::BVHNode::IsLeaf() const { return Count > 0; }
+
+
+// BVH //
+// gets the amount of nodes
+size_t cherry::BVH::GetNodeCount() const { return nodes.size(); }
+
+// gets the amount of primitives
+size_t cherry::BVH::GetPrimitiveCount() const { return order.size(); }
+
+// gets the minimum bounds
+glm::vec3 cherry::BVH::GetMinimum() const { return nodes.empty() ? glm::vec3(0.0F) : nodes[0].Min; }
+
+// gets the maximum bounds
+glm::vec3 cherry::BVH::GetMaximum() const { return nodes.empty() ? glm::vec3(0.0F) : nodes[0].Max; }
+
+// tests a ray against a box (slab test)
+float cherry::BVH::IntersectBox(const Ray& ray, const glm::vec3& min, const glm::vec3& max, float maxDistance)
+{
+	glm::vec3 t0 = (min - ray.Origin) * ray.InverseDirection;
+	glm::vec3 t1 = (max - ray.Origin) * ray.InverseDirection;
+
+	// the ray is inside every slab between the latest entry and the earliest exit.
+	glm::vec3 tSmall = glm::min(t0, t1);
+	glm::vec3 tBig = glm::max(t0, t1);
+
+	float tEnter = std::max(std::max(tSmall.x, tSmall.y), std::max(tSmall.z, 0.0F));
+	float tExit = std::min(std::min(tBig.x, tBig.y), std::min(tBig.z, maxDistance));
+
+	return (tEnter <= tExit) ? tEnter : FLT_MAX;
+}
+
+// builds the tree
+void cherry::BVH::Build(const std::vector<glm::vec3>& mins, const std::vector<glm::vec3>& maxes)
+{
+	nodes.clear();
+	order.clear();
+
+	const uint32_t count = (uint32_t)mins.size();
+
+	if (count == 0)
+		return;
+
+	order.resize(count);
+	std::iota(order.begin(), order.end(), 0);
+
+	std::vector<glm::vec3> centroids(count);
+
+	for (uint32_t i = 0; i < count; i++)
+		centroids[i] = (mins[i] + maxes[i]) * 0.5F;
+
+	// a tree with n leaves has at most 2n - 1 nodes, so reserving that stops the node references from moving during the build.
+	nodes.reserve(count * 2);
+	nodes.push_back(BVHNode{ glm::vec3(0.0F), 0, glm::vec3(0.0F), count });
+
+	__UpdateBounds(nodes[0], mins, maxes);
+	__Subdivide(0, mins, maxes, centroids, 0);
+
+	nodes.shrink_to_fit();
+}
+
+// splits a node
+void cherry::BVH::__Subdivide(uint32_t node, const std::vector<glm::vec3>& mins, const std::vector<glm::vec3>& maxes,
+	const std::vector<glm::vec3>& centroids, uint32_t depth)
+{
+	BVHNode& parent = nodes[node];
+
+	// the traversal stacks only have room for so many levels.
+	if (parent.Count <= 1 || depth >= BVH_STACK_SIZE - 2)
+		return;
+
+	int axis = 0;
+	float position = 0.0F;
+	float splitCost = __FindSplit(parent, mins, maxes, centroids, axis, position);
+
+	// every primitive has the same centre, so there's nothing to split on.
+	if (splitCost == FLT_MAX)
+		return;
+
+	// small nodes are only split if it makes them cheaper to trace. The cost of visiting the extra node is counted as one primitive.
+	float leafCost = parent.Count * SurfaceArea(parent.Min, parent.Max);
+
+	if (parent.Count <= BVH_MAX_LEAF_SIZE && splitCost + SurfaceArea(parent.Min, parent.Max) >= leafCost)
+		return;
+
+	// moves the primitives on the left of the split to the start of the node's range.
+	uint32_t i = parent.Start;
+	uint32_t j = parent.Start + parent.Count;
+
+	while (i < j)
+	{
+		if (centroids[order[i]][axis] < position)
+			i++;
+		else
+			std::swap(order[i], order[--j]);
+	}
+
+	const uint32_t leftCount = i - parent.Start;
+
+	// the bins and the partition can disagree on primitives right at the split due to rounding.
+	if (leftCount == 0 || leftCount == parent.Count)
+		return;
+
+	const uint32_t left = (uint32_t)nodes.size();
+
+	nodes.push_back(BVHNode{ glm::vec3(0.0F), parent.Start, glm::vec3(0.0F), leftCount });
+	nodes.push_back(BVHNode{ glm::vec3(0.0F), i, glm::vec3(0.0F), parent.Count - leftCount });
+
+	// the parent points to its children instead of its primitives.
+	parent.Start = left;
+	parent.Count = 0;
+
+	__UpdateBounds(nodes[left], mins, maxes);
+	__UpdateBounds(nodes[left + 1], mins, maxes);
+
+	__Subdivide(left, mins, maxes, centroids, depth + 1);
+	__Subdivide(left + 1, mins, maxes, centroids, depth + 1);
+}
+
+// finds the best split
+float cherry::BVH::__FindSplit(const BVHNode& node, const std::vector<glm::vec3>& mins, const std::vector<glm::vec3>& maxes,
+	const std::vector<glm::vec3>& centroids, int& axis, float& position) const
+{
+	// a bin's box and the amount of primitives with their centres in it.
+	struct Bin
+	{
+		glm::vec3 Min = glm::vec3(FLT_MAX);
+		glm::vec3 Max = glm::vec3(-FLT_MAX);
+		uint32_t Count = 0;
+	};
+
+	float bestCost = FLT_MAX;
+
+	for (int a = 0; a < 3; a++)
+	{
+		// the bins cover the range of the centres, not the node's box.
+		float cMin = FLT_MAX, cMax = -FLT_MAX;
+
+		for (uint32_t i = node.Start; i < node.Start + node.Count; i++)
+		{
+			cMin = std::min(cMin, centroids[order[i]][a]);
+			cMax = std::max(cMax, centroids[order[i]][a]);
+		}
+
+		if (cMin == cMax)
+			continue;
+
+		Bin bins[BVH_BINS];
+		const float scale = BVH_BINS / (cMax - cMin);
+
+		for (uint32_t i = node.Start; i < node.Start + node.Count; i++)
+		{
+			const uint32_t prim = order[i];
+			int b = std::min(BVH_BINS - 1, (int)((centroids[prim][a] - cMin) * scale));
+
+			bins[b].Min = glm::min(bins[b].Min, mins[prim]);
+			bins[b].Max = glm::max(bins[b].Max, maxes[prim]);
+			bins[b].Count++;
+		}
+
+		// the area and count on each side of every split, found by sweeping from both ends.
+		float leftArea[BVH_BINS - 1], rightArea[BVH_BINS - 1];
+		uint32_t leftCount[BVH_BINS - 1], rightCount[BVH_BINS - 1];
+
+		glm::vec3 leftMin = glm::vec3(FLT_MAX), leftMax = glm::vec3(-FLT_MAX);
+		glm::vec3 rightMin = glm::vec3(FLT_MAX), rightMax = glm::vec3(-FLT_MAX);
+		uint32_t leftSum = 0, rightSum = 0;
+
+		for (int i = 0; i < BVH_BINS - 1; i++)
+		{
+			const Bin& l = bins[i];
+			leftSum += l.Count;
+			leftMin = glm::min(leftMin, l.Min);
+			leftMax = glm::max(leftMax, l.Max);
+			leftCount[i] = leftSum;
+			leftArea[i] = (leftSum > 0) ? SurfaceArea(leftMin, leftMax) : 0.0F;
+
+			const Bin& r = bins[BVH_BINS - 1 - i];
+			rightSum += r.Count;
+			rightMin = glm::min(rightMin, r.Min);
+			rightMax = glm::max(rightMax, r.Max);
+			rightCount[BVH_BINS - 2 - i] = rightSum;
+			rightArea[BVH_BINS - 2 - i] = (rightSum > 0) ? SurfaceArea(rightMin, rightMax) : 0.0F;
+		}
+
+		for (int i = 0; i < BVH_BINS - 1; i++)
+		{
+			if (leftCount[i] == 0 || rightCount[i] == 0)
+				continue;
+
+			float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+
+			if (cost < bestCost)
+			{
+				bestCost = cost;
+				axis = a;
+				position = cMin + (i + 1) / scale;
+			}
+		}
+	}
+
+	return bestCost;
+}
+
+// calculates the bounds of a node
+void cherry::BVH::__UpdateBounds(BVHNode& node, const std::vector<glm::vec3>& mins, const std::vector<glm::vec3>& maxes) const
+{
+	node.Min = glm::vec3(FLT_MAX);
+	node.Max = glm::vec3(-FLT_MAX);
+
+	for (uint32_t i = node.Start; i < node.Start + node.Count; i++)
+	{
+		node.Min = glm::min(node.Min, mins[order[i]]);
+		node.Max = glm::max(node.Max, maxes[order[i]]);
+	}
+}
+
+
+// MESH BVH //
+// builds the hierarchy
+cherry::MeshBVH::MeshBVH(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount)
+{
+	if (vertices == nullptr || indices == nullptr)
+		return;
+
+	const uint32_t count = indexCount / 3;
+
+	std::vector<Triangle> unsorted;
+	std::vector<glm::vec3> mins, maxes;
+
+	unsorted.reserve(count);
+	mins.reserve(count);
+	maxes.reserve(count);
+
+	for (uint32_t i = 0; i < count; i++)
+	{
+		const uint32_t i0 = indices[i * 3], i1 = indices[i * 3 + 1], i2 = indices[i * 3 + 2];
+
+		// the triangle is kept (so the triangle indices line up with the mesh), but it's flattened to a point so it can't be hit.
+		if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount)
+		{
+			unsorted.push_back(Triangle{ glm::vec3(0.0F), glm::vec3(0.0F), glm::vec3(0.0F) });
+			mins.push_back(glm::vec3(0.0F));
+			maxes.push_back(glm::vec3(0.0F));
+			continue;
+		}
+
+		const glm::vec3& a = vertices[i0].Position;
+		const glm::vec3& b = vertices[i1].Position;
+		const glm::vec3& c = vertices[i2].Position;
+
+		unsorted.push_back(Triangle{ a, b - a, c - a });
+		mins.push_back(glm::min(a, glm::min(b, c)));
+		maxes.push_back(glm::max(a, glm::max(b, c)));
+	}
+
+	Build(mins, maxes);
+
+	// the triangles are put in leaf order, so each leaf reads one block of memory.
+	triangles.resize(count);
+
+	for (uint32_t i = 0; i < count; i++)
+		triangles[i] = unsorted[order[i]];
+}
+
+// gets the amount of triangles
+size_t cherry::MeshBVH::GetTriangleCount() const { return triangles.size(); }
+
+// finds the closest hit
+bool cherry::MeshBVH::Intersect(const Ray& ray, RayHit& hit) const
+{
+	if (nodes.empty())
+		return false;
+
+	// the nodes waiting to be visited, and the distance their boxes were entered at.
+	struct StackEntry
+	{
+		uint32_t Node;
+		float Distance;
+	};
+
+	StackEntry stack[BVH_STACK_SIZE];
+	int top = 0;
+	bool found = false;
+
+	float rootDist = IntersectBox(ray, nodes[0].Min, nodes[0].Max, hit.Distance);
+
+	if (rootDist == FLT_MAX)
+		return false;
+
+	stack[top++] = StackEntry{ 0, rootDist };
+
+	while (top > 0)
+	{
+		const StackEntry entry = stack[--top];
+
+		// a closer hit was found after the node was added.
+		if (entry.Distance > hit.Distance)
+			continue;
+
+		const BVHNode& node = nodes[entry.Node];
+
+		if (node.IsLeaf())
+		{
+			float distance = 0.0F;
+			glm::vec2 barycentrics;
+
+			for (uint32_t i = node.Start; i < node.Start + node.Count; i++)
+			{
+				if (__IntersectTriangle(ray, triangles[i], hit.Distance, distance, barycentrics))
+				{
+					hit.Distance = distance;
+					hit.Triangle = order[i];
+					hit.Barycentrics = barycentrics;
+					found = true;
+				}
+			}
+
+			continue;
+		}
+
+		uint32_t first = node.Start, second = node.Start + 1;
+		float firstDist = IntersectBox(ray, nodes[first].Min, nodes[first].Max, hit.Distance);
+		float secondDist = IntersectBox(ray, nodes[second].Min, nodes[second].Max, hit.Distance);
+
+		// the closer child goes on top, so it's visited first, which makes the hit distance shrink sooner.
+		if (secondDist < firstDist)
+		{
+			std::swap(first, second);
+			std::swap(firstDist, secondDist);
+		}
+
+		if (secondDist != FLT_MAX)
+			stack[top++] = StackEntry{ second, secondDist };
+
+		if (firstDist != FLT_MAX)
+			stack[top++] = StackEntry{ first, firstDist };
+	}
+
+	return found;
+}
+
+// finds the closest hits for a packet
+void cherry::MeshBVH::IntersectPacket(const RayPacket& packet, RayHit* hits) const
+{
+#ifdef BVH_USE_SSE
+	if (nodes.empty())
+		return;
+
+	const Ray* r = packet.Rays;
+
+	// each register holds one component of the four rays. Lane i is ray i.
+	const __m128 origin[3] = {
+		_mm_setr_ps(r[0].Origin.x, r[1].Origin.x, r[2].Origin.x, r[3].Origin.x),
+		_mm_setr_ps(r[0].Origin.y, r[1].Origin.y, r[2].Origin.y, r[3].Origin.y),
+		_mm_setr_ps(r[0].Origin.z, r[1].Origin.z, r[2].Origin.z, r[3].Origin.z)
+	};
+
+	const __m128 dir[3] = {
+		_mm_setr_ps(r[0].Direction.x, r[1].Direction.x, r[2].Direction.x, r[3].Direction.x),
+		_mm_setr_ps(r[0].Direction.y, r[1].Direction.y, r[2].Direction.y, r[3].Direction.y),
+		_mm_setr_ps(r[0].Direction.z, r[1].Direction.z, r[2].Direction.z, r[3].Direction.z)
+	};
+
+	const __m128 invDir[3] = {
+		_mm_setr_ps(r[0].InverseDirection.x, r[1].InverseDirection.x, r[2].InverseDirection.x, r[3].InverseDirection.x),
+		_mm_setr_ps(r[0].InverseDirection.y, r[1].InverseDirection.y, r[2].InverseDirection.y, r[3].InverseDirection.y),
+		_mm_setr_ps(r[0].InverseDirection.z, r[1].InverseDirection.z, r[2].InverseDirection.z, r[3].InverseDirection.z)
+	};
+
+	// the closest hit of each ray so far.
+	__m128 maxDist = _mm_setr_ps(hits[0].Distance, hits[1].Distance, hits[2].Distance, hits[3].Distance);
+
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0F);
+	const __m128 epsilon = _mm_set1_ps(1.0E-12F);
+	const __m128 signBit = _mm_set1_ps(-0.0F);
+
+	uint32_t stack[BVH_STACK_SIZE];
+	int top = 0;
+
+	stack[top++] = 0;
+
+	while (top > 0)
+	{
+		const BVHNode& node = nodes[stack[--top]];
+
+		// the slab test for all four rays. The node is visited if any of them hit it.
+		__m128 tEnter = zero, tExit = maxDist;
+
+		for (int a = 0; a < 3; a++)
+		{
+			__m128 t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.Min[a]), origin[a]), invDir[a]);
+			__m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node.Max[a]), origin[a]), invDir[a]);
+
+			tEnter = _mm_max_ps(tEnter, _mm_min_ps(t0, t1));
+			tExit = _mm_min_ps(tExit, _mm_max_ps(t0, t1));
+		}
+
+		if (_mm_movemask_ps(_mm_cmple_ps(tEnter, tExit)) == 0)
+			continue;
+
+		if (!node.IsLeaf())
+		{
+			// the child closest to the first ray is visited first. The rays in a packet go in similar directions, so it's usually the closest for all of them.
+			uint32_t first = node.Start, second = node.Start + 1;
+			const glm::vec3 centreDiff = (nodes[second].Min + nodes[second].Max) - (nodes[first].Min + nodes[first].Max);
+
+			if (glm::dot(centreDiff, r[0].Direction) < 0.0F)
+				std::swap(first, second);
+
+			stack[top++] = second;
+			stack[top++] = first;
+			continue;
+		}
+
+		// tests each triangle against all four rays at once (Moller-Trumbore).
+		for (uint32_t i = node.Start; i < node.Start + node.Count; i++)
+		{
+			const Triangle& tri = triangles[i];
+
+			const __m128 e1x = _mm_set1_ps(tri.Edge1.x), e1y = _mm_set1_ps(tri.Edge1.y), e1z = _mm_set1_ps(tri.Edge1.z);
+			const __m128 e2x = _mm_set1_ps(tri.Edge2.x), e2y = _mm_set1_ps(tri.Edge2.y), e2z = _mm_set1_ps(tri.Edge2.z);
+
+			// p = direction x edge2
+			__m128 px = _mm_sub_ps(_mm_mul_ps(dir[1], e2z), _mm_mul_ps(dir[2], e2y));
+			__m128 py = _mm_sub_ps(_mm_mul_ps(dir[2], e2x), _mm_mul_ps(dir[0], e2z));
+			__m128 pz = _mm_sub_ps(_mm_mul_ps(dir[0], e2y), _mm_mul_ps(dir[1], e2x));
+
+			__m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+			__m128 invDet = _mm_div_ps(one, det);
+
+			// s = origin - v0
+			__m128 sx = _mm_sub_ps(origin[0], _mm_set1_ps(tri.V0.x));
+			__m128 sy = _mm_sub_ps(origin[1], _mm_set1_ps(tri.V0.y));
+			__m128 sz = _mm_sub_ps(origin[2], _mm_set1_ps(tri.V0.z));
+
+			__m128 u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+
+			// q = s x edge1
+			__m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+			__m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+			__m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+
+			__m128 v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dir[0], qx), _mm_mul_ps(dir[1], qy)), _mm_mul_ps(dir[2], qz)), invDet);
+			__m128 t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+			// the lanes that hit. Lanes that aren't numbers (from a determinant of 0) fail every comparison.
+			__m128 mask = _mm_cmpgt_ps(_mm_andnot_ps(signBit, det), epsilon);
+			mask = _mm_and_ps(mask, _mm_cmpge_ps(u, zero));
+			mask = _mm_and_ps(mask, _mm_cmpge_ps(v, zero));
+			mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), one));
+			mask = _mm_and_ps(mask, _mm_cmpge_ps(t, zero));
+			mask = _mm_and_ps(mask, _mm_cmplt_ps(t, maxDist));
+
+			const int lanes = _mm_movemask_ps(mask);
+
+			if (lanes == 0)
+				continue;
+
+			maxDist = _mm_or_ps(_mm_and_ps(mask, t), _mm_andnot_ps(mask, maxDist));
+
+			float tOut[4], uOut[4], vOut[4];
+			_mm_storeu_ps(tOut, t);
+			_mm_storeu_ps(uOut, u);
+			_mm_storeu_ps(vOut, v);
+
+			for (int lane = 0; lane < 4; lane++)
+			{
+				if ((lanes & (1 << lane)) == 0)
+					continue;
+
+				hits[lane].Distance = tOut[lane];
+				hits[lane].Triangle = order[i];
+				hits[lane].Barycentrics = glm::vec2(uOut[lane], vOut[lane]);
+			}
+		}
+	}
+#else
+	for (int i = 0; i < 4; i++)
+		Intersect(packet.Rays[i], hits[i]);
+#endif
+}
+
+// checks for any hit
+bool cherry::MeshBVH::Occluded(const Ray& ray, float maxDistance) const
+{
+	if (nodes.empty())
+		return false;
+
+	uint32_t stack[BVH_STACK_SIZE];
+	int top = 0;
+
+	stack[top++] = 0;
+
+	float distance = 0.0F;
+	glm::vec2 barycentrics;
+
+	while (top > 0)
+	{
+		const BVHNode& node = nodes[stack[--top]];
+
+		if (IntersectBox(ray, node.Min, node.Max, maxDistance) == FLT_MAX)
+			continue;
+
+		if (!node.IsLeaf())
+		{
+			stack[top++] = node.Start + 1;
+			stack[top++] = node.Start;
+			continue;
+		}
+
+		for (uint32_t i = node.Start; i < node.Start + node.Count; i++)
+		{
+			if (__IntersectTriangle(ray, triangles[i], maxDistance, distance, barycentrics))
+				return true;
+		}
+	}
+
+	return false;
+}
+
+// tests a triangle
+bool cherry::MeshBVH::__IntersectTriangle(const Ray& ray, const Triangle& tri, float maxDistance, float& distance, glm::vec2& barycentrics)
+{
+	glm::vec3 p = glm::cross(ray.Direction, tri.Edge2);
+	float det = glm::dot(tri.Edge1, p);
+
+	// the ray is parallel to the triangle (or the triangle has no area). Both sides of the triangle can be hit.
+	if (fabsf(det) <= 1.0E-12F)
+		return false;
+
+	float invDet = 1.0F / det;
+	glm::vec3 s = ray.Origin - tri.V0;
+
+	float u = glm::dot(s, p) * invDet;
+
+	if (u < 0.0F || u > 1.0F)
+		return false;
+
+	glm::vec3 q = glm::cross(s, tri.Edge1);
+	float v = glm::dot(ray.Direction, q) * invDet;
+
+	if (v < 0.0F || u + v > 1.0F)
+		return false;
+
+	float t = glm::dot(tri.Edge2, q) * invDet;
+
+	if (t < 0.0F || t >= maxDistance)
+		return false;
+
+	distance = t;
+	barycentrics = glm::vec2(u, v);
+	return true;
+}
+
+
+// SCENE BVH //
+// builds the hierarchy from objects
+void cherry::SceneBVH::Build(const std::vector<cherry::Object*>& sceneObjects)
+{
+	std::vector<SceneBVHInstance> objectInstances;
+	objectInstances.reserve(sceneObjects.size());
+
+	for (cherry::Object* obj : sceneObjects)
+	{
+		if (obj != nullptr)
+			objectInstances.push_back(SceneBVHInstance{ obj->GetMeshBVH(), obj->GetWorldTransformation(), obj });
+	}
+
+	Build(objectInstances);
+}
+
+// builds the hierarchy from instances
+void cherry::SceneBVH::Build(const std::vector<SceneBVHInstance>& sceneInstances)
+{
+	Clear();
+
+	std::vector<SceneBVHInstance> used;
+	std::vector<glm::vec3> mins, maxes;
+
+	used.reserve(sceneInstances.size());
+	mins.reserve(sceneInstances.size());
+	maxes.reserve(sceneInstances.size());
+
+	for (const SceneBVHInstance& instance : sceneInstances)
+	{
+		if (instance.Mesh == nullptr || instance.Mesh->GetTriangleCount() == 0)
+			continue;
+
+		// the world box is the box around the corners of the mesh's box after they've been transformed.
+		const glm::vec3 lo = instance.Mesh->GetMinimum(), hi = instance.Mesh->GetMaximum();
+		glm::vec3 worldMin = glm::vec3(FLT_MAX), worldMax = glm::vec3(-FLT_MAX);
+
+		for (int c = 0; c < 8; c++)
+		{
+			glm::vec3 corner = glm::vec3((c & 1) ? hi.x : lo.x, (c & 2) ? hi.y : lo.y, (c & 4) ? hi.z : lo.z);
+			corner = glm::vec3(instance.Transform * glm::vec4(corner, 1.0F));
+
+			worldMin = glm::min(worldMin, corner);
+			worldMax = glm::max(worldMax, corner);
+		}
+
+		used.push_back(instance);
+		mins.push_back(worldMin);
+		maxes.push_back(worldMax);
+	}
+
+	BVH::Build(mins, maxes);
+
+	instances.resize(used.size());
+	inverses.resize(used.size());
+
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		instances[i] = used[order[i]];
+		inverses[i] = glm::inverse(instances[i].Transform);
+	}
+}
+
+// gets the amount of instances
+size_t cherry::SceneBVH::GetInstanceCount() const { return instances.size(); }
+
+// finds the closest hit
+bool cherry::SceneBVH::Intersect(const Ray& ray, RayHit& hit) const
+{
+	if (nodes.empty())
+		return false;
+
+	uint32_t stack[BVH_STACK_SIZE];
+	int top = 0;
+
+	stack[top++] = 0;
+
+	bool found = false;
+
+	while (top > 0)
+	{
+		const BVHNode& node = nodes[stack[--top]];
+
+		// the hit distance shrinks as meshes are hit, so the boxes are tested when they're visited.
+		if (IntersectBox(ray, node.Min, node.Max, hit.Distance) == FLT_MAX)
+			continue;
+
+		if (!node.IsLeaf())
+		{
+			// the child further along the ray goes on the stack first, so the closer one is visited first.
+			uint32_t first = node.Start, second = node.Start + 1;
+			const glm::vec3 centreDiff = (nodes[second].Min + nodes[second].Max) - (nodes[first].Min + nodes[first].Max);
+
+			if (glm::dot(centreDiff, ray.Direction) < 0.0F)
+				std::swap(first, second);
+
+			stack[top++] = second;
+			stack[top++] = first;
+			continue;
+		}
+
+		for (uint32_t i = node.Start; i < node.Start + node.Count; i++)
+		{
+			// the ray in the mesh's space. The direction isn't normalized, so the distances along it stay the same as in the world.
+			const glm::mat4& inverse = inverses[i];
+			Ray local = Ray(glm::vec3(inverse * glm::vec4(ray.Origin, 1.0F)), glm::mat3(inverse) * ray.Direction);
+
+			if (instances[i].Mesh->Intersect(local, hit))
+			{
+				hit.Object = instances[i].Object;
+				found = true;
+			}
+		}
+	}
+
+	return found;
+}
+
+// deletes the hierarchy
+void cherry::SceneBVH::Clear()
+{
+	nodes.clear();
+	order.clear();
+	instances.clear();
+	inverses.clear();
+}
@@ -0,0 +1,210 @@
+// BVH (Header) - bounding volume hierarchies over mesh triangles and scene objects, used for raycasts and mouse picking.
+#pragma once
+#include <GLM/glm.hpp>
+#include <vector>
+#include <stdint.h>
+#include <float.h>
+
+#include "..\Mesh.h"
+
+// the amount of bins the surface area heuristic sorts the centroids into when looking for a split.
+#define BVH_BINS 12
+
+// the most primitives a leaf can have. Nodes with more than this are always split.
+#define BVH_MAX_LEAF_SIZE 4
+
+// the deepest a traversal can go. The builds stop splitting before this is reached.
+#define BVH_STACK_SIZE 64
+
+// the packet traversal uses SSE when it's available (always on x86/x64). Otherwise, each ray is traced on its own.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#define BVH_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace cherry
+{
+	class Object;
+
+	// a ray. The direction doesn't need to be normalized, but the hit distances are in multiples of it.
+	struct Ray
+	{
+		// constructor
+		Ray() = default;
+
+		// makes a ray from an origin and a direction.
+		Ray(const glm::vec3& origin, const glm::vec3& direction);
+
+		// makes a ray going from the camera through a point on the screen.
+		// the screen position is in pixels, with (0, 0) at the top left.
+		static Ray FromScreen(const glm::vec2& screenPos, const glm::vec2& windowSize, const glm::mat4& viewProjection);
+
+		// gets the point at the provided distance along the ray.
+		glm::vec3 GetPoint(float distance) const;
+
+		glm::vec3 Origin = glm::vec3(0.0F);
+		glm::vec3 Direction = glm::vec3(0.0F, 0.0F, -1.0F);
+		glm::vec3 InverseDirection = glm::vec3(FLT_MAX, FLT_MAX, -1.0F); // 1 / direction, used for the box tests.
+	};
+
+	// the closest hit found by a raycast.
+	struct RayHit
+	{
+		float Distance = FLT_MAX; // the distance along the ray. Only hits closer than this are found, so it can be set to limit the ray's length.
+		uint32_t Triangle = UINT32_MAX; // the index of the triangle (the first index of the triangle is Triangle * 3). UINT32_MAX if nothing was hit.
+		glm::vec2 Barycentrics = glm::vec2(0.0F); // the weights of the triangle's second and third vertices at the hit point.
+		cherry::Object* Object = nullptr; // the object that was hit (scene raycasts only).
+
+		// returns 'true' if something was hit.
+		bool IsHit() const;
+	};
+
+	// four rays that are traced together. They should start near each other and go in similar directions (e.g. neighbouring pixels).
+	struct RayPacket
+	{
+		// constructor
+		RayPacket() = default;
+
+		// makes a packet from four rays.
+		RayPacket(const Ray rays[4]);
+
+		Ray Rays[4];
+	};
+
+	// a box around part of the hierarchy.
+	struct BVHNode
+	{
+		glm::vec3 Min;
+		uint32_t Start; // the first primitive if this is a leaf, or the left child if it isn't. The right child is always Start + 1.
+		glm::vec3 Max;
+		uint32_t Count; // the amount of primitives in the leaf. Nodes with a count of 0 aren't leaves.
+
+		// returns 'true' if this node is a leaf.
+		bool IsLeaf() const;
+	};
+
+	/*
+	 * The base of the hierarchies, which builds the tree of boxes from the bounds of each primitive.
+	 * The tree is built top down. Each node is split where the surface area heuristic says rays will be cheapest to trace,
+	 * which is found by sorting the primitive centres into bins along each axis, and trying a split between each bin.
+	 * The nodes are stored in one array, with the children of a node next to each other.
+	 * The primitives are reordered so that each leaf's primitives are next to each other (see order).
+	*/
+	class BVH
+	{
+	public:
+		// gets the amount of nodes.
+		size_t GetNodeCount() const;
+
+		// gets the amount of primitives.
+		size_t GetPrimitiveCount() const;
+
+		// gets the bounds of everything in the hierarchy.
+		glm::vec3 GetMinimum() const;
+		glm::vec3 GetMaximum() const;
+
+		// tests a ray against a box. Returns the distance the ray enters the box, or FLT_MAX if it misses or the box is further than maxDistance.
+		static float IntersectBox(const Ray& ray, const glm::vec3& min, const glm::vec3& max, float maxDistance);
+
+	protected:
+		// builds the tree from the bounds of each primitive.
+		void Build(const std::vector<glm::vec3>& mins, const std::vector<glm::vec3>& maxes);
+
+		std::vector<BVHNode> nodes;
+
+		// the primitives in the order they appear in the leaves. Each value is the index of the primitive that was passed to Build().
+		std::vector<uint32_t> order;
+
+	private:
+		// splits a node, then its children, until every leaf is small enough or can't be split any better.
+		void __Subdivide(uint32_t node, const std::vector<glm::vec3>& mins, const std::vector<glm::vec3>& maxes,
+			const std::vector<glm::vec3>& centroids, uint32_t depth);
+
+		// finds the cheapest split for a node. Returns its cost, or FLT_MAX if the node can't be split.
+		float __FindSplit(const BVHNode& node, const std::vector<glm::vec3>& mins, const std::vector<glm::vec3>& maxes,
+			const std::vector<glm::vec3>& centroids, int& axis, float& position) const;
+
+		// calculates the bounds of a node from its primitives.
+		void __UpdateBounds(BVHNode& node, const std::vector<glm::vec3>& mins, const std::vector<glm::vec3>& maxes) const;
+	};
+
+	/*
+	 * A hierarchy over the triangles of a mesh. The triangles are copied in, so the mesh data can be deleted afterwards.
+	 * The raycasts are done in the mesh's space. Use SceneBVH for raycasts against objects in the world.
+	*/
+	class MeshBVH : public BVH
+	{
+	public:
+		// builds the hierarchy from the vertices and indices of a mesh. Every three indices is a triangle.
+		MeshBVH(const Vertex* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount);
+
+		// gets the amount of triangles.
+		size_t GetTriangleCount() const;
+
+		// finds the closest triangle the ray hits. The hit is only changed if a triangle is closer than hit.Distance.
+		// returns 'true' if a closer triangle was hit.
+		bool Intersect(const Ray& ray, RayHit& hit) const;
+
+		// finds the closest triangle for each ray in the packet. The packet goes through the tree together, so each node is only loaded once.
+		// hits: an array of four hits, which are changed the same way as Intersect().
+		void IntersectPacket(const RayPacket& packet, RayHit* hits) const;
+
+		// returns 'true' if the ray hits any triangle closer than the max distance. This stops at the first hit, so it's faster than Intersect().
+		bool Occluded(const Ray& ray, float maxDistance) const;
+
+	private:
+		// a triangle, stored as its first corner and its two edges from that corner.
+		struct Triangle
+		{
+			glm::vec3 V0;
+			glm::vec3 Edge1;
+			glm::vec3 Edge2;
+		};
+
+		// tests a ray against a triangle (Moller-Trumbore). Returns 'true' if it's hit closer than the max distance.
+		static bool __IntersectTriangle(const Ray& ray, const Triangle& tri, float maxDistance, float& distance, glm::vec2& barycentrics);
+
+		std::vector<Triangle> triangles; // the triangles, in the order they appear in the leaves.
+	};
+
+	// a mesh placed in the world, which is a leaf of a scene hierarchy.
+	struct SceneBVHInstance
+	{
+		const MeshBVH* Mesh = nullptr;
+		glm::mat4 Transform = glm::mat4(1.0F); // the transformation from the mesh's space to the world.
+		cherry::Object* Object = nullptr; // the object the mesh belongs to (optional).
+	};
+
+	/*
+	 * A hierarchy over the boxes around meshes in the world.
+	 * The leaves go into each mesh's hierarchy (see Object::GetMeshBVH()), with the ray moved into the mesh's space.
+	 * Since the instances only point to the mesh hierarchies, many instances can share one mesh.
+	 * The world boxes are taken when the hierarchy is built, so it should be built again after the objects move.
+	*/
+	class SceneBVH : public BVH
+	{
+	public:
+		// constructor
+		SceneBVH() = default;
+
+		// builds the hierarchy from the objects, using their world transformations. Objects without triangles are skipped.
+		void Build(const std::vector<cherry::Object*>& sceneObjects);
+
+		// builds the hierarchy from mesh instances. Instances without meshes (or with empty meshes) are skipped.
+		void Build(const std::vector<SceneBVHInstance>& sceneInstances);
+
+		// gets the amount of instances.
+		size_t GetInstanceCount() const;
+
+		// finds the closest triangle the ray hits, and the object it belongs to.
+		// returns 'true' if anything was hit. hit.Object is the object that was hit, which is nullptr for instances without objects.
+		bool Intersect(const Ray& ray, RayHit& hit) const;
+
+		// deletes the hierarchy.
+		void Clear();
+
+	private:
+		std::vector<SceneBVHInstance> instances; // the instances, in the order they appear in the leaves.
+		std::vector<glm::mat4> inverses; // the inverse of each instance's transformation, which moves the ray into the mesh's space.
+	};
+}
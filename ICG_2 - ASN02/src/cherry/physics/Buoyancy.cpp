@@ -0,0 +1,119 @@
+// Buoyancy (Source) - floats objects with physics bodies on the waves of a liquid
+#include "Buoyancy.h"
+#include "PhysicsBody.h"
+
+// constructor
+cherry::Buoyancy::Buoyancy(cherry::Liquid* liquid) : liquid(liquid) {}
+
+// gets the liquid
+cherry::Liquid* cherry::Buoyancy::GetLiquid() const { return liquid; }
+
+// sets the liquid
+void cherry::Buoyancy::SetLiquid(cherry::Liquid* liquid) { this->liquid = liquid; }
+
+// adds an object
+bool cherry::Buoyancy::AddObject(cherry::Object* object, float density)
+{
+	if (object == nullptr)
+		return false;
+
+	for (const Floater& floater : floaters)
+	{
+		if (floater.object == object)
+			return false;
+	}
+
+	floaters.push_back(Floater{ object, glm::max(density, 0.001F), 0.0F });
+	return true;
+}
+
+// removes an object
+bool cherry::Buoyancy::RemoveObject(cherry::Object* object)
+{
+	for (size_t i = 0; i < floaters.size(); i++)
+	{
+		if (floaters[i].object == object)
+		{
+			floaters.erase(floaters.begin() + i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// gets the object count
+size_t cherry::Buoyancy::GetObjectCount() const { return floaters.size(); }
+
+// updates the objects
+void cherry::Buoyancy::Update(float deltaTime)
+{
+	if (liquid == nullptr || floaters.empty())
+		return;
+
+	queryIndexes.clear();
+	queryX.clear();
+	queryY.clear();
+	queryBottoms.clear();
+	queryDepths.clear();
+
+	// the bottom of each object's first body, and how tall it is.
+	for (size_t i = 0; i < floaters.size(); i++)
+	{
+		if (floaters[i].object->GetPhysicsBodyCount() == 0)
+			continue;
+
+		const PhysicsBody* body = floaters[i].object->GetPhysicsBodies()[0];
+		float depth = GetBodyDepth(body);
+
+		if (depth <= 0.0F)
+			continue;
+
+		glm::vec3 bodyPos = body->GetWorldPositionGLM();
+
+		queryIndexes.push_back(i);
+		queryX.push_back(bodyPos.x);
+		queryY.push_back(bodyPos.y);
+		queryBottoms.push_back(bodyPos.z - depth / 2.0F);
+		queryDepths.push_back(depth);
+	}
+
+	if (queryIndexes.empty())
+		return;
+
+	heights.resize(queryIndexes.size());
+	liquid->GetHeightsAt(queryX.data(), queryY.data(), queryX.size(), heights.data());
+
+	float gravity = glm::abs(liquid->GetGravity());
+
+	for (size_t i = 0; i < queryIndexes.size(); i++)
+	{
+		Floater& floater = floaters[queryIndexes[i]];
+
+		// how much of the body is under the surface (0 - 1).
+		float submerged = glm::clamp((heights[i] - queryBottoms[i]) / queryDepths[i], 0.0F, 1.0F);
+
+		// the buoyant force balances out gravity once the submerged amount matches the density.
+		// the drag only applies to the part that's in the liquid.
+		float acceleration = gravity * (submerged / floater.density - 1.0F) - drag * floater.velocity * submerged;
+
+		floater.velocity += acceleration * deltaTime;
+		floater.object->SetPositionZ(floater.object->GetPositionZ() + floater.velocity * deltaTime);
+	}
+}
+
+// gets the depth of a body
+float cherry::Buoyancy::GetBodyDepth(const cherry::PhysicsBody* body)
+{
+	switch (body->GetId())
+	{
+	case 1: // box
+		return ((const PhysicsBodyBox*)body)->GetWorldDepth();
+
+	case 2: // sphere
+		return ((const PhysicsBodySphere*)body)->GetWorldDiameter();
+
+	default:
+		return 0.0F;
+	}
+}
@@ -0,0 +1,66 @@
+// Buoyancy (Header) - floats objects with physics bodies on the waves of a liquid
+#pragma once
+#include "..\objects\Liquid.h"
+#include <vector>
+
+namespace cherry
+{
+	/*
+	 * Moves objects up and down so that they float on a liquid.
+	 * Each object uses its first physics body to work out how much of it is under the surface.
+	 * The surface heights for every object are found in one batch each update.
+	 * Only the height of the objects is changed; they aren't rotated or moved sideways by the waves.
+	*/
+	class Buoyancy
+	{
+	public:
+		// the liquid the objects float on.
+		Buoyancy(cherry::Liquid* liquid);
+
+		// gets the liquid.
+		cherry::Liquid* GetLiquid() const;
+
+		// sets the liquid.
+		void SetLiquid(cherry::Liquid* liquid);
+
+		// adds an object. Returns 'false' if the object is nullptr, or if it's already floating.
+		// density: the density of the object compared to the liquid, which is how much of it sits under the surface when it's still (0.5 = half).
+		// objects without physics bodies are kept, but don't float until a body is added.
+		bool AddObject(cherry::Object* object, float density = 0.5F);
+
+		// removes an object. Returns 'false' if the object wasn't floating.
+		bool RemoveObject(cherry::Object* object);
+
+		// gets the amount of objects.
+		size_t GetObjectCount() const;
+
+		// updates the objects.
+		void Update(float deltaTime);
+
+		// how quickly the up and down movement slows down while in the liquid.
+		float drag = 1.5F;
+
+	private:
+		// an object floating on the liquid
+		struct Floater
+		{
+			cherry::Object* object;
+			float density;
+			float velocity; // vertical velocity
+		};
+
+		// gets the size of a physics body on the z-axis (0 if unknown).
+		static float GetBodyDepth(const cherry::PhysicsBody* body);
+
+		cherry::Liquid* liquid = nullptr;
+		std::vector<Floater> floaters;
+
+		// the batch sent to the liquid each update. These are kept so that they aren't reallocated.
+		std::vector<size_t> queryIndexes;
+		std::vector<float> queryX;
+		std::vector<float> queryY;
+		std::vector<float> queryBottoms;
+		std::vector<float> queryDepths;
+		std::vector<float> heights;
+	};
+}
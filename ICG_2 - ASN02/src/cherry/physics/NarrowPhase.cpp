@@ -0,0 +1,426 @@
+// NarrowPhase (Source) - finds the physics bodies that are colliding, splitting the work across a thread pool.
+#include "NarrowPhase.h"
+#include "..\objects\Object.h"
+#include "..\utils\math\Collision.h"
+
+#include <algorithm>
+#include <chrono>
+#include <float.h>
+
+// converts a glm vector for the collision functions.
+#define NARROW_PHASE_VEC3(v) util::math::Vec3((v).x, (v).y, (v).z)
+
+// constructor
+cherry::NarrowPhase::NarrowPhase(uint32_t threadCount) : pool(threadCount)
+{
+	threadPairs.resize(pool.GetThreadCount());
+	threadHits.resize(pool.GetThreadCount());
+}
+
+// runs on the objects
+void cherry::NarrowPhase::Run(const std::vector<cherry::Object*>& objects)
+{
+	bodies.clear();
+
+	for (cherry::Object* object : objects)
+	{
+		if (object == nullptr || object->GetIntersection())
+			continue;
+
+		for (cherry::PhysicsBody* body : object->GetPhysicsBodies())
+		{
+			if (body != nullptr && (body->GetId() == 1 || body->GetId() == 2))
+				bodies.push_back(body);
+		}
+	}
+
+	__Run();
+}
+
+// runs on the bodies
+void cherry::NarrowPhase::Run(const std::vector<cherry::PhysicsBody*>& physicsBodies)
+{
+	bodies.clear();
+
+	for (cherry::PhysicsBody* body : physicsBodies)
+	{
+		if (body != nullptr && (body->GetId() == 1 || body->GetId() == 2))
+			bodies.push_back(body);
+	}
+
+	__Run();
+}
+
+// gets the snapshots
+const std::vector<cherry::BodySnapshot>& cherry::NarrowPhase::GetSnapshots() const { return snapshots; }
+
+// gets the hits
+const std::vector<cherry::CollisionHit>& cherry::NarrowPhase::GetHits() const { return hits; }
+
+// gets the pair count
+size_t cherry::NarrowPhase::GetPairCount() const { return pairs.size(); }
+
+// gets the time
+float cherry::NarrowPhase::GetTime() const { return time; }
+
+// gets the thread count
+uint32_t cherry::NarrowPhase::GetThreadCount() const { return pool.GetThreadCount(); }
+
+// tests two bodies
+bool cherry::NarrowPhase::Test(const BodySnapshot& a, const BodySnapshot& b, float& toi)
+{
+	toi = 1.0F;
+
+	// slow bodies can't pass through each other between updates, so only where they are now is checked.
+	if (!a.Fast && !b.Fast)
+		return __Overlap(a, b);
+
+	// Box - Box
+	if (a.Type == 1 && b.Type == 1)
+	{
+		// rotated boxes use the box around their corners, so the contact can be found a bit early.
+		glm::vec3 sizeA = (glm::abs(a.Rotation[0]) * a.HalfSize.x + glm::abs(a.Rotation[1]) * a.HalfSize.y + glm::abs(a.Rotation[2]) * a.HalfSize.z) * 2.0F;
+		glm::vec3 sizeB = (glm::abs(b.Rotation[0]) * b.HalfSize.x + glm::abs(b.Rotation[1]) * b.HalfSize.y + glm::abs(b.Rotation[2]) * b.HalfSize.z) * 2.0F;
+
+		bool col = util::math::sweptAABBCollision(
+			NARROW_PHASE_VEC3(a.LastPosition), NARROW_PHASE_VEC3(a.Position), NARROW_PHASE_VEC3(sizeA),
+			NARROW_PHASE_VEC3(b.LastPosition), NARROW_PHASE_VEC3(b.Position), NARROW_PHASE_VEC3(sizeB), toi);
+
+		// the box around a rotated box is larger than it, so the regular check is done to confirm it.
+		if (col && toi == 0.0F && (a.Rotated || b.Rotated))
+			col = __Overlap(a, b);
+
+		return col;
+	}
+	// Sphere - Sphere
+	else if (a.Type == 2 && b.Type == 2)
+	{
+		return util::math::sweptSphereCollision(
+			NARROW_PHASE_VEC3(a.LastPosition), NARROW_PHASE_VEC3(a.Position), a.Radius,
+			NARROW_PHASE_VEC3(b.LastPosition), NARROW_PHASE_VEC3(b.Position), b.Radius, toi);
+	}
+	// Sphere - Box
+	else
+	{
+		// the sphere goes first.
+		const BodySnapshot& sphere = (a.Type == 2) ? a : b;
+		const BodySnapshot& box = (a.Type == 2) ? b : a;
+
+		// the sphere is moved into the box's space, so the box can be treated as an aabb at the origin.
+		const glm::mat3 inverseRot = glm::transpose(box.Rotation);
+		const glm::vec3 start = inverseRot * (sphere.LastPosition - box.LastPosition);
+		const glm::vec3 end = inverseRot * (sphere.Position - box.Position);
+
+		return util::math::sweptSphereAABBCollision(NARROW_PHASE_VEC3(start), NARROW_PHASE_VEC3(end), sphere.Radius,
+			util::math::Vec3(), util::math::Vec3(), box.HalfSize.x * 2.0F, box.HalfSize.y * 2.0F, box.HalfSize.z * 2.0F, toi);
+	}
+}
+
+// takes a snapshot
+void cherry::NarrowPhase::__TakeSnapshot(cherry::PhysicsBody* body, BodySnapshot& snapshot)
+{
+	snapshot.Body = body;
+	snapshot.Object = body->GetObject();
+	snapshot.Type = body->GetId();
+
+	snapshot.Position = body->GetWorldPositionGLM();
+	snapshot.LastPosition = body->GetLastWorldPositionGLM();
+	snapshot.Fast = body->IsMovingFast();
+
+	glm::vec3 extents;
+
+	if (snapshot.Type == 1) // box
+	{
+		const cherry::PhysicsBodyBox* box = (const cherry::PhysicsBodyBox*)body;
+		snapshot.HalfSize = glm::vec3(box->GetWorldWidth(), box->GetWorldHeight(), box->GetWorldDepth()) * 0.5F;
+		snapshot.Radius = glm::length(snapshot.HalfSize);
+
+		// the rotation matrix is only made for boxes that are rotated.
+		snapshot.Rotated = box->GetWorldRotationDegreesGLM() != glm::vec3(0.0F);
+		snapshot.Rotation = (snapshot.Rotated) ? box->GetWorldRotationMatrix() : glm::mat3(1.0F);
+
+		extents = glm::abs(snapshot.Rotation[0]) * snapshot.HalfSize.x +
+			glm::abs(snapshot.Rotation[1]) * snapshot.HalfSize.y + glm::abs(snapshot.Rotation[2]) * snapshot.HalfSize.z;
+	}
+	else // sphere
+	{
+		snapshot.Radius = ((const cherry::PhysicsBodySphere*)body)->GetWorldRadius();
+		snapshot.HalfSize = glm::vec3(snapshot.Radius);
+		snapshot.Rotated = false;
+		snapshot.Rotation = glm::mat3(1.0F);
+
+		extents = snapshot.HalfSize;
+	}
+
+	// the box covers where the body was too, since fast bodies are swept.
+	snapshot.Min = glm::min(snapshot.Position, snapshot.LastPosition) - extents;
+	snapshot.Max = glm::max(snapshot.Position, snapshot.LastPosition) + extents;
+}
+
+// checks for overlap
+bool cherry::NarrowPhase::__Overlap(const BodySnapshot& a, const BodySnapshot& b)
+{
+	// Box - Box
+	if (a.Type == 1 && b.Type == 1)
+	{
+		const glm::vec3 offset = b.Position - a.Position;
+
+		// if the boxes haven't been rotated, a regular aabb check is done.
+		if (!a.Rotated && !b.Rotated)
+		{
+			const glm::vec3 overlap = a.HalfSize + b.HalfSize - glm::abs(offset);
+			return overlap.x >= 0.0F && overlap.y >= 0.0F && overlap.z >= 0.0F;
+		}
+
+		// if the spheres around the boxes don't touch, the boxes can't either.
+		const float radii = a.Radius + b.Radius;
+
+		if (glm::dot(offset, offset) > radii * radii)
+			return false;
+
+		return __BoxBoxOverlap(a, b);
+	}
+	// Sphere - Sphere
+	else if (a.Type == 2 && b.Type == 2)
+	{
+		const glm::vec3 offset = b.Position - a.Position;
+		const float radii = a.Radius + b.Radius;
+
+		return glm::dot(offset, offset) <= radii * radii;
+	}
+	// Sphere - Box
+	else
+	{
+		return (a.Type == 2) ? __SphereBoxOverlap(a, b) : __SphereBoxOverlap(b, a);
+	}
+}
+
+// sphere - box overlap
+bool cherry::NarrowPhase::__SphereBoxOverlap(const BodySnapshot& sphere, const BodySnapshot& box)
+{
+	// the closest point on the box, in the box's space.
+	const glm::vec3 local = glm::transpose(box.Rotation) * (sphere.Position - box.Position);
+	const glm::vec3 offset = local - glm::clamp(local, -box.HalfSize, box.HalfSize);
+
+	return glm::dot(offset, offset) < sphere.Radius * sphere.Radius;
+}
+
+// box - box overlap
+bool cherry::NarrowPhase::__BoxBoxOverlap(const BodySnapshot& a, const BodySnapshot& b)
+{
+	const glm::vec3 offset = b.Position - a.Position;
+
+	// separating axis test: the boxes overlap if they overlap on each of their face normals, and on the cross products of their edges.
+	glm::vec3 axes[15];
+	int axisCount = 0;
+
+	for (int i = 0; i < 3; i++)
+	{
+		axes[axisCount++] = a.Rotation[i];
+		axes[axisCount++] = b.Rotation[i];
+	}
+
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+			axes[axisCount++] = glm::cross(a.Rotation[i], b.Rotation[j]);
+	}
+
+	for (int i = 0; i < axisCount; i++)
+	{
+		// edges that are parallel don't make an axis. The axes don't need to be normalized, since both sides are scaled the same.
+		if (glm::dot(axes[i], axes[i]) < 1.0E-6F)
+			continue;
+
+		float radiusA = 0.0F, radiusB = 0.0F;
+
+		for (int j = 0; j < 3; j++)
+		{
+			radiusA += fabsf(glm::dot(axes[i], a.Rotation[j])) * a.HalfSize[j];
+			radiusB += fabsf(glm::dot(axes[i], b.Rotation[j])) * b.HalfSize[j];
+		}
+
+		if (fabsf(glm::dot(offset, axes[i])) > radiusA + radiusB)
+			return false;
+	}
+
+	return true;
+}
+
+// runs the narrow phase
+void cherry::NarrowPhase::__Run()
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	// the snapshot. The bodies are only read, so they can be copied on any thread.
+	snapshots.resize(bodies.size());
+
+	const uint32_t bodyTasks = ((uint32_t)bodies.size() + NARROW_PHASE_BODIES_PER_TASK - 1) / NARROW_PHASE_BODIES_PER_TASK;
+
+	pool.Run(bodyTasks, [this](uint32_t task, uint32_t)
+		{
+			const size_t first = (size_t)task * NARROW_PHASE_BODIES_PER_TASK;
+			const size_t last = std::min(first + NARROW_PHASE_BODIES_PER_TASK, bodies.size());
+
+			for (size_t i = first; i < last; i++)
+				__TakeSnapshot(bodies[i], snapshots[i]);
+		});
+
+	__FindPairs();
+
+	// the pairs. Each thread keeps its hits in its own buffer, and each task remembers where its hits went.
+	for (std::vector<CollisionHit>& buffer : threadHits)
+		buffer.clear();
+
+	const uint32_t pairTasks = ((uint32_t)pairs.size() + NARROW_PHASE_PAIRS_PER_TASK - 1) / NARROW_PHASE_PAIRS_PER_TASK;
+	taskHits.resize(pairTasks);
+
+	pool.Run(pairTasks, [this](uint32_t task, uint32_t thread)
+		{
+			std::vector<CollisionHit>& buffer = threadHits[thread];
+			TaskRange& range = taskHits[task];
+
+			range.Thread = thread;
+			range.Start = (uint32_t)buffer.size();
+
+			const size_t first = (size_t)task * NARROW_PHASE_PAIRS_PER_TASK;
+			const size_t last = std::min(first + NARROW_PHASE_PAIRS_PER_TASK, pairs.size());
+
+			for (size_t i = first; i < last; i++)
+			{
+				CollisionHit hit;
+				hit.First = pairs[i].first;
+				hit.Second = pairs[i].second;
+
+				if (Test(snapshots[hit.First], snapshots[hit.Second], hit.TimeOfImpact))
+					buffer.push_back(hit);
+			}
+
+			range.Count = (uint32_t)buffer.size() - range.Start;
+		});
+
+	// joins the buffers in task order.
+	hits.clear();
+
+	for (const TaskRange& range : taskHits)
+	{
+		const std::vector<CollisionHit>& buffer = threadHits[range.Thread];
+		hits.insert(hits.end(), buffer.begin() + range.Start, buffer.begin() + range.Start + range.Count);
+	}
+
+	time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+// finds the pairs
+void cherry::NarrowPhase::__FindPairs()
+{
+	// the space is split into stripes along the y-axis. Each stripe is about twice the size of the average body, so most bodies are only in one or two.
+	float minY = FLT_MAX, maxY = -FLT_MAX, totalSize = 0.0F;
+
+	for (const BodySnapshot& snapshot : snapshots)
+	{
+		minY = std::min(minY, snapshot.Min.y);
+		maxY = std::max(maxY, snapshot.Max.y);
+		totalSize += snapshot.Max.y - snapshot.Min.y;
+	}
+
+	uint32_t stripeCount = 1;
+	float stripeSize = 1.0F;
+
+	if (!snapshots.empty() && maxY > minY && totalSize > 0.0F)
+	{
+		const float averageSize = totalSize / snapshots.size();
+
+		stripeCount = (uint32_t)glm::clamp((maxY - minY) / (averageSize * 2.0F), 1.0F, (float)NARROW_PHASE_MAX_STRIPES);
+		stripeSize = (maxY - minY) / stripeCount;
+	}
+
+	// gets the stripe a y-value is in.
+	auto getStripe = [minY, stripeSize, stripeCount](float y) -> uint32_t
+	{
+		const int stripe = (int)((y - minY) / stripeSize);
+		return (uint32_t)glm::clamp(stripe, 0, (int)stripeCount - 1);
+	};
+
+	// the boxes are grouped by stripe. A body is put in every stripe it overlaps.
+	stripeStarts.assign(stripeCount + 1, 0);
+
+	for (const BodySnapshot& snapshot : snapshots)
+	{
+		for (uint32_t stripe = getStripe(snapshot.Min.y); stripe <= getStripe(snapshot.Max.y); stripe++)
+			stripeStarts[stripe + 1]++;
+	}
+
+	for (uint32_t i = 0; i < stripeCount; i++)
+		stripeStarts[i + 1] += stripeStarts[i];
+
+	sweepBoxes.resize(stripeStarts[stripeCount]);
+	stripeFill.assign(stripeStarts.begin(), stripeStarts.end() - 1);
+
+	for (uint32_t i = 0; i < snapshots.size(); i++)
+	{
+		const BodySnapshot& snapshot = snapshots[i];
+
+		for (uint32_t stripe = getStripe(snapshot.Min.y); stripe <= getStripe(snapshot.Max.y); stripe++)
+			sweepBoxes[stripeFill[stripe]++] = { snapshot.Min, i, snapshot.Max, snapshot.Object };
+	}
+
+	// each stripe is a task. The stripe's boxes are sorted along the x-axis, then swept, keeping the pairs in the thread's buffer.
+	for (std::vector<std::pair<uint32_t, uint32_t>>& buffer : threadPairs)
+		buffer.clear();
+
+	taskPairs.resize(stripeCount);
+
+	pool.Run(stripeCount, [this, &getStripe](uint32_t stripe, uint32_t thread)
+		{
+			std::vector<std::pair<uint32_t, uint32_t>>& buffer = threadPairs[thread];
+			TaskRange& range = taskPairs[stripe];
+
+			range.Thread = thread;
+			range.Start = (uint32_t)buffer.size();
+
+			SweepBox* const first = sweepBoxes.data() + stripeStarts[stripe];
+			SweepBox* const last = sweepBoxes.data() + stripeStarts[stripe + 1];
+
+			// ties are sorted by index, so the order is always the same.
+			std::sort(first, last, [](const SweepBox& b1, const SweepBox& b2)
+				{
+					return (b1.Min.x != b2.Min.x) ? b1.Min.x < b2.Min.x : b1.Index < b2.Index;
+				});
+
+			// only the bodies that start before the current one ends can overlap it.
+			for (const SweepBox* a = first; a != last; a++)
+			{
+				for (const SweepBox* b = a + 1; b != last; b++)
+				{
+					if (b->Min.x > a->Max.x)
+						break;
+
+					// the checks are combined so there's only one branch, which is almost always taken.
+					if (!((b->Min.y <= a->Max.y) & (b->Max.y >= a->Min.y) & (b->Min.z <= a->Max.z) & (b->Max.z >= a->Min.z)))
+						continue;
+
+					// bodies on the same object don't collide with each other.
+					if (a->Object != nullptr && a->Object == b->Object)
+						continue;
+
+					// a pair that's in more than one stripe is only kept by the stripe that its overlap starts in.
+					if (getStripe(std::max(a->Min.y, b->Min.y)) != stripe)
+						continue;
+
+					buffer.push_back(std::make_pair(std::min(a->Index, b->Index), std::max(a->Index, b->Index)));
+				}
+			}
+
+			range.Count = (uint32_t)buffer.size() - range.Start;
+		});
+
+	// joins the buffers in task order.
+	pairs.clear();
+
+	for (const TaskRange& range : taskPairs)
+	{
+		const std::vector<std::pair<uint32_t, uint32_t>>& buffer = threadPairs[range.Thread];
+		pairs.insert(pairs.end(), buffer.begin() + range.Start, buffer.begin() + range.Start + range.Count);
+	}
+}
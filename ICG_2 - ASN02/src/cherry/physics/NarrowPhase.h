@@ -0,0 +1,141 @@
+// NarrowPhase (Header) - finds the physics bodies that are colliding, splitting the work across a thread pool.
+#pragma once
+#include <GLM/glm.hpp>
+#include <vector>
+#include <stdint.h>
+
+#include "PhysicsBody.h"
+#include "..\ThreadPool.h"
+
+// the amount of pairs each task tests.
+#define NARROW_PHASE_PAIRS_PER_TASK 512
+
+// the amount of bodies each task copies into the snapshot.
+#define NARROW_PHASE_BODIES_PER_TASK 256
+
+// the most stripes the bodies are split into for the sweep.
+#define NARROW_PHASE_MAX_STRIPES 1024
+
+namespace cherry
+{
+	// a copy of a body's world values, taken at the start of the frame.
+	struct BodySnapshot
+	{
+		cherry::PhysicsBody* Body = nullptr;
+		cherry::Object* Object = nullptr;
+		int Type = 0; // 1 = box, 2 = sphere
+
+		glm::vec3 Position = glm::vec3(0.0F);
+		glm::vec3 LastPosition = glm::vec3(0.0F); // the position at the start of the frame (see PhysicsBody::GetLastWorldPositionGLM()).
+
+		glm::vec3 HalfSize = glm::vec3(0.0F); // the half size of a box.
+		glm::mat3 Rotation = glm::mat3(1.0F); // the rotation of a box.
+		float Radius = 0.0F; // the radius of a sphere, or the radius of the sphere around a box.
+
+		bool Rotated = false; // 'true' if the box is rotated.
+		bool Fast = false; // see PhysicsBody::IsMovingFast().
+
+		glm::vec3 Min = glm::vec3(0.0F), Max = glm::vec3(0.0F); // the box around the body, from where it was to where it is.
+	};
+
+	// a pair of bodies that are colliding.
+	struct CollisionHit
+	{
+		uint32_t First = 0, Second = 0; // the indexes of the bodies in the snapshot.
+		float TimeOfImpact = 1.0F; // see PhysicsBody::SweptCollision().
+	};
+
+	/*
+	 * Each Run():
+	 *** copies the world values of every body into a snapshot, so the workers never call into the bodies or their objects.
+	 *** splits the space into stripes along the y-axis, then sorts and sweeps each stripe along the x-axis on the threads to pair up the bodies whose boxes overlap.
+	 *** splits the pairs into tasks for the thread pool. Each thread writes its hits into its own buffer.
+	 *** joins the buffers in task order, so the pairs and hits are in the same order regardless of which thread ran which task.
+	 * The tests follow PhysicsBody::SweptCollision(), so fast bodies are swept from where they were at the start of the frame.
+	 * Bodies on the same object aren't tested against each other.
+	*/
+	class NarrowPhase
+	{
+	public:
+		// the amount of threads (including the calling thread). If this is 0, one is used for each core.
+		NarrowPhase(uint32_t threadCount = 0);
+
+		// finds the collisions between the bodies of the objects. Objects that are already intersecting are skipped.
+		void Run(const std::vector<cherry::Object*>& objects);
+
+		// finds the collisions between the bodies.
+		void Run(const std::vector<cherry::PhysicsBody*>& physicsBodies);
+
+		// gets the snapshot from the last run.
+		const std::vector<BodySnapshot>& GetSnapshots() const;
+
+		// gets the hits from the last run.
+		const std::vector<CollisionHit>& GetHits() const;
+
+		// gets the amount of pairs that were tested in the last run.
+		size_t GetPairCount() const;
+
+		// gets how long the last run took (in milliseconds).
+		float GetTime() const;
+
+		// gets the amount of threads.
+		uint32_t GetThreadCount() const;
+
+		// checks if two bodies are colliding, using only their snapshots.
+		static bool Test(const BodySnapshot& a, const BodySnapshot& b, float& toi);
+
+	private:
+		// the part of a thread's buffer that has the results of a task.
+		struct TaskRange
+		{
+			uint32_t Thread = 0;
+			uint32_t Start = 0;
+			uint32_t Count = 0;
+		};
+
+		// the box around a body, copied into its stripes so the sweep reads through memory in order.
+		struct SweepBox
+		{
+			glm::vec3 Min;
+			uint32_t Index; // the index of the body in the snapshot.
+			glm::vec3 Max;
+			const cherry::Object* Object;
+		};
+
+		// copies a body's values.
+		static void __TakeSnapshot(cherry::PhysicsBody* body, BodySnapshot& snapshot);
+
+		// checks if two bodies are colliding where they are now.
+		static bool __Overlap(const BodySnapshot& a, const BodySnapshot& b);
+
+		// checks if a sphere and a box are colliding where they are now.
+		static bool __SphereBoxOverlap(const BodySnapshot& sphere, const BodySnapshot& box);
+
+		// checks if two boxes are colliding, with at least one of them rotated.
+		static bool __BoxBoxOverlap(const BodySnapshot& a, const BodySnapshot& b);
+
+		// takes the snapshot and tests the bodies in the body list.
+		void __Run();
+
+		// pairs up the bodies whose boxes overlap.
+		void __FindPairs();
+
+		ThreadPool pool;
+
+		std::vector<cherry::PhysicsBody*> bodies;
+		std::vector<BodySnapshot> snapshots;
+		std::vector<SweepBox> sweepBoxes; // the boxes of the bodies, grouped by stripe.
+		std::vector<uint32_t> stripeStarts; // where each stripe's boxes start (with the total at the end).
+		std::vector<uint32_t> stripeFill; // used to fill the stripes.
+		std::vector<std::pair<uint32_t, uint32_t>> pairs;
+
+		std::vector<std::vector<std::pair<uint32_t, uint32_t>>> threadPairs; // a buffer for each thread.
+		std::vector<TaskRange> taskPairs; // where each task's pairs are.
+
+		std::vector<std::vector<CollisionHit>> threadHits; // a buffer for each thread.
+		std::vector<TaskRange> taskHits; // where each task's hits are.
+		std::vector<CollisionHit> hits;
+
+		float time = 0.0F;
+	};
+}
@@ -0,0 +1,87 @@
+// PhysicsBenchmark (Source) - times the physics world on stacks of boxes, and checks that running it twice gives the same results.
+#include "PhysicsBenchmark.h"
+#include "PhysicsWorld.h"
+
+#include <toolkit/Logging.h>
+#include <algorithm>
+#include <chrono>
+
+// runs the benchmark
+cherry::PhysicsBenchmarkResult cherry::PhysicsBenchmark::Run(uint32_t stacksPerSide, uint32_t stackHeight, uint32_t steps)
+{
+	PhysicsBenchmarkResult result = __Run(stacksPerSide, stackHeight, steps);
+	PhysicsBenchmarkResult second = __Run(stacksPerSide, stackHeight, steps);
+
+	result.Deterministic = result.Hash == second.Hash;
+
+	LOG_INFO("Physics benchmark: {} bodies, {} steps, {:.3f} ms per step ({:.3f} ms longest), {} asleep at the end.",
+		result.Bodies, result.Steps, result.AverageStepTime, result.LongestStepTime, result.SleepingBodies);
+
+	if (result.Deterministic)
+		LOG_INFO("Physics benchmark: both runs ended with hash {:016x}.", result.Hash);
+	else
+		LOG_ERROR("Physics benchmark: the runs ended differently (hash {:016x} and {:016x}).", result.Hash, second.Hash);
+
+	return result;
+}
+
+// runs the world once
+cherry::PhysicsBenchmarkResult cherry::PhysicsBenchmark::__Run(uint32_t stacksPerSide, uint32_t stackHeight, uint32_t steps)
+{
+	PhysicsBenchmarkResult result;
+
+	const float size = 1.0F;
+	const float spacing = size * 1.5F;
+	const float groundSize = spacing * (stacksPerSide + 2);
+
+	std::vector<PhysicsBody*> physicsBodies;
+	PhysicsWorld world;
+
+	// the ground's top is at z = 0.
+	physicsBodies.push_back(new PhysicsBodyBox(cherry::Vec3(0.0F, 0.0F, -0.5F), groundSize, groundSize, 1.0F));
+	world.AddBody(physicsBodies.back(), 0.0F);
+
+	// the stacks start slightly apart, so the boxes drop onto each other.
+	const float offset = (stacksPerSide - 1) * spacing * 0.5F;
+
+	for (uint32_t x = 0; x < stacksPerSide; x++)
+	{
+		for (uint32_t y = 0; y < stacksPerSide; y++)
+		{
+			for (uint32_t z = 0; z < stackHeight; z++)
+			{
+				cherry::Vec3 position(x * spacing - offset, y * spacing - offset, size * 0.5F + z * size * 1.05F);
+
+				physicsBodies.push_back(new PhysicsBodyBox(position, size, size, size));
+				world.AddBody(physicsBodies.back(), 1.0F);
+			}
+		}
+	}
+
+	result.Bodies = (uint32_t)world.GetBodyCount() - 1;
+	result.Steps = steps;
+
+	float totalTime = 0.0F;
+
+	for (uint32_t i = 0; i < steps; i++)
+	{
+		auto start = std::chrono::high_resolution_clock::now();
+		world.Step(world.fixedTimeStep);
+		float time = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		totalTime += time;
+		result.LongestStepTime = std::max(result.LongestStepTime, time);
+	}
+
+	result.AverageStepTime = (steps > 0) ? totalTime / steps : 0.0F;
+	result.SleepingBodies = result.Bodies - (uint32_t)world.GetAwakeBodyCount();
+	result.Hash = world.GetStateHash();
+
+	// the rigid bodies are deleted before the physics bodies they use.
+	world.Clear();
+
+	for (PhysicsBody* body : physicsBodies)
+		delete body;
+
+	return result;
+}
@@ -0,0 +1,34 @@
+// PhysicsBenchmark (Header) - times the physics world on stacks of boxes, and checks that running it twice gives the same results.
+#pragma once
+#include <stdint.h>
+
+namespace cherry
+{
+	// the results of a benchmark.
+	struct PhysicsBenchmarkResult
+	{
+		uint32_t Bodies = 0; // the amount of falling bodies (the ground isn't counted).
+		uint32_t Steps = 0;
+		float AverageStepTime = 0.0F; // (in milliseconds)
+		float LongestStepTime = 0.0F; // (in milliseconds)
+		uint32_t SleepingBodies = 0; // the bodies that were asleep at the end.
+		uint64_t Hash = 0; // the hash of the world at the end (see PhysicsWorld::GetStateHash()).
+		bool Deterministic = false; // 'true' if a second run ended with the same hash.
+	};
+
+	/*
+	 * The benchmark drops a grid of box stacks onto a static ground, and lets them settle.
+	 * The bodies aren't attached to objects, so nothing is drawn and no OpenGL context is needed.
+	 * The world is run twice from the same start, and the hashes are compared to make sure the steps are deterministic.
+	*/
+	class PhysicsBenchmark
+	{
+	public:
+		// runs the benchmark with (stacksPerSide * stacksPerSide) stacks, each with the provided amount of boxes. The results are printed to the log.
+		static PhysicsBenchmarkResult Run(uint32_t stacksPerSide = 6, uint32_t stackHeight = 10, uint32_t steps = 600);
+
+	private:
+		// runs the world once.
+		static PhysicsBenchmarkResult __Run(uint32_t stacksPerSide, uint32_t stackHeight, uint32_t steps);
+	};
+}
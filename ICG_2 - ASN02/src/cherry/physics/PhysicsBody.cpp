@@ -1,12 +1,13 @@
 // Physics Body - used to add physics related properties to an object.
 #include "PhysicsBody.h"
+#include "PhysicsWorld.h"
 #include "..\utils/math/Collision.h"
-#include "..\objects/PrimitiveCube.h"
 #include "..\WorldTransform.h"
 
 #include "..\utils/math/Rotation.h"
 
 float cherry::PhysicsBody::alpha = 0.80F;
+unsigned int cherry::PhysicsBody::visibleCount = 0;
 
 
 // constructors
@@ -14,26 +15,19 @@ float cherry::PhysicsBody::alpha = 0.80F;
 cherry::PhysicsBody::PhysicsBody(int id) : PhysicsBody(id, cherry::Vec3()) {}
 
 // sets the ID for a specific type of physics body
-cherry::PhysicsBody::PhysicsBody(int id, cherry::Vec3 pos) : id(id), position(pos) 
+// the body has no geometry of its own. Visible bodies are drawn by the DebugDraw class using shared meshes.
+cherry::PhysicsBody::PhysicsBody(int id, cherry::Vec3 pos) : id(id), worldPosition(pos), lastWorldPosition(pos), position(pos)
 {
-	// creates a material for the physics body. This is used to display the physics body for debugging purposes.
-	Shader::Sptr shader = std::make_shared<Shader>(); // creates the shader
-
-	// shader->Load("res/shaders/lighting.vs.glsl", "res/shaders/blinn-phong.fs.glsl");
-	shader->Load("res/shaders/shader.vs.glsl", "res/shaders/shader.fs.glsl");
-
-	// creating the material
-	material = std::make_shared<Material>(shader);
-
-	// setting transparency since the bodies need to be see through
-	material->HasTransparency = true;
 }
 
 // deleting the object
 cherry::PhysicsBody::~PhysicsBody()
 {
-	if (body != nullptr)
-		delete body;
+	SetVisible(false); // removes the body from the visible count.
+
+	// the world's rigid body uses this body, so it's removed with it.
+	if (physicsWorld != nullptr)
+		physicsWorld->RemoveBody(this);
 }
 
 
@@ -48,24 +42,27 @@ int cherry::PhysicsBody::GetId() const { return id; }
 // gets the object this physics body is attachted to.
 cherry::Object* cherry::PhysicsBody::GetObject() const { return object; }
 
+// gets the physics world the body is in.
+cherry::PhysicsWorld* cherry::PhysicsBody::GetPhysicsWorld() const { return physicsWorld; }
+
 // sets the object for hte physics body
 void cherry::PhysicsBody::SetObject(cherry::Object* obj) 
 { 
 	object = obj; 
 
-	if (object != nullptr) // adds the body to the scene, and gives it the material
+	if (object != nullptr) // moves the body into the object's space
 	{
-		body->CreateEntity(object->GetSceneName(), material);
-		body->SetVisible(false);
-
-		body->SetScale(scale);
-		body->SetRotationDegrees(rotation);
-		body->SetPosition(position);
+		SetLocalScale(scale);
+		SetLocalRotationDegrees(rotation);
+		SetLocalPosition(position);
 
 		// current values.
 		currParentScale = object->GetScale();
 		currParentRot = object->GetRotationDegrees();
 		currParentPos = object->GetPosition();
+
+		// moving onto the object isn't counted as movement.
+		lastWorldPosition = GetWorldPosition();
 	}
 }
 
@@ -164,8 +161,7 @@ void cherry::PhysicsBody::SetLocalPosition(cherry::Vec3 lPos)
 
 	result = parent * child;
 
-	if (body != nullptr)
-		body->SetPosition(result[0][3], result[1][3], result[2][3]);
+	worldPosition = cherry::Vec3(result[0][3], result[1][3], result[2][3]);
 }
 
 // sets the model (local) position
@@ -215,11 +211,8 @@ void cherry::PhysicsBody::SetLocalRotationDegrees(Vec3 degrees)
 { 
 	rotation = degrees;
 
-	// body exists
-	if (body != nullptr && object != nullptr)
-	{
-		body->SetRotationDegrees(object->GetRotationDegrees() + degrees);
-	}
+	// the rotation is relative to the object's rotation.
+	worldRotation = (object != nullptr) ? object->GetRotationDegrees() + degrees : degrees;
 }
 
 // gets the local rotation in radians.
@@ -244,53 +237,36 @@ cherry::Vec3 cherry::PhysicsBody::GetLocalRotationRadians() const
 // set rotation in radians
 void cherry::PhysicsBody::SetLocalRotationRadians(Vec3 radians)
 {
-	rotation = Vec3(
-		util::math::radiansToDegrees(rotation.v.x),
-		util::math::radiansToDegrees(rotation.v.y),
-		util::math::radiansToDegrees(rotation.v.z)
-	);
-
-	// body exists
-	if (body != nullptr)
-	{
-		body->SetRotationRadians(body->GetRotationRadians() + radians);
-	}
+	SetLocalRotationDegrees(Vec3(
+		util::math::radiansToDegrees(radians.v.x),
+		util::math::radiansToDegrees(radians.v.y),
+		util::math::radiansToDegrees(radians.v.z)
+	));
 }
 
 // gets the world rotation in degrees.
 glm::vec3 cherry::PhysicsBody::GetWorldRotationDegreesGLM() const
 {
-	if (body != nullptr)
-		return body->GetRotationDegreesGLM();
-	else
-		return GetLocalRotationDegreesGLM();
+	return glm::vec3(worldRotation.v.x, worldRotation.v.y, worldRotation.v.z);
 }
 
 // gets the world rotation of the body.
-cherry::Vec3 cherry::PhysicsBody::GetWorldRotationDegrees() const 
-{ 
-	if (body != nullptr)
-		return body->GetRotationDegrees();
-	else
-		return rotation;
-}
+cherry::Vec3 cherry::PhysicsBody::GetWorldRotationDegrees() const { return worldRotation; }
 
 // gets the world rotation in radians.
 cherry::Vec3 cherry::PhysicsBody::GetWorldRotationRadiansGLM() const
 {
-	if (body != nullptr)
-		return body->GetRotationRadiansGLM();
-	else
-		return GetLocalRotationRadiansGLM();
+	return GetWorldRotationRadians();
 }
 
 // gets the world rotation in radians.
 cherry::Vec3 cherry::PhysicsBody::GetWorldRotationRadians() const
 {
-	if (body != nullptr)
-		return body->GetRotationRadians();
-	else
-		return GetLocalRotationRadians();
+	return Vec3(
+		util::math::degreesToRadians(worldRotation.v.x),
+		util::math::degreesToRadians(worldRotation.v.y),
+		util::math::degreesToRadians(worldRotation.v.z)
+	);
 }
 
 
@@ -308,36 +284,25 @@ void cherry::PhysicsBody::SetLocalScale(cherry::Vec3 newScale)
 	scale = newScale; 
 
 	// scale of the physics body.
-	cherry::Vec3 bodyScale = newScale;
+	worldScale = newScale;
 
 	// setting the scale proportional to the body.
-	if (object != nullptr && body != nullptr)
+	if (object != nullptr)
 	{
-		bodyScale.v.x = object->GetScaleX() * scale.v.x;
-		bodyScale.v.y = object->GetScaleY() * scale.v.y;
-		bodyScale.v.z = object->GetScaleZ() * scale.v.z;
+		worldScale.v.x = object->GetScaleX() * scale.v.x;
+		worldScale.v.y = object->GetScaleY() * scale.v.y;
+		worldScale.v.z = object->GetScaleZ() * scale.v.z;
 	}
-	
-	body->SetScale(bodyScale);
 }
 
 // gets the world scale.
 glm::vec3 cherry::PhysicsBody::GetWorldScaleGLM() const
 {
-	if (body != nullptr)
-		return body->GetScaleGLM();
-	else
-		return glm::vec3(scale.v.x, scale.v.y, scale.v.z);
+	return glm::vec3(worldScale.v.x, worldScale.v.y, worldScale.v.z);
 }
 
 // gets the world scale of the physics body.
-cherry::Vec3 cherry::PhysicsBody::GetWorldScale() const
-{
-	if (body != nullptr)
-		return body->GetScale();
-	else
-		return scale;
-}
+cherry::Vec3 cherry::PhysicsBody::GetWorldScale() const { return worldScale; }
 
 
 // calculates collision between sceneLists
@@ -469,33 +434,174 @@ bool cherry::PhysicsBody::Collision(PhysicsBody* p1, PhysicsBody* p2)
 	return false;
 }
 
-// states whether the body is visible.
-bool cherry::PhysicsBody::IsVisible() const
+// gets the last world position
+glm::vec3 cherry::PhysicsBody::GetLastWorldPositionGLM() const
 {
-	// if a body hasn't been set, then it must be invisible.
-	if (body == nullptr)
-		return false;
-	else
-		return body->IsVisible();
+	return glm::vec3(lastWorldPosition.v.x, lastWorldPosition.v.y, lastWorldPosition.v.z);
 }
 
-// toggle visibility
-void cherry::PhysicsBody::SetVisible()
+// saves the last world position
+void cherry::PhysicsBody::SaveLastWorldPosition() { lastWorldPosition = GetWorldPosition(); }
+
+// gets the movement
+glm::vec3 cherry::PhysicsBody::GetMovementGLM() const { return GetWorldPositionGLM() - GetLastWorldPositionGLM(); }
+
+// gets the smallest size
+float cherry::PhysicsBody::GetSmallestWorldSize() const
+{
+	switch (id)
+	{
+	case 1: // box
+	{
+		const cherry::PhysicsBodyBox* box = (const cherry::PhysicsBodyBox*)this;
+		return min(box->GetWorldWidth(), min(box->GetWorldHeight(), box->GetWorldDepth()));
+	}
+
+	case 2: // sphere
+		return ((const cherry::PhysicsBodySphere*)this)->GetWorldDiameter();
+
+	default:
+		return 0.0F;
+	}
+}
+
+// checks if the body is moving fast
+bool cherry::PhysicsBody::IsMovingFast() const
+{
+	// the squared lengths are compared so that the square root isn't needed.
+	glm::vec3 movement = GetMovementGLM();
+	float size = GetSmallestWorldSize();
+
+	return glm::dot(movement, movement) > size * size;
+}
+
+// gets the world rotation matrix
+glm::mat3 cherry::PhysicsBody::GetWorldRotationMatrix() const
 {
-	if (body != nullptr)
-		body->SetVisible();
+	TempTransform transform;
+	transform.EulerRotation = GetWorldRotationDegreesGLM();
+
+	return glm::mat3(transform.GetWorldTransform());
 }
 
+// swept collision between bodies
+bool cherry::PhysicsBody::SweptCollision(PhysicsBody* p1, PhysicsBody* p2, float& toi)
+{
+	toi = 1.0F;
+
+	// if either object is null, or doesn't have a type.
+	if (p1 == nullptr || p2 == nullptr || p1->GetId() == 0 || p2->GetId() == 0)
+		return false;
+
+	// slow bodies can't pass through each other between updates, so only where they are now is checked.
+	if (!p1->IsMovingFast() && !p2->IsMovingFast())
+		return Collision(p1, p2);
+
+	// Box - Box
+	if (p1->GetId() == 1 && p2->GetId() == 1)
+	{
+		cherry::PhysicsBodyBox* box1 = (cherry::PhysicsBodyBox*)p1;
+		cherry::PhysicsBodyBox* box2 = (cherry::PhysicsBodyBox*)p2;
+
+		// rotated boxes use the box around their corners, so the contact can be found a bit early.
+		glm::vec3 size1 = glm::vec3(box1->GetWorldWidth(), box1->GetWorldHeight(), box1->GetWorldDepth());
+		glm::vec3 size2 = glm::vec3(box2->GetWorldWidth(), box2->GetWorldHeight(), box2->GetWorldDepth());
+
+		glm::mat3 rot1 = box1->GetWorldRotationMatrix();
+		glm::mat3 rot2 = box2->GetWorldRotationMatrix();
+
+		for (int i = 0; i < 3; i++)
+		{
+			rot1[i] = glm::abs(rot1[i]);
+			rot2[i] = glm::abs(rot2[i]);
+		}
+
+		size1 = rot1 * size1;
+		size2 = rot2 * size2;
+
+		bool col = util::math::sweptAABBCollision(
+			cherry::Vec3(box1->GetLastWorldPositionGLM()).v, box1->GetWorldPosition().v, cherry::Vec3(size1).v,
+			cherry::Vec3(box2->GetLastWorldPositionGLM()).v, box2->GetWorldPosition().v, cherry::Vec3(size2).v, toi);
+
+		// the box around a rotated box is larger than it, so the regular check is done to confirm it.
+		if (col && toi == 0.0F && (box1->GetWorldRotationDegrees() != cherry::Vec3() || box2->GetWorldRotationDegrees() != cherry::Vec3()))
+			col = Collision(p1, p2);
+
+		return col;
+	}
+	// Sphere - Sphere
+	else if (p1->GetId() == 2 && p2->GetId() == 2)
+	{
+		cherry::PhysicsBodySphere* sphere1 = (cherry::PhysicsBodySphere*)p1;
+		cherry::PhysicsBodySphere* sphere2 = (cherry::PhysicsBodySphere*)p2;
+
+		return util::math::sweptSphereCollision(
+			cherry::Vec3(sphere1->GetLastWorldPositionGLM()).v, sphere1->GetWorldPosition().v, sphere1->GetWorldRadius(),
+			cherry::Vec3(sphere2->GetLastWorldPositionGLM()).v, sphere2->GetWorldPosition().v, sphere2->GetWorldRadius(), toi);
+	}
+	// Sphere - Box
+	else if ((p1->GetId() == 1 && p2->GetId() == 2) || (p1->GetId() == 2 && p2->GetId() == 1))
+	{
+		// the sphere goes first.
+		if (p1->GetId() == 1)
+			return SweptCollision(p2, p1, toi);
+
+		cherry::PhysicsBodySphere* sphere = (cherry::PhysicsBodySphere*)p1;
+		cherry::PhysicsBodyBox* box = (cherry::PhysicsBodyBox*)p2;
+
+		// the sphere is moved into the box's space, so the box can be treated as an aabb at the origin.
+		glm::mat3 inverseRot = glm::transpose(box->GetWorldRotationMatrix());
+		glm::vec3 start = inverseRot * (sphere->GetLastWorldPositionGLM() - box->GetLastWorldPositionGLM());
+		glm::vec3 end = inverseRot * (sphere->GetWorldPositionGLM() - box->GetWorldPositionGLM());
+
+		return util::math::sweptSphereAABBCollision(cherry::Vec3(start).v, cherry::Vec3(end).v, sphere->GetWorldRadius(),
+			util::math::Vec3(), util::math::Vec3(), box->GetWorldWidth(), box->GetWorldHeight(), box->GetWorldDepth(), toi);
+	}
+
+	return false;
+}
+
+// states whether the body is visible.
+bool cherry::PhysicsBody::IsVisible() const { return visible; }
+
+// toggle visibility
+void cherry::PhysicsBody::SetVisible() { SetVisible(!visible); }
+
 // sets visibility
 void cherry::PhysicsBody::SetVisible(bool visible)
 {
-	if (body != nullptr)
-		body->SetVisible(visible);
+	// the count is only changed if the visibility changes.
+	if (this->visible != visible)
+		(visible) ? visibleCount++ : visibleCount--;
+
+	this->visible = visible;
+}
+
+// gets the amount of visible bodies
+unsigned int cherry::PhysicsBody::GetVisibleCount() { return visibleCount; }
+
+// gets the world transformation
+glm::mat4 cherry::PhysicsBody::GetWorldTransform() const
+{
+	TempTransform transform;
+
+	transform.Position = glm::vec3(worldPosition.v.x, worldPosition.v.y, worldPosition.v.z);
+	transform.EulerRotation = GetWorldRotationDegreesGLM();
+	transform.Scale = GetWorldScaleGLM();
+
+	return transform.GetWorldTransform();
+}
+
+// gets the debug colour
+glm::vec4 cherry::PhysicsBody::GetDebugColor() const
+{
+	return glm::vec4(COLOUR.v.x, COLOUR.v.y, COLOUR.v.z, COLOUR.v.w * alpha);
 }
 
 // updates a physics body
 void cherry::PhysicsBody::Update(float deltaTime)
 {
+	// the last world position isn't saved here, since the object has already been moved this frame (see SaveLastWorldPosition()).
 	if (object != nullptr)
 	{
 		// if the scale, rotation, or position has been changed.
@@ -543,13 +649,7 @@ cherry::PhysicsBodyBox::PhysicsBodyBox(float x, float y, float z, float width, f
 cherry::PhysicsBodyBox::PhysicsBodyBox(cherry::Vec3 position, float width, float height, float depth)
 	: PhysicsBody(1, position), width(abs(width)), height(abs(height)), depth(abs(depth))// , box(width, height, depth)
 {
-	body = new cherry::PrimitiveCube(width, height, depth, COLOUR);
-	// body->SetPosition(position);
-	if(object != nullptr)
-		body->CreateEntity(object->GetSceneName(), material);
-
 	SetLocalPosition(position);
-	body->SetAlpha(alpha);
 }
 
 // location of the physics body and its dimensions
@@ -608,14 +708,7 @@ cherry::PhysicsBodySphere::PhysicsBodySphere(float radius) : PhysicsBodySphere(V
 cherry::PhysicsBodySphere::PhysicsBodySphere(cherry::Vec3 position, float radius)
 	: PhysicsBody(2, position), radius(radius) 
 {
-	body = new cherry::PrimitiveUVSphere(radius, 15, 15, COLOUR);
-
-	if(object != nullptr)
-		body->CreateEntity(object->GetSceneName(), object->GetMaterial());
-
 	SetLocalPosition(position);
-	body->SetAlpha(alpha);
-	
 }
 
 // gets the radius
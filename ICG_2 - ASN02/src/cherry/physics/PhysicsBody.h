@@ -1,10 +1,12 @@
 // Physics Body - used to add physics related properties to an object.
 #pragma once
 #include "..\VectorCRY.h"
-#include "..\objects/Primitives.h"
+#include "..\objects/Object.h"
 
 namespace cherry
 {
+	class PhysicsWorld;
+
 	// abstract physics body class
 	class PhysicsBody
 	{
@@ -32,6 +34,9 @@ namespace cherry
 		// sets the object the physics body is attachted to.
 		void SetObject(cherry::Object * obj);
 
+		// gets the physics world the body is in (nullptr if it isn't in one).
+		cherry::PhysicsWorld* GetPhysicsWorld() const;
+
 		// sets the object for the physics body, and returns the physics body so that it can be added to the object's physics body list.
 		// NOTE: this does not save the body to the object's list. Call AddPhysicsBody() on the object to add it to the object's list.
 		cherry::PhysicsBody* AttachToObject(cherry::Object * newObj);
@@ -114,6 +119,32 @@ namespace cherry
 		// calculates collision between two physics bodies if an equation for it is available.
 		static bool Collision(PhysicsBody* p1, PhysicsBody* p2);
 
+		// gets the world position the body had when SaveLastWorldPosition() was last called.
+		glm::vec3 GetLastWorldPositionGLM() const;
+
+		// saves the current world position as the start of the next swept collision.
+		// the game calls this once per frame for every object, before the paths and objects are updated (see Game::Update()).
+		void SaveLastWorldPosition();
+
+		// gets how far the body moved since its last position was saved (i.e. over the last frame).
+		glm::vec3 GetMovementGLM() const;
+
+		// gets the length of the body's smallest side in world space (the diameter for spheres).
+		float GetSmallestWorldSize() const;
+
+		// returns 'true' if the body moved further than its smallest size over the last frame.
+		// these are the bodies that could have passed through something between updates.
+		bool IsMovingFast() const;
+
+		// gets the rotation matrix for the world rotation of the body.
+		glm::mat3 GetWorldRotationMatrix() const;
+
+		// calculates collision between two physics bodies over the last frame, using where they were when their positions were saved and where they are now.
+		// toi: the time of impact (0 = where they were at the start of the frame, 1 = where they are now).
+		// the sweep is only done if one of the bodies is moving fast (see IsMovingFast()). Otherwise, Collision() is used, and the time of impact is 1.
+		// rotated boxes keep their current rotation over the update.
+		static bool SweptCollision(PhysicsBody* p1, PhysicsBody* p2, float& toi);
+
 		// states whether the body is visible.
 		bool IsVisible() const;
 
@@ -123,6 +154,15 @@ namespace cherry
 		// sets visibility of the body
 		void SetVisible(bool visible);
 
+		// gets the amount of bodies that are visible. If there are none, the debug view has nothing to draw.
+		static unsigned int GetVisibleCount();
+
+		// gets the world transformation of the body (position, rotation, and scale), without its dimensions applied.
+		glm::mat4 GetWorldTransform() const;
+
+		// gets the colour the body is drawn with in the debug view.
+		glm::vec4 GetDebugColor() const;
+
 		// update loop for physics bodies
 		virtual void Update(float deltaTime);
 
@@ -139,6 +179,22 @@ namespace cherry
 		// if these have changed, then the object must be updated.
 		cherry::Vec3 currParentScale, currParentPos, currParentRot;
 
+		// the world position, rotation (in degrees), and scale of the body, which are used to draw it.
+		cherry::Vec3 worldPosition, worldRotation, worldScale{ 1.0F, 1.0F, 1.0F };
+
+		// the world position from the start of the frame, which is used for the swept collisions.
+		cherry::Vec3 lastWorldPosition;
+
+		// whether the body is drawn in the debug view.
+		bool visible = false;
+
+		// the amount of visible bodies.
+		static unsigned int visibleCount;
+
+		// the world the body is in. The world sets this, so that the body can take itself out of the world when it's deleted.
+		friend class PhysicsWorld;
+		cherry::PhysicsWorld* physicsWorld = nullptr;
+
 	protected:
 		// the colour of the physics bodies (RGBA)
 		const Vec4 COLOUR{ 0.9F, 0.1F, 0.1F, 1.0F };
@@ -149,15 +205,9 @@ namespace cherry
 		// position
 		cherry::Vec3 position;
 
-		// used to draw the body to the scene.
-		cherry::Primitive* body = nullptr;
-
 		// body scale
 		cherry::Vec3 scale{ 1.0F, 1.0F, 1.0F };
 
-		// material for body when drawn to hte screen
-		Material::Sptr material;
-
 		// TODO: create function for this.
 		// the alpha value of all physics bodies.
 		static float alpha;
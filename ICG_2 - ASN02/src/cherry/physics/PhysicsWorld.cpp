@@ -0,0 +1,811 @@
+// PhysicsWorld (Source) - moves rigid bodies with gravity, and pushes them apart when they touch using a sequential impulse solver.
+#include "PhysicsWorld.h"
+#include "Physics.h"
+#include "..\objects\Object.h"
+
+#include <toolkit/Logging.h>
+#include <algorithm>
+#include <string.h>
+#include <float.h>
+
+// constructor
+cherry::PhysicsWorld::PhysicsWorld() : gravity(0.0F, 0.0F, -cherry::gravity)
+{
+}
+
+// destructor
+cherry::PhysicsWorld::~PhysicsWorld()
+{
+	Clear();
+}
+
+// adds a body
+cherry::RigidBody* cherry::PhysicsWorld::AddBody(cherry::PhysicsBody* body, float mass)
+{
+	if (body == nullptr)
+		return nullptr;
+
+	// the body is already in the world.
+	if (bodyMap.find(body) != bodyMap.end())
+		return bodyMap[body];
+
+	// only boxes and spheres have shapes.
+	if (body->GetId() != 1 && body->GetId() != 2)
+	{
+		LOG_WARN("Physics world can't add a body of type {}. Only boxes and spheres are supported.", body->GetId());
+		return nullptr;
+	}
+
+	// the body is in another world.
+	if (body->physicsWorld != nullptr)
+		body->physicsWorld->RemoveBody(body);
+
+	RigidBody* rigidBody = new RigidBody(body, mass);
+	rigidBody->id = (uint32_t)bodies.size();
+
+	bodies.push_back(rigidBody);
+	bodyMap[body] = rigidBody;
+	body->physicsWorld = this;
+
+	return rigidBody;
+}
+
+// adds an object
+cherry::RigidBody* cherry::PhysicsWorld::AddObject(cherry::Object* object, float mass)
+{
+	if (object == nullptr || object->GetPhysicsBodyCount() == 0)
+		return nullptr;
+
+	return AddBody(object->GetPhysicsBodies()[0], mass);
+}
+
+// removes a body
+bool cherry::PhysicsWorld::RemoveBody(cherry::PhysicsBody* body)
+{
+	auto it = bodyMap.find(body);
+
+	if (it == bodyMap.end())
+		return false;
+
+	RigidBody* rigidBody = it->second;
+	const uint32_t index = rigidBody->id;
+
+	bodyMap.erase(it);
+	bodies.erase(bodies.begin() + index);
+	body->physicsWorld = nullptr;
+	delete rigidBody;
+
+	// the bodies after it move up the list.
+	for (uint32_t i = index; i < bodies.size(); i++)
+		bodies[i]->id = i;
+
+	// the contacts and the sorted list use the old identifiers.
+	contacts.clear();
+	lastImpulses.clear();
+	sortedBodies.clear();
+
+	return true;
+}
+
+// removes an object
+bool cherry::PhysicsWorld::RemoveObject(cherry::Object* object)
+{
+	if (object == nullptr)
+		return false;
+
+	bool removed = false;
+
+	for (cherry::PhysicsBody* body : object->GetPhysicsBodies())
+		removed = RemoveBody(body) || removed;
+
+	return removed;
+}
+
+// gets the rigid body
+cherry::RigidBody* cherry::PhysicsWorld::GetRigidBody(cherry::PhysicsBody* body) const
+{
+	auto it = bodyMap.find(body);
+	return (it != bodyMap.end()) ? it->second : nullptr;
+}
+
+// gets the body count
+size_t cherry::PhysicsWorld::GetBodyCount() const { return bodies.size(); }
+
+// gets the awake body count
+size_t cherry::PhysicsWorld::GetAwakeBodyCount() const
+{
+	size_t count = 0;
+
+	for (const RigidBody* body : bodies)
+		count += (!body->IsStatic() && !body->IsSleeping()) ? 1 : 0;
+
+	return count;
+}
+
+// gets the contacts
+const std::vector<cherry::Contact>& cherry::PhysicsWorld::GetContacts() const { return contacts; }
+
+// wakes up every body
+void cherry::PhysicsWorld::WakeAll()
+{
+	for (RigidBody* body : bodies)
+		body->Wake();
+}
+
+// update
+void cherry::PhysicsWorld::Update(float deltaTime)
+{
+	if (fixedTimeStep <= 0.0F)
+		return;
+
+	accumulator += deltaTime;
+
+	int steps = 0;
+
+	while (accumulator >= fixedTimeStep && steps < maxSteps)
+	{
+		Step(fixedTimeStep);
+		accumulator -= fixedTimeStep;
+		steps++;
+	}
+
+	// the time that didn't fit is dropped, so a slow frame doesn't cause more slow frames.
+	if (accumulator >= fixedTimeStep)
+		accumulator = fmodf(accumulator, fixedTimeStep);
+}
+
+// runs a step
+void cherry::PhysicsWorld::Step(float timeStep)
+{
+	__SyncPositions();
+
+	// if nothing is awake, nothing can move.
+	bool awake = false;
+
+	for (const RigidBody* body : bodies)
+	{
+		if (!body->IsStatic() && !body->IsSleeping())
+		{
+			awake = true;
+			break;
+		}
+	}
+
+	if (!awake)
+	{
+		contacts.clear();
+		return;
+	}
+
+	// gravity and damping
+	for (RigidBody* body : bodies)
+	{
+		if (body->IsStatic() || body->IsSleeping())
+			continue;
+
+		body->velocity += gravity * body->gravityScale * timeStep;
+		body->velocity *= 1.0F / (1.0F + timeStep * body->linearDamping);
+	}
+
+	__UpdateShapes();
+	__FindContacts();
+	__Solve(timeStep);
+
+	// moves the bodies
+	for (RigidBody* body : bodies)
+	{
+		if (!body->IsStatic() && !body->IsSleeping())
+			body->position += body->velocity * timeStep;
+	}
+
+	__UpdateSleeping(timeStep);
+
+	// moves the physics bodies (or their objects) to the new positions.
+	for (RigidBody* body : bodies)
+	{
+		if (!body->IsStatic() && body->position != body->syncedPosition)
+			body->__WritePosition();
+	}
+}
+
+// gets the state hash
+uint64_t cherry::PhysicsWorld::GetStateHash() const
+{
+	// FNV-1a over the bits of the positions and velocities.
+	uint64_t hash = 14695981039346656037ULL;
+
+	for (const RigidBody* body : bodies)
+	{
+		const float values[6] = {
+			body->position.x, body->position.y, body->position.z,
+			body->velocity.x, body->velocity.y, body->velocity.z
+		};
+
+		unsigned char bytes[sizeof(values)];
+		memcpy(bytes, values, sizeof(values));
+
+		for (unsigned char byte : bytes)
+		{
+			hash ^= byte;
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	return hash;
+}
+
+// removes every body
+void cherry::PhysicsWorld::Clear()
+{
+	// the physics bodies are no longer in the world.
+	for (std::pair<cherry::PhysicsBody* const, RigidBody*>& entry : bodyMap)
+		entry.first->physicsWorld = nullptr;
+
+	for (RigidBody* body : bodies)
+		delete body;
+
+	bodies.clear();
+	shapes.clear();
+	bodyMap.clear();
+	contacts.clear();
+	solvers.clear();
+	lastImpulses.clear();
+	sortedBodies.clear();
+	accumulator = 0.0F;
+}
+
+// syncs the positions
+void cherry::PhysicsWorld::__SyncPositions()
+{
+	bool staticMoved = false;
+
+	for (RigidBody* body : bodies)
+	{
+		glm::vec3 current = body->__ReadPosition();
+
+		if (current == body->syncedPosition)
+			continue;
+
+		body->position = current;
+		body->syncedPosition = current;
+
+		if (body->IsStatic())
+			staticMoved = true;
+		else
+			body->Wake();
+	}
+
+	// the bodies resting on a static body that moved need to fall or be pushed.
+	if (staticMoved)
+		WakeAll();
+}
+
+// updates the shapes
+void cherry::PhysicsWorld::__UpdateShapes()
+{
+	shapes.resize(bodies.size());
+
+	for (size_t i = 0; i < bodies.size(); i++)
+	{
+		const RigidBody* body = bodies[i];
+		Shape& shape = shapes[i];
+
+		shape.type = body->body->GetId();
+		shape.centre = body->position;
+		shape.rotation = glm::mat3(1.0F);
+		shape.rotated = false;
+
+		if (shape.type == 1) // box
+		{
+			const PhysicsBodyBox* box = (const PhysicsBodyBox*)body->body;
+			shape.halfSize = glm::vec3(box->GetWorldWidth(), box->GetWorldHeight(), box->GetWorldDepth()) * 0.5F;
+
+			// the rotation matrix is only made for boxes that are rotated.
+			if (box->GetWorldRotationDegreesGLM() != glm::vec3(0.0F))
+			{
+				shape.rotation = box->GetWorldRotationMatrix();
+				shape.rotated = true;
+			}
+		}
+		else // sphere
+		{
+			shape.halfSize = glm::vec3(((const PhysicsBodySphere*)body->body)->GetWorldRadius());
+		}
+
+		// the box around a rotated box uses the absolute values of its rotation.
+		glm::vec3 extents = shape.halfSize;
+
+		if (shape.rotated)
+		{
+			glm::mat3 absRotation = shape.rotation;
+
+			for (int j = 0; j < 3; j++)
+				absRotation[j] = glm::abs(absRotation[j]);
+
+			extents = absRotation * shape.halfSize;
+		}
+
+		shape.min = shape.centre - extents;
+		shape.max = shape.centre + extents;
+	}
+}
+
+// finds the contacts
+void cherry::PhysicsWorld::__FindContacts()
+{
+	contacts.clear();
+
+	// the list is remade if bodies were added or removed.
+	if (sortedBodies.size() != bodies.size())
+	{
+		sortedBodies.resize(bodies.size());
+
+		for (uint32_t i = 0; i < sortedBodies.size(); i++)
+			sortedBodies[i] = i;
+	}
+
+	// insertion sort, which is fast since the bodies barely move between steps. Ties are sorted by id so the order is always the same.
+	for (size_t i = 1; i < sortedBodies.size(); i++)
+	{
+		uint32_t current = sortedBodies[i];
+		size_t j = i;
+
+		while (j > 0)
+		{
+			const uint32_t prev = sortedBodies[j - 1];
+
+			if (shapes[prev].min.x < shapes[current].min.x ||
+				(shapes[prev].min.x == shapes[current].min.x && prev < current))
+				break;
+
+			sortedBodies[j] = prev;
+			j--;
+		}
+
+		sortedBodies[j] = current;
+	}
+
+	// sweeps along the x-axis. Only the bodies that start before the current one ends can overlap it.
+	for (size_t i = 0; i < sortedBodies.size(); i++)
+	{
+		const uint32_t first = sortedBodies[i];
+		const Shape& a = shapes[first];
+
+		for (size_t j = i + 1; j < sortedBodies.size(); j++)
+		{
+			const uint32_t second = sortedBodies[j];
+			const Shape& b = shapes[second];
+
+			if (b.min.x > a.max.x)
+				break;
+
+			if (b.min.y > a.max.y || b.max.y < a.min.y || b.min.z > a.max.z || b.max.z < a.min.z)
+				continue;
+
+			RigidBody* bodyA = bodies[std::min(first, second)];
+			RigidBody* bodyB = bodies[std::max(first, second)];
+
+			// at least one of the bodies needs to be awake and able to move.
+			const bool activeA = !bodyA->IsStatic() && !bodyA->IsSleeping();
+			const bool activeB = !bodyB->IsStatic() && !bodyB->IsSleeping();
+
+			if (!activeA && !activeB)
+				continue;
+
+			Contact contact;
+			contact.A = bodyA;
+			contact.B = bodyB;
+
+			if (!__MakeContact(shapes[bodyA->id], shapes[bodyB->id], contact))
+				continue;
+
+			// an awake body wakes up the sleeping bodies it touches.
+			if (!bodyA->IsStatic() && bodyA->IsSleeping())
+				bodyA->Wake();
+
+			if (!bodyB->IsStatic() && bodyB->IsSleeping())
+				bodyB->Wake();
+
+			contacts.push_back(contact);
+		}
+	}
+
+	// the solver goes through the contacts in order, so they're sorted by their bodies rather than where they are.
+	std::sort(contacts.begin(), contacts.end(), [](const Contact& c1, const Contact& c2)
+		{
+			return __PairKey(c1.A, c1.B) < __PairKey(c2.A, c2.B);
+		});
+}
+
+// makes a contact
+bool cherry::PhysicsWorld::__MakeContact(const Shape& a, const Shape& b, Contact& contact)
+{
+	// sphere - sphere
+	if (a.type == 2 && b.type == 2)
+	{
+		const glm::vec3 offset = b.centre - a.centre;
+		const float radii = a.halfSize.x + b.halfSize.x;
+		const float distSqr = glm::dot(offset, offset);
+
+		if (distSqr >= radii * radii)
+			return false;
+
+		const float dist = sqrtf(distSqr);
+
+		// if the centres are in the same place, the spheres are pushed apart vertically.
+		contact.Normal = (dist > 1.0E-6F) ? offset / dist : glm::vec3(0.0F, 0.0F, 1.0F);
+		contact.Depth = radii - dist;
+		contact.Point = a.centre + contact.Normal * (a.halfSize.x - contact.Depth * 0.5F);
+		return true;
+	}
+	// sphere - box
+	else if (a.type == 2 && b.type == 1)
+	{
+		return __SphereBoxContact(a, b, contact);
+	}
+	// box - sphere
+	else if (a.type == 1 && b.type == 2)
+	{
+		if (!__SphereBoxContact(b, a, contact))
+			return false;
+
+		contact.Normal = -contact.Normal;
+		return true;
+	}
+	// box - box
+	else
+	{
+		return __BoxBoxContact(a, b, contact);
+	}
+}
+
+// sphere - box contact
+bool cherry::PhysicsWorld::__SphereBoxContact(const Shape& sphere, const Shape& box, Contact& contact)
+{
+	const float radius = sphere.halfSize.x;
+
+	// the sphere's centre in the box's space.
+	const glm::vec3 local = glm::transpose(box.rotation) * (sphere.centre - box.centre);
+	const glm::vec3 closest = glm::clamp(local, -box.halfSize, box.halfSize);
+
+	// the centre is inside the box, so it's pushed out through the closest face.
+	if (closest == local)
+	{
+		int axis = 0;
+		float faceDist = box.halfSize.x - fabsf(local.x);
+
+		for (int i = 1; i < 3; i++)
+		{
+			float dist = box.halfSize[i] - fabsf(local[i]);
+
+			if (dist < faceDist)
+			{
+				faceDist = dist;
+				axis = i;
+			}
+		}
+
+		glm::vec3 faceNormal(0.0F);
+		faceNormal[axis] = (local[axis] < 0.0F) ? -1.0F : 1.0F;
+
+		contact.Normal = -(box.rotation * faceNormal);
+		contact.Depth = faceDist + radius;
+		contact.Point = sphere.centre;
+		return true;
+	}
+
+	const glm::vec3 offset = local - closest;
+	const float distSqr = glm::dot(offset, offset);
+
+	if (distSqr >= radius * radius)
+		return false;
+
+	const float dist = sqrtf(distSqr);
+
+	contact.Normal = -(box.rotation * (offset / dist));
+	contact.Depth = radius - dist;
+	contact.Point = box.centre + box.rotation * closest;
+	return true;
+}
+
+// box - box contact
+bool cherry::PhysicsWorld::__BoxBoxContact(const Shape& a, const Shape& b, Contact& contact)
+{
+	const glm::vec3 offset = b.centre - a.centre;
+
+	// if neither box is rotated, the boxes around them are the boxes.
+	if (!a.rotated && !b.rotated)
+	{
+		const glm::vec3 overlap = a.halfSize + b.halfSize - glm::abs(offset);
+
+		if (overlap.x <= 0.0F || overlap.y <= 0.0F || overlap.z <= 0.0F)
+			return false;
+
+		// the boxes are pushed apart along the axis they overlap the least on.
+		int axis = 0;
+
+		for (int i = 1; i < 3; i++)
+		{
+			if (overlap[i] < overlap[axis])
+				axis = i;
+		}
+
+		contact.Normal = glm::vec3(0.0F);
+		contact.Normal[axis] = (offset[axis] < 0.0F) ? -1.0F : 1.0F;
+		contact.Depth = overlap[axis];
+		contact.Point = (glm::max(a.min, b.min) + glm::min(a.max, b.max)) * 0.5F;
+		return true;
+	}
+
+	// separating axis test: the boxes overlap if they overlap on each of their face normals, and on the cross products of their edges.
+	glm::vec3 axes[15];
+	int axisCount = 0;
+
+	for (int i = 0; i < 3; i++)
+	{
+		axes[axisCount++] = a.rotation[i];
+		axes[axisCount++] = b.rotation[i];
+	}
+
+	for (int i = 0; i < 3; i++)
+	{
+		for (int j = 0; j < 3; j++)
+			axes[axisCount++] = glm::cross(a.rotation[i], b.rotation[j]);
+	}
+
+	float bestDepth = FLT_MAX;
+	glm::vec3 bestAxis(0.0F, 0.0F, 1.0F);
+
+	for (int i = 0; i < axisCount; i++)
+	{
+		const float lengthSqr = glm::dot(axes[i], axes[i]);
+
+		// edges that are parallel don't make an axis.
+		if (lengthSqr < 1.0E-6F)
+			continue;
+
+		const glm::vec3 axis = axes[i] / sqrtf(lengthSqr);
+
+		float radiusA = 0.0F, radiusB = 0.0F;
+
+		for (int j = 0; j < 3; j++)
+		{
+			radiusA += fabsf(glm::dot(axis, a.rotation[j])) * a.halfSize[j];
+			radiusB += fabsf(glm::dot(axis, b.rotation[j])) * b.halfSize[j];
+		}
+
+		const float dist = glm::dot(offset, axis);
+		const float depth = radiusA + radiusB - fabsf(dist);
+
+		if (depth <= 0.0F)
+			return false;
+
+		// the face normals (the first six axes) are preferred, since the edge axes are less stable for resting boxes.
+		if ((i < 6) ? depth < bestDepth : depth < bestDepth * 0.95F)
+		{
+			bestDepth = depth;
+			bestAxis = (dist < 0.0F) ? -axis : axis;
+		}
+	}
+
+	contact.Normal = bestAxis;
+	contact.Depth = bestDepth;
+
+	// the point is the average of the corners of each box that are inside the other box.
+	glm::vec3 pointTotal(0.0F);
+	int pointCount = 0;
+
+	const Shape* boxes[2] = { &a, &b };
+
+	for (int i = 0; i < 2; i++)
+	{
+		const Shape& box = *boxes[i];
+		const Shape& other = *boxes[1 - i];
+		const glm::mat3 otherInverse = glm::transpose(other.rotation);
+
+		for (int corner = 0; corner < 8; corner++)
+		{
+			glm::vec3 sign((corner & 1) ? 1.0F : -1.0F, (corner & 2) ? 1.0F : -1.0F, (corner & 4) ? 1.0F : -1.0F);
+			glm::vec3 point = box.centre + box.rotation * (sign * box.halfSize);
+			glm::vec3 local = glm::abs(otherInverse * (point - other.centre));
+
+			if (local.x <= other.halfSize.x && local.y <= other.halfSize.y && local.z <= other.halfSize.z)
+			{
+				pointTotal += point;
+				pointCount++;
+			}
+		}
+	}
+
+	// edge to edge contacts don't have any corners inside, so the middle of the boxes is used.
+	contact.Point = (pointCount > 0) ? pointTotal / (float)pointCount : (a.centre + b.centre) * 0.5F;
+	return true;
+}
+
+// solves the contacts
+void cherry::PhysicsWorld::__Solve(float timeStep)
+{
+	solvers.resize(contacts.size());
+
+	// prepares the contacts. This is done before any impulses are applied, so the bounces use the velocities the bodies hit each other with.
+	for (size_t i = 0; i < contacts.size(); i++)
+	{
+		Contact& contact = contacts[i];
+		ContactSolver& solver = solvers[i];
+		RigidBody* a = contact.A;
+		RigidBody* b = contact.B;
+
+		const glm::vec3 n = contact.Normal;
+
+		// two directions along the surface.
+		if (fabsf(n.x) >= 0.57735F)
+			solver.tangent1 = glm::normalize(glm::vec3(n.y, -n.x, 0.0F));
+		else
+			solver.tangent1 = glm::normalize(glm::vec3(0.0F, n.z, -n.y));
+
+		solver.tangent2 = glm::cross(n, solver.tangent1);
+
+		solver.mass = 1.0F / (a->inverseMass + b->inverseMass);
+		solver.friction = sqrtf(a->friction * b->friction);
+
+		// pushes the bodies apart over a few steps.
+		solver.bias = positionCorrection / timeStep * std::max(contact.Depth - slop, 0.0F);
+
+		// bounces the bodies if they're hitting each other fast enough.
+		const float closing = glm::dot(b->velocity - a->velocity, n);
+
+		if (closing < -bounceSpeed)
+			solver.bias = std::max(solver.bias, -std::max(a->restitution, b->restitution) * closing);
+	}
+
+	// warm starting, which applies the impulses from the last step.
+	for (size_t i = 0; i < contacts.size(); i++)
+	{
+		Contact& contact = contacts[i];
+		const ContactSolver& solver = solvers[i];
+		RigidBody* a = contact.A;
+		RigidBody* b = contact.B;
+		const glm::vec3 n = contact.Normal;
+
+		auto last = lastImpulses.find(__PairKey(a, b));
+
+		if (last != lastImpulses.end())
+		{
+			contact.NormalImpulse = std::max(glm::dot(last->second, n), 0.0F);
+			contact.TangentImpulse = glm::vec2(glm::dot(last->second, solver.tangent1), glm::dot(last->second, solver.tangent2));
+
+			const glm::vec3 impulse = n * contact.NormalImpulse +
+				solver.tangent1 * contact.TangentImpulse.x + solver.tangent2 * contact.TangentImpulse.y;
+
+			a->velocity -= impulse * a->inverseMass;
+			b->velocity += impulse * b->inverseMass;
+		}
+	}
+
+	for (int iteration = 0; iteration < iterations; iteration++)
+	{
+		for (size_t i = 0; i < contacts.size(); i++)
+		{
+			Contact& contact = contacts[i];
+			const ContactSolver& solver = solvers[i];
+			RigidBody* a = contact.A;
+			RigidBody* b = contact.B;
+
+			// friction, which can't be stronger than the normal impulse allows.
+			const float maxFriction = solver.friction * contact.NormalImpulse;
+			const glm::vec3 tangents[2] = { solver.tangent1, solver.tangent2 };
+
+			for (int t = 0; t < 2; t++)
+			{
+				const float speed = glm::dot(b->velocity - a->velocity, tangents[t]);
+				const float oldImpulse = contact.TangentImpulse[t];
+
+				contact.TangentImpulse[t] = glm::clamp(oldImpulse - speed * solver.mass, -maxFriction, maxFriction);
+
+				const glm::vec3 impulse = tangents[t] * (contact.TangentImpulse[t] - oldImpulse);
+				a->velocity -= impulse * a->inverseMass;
+				b->velocity += impulse * b->inverseMass;
+			}
+
+			// normal, which can only push.
+			const float speed = glm::dot(b->velocity - a->velocity, contact.Normal);
+			const float oldImpulse = contact.NormalImpulse;
+
+			contact.NormalImpulse = std::max(oldImpulse + (solver.bias - speed) * solver.mass, 0.0F);
+
+			const glm::vec3 impulse = contact.Normal * (contact.NormalImpulse - oldImpulse);
+			a->velocity -= impulse * a->inverseMass;
+			b->velocity += impulse * b->inverseMass;
+		}
+	}
+
+	// saves the impulses for the next step.
+	lastImpulses.clear();
+
+	for (size_t i = 0; i < contacts.size(); i++)
+	{
+		const Contact& contact = contacts[i];
+
+		lastImpulses[__PairKey(contact.A, contact.B)] = contact.Normal * contact.NormalImpulse +
+			solvers[i].tangent1 * contact.TangentImpulse.x + solvers[i].tangent2 * contact.TangentImpulse.y;
+	}
+}
+
+// updates sleeping
+void cherry::PhysicsWorld::__UpdateSleeping(float timeStep)
+{
+	if (!sleeping)
+		return;
+
+	const float sleepSpeedSqr = sleepSpeed * sleepSpeed;
+
+	islandParents.resize(bodies.size());
+	islandTimes.assign(bodies.size(), FLT_MAX);
+
+	for (uint32_t i = 0; i < bodies.size(); i++)
+	{
+		RigidBody* body = bodies[i];
+		islandParents[i] = i;
+
+		if (body->IsStatic() || body->IsSleeping())
+			continue;
+
+		if (glm::dot(body->velocity, body->velocity) < sleepSpeedSqr)
+			body->sleepTime += timeStep;
+		else
+			body->sleepTime = 0.0F;
+	}
+
+	// finds the root of a body's island.
+	auto findRoot = [this](uint32_t index) -> uint32_t
+	{
+		while (islandParents[index] != index)
+		{
+			islandParents[index] = islandParents[islandParents[index]];
+			index = islandParents[index];
+		}
+
+		return index;
+	};
+
+	// bodies that touch are in the same island. Static bodies aren't joined, otherwise everything on the ground would be one island.
+	for (const Contact& contact : contacts)
+	{
+		if (contact.A->IsStatic() || contact.B->IsStatic())
+			continue;
+
+		uint32_t rootA = findRoot(contact.A->id);
+		uint32_t rootB = findRoot(contact.B->id);
+
+		if (rootA != rootB)
+			islandParents[std::max(rootA, rootB)] = std::min(rootA, rootB);
+	}
+
+	// an island is only as still as its least still body.
+	for (uint32_t i = 0; i < bodies.size(); i++)
+	{
+		if (bodies[i]->IsStatic() || bodies[i]->IsSleeping())
+			continue;
+
+		uint32_t root = findRoot(i);
+		islandTimes[root] = std::min(islandTimes[root], bodies[i]->sleepTime);
+	}
+
+	for (uint32_t i = 0; i < bodies.size(); i++)
+	{
+		if (bodies[i]->IsStatic() || bodies[i]->IsSleeping())
+			continue;
+
+		if (islandTimes[findRoot(i)] >= sleepDelay)
+			bodies[i]->Sleep();
+	}
+}
+
+// makes a pair key
+uint64_t cherry::PhysicsWorld::__PairKey(const RigidBody* a, const RigidBody* b)
+{
+	const uint64_t first = std::min(a->id, b->id);
+	const uint64_t second = std::max(a->id, b->id);
+
+	return (first << 32) | second;
+}
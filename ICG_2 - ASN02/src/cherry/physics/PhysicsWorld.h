@@ -0,0 +1,181 @@
+// PhysicsWorld (Header) - moves rigid bodies with gravity, and pushes them apart when they touch using a sequential impulse solver.
+#pragma once
+#include <GLM/glm.hpp>
+#include <vector>
+#include <unordered_map>
+#include <stdint.h>
+
+#include "RigidBody.h"
+
+namespace cherry
+{
+	// a point where two bodies touch.
+	struct Contact
+	{
+		RigidBody* A = nullptr;
+		RigidBody* B = nullptr;
+
+		glm::vec3 Normal = glm::vec3(0.0F, 0.0F, 1.0F); // the direction that pushes B away from A.
+		float Depth = 0.0F; // how far the bodies are overlapping along the normal.
+		glm::vec3 Point = glm::vec3(0.0F); // the middle of the overlap, in world space.
+
+		// the total impulses applied by the solver. These are carried over to the next step if the bodies are still touching (warm starting).
+		float NormalImpulse = 0.0F;
+		glm::vec2 TangentImpulse = glm::vec2(0.0F);
+	};
+
+	/*
+	 * The world steps at a fixed rate, so the results don't depend on the frame rate.
+	 * Each step:
+	 *** the velocities of the awake bodies are changed by gravity.
+	 *** the bodies are sorted along the x-axis to find the pairs that could be touching, then the contacts are made from their shapes.
+	 *** the contacts are solved over several iterations, starting from the impulses of the last step.
+	 *** the awake bodies are moved, and then the bodies that touch are grouped into islands.
+	 *** islands where every body has been slow for long enough are put to sleep.
+	 * If every body is asleep, a step only checks if any of them were moved by something else.
+	 * The bodies are always processed in the order they were added, so the same scene gives the same results.
+	*/
+	class PhysicsWorld
+	{
+	public:
+		// constructor
+		PhysicsWorld();
+
+		// deletes the rigid bodies. The physics bodies and objects aren't deleted.
+		~PhysicsWorld();
+
+		// adds a physics body, using the provided mass (0 = static). Returns the rigid body, or nullptr if it couldn't be added.
+		// the body needs to be a box or a sphere. If it's already in the world, its rigid body is returned.
+		// a body can only be in one world, so it's taken out of its old world first.
+		// bodies take themselves out of the world when they're deleted, or removed from their objects.
+		RigidBody* AddBody(cherry::PhysicsBody* body, float mass = 1.0F);
+
+		// adds an object using its first physics body. Returns nullptr if the object doesn't have any physics bodies.
+		RigidBody* AddObject(cherry::Object* object, float mass = 1.0F);
+
+		// removes a physics body. Returns 'false' if it wasn't in the world.
+		bool RemoveBody(cherry::PhysicsBody* body);
+
+		// removes every body that belongs to the object. Returns 'false' if none of them were in the world.
+		bool RemoveObject(cherry::Object* object);
+
+		// gets the rigid body for a physics body (nullptr if it isn't in the world).
+		RigidBody* GetRigidBody(cherry::PhysicsBody* body) const;
+
+		// gets the amount of bodies.
+		size_t GetBodyCount() const;
+
+		// gets the amount of bodies that aren't static or asleep.
+		size_t GetAwakeBodyCount() const;
+
+		// gets the contacts from the last step.
+		const std::vector<Contact>& GetContacts() const;
+
+		// wakes up every body.
+		void WakeAll();
+
+		// advances the world by the frame time. This runs as many fixed steps as fit in the time, up to maxSteps.
+		void Update(float deltaTime);
+
+		// runs a single step.
+		void Step(float timeStep);
+
+		// gets a hash of the positions and velocities of every body. Two worlds that did the same thing have the same hash.
+		uint64_t GetStateHash() const;
+
+		// removes every body.
+		void Clear();
+
+		// the gravity (z is up).
+		glm::vec3 gravity;
+
+		// the length of a step (in seconds).
+		float fixedTimeStep = 1.0F / 60.0F;
+
+		// the most steps that are run in one update. If a frame takes longer than this, the world slows down instead of falling further behind.
+		int maxSteps = 4;
+
+		// the amount of times the contacts are solved each step.
+		int iterations = 10;
+
+		// how much of the overlap is fixed each step (0 - 1). Overlaps smaller than the slop aren't fixed, which stops resting bodies from jittering.
+		float positionCorrection = 0.2F;
+		float slop = 0.005F;
+
+		// contacts that are closing slower than this (in metres per second) don't bounce.
+		float bounceSpeed = 0.5F;
+
+		// bodies whose speed stays below the sleep speed for the sleep delay (in seconds) are put to sleep.
+		bool sleeping = true;
+		float sleepSpeed = 0.05F;
+		float sleepDelay = 0.5F;
+
+	private:
+		// the shape of a body for the current step.
+		struct Shape
+		{
+			int type; // 1 = box, 2 = sphere
+			glm::vec3 centre;
+			glm::vec3 halfSize; // the half size of the box, or the radius on every axis for spheres.
+			glm::mat3 rotation; // the rotation of the box.
+			bool rotated; // 'false' if the box is axis aligned.
+			glm::vec3 min, max; // the box around the shape in world space.
+		};
+
+		// the values the solver needs for each contact.
+		struct ContactSolver
+		{
+			glm::vec3 tangent1, tangent2;
+			float mass; // 1 / (the inverse masses added together)
+			float bias; // the extra velocity used to push the bodies apart and to bounce them.
+			float friction;
+		};
+
+		// checks for bodies that were moved by something else, and wakes them up.
+		void __SyncPositions();
+
+		// updates the shape of every body.
+		void __UpdateShapes();
+
+		// finds the contacts between the bodies.
+		void __FindContacts();
+
+		// makes a contact between two shapes. Returns 'false' if they aren't touching.
+		static bool __MakeContact(const Shape& a, const Shape& b, Contact& contact);
+
+		// makes a contact between a sphere and a box. The normal goes from the sphere to the box.
+		static bool __SphereBoxContact(const Shape& sphere, const Shape& box, Contact& contact);
+
+		// makes a contact between two boxes.
+		static bool __BoxBoxContact(const Shape& a, const Shape& b, Contact& contact);
+
+		// solves the contacts.
+		void __Solve(float timeStep);
+
+		// groups the bodies into islands, and puts the still islands to sleep.
+		void __UpdateSleeping(float timeStep);
+
+		// makes the key for a pair of bodies.
+		static uint64_t __PairKey(const RigidBody* a, const RigidBody* b);
+
+		std::vector<RigidBody*> bodies; // a body's id is its index.
+		std::vector<Shape> shapes; // the shape of each body, in the same order.
+		std::unordered_map<cherry::PhysicsBody*, RigidBody*> bodyMap;
+
+		std::vector<Contact> contacts;
+		std::vector<ContactSolver> solvers;
+
+		// the impulses from the last step, found by their pair key. These are in world space, so they can be split along the new normals.
+		std::unordered_map<uint64_t, glm::vec3> lastImpulses;
+
+		// the time that hasn't been stepped yet.
+		float accumulator = 0.0F;
+
+		// the bodies sorted along the x-axis (kept between steps, since the order barely changes).
+		std::vector<uint32_t> sortedBodies;
+
+		// used for the islands.
+		std::vector<uint32_t> islandParents;
+		std::vector<float> islandTimes; // the shortest time a body in the island has been still.
+	};
+}
@@ -0,0 +1,252 @@
+// RayBenchmark (Source) - times raycasts against the bounding volume hierarchies, and reports how many rays are traced per second.
+#include "RayBenchmark.h"
+#include "..\objects\Object.h"
+
+#include <toolkit/Logging.h>
+#include <GLM/gtc/constants.hpp>
+#include <GLM/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <random>
+
+// loads a file and runs the mesh benchmark
+cherry::RayBenchmarkResult cherry::RayBenchmark::RunMesh(const std::string& filePath, uint32_t raysPerSide)
+{
+	RayBenchmarkResult result;
+	result.Name = filePath;
+
+	try
+	{
+		// the object isn't given a scene, so it's never drawn.
+		Object object(filePath);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		MeshBVH mesh(object.GetVertices(), object.GetVerticesTotal(), object.GetIndices(), object.GetIndicesTotal());
+		float buildTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+		result = RunMesh(mesh, filePath, raysPerSide);
+		result.BuildTime = buildTime;
+	}
+	catch (const std::exception& e)
+	{
+		LOG_ERROR("Ray benchmark couldn't load \"{}\": {}", filePath, e.what());
+		return result;
+	}
+
+	__Log(result);
+	return result;
+}
+
+// runs the mesh benchmark
+cherry::RayBenchmarkResult cherry::RayBenchmark::RunMesh(const MeshBVH& mesh, const std::string& name, uint32_t raysPerSide)
+{
+	RayBenchmarkResult result;
+	result.Name = name;
+	result.Primitives = mesh.GetTriangleCount();
+	result.Nodes = mesh.GetNodeCount();
+
+	if (mesh.GetTriangleCount() == 0 || raysPerSide == 0)
+		return result;
+
+	// the packets are 2 x 2 squares of the grid.
+	raysPerSide += raysPerSide % 2;
+
+	const glm::vec3 centre = (mesh.GetMinimum() + mesh.GetMaximum()) * 0.5F;
+	const float radius = glm::length(mesh.GetMaximum() - mesh.GetMinimum()) * 0.5F;
+
+	std::vector<Ray> rays;
+	rays.reserve((size_t)raysPerSide * raysPerSide * 8);
+
+	// eight directions around the mesh, looking slightly down at it.
+	for (int view = 0; view < 8; view++)
+	{
+		float angle = glm::two_pi<float>() * view / 8.0F;
+		glm::vec3 back = glm::normalize(glm::vec3(cosf(angle), 0.35F, sinf(angle)));
+		glm::vec3 right = glm::normalize(glm::cross(glm::vec3(0.0F, 1.0F, 0.0F), back));
+		glm::vec3 up = glm::cross(back, right);
+
+		// the grid covers the whole mesh, and starts outside of it.
+		for (uint32_t y = 0; y < raysPerSide; y++)
+		{
+			for (uint32_t x = 0; x < raysPerSide; x++)
+			{
+				glm::vec2 offset = (glm::vec2(x, y) + 0.5F) / (float)raysPerSide * 2.0F - 1.0F;
+				glm::vec3 origin = centre + back * radius * 2.0F + (right * offset.x + up * offset.y) * radius;
+
+				rays.push_back(Ray(origin, -back));
+			}
+		}
+	}
+
+	result.Rays = rays.size();
+
+	// one ray at a time
+	std::vector<RayHit> hits(rays.size());
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (size_t i = 0; i < rays.size(); i++)
+		mesh.Intersect(rays[i], hits[i]);
+
+	double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	result.RaysPerSecond = (seconds > 0.0) ? rays.size() / seconds : 0.0;
+
+	// four rays at a time. The squares are made from two neighbouring rays on two neighbouring rows.
+	std::vector<RayPacket> packets;
+	std::vector<uint32_t> packetRays; // the index of the first ray in each packet's square.
+	packets.reserve(rays.size() / 4);
+	packetRays.reserve(rays.size() / 4);
+
+	for (uint32_t view = 0; view < 8; view++)
+	{
+		for (uint32_t y = 0; y < raysPerSide; y += 2)
+		{
+			for (uint32_t x = 0; x < raysPerSide; x += 2)
+			{
+				uint32_t first = (view * raysPerSide + y) * raysPerSide + x;
+				Ray square[4] = { rays[first], rays[first + 1], rays[first + raysPerSide], rays[first + raysPerSide + 1] };
+
+				packets.push_back(RayPacket(square));
+				packetRays.push_back(first);
+			}
+		}
+	}
+
+	std::vector<RayHit> packetHits(packets.size() * 4);
+
+	start = std::chrono::high_resolution_clock::now();
+
+	for (size_t i = 0; i < packets.size(); i++)
+		mesh.IntersectPacket(packets[i], &packetHits[i * 4]);
+
+	seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	result.PacketRaysPerSecond = (seconds > 0.0) ? rays.size() / seconds : 0.0;
+
+	// the packets should find the same hits as the single rays. Rays that hit an edge can get either triangle, so the distances are compared instead.
+	const float tolerance = radius * 1.0E-4F;
+
+	for (size_t i = 0; i < packets.size(); i++)
+	{
+		const uint32_t first = packetRays[i];
+		const uint32_t single[4] = { first, first + 1, first + raysPerSide, first + raysPerSide + 1 };
+
+		for (int lane = 0; lane < 4; lane++)
+		{
+			const RayHit& a = packetHits[i * 4 + lane];
+			const RayHit& b = hits[single[lane]];
+
+			if (a.IsHit() != b.IsHit() || (a.IsHit() && fabsf(a.Distance - b.Distance) > tolerance))
+				result.PacketMismatches++;
+		}
+	}
+
+	for (const RayHit& hit : hits)
+		result.Hits += hit.IsHit() ? 1 : 0;
+
+	return result;
+}
+
+// loads a file and runs the scene benchmark
+cherry::RayBenchmarkResult cherry::RayBenchmark::RunScene(const std::string& filePath, uint32_t instanceCount, uint32_t rayCount)
+{
+	RayBenchmarkResult result;
+	result.Name = filePath;
+
+	try
+	{
+		Object object(filePath);
+		MeshBVH mesh(object.GetVertices(), object.GetVerticesTotal(), object.GetIndices(), object.GetIndicesTotal());
+
+		result = RunScene(mesh, filePath, instanceCount, rayCount);
+	}
+	catch (const std::exception& e)
+	{
+		LOG_ERROR("Ray benchmark couldn't load \"{}\": {}", filePath, e.what());
+		return result;
+	}
+
+	__Log(result);
+	return result;
+}
+
+// runs the scene benchmark
+cherry::RayBenchmarkResult cherry::RayBenchmark::RunScene(const MeshBVH& mesh, const std::string& name, uint32_t instanceCount, uint32_t rayCount)
+{
+	RayBenchmarkResult result;
+	result.Name = name + " x " + std::to_string(instanceCount);
+
+	if (mesh.GetTriangleCount() == 0 || instanceCount == 0)
+		return result;
+
+	// the same seed is used every time, so the runs can be compared.
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> unit(0.0F, 1.0F);
+
+	// the copies are spread out so that there's about three mesh widths between their centres.
+	const float meshSize = glm::length(mesh.GetMaximum() - mesh.GetMinimum());
+	const float extent = meshSize * 3.0F * cbrtf((float)instanceCount) * 0.5F;
+
+	std::vector<SceneBVHInstance> instances(instanceCount);
+
+	for (SceneBVHInstance& instance : instances)
+	{
+		glm::vec3 position = (glm::vec3(unit(random), unit(random), unit(random)) * 2.0F - 1.0F) * extent;
+		float yaw = unit(random) * glm::two_pi<float>();
+		float scale = 0.5F + unit(random);
+
+		instance.Mesh = &mesh;
+		instance.Transform = glm::translate(glm::mat4(1.0F), position) *
+			glm::rotate(glm::mat4(1.0F), yaw, glm::vec3(0.0F, 1.0F, 0.0F)) *
+			glm::scale(glm::mat4(1.0F), glm::vec3(scale));
+	}
+
+	SceneBVH scene;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	scene.Build(instances);
+	result.BuildTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	result.Primitives = scene.GetInstanceCount();
+	result.Nodes = scene.GetNodeCount();
+
+	// the rays start on one side of the box, and go through random points inside it.
+	std::vector<Ray> rays;
+	rays.reserve(rayCount);
+
+	const glm::vec3 eye = glm::vec3(0.0F, extent * 0.5F, extent * 2.0F);
+
+	for (uint32_t i = 0; i < rayCount; i++)
+	{
+		glm::vec3 target = (glm::vec3(unit(random), unit(random), unit(random)) * 2.0F - 1.0F) * extent;
+		rays.push_back(Ray(eye, glm::normalize(target - eye)));
+	}
+
+	result.Rays = rays.size();
+
+	start = std::chrono::high_resolution_clock::now();
+
+	for (const Ray& ray : rays)
+	{
+		RayHit hit;
+
+		if (scene.Intersect(ray, hit))
+			result.Hits++;
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+	result.RaysPerSecond = (seconds > 0.0) ? rays.size() / seconds : 0.0;
+
+	return result;
+}
+
+// prints the results
+void cherry::RayBenchmark::__Log(const RayBenchmarkResult& result)
+{
+	LOG_INFO("Ray benchmark \"{}\": {} primitives, {} nodes, built in {:.2f} ms.", result.Name, result.Primitives, result.Nodes, result.BuildTime);
+	LOG_INFO("Ray benchmark \"{}\": {} rays, {} hits, {:.2f} million rays/sec.", result.Name, result.Rays, result.Hits, result.RaysPerSecond / 1.0E6);
+
+	if (result.PacketRaysPerSecond > 0.0)
+	{
+		LOG_INFO("Ray benchmark \"{}\": {:.2f} million rays/sec in packets of four ({} mismatches).", result.Name,
+			result.PacketRaysPerSecond / 1.0E6, result.PacketMismatches);
+	}
+}
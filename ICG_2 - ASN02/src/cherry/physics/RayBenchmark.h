@@ -0,0 +1,50 @@
+// RayBenchmark (Header) - times raycasts against the bounding volume hierarchies, and reports how many rays are traced per second.
+#pragma once
+#include <string>
+#include <stdint.h>
+
+#include "BVH.h"
+
+namespace cherry
+{
+	// the results of a benchmark.
+	struct RayBenchmarkResult
+	{
+		std::string Name = "";
+		size_t Primitives = 0; // the triangles for a mesh, or the instances for a scene.
+		size_t Nodes = 0;
+		float BuildTime = 0.0F; // how long the hierarchy took to build (in milliseconds).
+
+		uint64_t Rays = 0;
+		uint64_t Hits = 0;
+		double RaysPerSecond = 0.0; // tracing one ray at a time.
+		double PacketRaysPerSecond = 0.0; // tracing four rays at a time (meshes only).
+		uint64_t PacketMismatches = 0; // the rays where the packet and the single ray found different hits. This should be 0.
+	};
+
+	/*
+	 * The mesh benchmark traces a grid of parallel rays at the mesh from eight directions around it, once a ray at a time and once in packets of four.
+	 * The scene benchmark scatters copies of a mesh through a box, and traces rays from outside the box through random points inside it.
+	 * Both are run on the calling thread. The versions that load a file print their results to the log.
+	*/
+	class RayBenchmark
+	{
+	public:
+		// loads the .obj file (without putting it in a scene), builds a hierarchy over its triangles, then traces (raysPerSide * raysPerSide) rays from each direction.
+		// the file needs an OpenGL context to load, since it makes a mesh.
+		static RayBenchmarkResult RunMesh(const std::string& filePath, uint32_t raysPerSide = 256);
+
+		// traces rays at a mesh hierarchy that's already been built.
+		static RayBenchmarkResult RunMesh(const MeshBVH& mesh, const std::string& name, uint32_t raysPerSide = 256);
+
+		// loads the .obj file, then scatters the provided amount of copies of it, builds a scene hierarchy over them, and traces the rays.
+		static RayBenchmarkResult RunScene(const std::string& filePath, uint32_t instanceCount = 10000, uint32_t rayCount = 262144);
+
+		// scatters copies of a mesh hierarchy that's already been built.
+		static RayBenchmarkResult RunScene(const MeshBVH& mesh, const std::string& name, uint32_t instanceCount = 10000, uint32_t rayCount = 262144);
+
+	private:
+		// prints the results to the log.
+		static void __Log(const RayBenchmarkResult& result);
+	};
+}
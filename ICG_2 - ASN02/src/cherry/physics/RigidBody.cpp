@@ -0,0 +1,108 @@
+// RigidBody (Source) - the mass, velocity, and material of a physics body that's moved by a PhysicsWorld.
+#include "RigidBody.h"
+
+// constructor
+cherry::RigidBody::RigidBody(cherry::PhysicsBody* body, float mass) : body(body)
+{
+	SetMass(mass);
+
+	position = __ReadPosition();
+	syncedPosition = position;
+}
+
+// gets the physics body
+cherry::PhysicsBody* cherry::RigidBody::GetBody() const { return body; }
+
+// gets the object
+cherry::Object* cherry::RigidBody::GetObject() const { return (body != nullptr) ? body->GetObject() : nullptr; }
+
+// gets the mass
+float cherry::RigidBody::GetMass() const { return mass; }
+
+// sets the mass
+void cherry::RigidBody::SetMass(float newMass)
+{
+	mass = (newMass > 0.0F) ? newMass : 0.0F;
+	inverseMass = (mass > 0.0F) ? 1.0F / mass : 0.0F;
+
+	// static bodies don't move.
+	if (mass == 0.0F)
+		velocity = glm::vec3(0.0F);
+
+	Wake();
+}
+
+// gets the inverse mass
+float cherry::RigidBody::GetInverseMass() const { return inverseMass; }
+
+// checks if static
+bool cherry::RigidBody::IsStatic() const { return mass == 0.0F; }
+
+// gets the position
+glm::vec3 cherry::RigidBody::GetPosition() const { return position; }
+
+// gets the velocity
+glm::vec3 cherry::RigidBody::GetVelocity() const { return velocity; }
+
+// sets the velocity
+void cherry::RigidBody::SetVelocity(glm::vec3 newVelocity)
+{
+	if (IsStatic())
+		return;
+
+	velocity = newVelocity;
+	Wake();
+}
+
+// applies an impulse
+void cherry::RigidBody::ApplyImpulse(glm::vec3 impulse)
+{
+	if (IsStatic())
+		return;
+
+	velocity += impulse * inverseMass;
+	Wake();
+}
+
+// checks if asleep
+bool cherry::RigidBody::IsSleeping() const { return sleeping; }
+
+// wakes the body up
+void cherry::RigidBody::Wake()
+{
+	sleeping = false;
+	sleepTime = 0.0F;
+}
+
+// puts the body to sleep
+void cherry::RigidBody::Sleep()
+{
+	sleeping = true;
+	velocity = glm::vec3(0.0F);
+}
+
+// gets the id
+uint32_t cherry::RigidBody::GetId() const { return id; }
+
+// reads the position
+glm::vec3 cherry::RigidBody::__ReadPosition() const
+{
+	return (body != nullptr) ? body->GetWorldPositionGLM() : glm::vec3(0.0F);
+}
+
+// writes the position
+void cherry::RigidBody::__WritePosition()
+{
+	if (body == nullptr)
+		return;
+
+	// the world position of a body is its object's position plus its local position.
+	if (body->GetObject() != nullptr)
+		body->GetObject()->SetPosition(position - body->GetLocalPositionGLM());
+	else
+		body->SetLocalPosition(position);
+
+	// the position is read back, since going through the object can round it slightly differently.
+	position = __ReadPosition();
+	syncedPosition = position;
+}
@@ -0,0 +1,104 @@
+// RigidBody (Header) - the mass, velocity, and material of a physics body that's moved by a PhysicsWorld.
+#pragma once
+#include <GLM/glm.hpp>
+#include <stdint.h>
+
+#include "PhysicsBody.h"
+
+namespace cherry
+{
+	class PhysicsWorld;
+
+	/*
+	 * A rigid body uses a physics body (box or sphere) as its shape. If the physics body is attached to an object, the object is moved.
+	 * Bodies with a mass of 0 are static. They're never moved by the world, but can still be moved by setting their object's position.
+	 * The bodies only move; they aren't rotated by the contacts. Rotated boxes keep the rotation of their object.
+	 * Bodies that have stopped moving are put to sleep, and aren't updated until something touches them or they're moved.
+	*/
+	class RigidBody
+	{
+	public:
+		// the physics body used as the shape, and the mass (0 = static).
+		RigidBody(cherry::PhysicsBody* body, float mass);
+
+		// gets the physics body.
+		cherry::PhysicsBody* GetBody() const;
+
+		// gets the object the physics body is attached to (nullptr if it isn't attached to anything).
+		cherry::Object* GetObject() const;
+
+		// gets the mass.
+		float GetMass() const;
+
+		// sets the mass. A mass of 0 (or lower) makes the body static.
+		void SetMass(float newMass);
+
+		// gets 1 / mass, which is 0 for static bodies.
+		float GetInverseMass() const;
+
+		// returns 'true' if the body is static.
+		bool IsStatic() const;
+
+		// gets the centre of the body in world space.
+		glm::vec3 GetPosition() const;
+
+		// gets the velocity.
+		glm::vec3 GetVelocity() const;
+
+		// sets the velocity, and wakes the body up.
+		void SetVelocity(glm::vec3 newVelocity);
+
+		// changes the velocity by impulse / mass, and wakes the body up. This does nothing for static bodies.
+		void ApplyImpulse(glm::vec3 impulse);
+
+		// returns 'true' if the body is asleep.
+		bool IsSleeping() const;
+
+		// wakes the body up.
+		void Wake();
+
+		// puts the body to sleep, which stops it.
+		void Sleep();
+
+		// gets the identifier the world gave the body, which is its place in the world's list. Bodies are always processed in the order of their identifiers.
+		// removing a body moves the bodies after it up the list, so their identifiers go down by one.
+		uint32_t GetId() const;
+
+		// how bouncy the body is (0 = no bounce, 1 = keeps all of its speed). The bounciest of the two bodies is used for a contact.
+		float restitution = 0.2F;
+
+		// the friction of the body. The two frictions are multiplied together, then square rooted for a contact.
+		float friction = 0.5F;
+
+		// how quickly the body slows down on its own (per second).
+		float linearDamping = 0.05F;
+
+		// how much gravity affects the body.
+		float gravityScale = 1.0F;
+
+	private:
+		friend class PhysicsWorld;
+
+		// reads the position of the physics body.
+		glm::vec3 __ReadPosition() const;
+
+		// moves the physics body (or its object) to the position.
+		void __WritePosition();
+
+		cherry::PhysicsBody* body = nullptr;
+
+		float mass = 0.0F;
+		float inverseMass = 0.0F;
+
+		glm::vec3 position = glm::vec3(0.0F); // the centre of the body.
+		glm::vec3 velocity = glm::vec3(0.0F);
+
+		// the position the world last read or wrote. If the body is somewhere else, something else moved it.
+		glm::vec3 syncedPosition = glm::vec3(0.0F);
+
+		bool sleeping = false;
+		float sleepTime = 0.0F; // how long the body has been moving slowly enough to sleep.
+
+		uint32_t id = 0;
+	};
+}
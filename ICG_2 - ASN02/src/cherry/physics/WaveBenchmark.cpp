@@ -0,0 +1,264 @@
+// WaveBenchmark (Source) - times the liquid's waves and buoyancy on the CPU, and checks that the waves match the water shader.
+#include "WaveBenchmark.h"
+#include "Buoyancy.h"
+#include "PhysicsBody.h"
+#include "..\Game.h"
+#include "..\GLState.h"
+#include "..\objects\Liquid.h"
+#include "..\objects\PrimitiveCube.h"
+
+#include <toolkit/Logging.h>
+#include <GLM/gtc/constants.hpp>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+// the vertex shader the waves are compared against.
+#define WAVE_BENCHMARK_SHADER "res/shaders/water-shader.vs.glsl"
+
+// runs the benchmark
+cherry::WaveBenchmarkResult cherry::WaveBenchmark::Run(uint32_t samples, uint32_t floaters)
+{
+	WaveBenchmarkResult result;
+	result.Samples = samples;
+
+	// the waves from the engine scene's water.
+	const glm::vec4 waveInfo[3] = {
+		glm::vec4(1.0F, 0.0F, 0.50F, 6.0F),
+		glm::vec4(0.0F, 1.0F, 0.25F, 3.1F),
+		glm::vec4(1.0F, 1.4F, 0.20F, 1.8F)
+	};
+	const float gravity = 9.81F;
+	const float time = 10.0F;
+
+	GerstnerWaves waves;
+	waves.SetEnabledWaves(3);
+	waves.SetGravity(gravity);
+
+	for (unsigned int i = 0; i < 3; i++)
+		waves.SetWave(i, waveInfo[i]);
+
+	// the samples are spread over the same area as the engine scene's water.
+	std::vector<float> x(samples);
+	std::vector<float> y(samples);
+	std::vector<float> singleHeights(samples);
+	std::vector<float> batchHeights(samples);
+
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> area(-10.0F, 10.0F);
+
+	for (uint32_t i = 0; i < samples; i++)
+	{
+		x[i] = area(random);
+		y[i] = area(random);
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (uint32_t i = 0; i < samples; i++)
+		singleHeights[i] = waves.GetHeight(glm::vec2(x[i], y[i]), time);
+
+	result.SingleTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	start = std::chrono::high_resolution_clock::now();
+	waves.GetHeights(x.data(), y.data(), samples, time, batchHeights.data());
+	result.BatchTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+
+	for (uint32_t i = 0; i < samples; i++)
+		result.MaxBatchError = glm::max(result.MaxBatchError, glm::abs(singleHeights[i] - batchHeights[i]));
+
+	result.ShaderChecked = __CheckShader(waves, time, x, y, result);
+	result.Passed = result.ShaderChecked && result.MaxBatchError <= 0.001F && result.MaxPositionError <= 0.001F &&
+		result.MaxNormalError <= 0.001F && result.MaxHeightError <= result.HeightTolerance;
+
+	// floats a grid of boxes on a liquid, which needs a scene to be put in.
+	Game* const game = Game::GetRunningGame();
+
+	if (game != nullptr && floaters > 0)
+	{
+		Liquid* liquid = new Liquid(game->GetCurrentSceneName(), 20.0F, 1.0F);
+		Buoyancy buoyancy(liquid);
+		std::vector<Object*> boxes;
+
+		liquid->SetEnabledWaves(3);
+		liquid->SetGravity(gravity);
+
+		for (unsigned int i = 0; i < 3; i++)
+			liquid->SetWave(i, waveInfo[i].x, waveInfo[i].y, waveInfo[i].z, waveInfo[i].w);
+
+		// the boxes aren't put in a scene, so they're never drawn.
+		const uint32_t perSide = (uint32_t)glm::ceil(glm::sqrt((float)floaters));
+		const float spacing = 20.0F / perSide;
+
+		boxes.reserve(floaters);
+
+		for (uint32_t i = 0; i < floaters; i++)
+		{
+			Object* box = new PrimitiveCube(spacing * 0.5F);
+			box->SetPosition((i % perSide + 0.5F) * spacing - 10.0F, (i / perSide + 0.5F) * spacing - 10.0F, 0.0F);
+
+			// the cube's size is its scale, so the body is the size of the unit cube (2 x 2 x 2), and is scaled with it.
+			box->AddPhysicsBody(new PhysicsBodyBox(2.0F, 2.0F, 2.0F));
+
+			buoyancy.AddObject(box);
+			boxes.push_back(box);
+		}
+
+		result.Floaters = floaters;
+
+		// a second of updates at 60 frames per second.
+		const int updates = 60;
+
+		start = std::chrono::high_resolution_clock::now();
+
+		for (int i = 0; i < updates; i++)
+			buoyancy.Update(1.0F / 60.0F);
+
+		result.BuoyancyTime = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count() / updates;
+
+		for (Object* box : boxes)
+			delete box;
+
+		delete liquid;
+	}
+
+	LOG_INFO("Wave benchmark: {} samples, {:.3f} ms one at a time, {:.3f} ms batched (largest difference {:.6f}).",
+		result.Samples, result.SingleTime, result.BatchTime, result.MaxBatchError);
+
+	if (result.Floaters > 0)
+		LOG_INFO("Wave benchmark: {} floating boxes, {:.3f} ms per buoyancy update.", result.Floaters, result.BuoyancyTime);
+
+	if (result.ShaderChecked)
+	{
+		LOG_INFO("Wave benchmark: shader difference of {:.6f} (position), {:.6f} (normal), {:.6f} (height, {:.6f} allowed).",
+			result.MaxPositionError, result.MaxNormalError, result.MaxHeightError, result.HeightTolerance);
+	}
+
+	if (result.Passed)
+		LOG_INFO("Wave benchmark: the CPU waves match the water shader.");
+	else
+		LOG_ERROR("Wave benchmark: the CPU waves don't match the water shader.");
+
+	return result;
+}
+
+// checks the waves against the shader
+bool cherry::WaveBenchmark::__CheckShader(const GerstnerWaves& waves, float time, const std::vector<float>& x, const std::vector<float>& y, WaveBenchmarkResult& result)
+{
+	std::ifstream file(WAVE_BENCHMARK_SHADER, std::ios::in);
+
+	if (!file)
+	{
+		LOG_ERROR("Wave benchmark couldn't open \"{}\".", WAVE_BENCHMARK_SHADER);
+		return false;
+	}
+
+	std::stringstream stream;
+	stream << file.rdbuf();
+
+	const std::string source = stream.str();
+	const char* sourcePtr = source.c_str();
+	const GLsizei count = (GLsizei)x.size();
+
+	// only the vertex shader is used, and its outputs are captured instead of being drawn.
+	GLuint shader = glCreateShader(GL_VERTEX_SHADER);
+	glShaderSource(shader, 1, &sourcePtr, nullptr);
+	glCompileShader(shader);
+
+	GLuint program = glCreateProgram();
+	const char* varyings[2] = { "outNormal", "outWorldPos" };
+
+	glAttachShader(program, shader);
+	glTransformFeedbackVaryings(program, 2, varyings, GL_INTERLEAVED_ATTRIBS);
+	glLinkProgram(program);
+	glDetachShader(program, shader);
+	glDeleteShader(shader);
+
+	GLint success = 0;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+
+	if (success == GL_FALSE)
+	{
+		LOG_ERROR("Wave benchmark couldn't link \"{}\" for transform feedback.", WAVE_BENCHMARK_SHADER);
+		glDeleteProgram(program);
+		return false;
+	}
+
+	// the waves are given in local space, so there's no transformation.
+	const glm::mat4 identity = glm::mat4(1.0F);
+	glm::vec4 waveInfo[GERSTNER_MAX_WAVES];
+
+	for (unsigned int i = 0; i < GERSTNER_MAX_WAVES; i++)
+		waveInfo[i] = waves.GetWave(i);
+
+	glProgramUniformMatrix4fv(program, glGetUniformLocation(program, "a_ModelViewProjection"), 1, GL_FALSE, &identity[0][0]);
+	glProgramUniform1f(program, glGetUniformLocation(program, "a_Time"), time);
+	glProgramUniform1f(program, glGetUniformLocation(program, "a_Gravity"), waves.GetGravity());
+	glProgramUniform1i(program, glGetUniformLocation(program, "a_EnabledWaves"), waves.GetEnabledWaves());
+	glProgramUniform4fv(program, glGetUniformLocation(program, "a_Waves"), GERSTNER_MAX_WAVES, &waveInfo[0][0]);
+
+	// the points on the flat surface, and the normals and positions the shader moves them to.
+	std::vector<glm::vec3> points(count);
+	std::vector<glm::vec3> captured((size_t)count * 2);
+
+	for (GLsizei i = 0; i < count; i++)
+		points[i] = glm::vec3(x[i], y[i], 0.0F);
+
+	GLuint buffers[2];
+	GLuint vao;
+
+	glCreateBuffers(2, buffers);
+	glNamedBufferData(buffers[0], sizeof(glm::vec3) * points.size(), points.data(), GL_STATIC_DRAW);
+	glNamedBufferData(buffers[1], sizeof(glm::vec3) * captured.size(), nullptr, GL_STATIC_READ);
+
+	glCreateVertexArrays(1, &vao);
+	glVertexArrayVertexBuffer(vao, 0, buffers[0], 0, sizeof(glm::vec3));
+	glEnableVertexArrayAttrib(vao, 0);
+	glVertexArrayAttribFormat(vao, 0, 3, GL_FLOAT, GL_FALSE, 0);
+	glVertexArrayAttribBinding(vao, 0, 0);
+
+	GLState::UseProgram(program);
+	GLState::BindVertexArray(vao);
+	GLState::Enable(GL_RASTERIZER_DISCARD);
+
+	glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, buffers[1]);
+	glBeginTransformFeedback(GL_POINTS);
+	glDrawArrays(GL_POINTS, 0, count);
+	glEndTransformFeedback();
+	glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+
+	GLState::Disable(GL_RASTERIZER_DISCARD);
+	glGetNamedBufferSubData(buffers[1], 0, sizeof(glm::vec3) * captured.size(), captured.data());
+
+	// the program and vertex array are deleted, so the state cache can't keep them as bound.
+	GLState::ForgetProgram(program);
+	GLState::ForgetVertexArray(vao);
+	glDeleteProgram(program);
+	glDeleteVertexArrays(1, &vao);
+	glDeleteBuffers(2, buffers);
+
+	// GetHeight() is only as close as its corrections, so the height gets a tolerance based on how tall the waves are.
+	float amplitude = 0.0F;
+
+	for (int i = 0; i < waves.GetEnabledWaves(); i++)
+		amplitude += glm::abs(waves.GetWave(i).z * waves.GetWave(i).w) / glm::two_pi<float>();
+
+	result.HeightTolerance = amplitude * 0.05F;
+
+	for (GLsizei i = 0; i < count; i++)
+	{
+		const glm::vec3& shaderNormal = captured[(size_t)i * 2];
+		const glm::vec3& shaderPosition = captured[(size_t)i * 2 + 1];
+
+		glm::vec3 normal;
+		glm::vec3 position = waves.Displace(glm::vec2(points[i]), time, &normal);
+		float height = waves.GetHeight(glm::vec2(shaderPosition), time);
+
+		result.MaxPositionError = glm::max(result.MaxPositionError, glm::length(position - shaderPosition));
+		result.MaxNormalError = glm::max(result.MaxNormalError, 1.0F - glm::dot(normal, shaderNormal));
+		result.MaxHeightError = glm::max(result.MaxHeightError, glm::abs(height - shaderPosition.z));
+	}
+
+	return true;
+}
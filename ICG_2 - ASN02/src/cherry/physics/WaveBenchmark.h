@@ -0,0 +1,46 @@
+// WaveBenchmark (Header) - times the liquid's waves and buoyancy on the CPU, and checks that the waves match the water shader.
+#pragma once
+#include <stdint.h>
+#include <vector>
+
+#include "..\objects\GerstnerWaves.h"
+
+namespace cherry
+{
+	// the results of a benchmark.
+	struct WaveBenchmarkResult
+	{
+		uint32_t Samples = 0;
+		float SingleTime = 0.0F; // GerstnerWaves::GetHeight() on every sample, one at a time (in milliseconds).
+		float BatchTime = 0.0F; // GerstnerWaves::GetHeights() on every sample at once (in milliseconds).
+		float MaxBatchError = 0.0F; // the largest difference between the single and batched heights. This should be about 0.
+
+		uint32_t Floaters = 0; // the amount of objects floating on the liquid.
+		float BuoyancyTime = 0.0F; // the average time of Buoyancy::Update() (in milliseconds).
+
+		bool ShaderChecked = false; // 'false' if the shader couldn't be run.
+		float MaxPositionError = 0.0F; // the largest distance between GerstnerWaves::Displace() and the vertex shader's position.
+		float MaxNormalError = 0.0F; // the largest (1 - dot) between the CPU and vertex shader normals.
+		float MaxHeightError = 0.0F; // the largest difference between GerstnerWaves::GetHeight() and the height the shader drew at the same spot.
+		float HeightTolerance = 0.0F; // the height error that's allowed, since GetHeight() only corrects the sideways offset a few times.
+		bool Passed = false; // 'true' if the shader was checked, and all of the errors are within their tolerances.
+	};
+
+	/*
+	 * The benchmark uses the waves from the engine scene's water, and spreads the samples over a 20 x 20 area of it.
+	 * The heights are found one at a time and in a batch, then a grid of boxes is floated on a liquid for a second of updates.
+	 * The samples are also run through 'water-shader.vs.glsl' with transform feedback, so that the CPU can be compared to what's drawn.
+	 * This needs an OpenGL context and a running game (for the liquid's scene). The results are printed to the log.
+	*/
+	class WaveBenchmark
+	{
+	public:
+		// runs the benchmark on the provided amount of samples and floating boxes.
+		static WaveBenchmarkResult Run(uint32_t samples = 100000, uint32_t floaters = 10000);
+
+	private:
+		// runs the points through the water shader, and compares the results with the waves on the CPU.
+		// returns 'false' if the shader couldn't be used.
+		static bool __CheckShader(const GerstnerWaves& waves, float time, const std::vector<float>& x, const std::vector<float>& y, WaveBenchmarkResult& result);
+	};
+}
@@ -0,0 +1,146 @@
+// BloomLayer - bloom made from a mip chain with separable blurs
+#include "BloomLayer.h"
+#include "..\Game.h"
+
+// constructor
+cherry::BloomLayer::BloomLayer() : PostLayer()
+{
+	downsampleShader = std::make_shared<Shader>();
+	downsampleShader->Load(POST_VS, BLOOM_DOWNSAMPLE_FS);
+
+	blurShader = std::make_shared<Shader>();
+	blurShader->Load(POST_VS, BLOOM_BLUR_FS);
+
+	upsampleShader = std::make_shared<Shader>();
+	upsampleShader->Load(POST_VS, BLOOM_UPSAMPLE_FS);
+
+	compositeShader = std::make_shared<Shader>();
+	compositeShader->Load(POST_VS, BLOOM_COMPOSITE_FS);
+}
+
+// sets the radius
+void cherry::BloomLayer::SetRadius(float radius) { this->radius = glm::max(radius, 1.0F); }
+
+// gets the radius
+float cherry::BloomLayer::GetRadius() const { return radius; }
+
+// sets the threshold
+void cherry::BloomLayer::SetThreshold(float threshold) { this->threshold = glm::clamp(threshold, 0.0F, 1.0F); }
+
+// gets the threshold
+float cherry::BloomLayer::GetThreshold() const { return threshold; }
+
+// sets the intensity
+void cherry::BloomLayer::SetIntensity(float intensity) { this->intensity = glm::max(intensity, 0.0F); }
+
+// gets the intensity
+float cherry::BloomLayer::GetIntensity() const { return intensity; }
+
+// gets the level count
+uint32_t cherry::BloomLayer::GetLevelCount() const
+{
+	// a level's blur reaches about 4 of its texels, and the texels of level i are 2^(i + 1) pixels wide.
+	// so the levels up to and including level i reach about 2^(i + 3) pixels.
+	float levels = glm::log2(radius) - 2.0F;
+
+	return (uint32_t)glm::clamp(glm::ceil(levels), 1.0F, (float)BLOOM_MAX_LEVELS);
+}
+
+// declares the passes
+cherry::RenderGraph::Resource cherry::BloomLayer::DeclarePasses(RenderGraph& graph, RenderGraph::Resource input)
+{
+	const Game* const game = Game::GetRunningGame();
+	const uint32_t width = game->GetWindowWidth();
+	const uint32_t height = game->GetWindowHeight();
+
+	RenderGraph::Resource scene = (initialBuffer == nullptr) ? input : graph.Import(initialBuffer);
+	RenderGraph::Resource down[BLOOM_MAX_LEVELS]; // the downsampled levels
+	RenderGraph::Resource blurred[BLOOM_MAX_LEVELS]; // the blurred levels
+
+	uint32_t levels = GetLevelCount();
+	float lastWeight = 1.0F; // the weight of the smallest level
+
+	// the levels use floating point colour, since they're added together.
+	RenderBufferDesc color = RenderBufferDesc();
+	color.ShaderReadable = true;
+	color.Attachment = RenderTargetAttachment::Color0;
+	color.Format = RenderTargetType::Color32F;
+
+	// the final image
+	RenderBufferDesc outColor = color;
+	outColor.Format = RenderTargetType::Color24;
+
+	initialBuffer = nullptr;
+
+	// stops halving once a level would be smaller than 2 pixels.
+	while (levels > 1 && ((width >> levels) < 2 || (height >> levels) < 2))
+		levels--;
+
+	// fades in the smallest level if the radius is between two levels.
+	if (levels > 1 && levels == GetLevelCount())
+		lastWeight = glm::clamp(glm::log2(radius) - 2.0F - (levels - 1), 0.0F, 1.0F);
+
+	graph.BeginTimer(&myTimer);
+
+	// downsampling. The first level only keeps the bright parts of the scene.
+	for (uint32_t i = 0; i < levels; i++)
+	{
+		const float levelThreshold = threshold;
+		const int prefilter = (i == 0) ? 1 : 0;
+
+		down[i] = graph.Create(glm::max(width >> (i + 1), 1U), glm::max(height >> (i + 1), 1U), { color });
+
+		graph.AddPass(downsampleShader, (i == 0) ? scene : down[i - 1], RenderGraph::NONE, down[i],
+			[prefilter, levelThreshold](const Shader::Sptr& shader) {
+				shader->SetUniform("xPrefilter", prefilter);
+				shader->SetUniform("xThreshold", levelThreshold);
+			});
+	}
+
+	// blurring horizontally, then vertically.
+	for (uint32_t i = 0; i < levels; i++)
+	{
+		const uint32_t levelWidth = glm::max(width >> (i + 1), 1U);
+		const uint32_t levelHeight = glm::max(height >> (i + 1), 1U);
+
+		RenderGraph::Resource horizontal = graph.Create(levelWidth, levelHeight, { color });
+		blurred[i] = graph.Create(levelWidth, levelHeight, { color });
+
+		graph.AddPass(blurShader, down[i], RenderGraph::NONE, horizontal, [](const Shader::Sptr& shader) {
+			shader->SetUniform("xDirection", glm::vec2(1.0F, 0.0F));
+		});
+
+		graph.AddPass(blurShader, horizontal, RenderGraph::NONE, blurred[i], [](const Shader::Sptr& shader) {
+			shader->SetUniform("xDirection", glm::vec2(0.0F, 1.0F));
+		});
+	}
+
+	// adding the levels together, starting from the smallest.
+	RenderGraph::Resource bloom = blurred[levels - 1];
+
+	for (int i = (int)levels - 2; i >= 0; i--)
+	{
+		const float lowerWeight = (i == (int)levels - 2) ? lastWeight : 1.0F;
+		RenderGraph::Resource combined = graph.Create(glm::max(width >> (i + 1), 1U), glm::max(height >> (i + 1), 1U), { color });
+
+		graph.AddPass(upsampleShader, blurred[i], bloom, combined, [lowerWeight](const Shader::Sptr& shader) {
+			shader->SetUniform("xLowerWeight", lowerWeight);
+		});
+
+		bloom = combined;
+	}
+
+	// adding the bloom to the scene. The levels are averaged so the brightness doesn't depend on the radius.
+	{
+		const float bloomIntensity = intensity / (levels - 1 + lastWeight);
+		RenderGraph::Resource output = graph.Create(width, height, { outColor });
+
+		graph.AddPass(compositeShader, scene, bloom, output, [bloomIntensity](const Shader::Sptr& shader) {
+			shader->SetUniform("xIntensity", bloomIntensity);
+		});
+
+		graph.EndTimer();
+
+		return output;
+	}
+}
@@ -0,0 +1,69 @@
+/*
+ * Team: Bonus Fruit:
+ * Description: bloom made from a mip chain instead of stacked 3x3 kernels.
+	* the bright parts of the scene are downsampled to half size, then halved again for each level.
+	* every level gets a separable gaussian blur, which is done in 5 samples per direction using linear filtering.
+	* the levels are added back together from the smallest to the largest, then added to the scene.
+	* each level is a quarter the size of the one before it, so a bigger radius only adds a small amount of work.
+ * References:
+	* https://www.rastergrid.com/blog/2010/09/efficient-gaussian-blur-with-linear-sampling/
+	* http://www.iryoku.com/next-generation-post-processing-in-call-of-duty-advanced-warfare
+ */
+#pragma once
+#include "PostLayer.h"
+
+// the bloom shaders
+#define BLOOM_DOWNSAMPLE_FS ("res/shaders/post/bloom-downsample.fs.glsl")
+#define BLOOM_BLUR_FS ("res/shaders/post/bloom-blur.fs.glsl")
+#define BLOOM_UPSAMPLE_FS ("res/shaders/post/bloom-upsample.fs.glsl")
+#define BLOOM_COMPOSITE_FS ("res/shaders/post/bloom-composite.fs.glsl")
+
+// the most levels the mip chain can have.
+#define BLOOM_MAX_LEVELS 8
+
+namespace cherry
+{
+	// the bloom layer
+	class BloomLayer : public PostLayer
+	{
+	public:
+		// loads the bloom shaders.
+		BloomLayer();
+
+		// sets the radius of the bloom (in pixels at full resolution).
+		// the radius decides how many levels are used, and the last level is faded in for radii in-between.
+		void SetRadius(float radius);
+
+		// gets the radius of the bloom.
+		float GetRadius() const;
+
+		// sets the brightness that the bloom starts at (0 - 1).
+		void SetThreshold(float threshold);
+
+		// gets the threshold.
+		float GetThreshold() const;
+
+		// sets how bright the bloom is when added to the scene.
+		void SetIntensity(float intensity);
+
+		// gets the intensity.
+		float GetIntensity() const;
+
+		// gets the amount of levels used for the current radius.
+		uint32_t GetLevelCount() const;
+
+		// declares the downsample, blur, upsample, and composite passes.
+		RenderGraph::Resource DeclarePasses(RenderGraph& graph, RenderGraph::Resource input) override;
+
+	private:
+		// the shaders for each type of pass.
+		Shader::Sptr downsampleShader;
+		Shader::Sptr blurShader;
+		Shader::Sptr upsampleShader;
+		Shader::Sptr compositeShader;
+
+		float radius = 64.0F;
+		float threshold = 0.75F;
+		float intensity = 1.0F;
+	};
+}
@@ -54,6 +54,8 @@ namespace cherry
 		Color24 = GL_RGB8,
 		Color16 = GL_RG8,
 		Color8 = GL_R8,
+		RG16 = GL_RG16, // two 16-bit unsigned normalized channels; used for octahedral normals in the g-buffer.
+		Color32F = GL_R11F_G11F_B10F, // floating point colour with no alpha; used for values above 1 (e.g. bloom).
 		DepthStencil = GL_DEPTH24_STENCIL8,
 		Depth16 = GL_DEPTH_COMPONENT16,
 		Depth24 = GL_DEPTH_COMPONENT24,
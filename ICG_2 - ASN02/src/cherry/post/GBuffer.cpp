@@ -0,0 +1,89 @@
+// GBuffer - the layout of the g-buffer used for deferred lighting
+#include "GBuffer.h"
+
+// attachments
+const cherry::RenderTargetAttachment cherry::GBuffer::ALBEDO = cherry::RenderTargetAttachment::Color0;
+const cherry::RenderTargetAttachment cherry::GBuffer::NORMAL = cherry::RenderTargetAttachment::Color1;
+const cherry::RenderTargetAttachment cherry::GBuffer::MATERIAL = cherry::RenderTargetAttachment::Color2;
+const cherry::RenderTargetAttachment cherry::GBuffer::DEPTH = cherry::RenderTargetAttachment::DepthStencil;
+
+// gets the targets
+std::vector<cherry::RenderBufferDesc> cherry::GBuffer::GetTargets()
+{
+	return std::vector<RenderBufferDesc>{
+		MakeTarget(ALBEDO, RenderTargetType::Color32),
+		MakeTarget(NORMAL, RenderTargetType::RG16),
+		MakeTarget(MATERIAL, RenderTargetType::Color16),
+		MakeTarget(DEPTH, RenderTargetType::DepthStencil)
+	};
+}
+
+// creates the g-buffer
+cherry::FrameBuffer::Sptr cherry::GBuffer::Create(uint32_t width, uint32_t height)
+{
+	FrameBuffer::Sptr fb = std::make_shared<FrameBuffer>(width, height);
+
+	for (const RenderBufferDesc& target : GetTargets())
+		fb->AddAttachment(target);
+
+	return fb;
+}
+
+// gets the bytes per pixel for all targets
+uint32_t cherry::GBuffer::GetBytesPerPixel(const std::vector<RenderBufferDesc>& targets)
+{
+	uint32_t bytes = 0;
+
+	for (const RenderBufferDesc& target : targets)
+		bytes += GetBytesPerPixel(target.Format);
+
+	return bytes;
+}
+
+// gets the bytes per pixel for a format
+uint32_t cherry::GBuffer::GetBytesPerPixel(RenderTargetType format)
+{
+	switch (format)
+	{
+	case RenderTargetType::Color8:
+	case RenderTargetType::Stencil4:
+	case RenderTargetType::Stencil8:
+		return 1;
+
+	case RenderTargetType::Color16:
+	case RenderTargetType::Depth16:
+	case RenderTargetType::Stencil16:
+		return 2;
+
+	case RenderTargetType::Color24:
+	case RenderTargetType::Depth24:
+		return 3;
+
+	case RenderTargetType::Color32:
+	case RenderTargetType::Color32F:
+	case RenderTargetType::RG16:
+	case RenderTargetType::DepthStencil:
+	case RenderTargetType::Depth32:
+		return 4;
+
+	default:
+		return 0;
+	}
+}
+
+// gets the size in megabytes
+float cherry::GBuffer::GetSizeMB(const std::vector<RenderBufferDesc>& targets, uint32_t width, uint32_t height)
+{
+	return (float)GetBytesPerPixel(targets) * width * height / (1024.0F * 1024.0F);
+}
+
+// makes a target
+cherry::RenderBufferDesc cherry::GBuffer::MakeTarget(RenderTargetAttachment attachment, RenderTargetType format)
+{
+	RenderBufferDesc desc = RenderBufferDesc();
+	desc.ShaderReadable = true;
+	desc.Attachment = attachment;
+	desc.Format = format;
+
+	return desc;
+}
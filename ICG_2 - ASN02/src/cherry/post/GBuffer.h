@@ -0,0 +1,47 @@
+/*
+ * Team: Bonus Fruit:
+ * Description: the layout of the g-buffer that the scene is drawn into before the deferred lighting.
+	* Color0 - albedo (RGBA8).
+	* Color1 - normal (RG16), stored as an octahedral encoding instead of three channels.
+	* Color2 - material (RG8), with the material id in red and the roughness in green.
+	* DepthStencil - depth and stencil (D24S8). The position isn't stored, since it's rebuilt from the depth and the inverse view projection.
+ * References:
+	* https://knarkowicz.wordpress.com/2014/04/16/octahedron-normal-vector-encoding/
+	* https://aras-p.info/texts/CompactNormalStorage.html
+ */
+#pragma once
+#include "FrameBuffer.h"
+
+#include <vector>
+
+namespace cherry
+{
+	// the g-buffer
+	class GBuffer
+	{
+	public:
+		// the attachment for each of the targets.
+		static const RenderTargetAttachment ALBEDO;
+		static const RenderTargetAttachment NORMAL;
+		static const RenderTargetAttachment MATERIAL;
+		static const RenderTargetAttachment DEPTH;
+
+		// gets the descriptions of the targets in the g-buffer.
+		static std::vector<RenderBufferDesc> GetTargets();
+
+		// creates a frame buffer with the g-buffer's targets.
+		static FrameBuffer::Sptr Create(uint32_t width, uint32_t height);
+
+		// gets the amount of bytes a pixel takes up across all of the targets.
+		static uint32_t GetBytesPerPixel(const std::vector<RenderBufferDesc>& targets);
+
+		// gets the amount of bytes a format takes up per pixel (0 if unknown).
+		static uint32_t GetBytesPerPixel(RenderTargetType format);
+
+		// gets the size of the targets at the provided resolution in megabytes.
+		static float GetSizeMB(const std::vector<RenderBufferDesc>& targets, uint32_t width, uint32_t height);
+
+		// makes a shader readable target description.
+		static RenderBufferDesc MakeTarget(RenderTargetAttachment attachment, RenderTargetType format);
+	};
+}
@@ -0,0 +1,229 @@
+// LightVolumeLayer - deferred lighting with stencil tested light volumes
+#include "LightVolumeLayer.h"
+#include "GBuffer.h"
+#include "..\objects\PrimitiveSphere.h"
+#include "..\objects\PrimitiveCube.h"
+#include "..\objects\PrimitiveCone.h"
+#include "..\GLState.h"
+#include "..\Game.h"
+
+// constructor
+cherry::LightVolumeLayer::LightVolumeLayer(const FrameBuffer::Sptr& output)
+	: PostLayer(), output(output)
+{
+	volumeShader = std::make_shared<Shader>();
+	volumeShader->Load(LIGHT_VOLUME_VS, LIGHT_VOLUME_FS);
+
+	stencilShader = std::make_shared<Shader>();
+	stencilShader->Load(LIGHT_VOLUME_VS, LIGHT_VOLUME_STENCIL_FS);
+
+	baseShader = std::make_shared<Shader>();
+	baseShader->Load(LIGHT_VOLUME_BASE_VS, LIGHT_VOLUME_BASE_FS);
+
+	// the volumes all fit in a box from -1 to 1, and are scaled by the radius in the vertex shader.
+	volumes[SPHERE] = new PrimitiveUVSphere(1.0F, 12, 12);
+	volumes[CUBE] = new PrimitiveCube(2.0F);
+	volumes[CONE] = new PrimitiveCone(1.0F, 2.0F, 16);
+}
+
+// destructor
+cherry::LightVolumeLayer::~LightVolumeLayer()
+{
+	for (Primitive* volume : volumes)
+		delete volume;
+
+	if (instanceBuffer != 0)
+		glDeleteBuffers(1, &instanceBuffer);
+}
+
+// sets the lights
+void cherry::LightVolumeLayer::SetLights(const std::vector<ClusterLight>& lights, float maxRadius)
+{
+	uint32_t next[VOLUME_TYPE_COUNT]{};
+
+	for (int i = 0; i < VOLUME_TYPE_COUNT; i++)
+		counts[i] = 0;
+
+	// counts each type, so the lights can be put into batches without sorting.
+	for (const ClusterLight& light : lights)
+		counts[glm::clamp((int)light.material.y, 0, VOLUME_TYPE_COUNT - 1)]++;
+
+	for (int i = 0; i < VOLUME_TYPE_COUNT; i++)
+	{
+		offsets[i] = (i == 0) ? 0 : offsets[i - 1] + counts[i - 1];
+		next[i] = offsets[i];
+	}
+
+	instances.resize(lights.size());
+
+	for (const ClusterLight& light : lights)
+	{
+		int type = glm::clamp((int)light.material.y, 0, VOLUME_TYPE_COUNT - 1);
+		ClusterLight& instance = instances[next[type]++];
+
+		instance = light;
+		instance.position.w = glm::min(light.position.w, maxRadius);
+		instance.material.y = (float)type;
+	}
+
+	// the instances are uploaded now, since the pass may be skipped if nothing reads its output.
+	if (instanceBuffer == 0)
+		glCreateBuffers(1, &instanceBuffer);
+
+	if (instances.empty())
+	{
+		static const ClusterLight EMPTY_LIGHT = ClusterLight();
+		glNamedBufferData(instanceBuffer, sizeof(ClusterLight), &EMPTY_LIGHT, GL_STREAM_DRAW);
+	}
+	else
+	{
+		glNamedBufferData(instanceBuffer, sizeof(ClusterLight) * instances.size(), instances.data(), GL_STREAM_DRAW);
+	}
+}
+
+// gets a light count
+uint32_t cherry::LightVolumeLayer::GetLightCount(VolumeType type) const { return (type < VOLUME_TYPE_COUNT) ? counts[type] : 0; }
+
+// sets if the clear colour is used
+void cherry::LightVolumeLayer::SetUseClearColor(bool useClear) { useClearColor = useClear; }
+
+// declares the passes
+cherry::RenderGraph::Resource cherry::LightVolumeLayer::DeclarePasses(RenderGraph& graph, RenderGraph::Resource input)
+{
+	const Game* const game = Game::GetRunningGame();
+	RenderGraph::Resource scene = (initialBuffer == nullptr) ? input : graph.Import(initialBuffer);
+	RenderGraph::Resource result = RenderGraph::NONE;
+
+	initialBuffer = nullptr;
+
+	if (output != nullptr)
+	{
+		result = graph.Import(output);
+	}
+	else
+	{
+		// the colour, and the depth and stencil. The depth is copied from the scene, so the formats need to match.
+		RenderBufferDesc color = RenderBufferDesc();
+		color.ShaderReadable = true;
+		color.Attachment = RenderTargetAttachment::Color0;
+		color.Format = RenderTargetType::Color24;
+
+		RenderBufferDesc depthStencil = RenderBufferDesc();
+		depthStencil.ShaderReadable = false;
+		depthStencil.Attachment = RenderTargetAttachment::DepthStencil;
+		depthStencil.Format = RenderTargetType::DepthStencil;
+
+		result = graph.Create(game->GetWindowWidth(), game->GetWindowHeight(), { color, depthStencil });
+	}
+
+	graph.BeginTimer(&myTimer);
+
+	graph.AddCustomPass(scene, result,
+		[this](const FrameBuffer::Sptr& input, const FrameBuffer::Sptr& output, const Camera::Sptr& camera) {
+			DrawVolumes(input, output, camera);
+		});
+
+	graph.EndTimer();
+
+	return result;
+}
+
+// draws the volumes
+void cherry::LightVolumeLayer::DrawVolumes(const FrameBuffer::Sptr& input, const FrameBuffer::Sptr& output, const Camera::Sptr& camera)
+{
+	Texture2D::Sptr inputColor = input->GetAttachment(RenderTargetAttachment::Color0);
+	Texture2D::Sptr inputDepth = input->GetAttachment(RenderTargetAttachment::DepthStencil);
+	Texture2D::Sptr inputNormal = input->GetAttachment(GBuffer::NORMAL);
+
+	if (inputNormal == nullptr)
+		inputNormal = inputColor;
+
+	if (inputDepth == nullptr)
+		inputDepth = input->GetAttachment(RenderTargetAttachment::Depth);
+
+	// copies the scene's depth so that the volumes can be depth tested against it.
+	input->Bind(RenderTargetBinding::Read);
+	FrameBuffer::Blit({ 0, 0, input->GetWidth(), input->GetHeight() },
+		{ 0, 0, output->GetWidth(), output->GetHeight() }, BufferFlags::Depth, MagFilter::Nearest);
+	input->UnBind();
+
+	// the output gets bound again, since unbinding the input may have changed the binding.
+	output->Bind(RenderTargetBinding::Draw);
+	glClear(GL_COLOR_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+	// sets the scene's pixels to black, leaving the clear colour in the background.
+	// the triangle is on the far plane, so it only passes where the scene is closer than the far plane.
+	GLState::Enable(GL_DEPTH_TEST);
+	GLState::DepthMask(false);
+	GLState::DepthFunc(useClearColor ? GL_GREATER : GL_ALWAYS);
+	GLState::Disable(GL_CULL_FACE);
+
+	baseShader->Bind();
+	GLState::BindVertexArray(volumes[SPHERE]->GetMesh()->GetVao());
+	glDrawArrays(GL_TRIANGLES, 0, 3);
+
+	if (!instances.empty())
+	{
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, LIGHT_VOLUME_BINDING, instanceBuffer);
+
+		// stencil marking. Both sides are drawn, and only the depth fails change the stencil.
+		GLState::DepthFunc(GL_LESS);
+		glEnable(GL_STENCIL_TEST);
+		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+		glStencilFunc(GL_ALWAYS, 0, 0xFF);
+		glStencilOpSeparate(GL_BACK, GL_KEEP, GL_INCR_WRAP, GL_KEEP);
+		glStencilOpSeparate(GL_FRONT, GL_KEEP, GL_DECR_WRAP, GL_KEEP);
+
+		stencilShader->Bind();
+		stencilShader->SetUniform("a_ViewProjection", camera->GetViewProjection());
+		DrawBatches(stencilShader);
+
+		// lighting. The back faces are used so that the volumes are still drawn when the camera is inside of them.
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+		glStencilFunc(GL_NOTEQUAL, 0, 0xFF);
+		glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+
+		GLState::Disable(GL_DEPTH_TEST);
+		GLState::Enable(GL_CULL_FACE);
+		glCullFace(GL_FRONT);
+		GLState::Enable(GL_BLEND);
+		GLState::BlendFuncSeparate(GL_ONE, GL_ONE, GL_ONE, GL_ONE);
+
+		volumeShader->Bind();
+
+		if (inputDepth != nullptr)
+			inputDepth->Bind(1);
+
+		if (inputNormal != nullptr)
+			inputNormal->Bind(2);
+
+		volumeShader->SetUniform("a_ViewProjection", camera->GetViewProjection());
+		volumeShader->SetUniform("a_ViewProjectionInv", glm::inverse(camera->GetViewProjection()));
+		volumeShader->SetUniform("a_CameraPos", camera->GetPosition());
+		volumeShader->SetUniform("a_ScreenRes", glm::vec2(output->GetWidth(), output->GetHeight()));
+		DrawBatches(volumeShader);
+
+		glCullFace(GL_BACK);
+		glDisable(GL_STENCIL_TEST);
+		GLState::Disable(GL_BLEND);
+	}
+
+	// the graph expects the depth test to be off between passes.
+	GLState::DepthMask(true);
+	GLState::DepthFunc(GL_LESS);
+	GLState::Enable(GL_CULL_FACE);
+	GLState::Disable(GL_DEPTH_TEST);
+}
+
+// draws the batches
+void cherry::LightVolumeLayer::DrawBatches(const Shader::Sptr& shader)
+{
+	for (int i = 0; i < VOLUME_TYPE_COUNT; i++)
+	{
+		if (counts[i] == 0)
+			continue;
+
+		shader->SetUniform("a_InstanceOffset", (int)offsets[i]);
+		volumes[i]->GetMesh()->DrawInstanced(counts[i]);
+	}
+}
@@ -0,0 +1,80 @@
+/*
+ * Team: Bonus Fruit:
+ * Description: deferred lighting that only shades the pixels inside each light's volume.
+	* every light is drawn as a sphere, cube, or cone that's scaled to its radius. The volumes of each type are drawn instanced.
+	* the volumes are first drawn into the stencil buffer against the scene's depth.
+		* back faces behind the scene increment the stencil, and front faces behind the scene decrement it.
+		* this leaves a non-zero stencil value only where the scene is inside a volume.
+	* the back faces are then drawn again with additive blending, only where the stencil isn't 0.
+	* since the volumes of a type are marked together, each light also checks its radius in the shader.
+ * References:
+	* https://ogldev.org/www/tutorial37/tutorial37.html
+	* https://www.khronos.org/opengl/wiki/Stencil_Test
+ */
+#pragma once
+#include "PostLayer.h"
+#include "..\lights\LightClusters.h"
+#include "..\objects\Primitive.h"
+
+// the light volume shaders
+#define LIGHT_VOLUME_VS ("res/shaders/post/light-volume.vs.glsl")
+#define LIGHT_VOLUME_FS ("res/shaders/post/light-volume.fs.glsl")
+#define LIGHT_VOLUME_STENCIL_FS ("res/shaders/post/light-volume-stencil.fs.glsl")
+#define LIGHT_VOLUME_BASE_VS ("res/shaders/post/light-volume-base.vs.glsl")
+#define LIGHT_VOLUME_BASE_FS ("res/shaders/post/light-volume-base.fs.glsl")
+
+// the storage buffer binding for the volumes (the light clusters use 0 - 2).
+#define LIGHT_VOLUME_BINDING 3
+
+namespace cherry
+{
+	// the light volume layer
+	class LightVolumeLayer : public PostLayer
+	{
+	public:
+		// the volume types, which match the volume types of the post lights.
+		enum VolumeType { SPHERE = 0, CUBE = 1, CONE = 2, VOLUME_TYPE_COUNT = 3 };
+
+		// loads the shaders and makes the volume meshes.
+		// if an output is provided, the lighting is drawn into it. Otherwise, a transient buffer is used.
+		LightVolumeLayer(const FrameBuffer::Sptr& output = nullptr);
+
+		// deletes the volume meshes and the storage buffer.
+		~LightVolumeLayer();
+
+		// sets the lights that will be drawn. The volume type of each light is in material.y.
+		// radii are clamped to the maximum so that lights with no attenuation don't cover everything.
+		void SetLights(const std::vector<ClusterLight>& lights, float maxRadius);
+
+		// gets the amount of lights of a given volume type.
+		uint32_t GetLightCount(VolumeType type) const;
+
+		// if 'true', the clear colour is kept for the background. If 'false', the background is black.
+		void SetUseClearColor(bool useClear);
+
+		// adds the volume pass, which reads the depth and normals from the input.
+		RenderGraph::Resource DeclarePasses(RenderGraph& graph, RenderGraph::Resource input) override;
+
+	private:
+		// draws the volumes into the output.
+		void DrawVolumes(const FrameBuffer::Sptr& input, const FrameBuffer::Sptr& output, const Camera::Sptr& camera);
+
+		// draws every batch of volumes with the bound shader.
+		void DrawBatches(const Shader::Sptr& shader);
+
+		Shader::Sptr volumeShader; // shades the pixels inside the volumes
+		Shader::Sptr stencilShader; // marks the stencil
+		Shader::Sptr baseShader; // sets the scene's pixels to black before the lights are added
+
+		Primitive* volumes[VOLUME_TYPE_COUNT]{ nullptr, nullptr, nullptr }; // the unit volumes
+
+		std::vector<ClusterLight> instances; // the lights, sorted by volume type
+		uint32_t offsets[VOLUME_TYPE_COUNT]{}; // where each type starts in the instances
+		uint32_t counts[VOLUME_TYPE_COUNT]{}; // the amount of each type
+
+		GLuint instanceBuffer = 0; // the storage buffer for the instances
+
+		FrameBuffer::Sptr output = nullptr;
+		bool useClearColor = true;
+	};
+}
@@ -6,6 +6,7 @@
 #define POST_FS ("res/shaders/post/post.fs.glsl")
 
 #include "FrameBuffer.h"
+#include "RenderGraph.h"
 #include "..\Shader.h"
 #include "..\Mesh.h"
 #include "..\Camera.h"
@@ -27,23 +28,39 @@ namespace cherry
 		// rendering the scene with depth may fail otherwise.
 		PostLayer(Shader::Sptr& shader, FrameBuffer::Sptr& output);
 
-		// adds a post processing layer with a default frame buffer.
+		// creates a post processing layer whose output is a transient buffer with the provided attachments.
+		PostLayer(Shader::Sptr& shader, const std::vector<RenderBufferDesc>& targets);
+
+		// destructor (virtual since layers can be derived from, such as the bloom layer).
+		virtual ~PostLayer() = default;
+
+		// adds a post processing layer with a default output (a transient colour buffer).
 		void AddLayer(const std::string vs, const std::string fs);
 
 		// adds a layer using the provided shader and frame buffer.
 		// colour and depth attachment are suggested for the frame buffer if it is the first pass.
 		void AddLayer(Shader::Sptr& shader, FrameBuffer::Sptr& output);
 
+		// adds a layer that writes to a transient buffer with the provided attachments.
+		// the buffer is taken from the render graph's pool when it's needed, so it's only kept while it's in use.
+		void AddLayer(Shader::Sptr& shader, const std::vector<RenderBufferDesc>& targets);
+
+		// resizes the frame buffers owned by this layer. Transient buffers are sized when they're declared.
 		virtual void OnWindowResize(uint32_t width, uint32_t height);
 
-		// renders the post layer
-		virtual void PostRender(const cherry::Camera::Sptr& camera);
+		// adds the passes for this layer to the render graph. The first pass reads from the input.
+		// if initialBuffer is set, it's used as the input instead.
+		// returns the resource written by the last pass.
+		virtual RenderGraph::Resource DeclarePasses(RenderGraph& graph, RenderGraph::Resource input);
 
 		// gets the shader form the last pass.
 		const cherry::Shader::Sptr& GetLastPassShader();
 
-		// gets the last pas from the buffer.
+		// gets the last pas from the buffer. This is a nullptr if the last pass writes to a transient buffer.
 		const FrameBuffer::Sptr& GetLastPassBuffer();
+
+		// gets how long the GPU took to run this layer's passes (in milliseconds). This is a few frames behind.
+		float GetGpuTime() const;
 		 
 		// the initial frame buffer for this layer's passes
 		// if left as a nullptr, it is set to the scene registry's mainbuffer
@@ -52,16 +69,21 @@ namespace cherry
 	protected:
 		// FrameBuffer::Sptr myMainFrameBuffer; // no longer needed
 
-		Mesh::Sptr myFullscreenQuad;
+		// Mesh::Sptr myFullscreenQuad; // moved to the render graph
 		
 		// post processing pass
+		// if the output is a nullptr, the pass writes to a transient buffer with the provided targets.
 		struct PostPass {
 			Shader::Sptr Shader;
 			FrameBuffer::Sptr Output;
+			std::vector<RenderBufferDesc> Targets;
 		};
 
 		// TODO: maybe make this a queue for algorithms GDW requirements?
 		std::vector<PostPass> myPasses;
+
+		// times the passes of this layer.
+		GpuTimer myTimer;
 	};
 
 }
\ No newline at end of file
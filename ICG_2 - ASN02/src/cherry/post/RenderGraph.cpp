@@ -0,0 +1,466 @@
+// RenderGraph - schedules post processing passes, and pools the frame buffers between them
+#include "RenderGraph.h"
+#include "GBuffer.h"
+#include "..\GLState.h"
+#include <toolkit/Logging.h>
+
+///////////////////////////////
+// FRAME BUFFER POOL
+// gets a buffer
+cherry::FrameBuffer::Sptr cherry::FrameBufferPool::Acquire(uint32_t width, uint32_t height, const std::vector<RenderBufferDesc>& targets)
+{
+	// looks for a free buffer that's the same.
+	for (Entry& entry : entries)
+	{
+		if (!entry.InUse && Matches(entry, width, height, targets))
+		{
+			entry.InUse = true;
+			entry.UnusedFrames = 0;
+			return entry.Buffer;
+		}
+	}
+
+	// no buffer was free, so a new one is made.
+	FrameBuffer::Sptr buffer = std::make_shared<FrameBuffer>(width, height);
+
+	for (const RenderBufferDesc& desc : targets)
+		buffer->AddAttachment(desc);
+
+	buffer->Validate();
+
+	entries.push_back({ buffer, width, height, targets, true, 0 });
+
+	return buffer;
+}
+
+// gives a buffer back
+void cherry::FrameBufferPool::Release(const FrameBuffer::Sptr& buffer)
+{
+	for (Entry& entry : entries)
+	{
+		if (entry.Buffer == buffer)
+		{
+			entry.InUse = false;
+			return;
+		}
+	}
+}
+
+// trims the pool
+void cherry::FrameBufferPool::Trim(uint32_t maxUnusedFrames)
+{
+	for (int i = entries.size() - 1; i >= 0; i--)
+	{
+		if (entries[i].InUse)
+			continue;
+
+		entries[i].UnusedFrames++;
+
+		if (entries[i].UnusedFrames > maxUnusedFrames)
+			entries.erase(entries.begin() + i);
+	}
+}
+
+// clears the free buffers
+void cherry::FrameBufferPool::Clear()
+{
+	for (int i = entries.size() - 1; i >= 0; i--)
+	{
+		if (!entries[i].InUse)
+			entries.erase(entries.begin() + i);
+	}
+}
+
+// buffer count
+size_t cherry::FrameBufferPool::GetBufferCount() const { return entries.size(); }
+
+// checks if an entry matches
+bool cherry::FrameBufferPool::Matches(const Entry& entry, uint32_t width, uint32_t height, const std::vector<RenderBufferDesc>& targets)
+{
+	if (entry.Width != width || entry.Height != height || entry.Targets.size() != targets.size())
+		return false;
+
+	for (size_t i = 0; i < targets.size(); i++)
+	{
+		if (entry.Targets[i].Attachment != targets[i].Attachment ||
+			entry.Targets[i].Format != targets[i].Format ||
+			entry.Targets[i].ShaderReadable != targets[i].ShaderReadable)
+			return false;
+	}
+
+	return true;
+}
+
+
+///////////////////////////////
+// RENDER GRAPH
+// constructor
+// the quad isn't made here, since the graph may be made before there's an OpenGL context.
+cherry::RenderGraph::RenderGraph()
+{
+}
+
+// resets the graph
+void cherry::RenderGraph::Reset()
+{
+	resources.clear();
+	passes.clear();
+	presented = NONE;
+	culledPasses = 0;
+	declaringTimer = nullptr;
+}
+
+// releases the graph
+void cherry::RenderGraph::Release()
+{
+	Reset();
+	pool.Clear();
+	myFullscreenQuad = nullptr;
+}
+
+// makes the quad that will be overlayed.
+void cherry::RenderGraph::__MakeFullscreenQuad()
+{
+	// making the vertices for the quad
+	Vertex* verts = new Vertex[4]
+	{
+		//  {nx, ny, nz}, {r, g, b, a}, {nx, ny, nz}, {u, v}
+		{{ -1.0F, -1.0F, 0.0f }, { 1.0F, 1.0F, 1.0F, 1.0F }, {0.0F, 0.0F, 1.0F}, {0.0F, 0.0F}}, // bottom left
+		{{  1.0F, -1.0F, 0.0f }, { 1.0F, 1.0F, 1.0F, 1.0F }, {0.0F, 0.0F, 1.0F}, {1.0F, 0.0F}}, // bottom right
+		{{ -1.0F,  1.0F, 0.0f }, { 1.0F, 1.0F, 1.0F, 1.0F }, {0.0F, 0.0F, 1.0F}, {0.0F, 1.0F}}, // top left
+		{{  1.0F,  1.0F, 0.0f }, { 1.0F, 1.0F, 1.0F, 1.0F }, {0.0F, 0.0F, 1.0F}, {1.0F, 1.0F}}, // top right
+	};
+
+	// making the indices for the quad
+	uint32_t* indices = new uint32_t[6]{
+		0, 1, 2,
+		2, 1, 3
+	};
+
+	// full screen quadrilateral
+	myFullscreenQuad = std::make_shared<cherry::Mesh>(verts, 4, indices, 6);
+
+	// deleting the vertices and indices
+	delete[] verts;
+	delete[] indices;
+}
+
+// imports a buffer
+cherry::RenderGraph::Resource cherry::RenderGraph::Import(const FrameBuffer::Sptr& buffer)
+{
+	if (buffer == nullptr)
+		return NONE;
+
+	// if the buffer was already imported, the same resource is used.
+	for (size_t i = 0; i < resources.size(); i++)
+	{
+		if (resources[i].Imported && resources[i].Buffer == buffer)
+			return (Resource)i;
+	}
+
+	resources.push_back({ buffer, true, buffer->GetWidth(), buffer->GetHeight(), {}, -1, -1 });
+	return (Resource)resources.size() - 1;
+}
+
+// creates a transient buffer
+cherry::RenderGraph::Resource cherry::RenderGraph::Create(uint32_t width, uint32_t height, const std::vector<RenderBufferDesc>& targets)
+{
+	resources.push_back({ nullptr, false, width, height, targets, -1, -1 });
+	return (Resource)resources.size() - 1;
+}
+
+// adds a pass
+void cherry::RenderGraph::AddPass(const Shader::Sptr& shader, Resource input, Resource output)
+{
+	AddPass(shader, input, NONE, output, nullptr);
+}
+
+// adds a pass with a second input
+void cherry::RenderGraph::AddPass(const Shader::Sptr& shader, Resource input, Resource secondInput, Resource output, const PassSetup& setup)
+{
+	if (shader == nullptr || input < 0 || output < 0 || input >= (Resource)resources.size() || output >= (Resource)resources.size() ||
+		secondInput < NONE || secondInput >= (Resource)resources.size())
+	{
+		LOG_ERROR("Render graph pass was given an invalid shader or resource.");
+		return;
+	}
+
+	passes.push_back({ shader, input, secondInput, output, setup, nullptr, declaringTimer, false });
+}
+
+// adds a custom pass
+void cherry::RenderGraph::AddCustomPass(Resource input, Resource output, const CustomPass& draw)
+{
+	if (!draw || input < 0 || output < 0 || input >= (Resource)resources.size() || output >= (Resource)resources.size())
+	{
+		LOG_ERROR("Render graph custom pass was given an invalid function or resource.");
+		return;
+	}
+
+	passes.push_back({ nullptr, input, NONE, output, nullptr, draw, declaringTimer, false });
+}
+
+// begins a timer
+void cherry::RenderGraph::BeginTimer(GpuTimer* timer) { declaringTimer = timer; }
+
+// ends a timer
+void cherry::RenderGraph::EndTimer() { declaringTimer = nullptr; }
+
+// presents a resource
+void cherry::RenderGraph::Present(Resource resource) { presented = resource; }
+
+// compiles the graph
+void cherry::RenderGraph::Compile()
+{
+	std::vector<bool> needed(resources.size(), false); // resources that something later depends on
+
+	culledPasses = 0;
+
+	if (presented >= 0 && presented < (Resource)resources.size())
+		needed[presented] = true;
+
+	// goes backwards from the presented resource. A pass is only kept if something needs what it writes.
+	for (int i = passes.size() - 1; i >= 0; i--)
+	{
+		PassInfo& pass = passes[i];
+
+		pass.Culled = !needed[pass.Output];
+
+		if (pass.Culled)
+		{
+			culledPasses++;
+			continue;
+		}
+
+		// the output is written here, so passes before this don't need to fill it.
+		// imported buffers are kept, since they may have been written to outside of the graph.
+		if (!resources[pass.Output].Imported)
+			needed[pass.Output] = false;
+
+		needed[pass.Input] = true;
+
+		if (pass.SecondInput != NONE)
+			needed[pass.SecondInput] = true;
+	}
+
+	// works out the lifetime of each resource. The lifetimes are pass indexes, which are ints.
+	for (int i = 0; i < (int)passes.size(); i++)
+	{
+		const PassInfo& pass = passes[i];
+
+		if (pass.Culled)
+			continue;
+
+		for (Resource res : { pass.Input, pass.SecondInput, pass.Output })
+		{
+			if (res == NONE)
+				continue;
+
+			if (resources[res].FirstUse < 0)
+				resources[res].FirstUse = i;
+
+			resources[res].LastUse = i;
+		}
+	}
+
+	// the presented resource is used after every pass.
+	if (presented >= 0 && presented < (Resource)resources.size())
+		resources[presented].LastUse = (int)passes.size();
+}
+
+// executes the graph
+void cherry::RenderGraph::Execute(const Camera::Sptr& camera, uint32_t screenWidth, uint32_t screenHeight)
+{
+	if (myFullscreenQuad == nullptr)
+		__MakeFullscreenQuad();
+
+	GpuTimer* timer = nullptr; // the timer that's running
+
+	GLState::Disable(GL_DEPTH_TEST);
+
+	for (int i = 0; i < (int)passes.size(); i++)
+	{
+		const PassInfo& pass = passes[i];
+
+		if (pass.Culled)
+			continue;
+
+		// switches timers if this pass belongs to a different one.
+		if (pass.Timer != timer)
+		{
+			if (timer != nullptr)
+				timer->End();
+
+			timer = pass.Timer;
+
+			if (timer != nullptr)
+				timer->Begin();
+		}
+
+		// transient buffers are taken from the pool on their first use.
+		for (Resource res : { pass.Input, pass.SecondInput, pass.Output })
+		{
+			if (res == NONE)
+				continue;
+
+			ResourceInfo& info = resources[res];
+
+			if (!info.Imported && info.FirstUse == i && info.Buffer == nullptr)
+				info.Buffer = pool.Acquire(info.Width, info.Height, info.Targets);
+		}
+
+		__DrawPass(pass, camera);
+
+		// transient buffers are given back after their last use, so a later pass can reuse them.
+		for (Resource res : { pass.Input, pass.SecondInput, pass.Output })
+		{
+			if (res == NONE)
+				continue;
+
+			ResourceInfo& info = resources[res];
+
+			if (!info.Imported && info.LastUse == i && info.Buffer != nullptr)
+			{
+				pool.Release(info.Buffer);
+				info.Buffer = nullptr;
+			}
+		}
+	}
+
+	if (timer != nullptr)
+		timer->End();
+
+	// Copies the image from the presented buffer into the default back buffer
+	if (presented >= 0 && presented < (Resource)resources.size() && resources[presented].Buffer != nullptr)
+	{
+		FrameBuffer::Sptr& buffer = resources[presented].Buffer;
+
+		// Bind the last buffer we wrote to as our source for read operations
+		buffer->Bind(RenderTargetBinding::Read);
+
+		FrameBuffer::Blit({ 0, 0, buffer->GetWidth(), buffer->GetHeight() },
+			{ 0, 0, screenWidth, screenHeight }, BufferFlags::All, MagFilter::Nearest);
+
+		// Unbind the last buffer from read operations, so we can write to it again later
+		buffer->UnBind();
+
+		if (!resources[presented].Imported)
+		{
+			pool.Release(buffer);
+			buffer = nullptr;
+		}
+	}
+
+	GLState::Enable(GL_DEPTH_TEST);
+
+	// buffers that haven't been used in a while are deleted.
+	pool.Trim();
+}
+
+// gets the pool
+cherry::FrameBufferPool& cherry::RenderGraph::GetPool() { return pool; }
+
+// gets the pass count
+size_t cherry::RenderGraph::GetPassCount() const { return passes.size(); }
+
+// gets the culled pass count
+size_t cherry::RenderGraph::GetCulledPassCount() const { return culledPasses; }
+
+// draws a pass
+void cherry::RenderGraph::__DrawPass(const PassInfo& pass, const Camera::Sptr& camera)
+{
+	const FrameBuffer::Sptr& input = resources[pass.Input].Buffer;
+	const FrameBuffer::Sptr& output = resources[pass.Output].Buffer;
+	Texture2D::Sptr inputColor = input->GetAttachment(RenderTargetAttachment::Color0);
+	Texture2D::Sptr inputDepth = input->GetAttachment(RenderTargetAttachment::Depth);
+	Texture2D::Sptr inputNormal = input->GetAttachment(GBuffer::NORMAL);
+	Texture2D::Sptr inputMaterial = input->GetAttachment(GBuffer::MATERIAL);
+
+	// the depth may be stored with the stencil instead.
+	if (inputDepth == nullptr)
+		inputDepth = input->GetAttachment(RenderTargetAttachment::DepthStencil);
+
+	// buffers that aren't g-buffers use the colour in place of the normal.
+	if (inputNormal == nullptr)
+		inputNormal = inputColor;
+
+	// getting the near and far planes.
+	float nearPlane = camera->IsPerspectiveCamera() ? camera->GetNearPerspective() : camera->GetNearOrthographic();
+	float farPlane = camera->IsPerspectiveCamera() ? camera->GetFarPerspective() : camera->GetFarOrthographic();
+
+	// the pass draws on its own.
+	if (pass.Custom)
+	{
+		output->Bind(RenderTargetBinding::Draw);
+		GLState::Viewport(0, 0, output->GetWidth(), output->GetHeight());
+
+		pass.Custom(input, output, camera);
+
+		output->UnBind();
+		return;
+	}
+
+	// We'll bind our post-processing output as the current render target and clear it
+	output->Bind(RenderTargetBinding::Draw);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // the original version only clears the colour buffer
+	// Set the viewport to be the entire size of the passes output
+	GLState::Viewport(0, 0, output->GetWidth(), output->GetHeight());
+
+	// Use the post processing shader to draw the fullscreen quad
+	pass.Shader->Bind();
+
+	if (inputColor != nullptr)
+		inputColor->Bind(0);
+
+	pass.Shader->SetUniform("xImage", 0);
+
+	// camera components for the shaders.
+	pass.Shader->SetUniform("a_View", camera->GetView());
+	pass.Shader->SetUniform("a_Projection", camera->GetProjection());
+	pass.Shader->SetUniform("a_ProjectionInv", glm::inverse(camera->GetProjection()));
+	pass.Shader->SetUniform("a_ViewProjection", camera->GetViewProjection());
+	pass.Shader->SetUniform("a_ViewProjectionInv", glm::inverse(camera->GetViewProjection()));
+
+	// this is supposed to be from the last pass, but these components don't change between passes.
+	pass.Shader->SetUniform("a_PrevView", camera->GetView());
+	pass.Shader->SetUniform("a_PrevProjection", camera->GetProjection());
+	pass.Shader->SetUniform("a_PrevProjectionInv", glm::inverse(camera->GetProjection()));
+	pass.Shader->SetUniform("a_PrevViewProjection", camera->GetViewProjection());
+	pass.Shader->SetUniform("a_PrevViewProjectionInv", glm::inverse(camera->GetViewProjection()));
+
+	// near and far plane
+	pass.Shader->SetUniform("a_NearPlane", nearPlane);
+	pass.Shader->SetUniform("a_FarPlane", farPlane);
+
+	// post processed lights
+	if (inputDepth != nullptr)
+		inputDepth->Bind(1);
+
+	if (inputNormal != nullptr)
+		inputNormal->Bind(2);
+
+	if (inputMaterial != nullptr)
+		inputMaterial->Bind(4);
+
+	pass.Shader->SetUniform("xScreenRes", glm::vec2(output->GetWidth(), output->GetHeight()));
+
+	// the second input
+	if (pass.SecondInput != NONE)
+	{
+		Texture2D::Sptr secondColor = resources[pass.SecondInput].Buffer->GetAttachment(RenderTargetAttachment::Color0);
+
+		if (secondColor != nullptr)
+			secondColor->Bind(3);
+
+		pass.Shader->SetUniform("xImage2", 3);
+	}
+
+	// uniforms that are specific to this pass.
+	if (pass.Setup)
+		pass.Setup(pass.Shader);
+
+	myFullscreenQuad->Draw();
+
+	// Unbind the output pass so that we can read from it
+	output->UnBind();
+}
@@ -0,0 +1,173 @@
+/*
+ * Team: Bonus Fruit:
+ * Description: render graph for post processing passes, and the pool for the frame buffers between them.
+	* passes declare the buffer they read from and the buffer they write to.
+	* passes that don't lead to the presented buffer are skipped.
+	* buffers that only exist between passes (transient buffers) are taken from a pool, and given back after their last use.
+	* since they're given back, buffers with the same size and attachments are shared by passes that don't overlap.
+	* a pass can read from a second buffer, which is bound to texture unit 3 as xImage2.
+	* if the input is a g-buffer, its normals are bound to texture unit 2, and its materials are bound to texture unit 4.
+ * References:
+	* https://www.khronos.org/opengl/wiki/Framebuffer_Object
+ */
+#pragma once
+#include "FrameBuffer.h"
+#include "..\Shader.h"
+#include "..\Mesh.h"
+#include "..\Camera.h"
+#include "..\GpuTimer.h"
+
+#include <vector>
+#include <functional>
+
+namespace cherry
+{
+	// a pool of frame buffers, which are matched by their size and attachments.
+	class FrameBufferPool
+	{
+	public:
+		// constructor
+		FrameBufferPool() = default;
+
+		// gets a free frame buffer that matches the size and attachments, or makes a new one if there are none.
+		FrameBuffer::Sptr Acquire(uint32_t width, uint32_t height, const std::vector<RenderBufferDesc>& targets);
+
+		// gives a frame buffer back to the pool so that it can be used again.
+		void Release(const FrameBuffer::Sptr& buffer);
+
+		// called once per frame. Free buffers that haven't been used for more than maxUnusedFrames are deleted.
+		// this is what removes buffers that are the wrong size after the window is resized.
+		void Trim(uint32_t maxUnusedFrames = 3);
+
+		// deletes all of the free buffers.
+		void Clear();
+
+		// gets the amount of buffers the pool is holding (free and in use).
+		size_t GetBufferCount() const;
+
+	private:
+		// a buffer in the pool
+		struct Entry
+		{
+			FrameBuffer::Sptr Buffer;
+			uint32_t Width;
+			uint32_t Height;
+			std::vector<RenderBufferDesc> Targets;
+			bool InUse;
+			uint32_t UnusedFrames;
+		};
+
+		// checks if an entry matches the provided size and attachments.
+		static bool Matches(const Entry& entry, uint32_t width, uint32_t height, const std::vector<RenderBufferDesc>& targets);
+
+		std::vector<Entry> entries;
+	};
+
+	// the render graph
+	class RenderGraph
+	{
+	public:
+		// a handle to a frame buffer in the graph.
+		typedef int Resource;
+
+		// an invalid resource.
+		static const Resource NONE = -1;
+
+		// called right before a pass is drawn, so that it can set uniforms that are different for each pass using the same shader.
+		typedef std::function<void(const Shader::Sptr&)> PassSetup;
+
+		// draws a pass that isn't a full screen quad. The output is bound for drawing before it's called, and depth testing is off.
+		typedef std::function<void(const FrameBuffer::Sptr& input, const FrameBuffer::Sptr& output, const Camera::Sptr& camera)> CustomPass;
+
+		// constructor
+		RenderGraph();
+
+		// clears all of the passes and resources so that the graph can be declared again.
+		void Reset();
+
+		// resets the graph, and deletes the pooled buffers and the quad.
+		void Release();
+
+		// adds a frame buffer that is owned outside of the graph. It's never returned to the pool.
+		Resource Import(const FrameBuffer::Sptr& buffer);
+
+		// adds a frame buffer that only exists for this frame. It's taken from the pool when it's first written to.
+		Resource Create(uint32_t width, uint32_t height, const std::vector<RenderBufferDesc>& targets);
+
+		// adds a full screen pass, which draws using the shader, reads from the input, and writes to the output.
+		void AddPass(const Shader::Sptr& shader, Resource input, Resource output);
+
+		// adds a full screen pass that also reads from a second input (NONE if not used).
+		// the setup function (if provided) is called after the shader is bound.
+		void AddPass(const Shader::Sptr& shader, Resource input, Resource secondInput, Resource output, const PassSetup& setup);
+
+		// adds a pass that does its own drawing, such as drawing meshes into the output.
+		void AddCustomPass(Resource input, Resource output, const CustomPass& draw);
+
+		// the passes added until EndTimer() is called are timed with the provided timer.
+		void BeginTimer(GpuTimer* timer);
+
+		// stops adding passes to the timer.
+		void EndTimer();
+
+		// sets the resource that gets copied to the screen once all of the passes are done.
+		void Present(Resource resource);
+
+		// skips the passes that aren't needed, and works out when each transient buffer is first and last used.
+		void Compile();
+
+		// runs the passes that weren't skipped, then copies the presented resource to the screen.
+		void Execute(const Camera::Sptr& camera, uint32_t screenWidth, uint32_t screenHeight);
+
+		// gets the pool used for the transient buffers.
+		FrameBufferPool& GetPool();
+
+		// gets the amount of passes that were declared.
+		size_t GetPassCount() const;
+
+		// gets the amount of passes that were skipped.
+		size_t GetCulledPassCount() const;
+
+	private:
+		// a frame buffer in the graph
+		struct ResourceInfo
+		{
+			FrameBuffer::Sptr Buffer; // the buffer (nullptr for transient buffers until they're acquired)
+			bool Imported;
+			uint32_t Width;
+			uint32_t Height;
+			std::vector<RenderBufferDesc> Targets;
+			int FirstUse; // the first pass that uses the resource
+			int LastUse; // the last pass that uses the resource
+		};
+
+		// a pass in the graph
+		struct PassInfo
+		{
+			Shader::Sptr Shader;
+			Resource Input;
+			Resource SecondInput; // NONE if there isn't one
+			Resource Output;
+			PassSetup Setup; // may be empty
+			CustomPass Custom; // if set, this is called instead of drawing the quad (the shader is nullptr)
+			GpuTimer* Timer; // may be nullptr
+			bool Culled;
+		};
+
+		// makes the quad that will be overlayed.
+		void __MakeFullscreenQuad();
+
+		// draws a single pass
+		void __DrawPass(const PassInfo& pass, const Camera::Sptr& camera);
+
+		std::vector<ResourceInfo> resources;
+		std::vector<PassInfo> passes;
+		Resource presented = NONE;
+		size_t culledPasses = 0;
+		GpuTimer* declaringTimer = nullptr; // the timer given to passes that are being added
+
+		FrameBufferPool pool; // the pool of transient buffers
+
+		Mesh::Sptr myFullscreenQuad = nullptr; // the quad drawn by every pass, which is made on the first execute.
+	};
+}
@@ -15,6 +15,24 @@ cherry::EngineScene::EngineScene(std::string sceneName) : GameplayScene(sceneNam
 {
 }
 
+// preloading the scene
+void cherry::EngineScene::OnPreload()
+{
+	// terrain
+	PreloadTexture("res/images/heightmaps/heightmap.bmp");
+	PreloadTexture("res/images/red.png");
+	PreloadTexture("res/images/green.png");
+	PreloadTexture("res/images/blue.png");
+
+	// images
+	PreloadTexture("res/images/bonus_fruit_logo_ss_sml.png");
+	PreloadTexture("res/images/codename_zero_logo.png");
+
+	// objects
+	PreloadObjFile("res/objects/charactoereee.obj");
+	PreloadObjFile("res/objects/hero pose one.obj");
+}
+
 void cherry::EngineScene::OnOpen()
 {
 	GameplayScene::OnOpen();
@@ -179,7 +197,7 @@ void cherry::EngineScene::OnOpen()
 	// material = LightManager::GetLightList(currentScene)->at(1).GenerateMaterial(sampler);
 	// replace the shader for the material if using morph tagets.
 	matStatic = lightList->GenerateMaterial(STATIC_VS, STATIC_FS, sampler);
-	matDynamic = lightList->GenerateMaterial(DYNAMIC_VS, DYNAMIC_FS, sampler);
+	matDynamic = lightList->GenerateMaterial(STATIC_VS, STATIC_FS, sampler, { MORPH_KEYWORD });
 
 
 	// loads in default sceneLists
@@ -193,35 +211,35 @@ void cherry::EngineScene::OnOpen()
 		  //sceneLists.at(sceneLists.size() - 1)->SetPosition(0.0F, 0.0F, 0.0F);
 
 		// Creating the sceneLists, storing them, and making them part of the default m_Scene.
-		objectList->objects.push_back(new PrimitiveCapsule());
+		objectList->AddObject(new PrimitiveCapsule());
 		objectList->objects.at(objectList->objects.size() - 1)->CreateEntity(game->GetCurrentSceneName(), matStatic);
 		objectList->objects.at(objectList->objects.size() - 1)->SetPosition(-offset, -offset, 0.0F);
 		
-		objectList->objects.push_back(new PrimitiveCircle());
+		objectList->AddObject(new PrimitiveCircle());
 		objectList->objects.at(objectList->objects.size() - 1)->CreateEntity(game->GetCurrentSceneName(), matStatic);
 		objectList->objects.at(objectList->objects.size() - 1)->SetPosition(-offset, 0.0f, 0.0F);
 		 
-		objectList->objects.push_back(new PrimitiveCone());
+		objectList->AddObject(new PrimitiveCone());
 		objectList->objects.at(objectList->objects.size() - 1)->CreateEntity(game->GetCurrentSceneName(), matStatic);
 		objectList->objects.at(objectList->objects.size() - 1)->SetPosition(-offset, offset, 0.0F);
 		 
-		objectList->objects.push_back(new PrimitiveCube());
+		objectList->AddObject(new PrimitiveCube());
 		objectList->objects.at(objectList->objects.size() - 1)->CreateEntity(game->GetCurrentSceneName(), matStatic);
 		objectList->objects.at(objectList->objects.size() - 1)->SetPosition(0.0F, -offset, 0.0F);
 		
-		objectList->objects.push_back(new PrimitiveCylinder());
+		objectList->AddObject(new PrimitiveCylinder());
 		objectList->objects.at(objectList->objects.size() - 1)->CreateEntity(game->GetCurrentSceneName(), matStatic);
 		objectList->objects.at(objectList->objects.size() - 1)->SetPosition(0.0F, 0.0F, 0.0F);
 		
-		objectList->objects.push_back(new PrimitiveDiamond());
+		objectList->AddObject(new PrimitiveDiamond());
 		objectList->objects.at(objectList->objects.size() - 1)->CreateEntity(game->GetCurrentSceneName(), matStatic);
 		objectList->objects.at(objectList->objects.size() - 1)->SetPosition(0.0F, offset, 0.0F);
 		
-		objectList->objects.push_back(new PrimitiveUVSphere());
+		objectList->AddObject(new PrimitiveUVSphere());
 		objectList->objects.at(objectList->objects.size() - 1)->CreateEntity(game->GetCurrentSceneName(), matStatic);
 		objectList->objects.at(objectList->objects.size() - 1)->SetPosition(offset, -offset, 0.0F);
 		
-		objectList->objects.push_back(new PrimitivePlane());
+		objectList->AddObject(new PrimitivePlane());
 		objectList->objects.at(objectList->objects.size() - 1)->CreateEntity(game->GetCurrentSceneName(), matStatic);
 		objectList->objects.at(objectList->objects.size() - 1)->SetPosition(offset, 0.0F, 0.0F);
 
@@ -323,7 +341,7 @@ void cherry::EngineScene::OnOpen()
 			image->AddAnimation(imgAnime, false);
 			image->SetVisible(true);
 
-			objectList->objects.push_back(image);
+			objectList->AddObject(image);
 			objectList->objects.at(objectList->GetObjectCount() - 1)->SetPosition(0.0F, 0.0F, 1.0F);
 			objectList->objects.at(objectList->GetObjectCount() - 1)->SetScale(0.01F);
 
@@ -356,8 +374,8 @@ void cherry::EngineScene::OnOpen()
 		}
 
 		// version 1 (finds .mtl file automatically)
-		objectList->objects.push_back(new Object("res/objects/charactoereee.obj", game->GetCurrentSceneName(),
-			lightList->GenerateMaterial(DYNAMIC_VS, DYNAMIC_FS, sampler), true, true));
+		objectList->AddObject(new Object("res/objects/charactoereee.obj", game->GetCurrentSceneName(),
+			lightList->GenerateMaterial(STATIC_VS, STATIC_FS, sampler, { MORPH_KEYWORD }), true, true));
 
 		// objectList->objects.push_back(new Object("res/objects/charactoereee.obj", currentScene,
 		// LightManager::GetSceneLightsMerged(currentScene)->GenerateMaterial(sampler), true, true));
@@ -415,7 +433,7 @@ void cherry::EngineScene::OnOpen()
 		//mph->AddFrame(new MorphAnimationFrame("res/sceneLists/cube_morph_target_1.obj", 2.0F));
 
 		// VER 2
-		objectList->objects.push_back(new Object("res/objects/hero pose one.obj", game->GetCurrentSceneName(), matDynamic, false, true));
+		objectList->AddObject(new Object("res/objects/hero pose one.obj", game->GetCurrentSceneName(), matDynamic, false, true));
 		objectList->objects.at(objectList->objects.size() - 1)->SetPosition(offset, offset, 0.0F);
 		//
 
@@ -626,7 +644,7 @@ void cherry::EngineScene::KeyPressed(GLFWwindow* window, int key)
 		break;
 	case GLFW_KEY_P:
 		if (hitBoxIndex >= 0 && hitBoxIndex < objectList->objects.size())
-			objectList->objects[hitBoxIndex]->followPath = !objectList->objects[hitBoxIndex]->followPath;
+			objectList->objects[hitBoxIndex]->UsePath(!objectList->objects[hitBoxIndex]->IsFollowingPath());
 	case GLFW_KEY_I:
 		if (hitBoxIndex >= 0 && hitBoxIndex < objectList->objects.size())
 		{
@@ -840,47 +858,19 @@ void cherry::EngineScene::Update(float deltaTime)
 
 
 	// collision calculations
-mainLoop:
-	for (cherry::Object* obj1 : objectList->objects) // object 1
-	{
-		if (obj1 == nullptr)
-			continue;
-
-		if (obj1->GetIntersection() == true) // already colliding with something.
-			continue;
+	// the bodies are copied at the start, then the pairs are tested on the worker threads.
+	narrowPhase.Run(objectList->objects);
 
-		for (cherry::Object* obj2 : objectList->objects) // object 2
-		{
-			if (obj1 == obj2 || obj2 == nullptr) // if the two sceneLists are the same.
-				continue;
-
-			if (obj2->GetIntersection() == true) // if the object is already intersecting with something.
-				continue;
+	for (const CollisionHit& hit : narrowPhase.GetHits())
+	{
+		const BodySnapshot& body1 = narrowPhase.GetSnapshots()[hit.First];
+		const BodySnapshot& body2 = narrowPhase.GetSnapshots()[hit.Second];
 
-			// gets the vectors from both sceneLists
-			std::vector<cherry::PhysicsBody*> pbods1 = obj1->GetPhysicsBodies();
-			std::vector<cherry::PhysicsBody*> pbods2 = obj2->GetPhysicsBodies();
+		if (body1.Object != nullptr)
+			body1.Object->SetIntersection(true);
 
-			// goes through each collision body
-			for (cherry::PhysicsBody* pb1 : pbods1)
-			{
-				for (cherry::PhysicsBody* pb2 : pbods2)
-				{
-					bool col = PhysicsBody::Collision(pb1, pb2);
-
-					if (col == true) // if collision has occurred.
-					{
-						obj1->SetIntersection(true);
-						// obj1->setColor(255, 0, 0);
-						obj2->SetIntersection(true);
-						// obj2->setColor(255, 0, 0);
-						// std::cout << "Hit!" << std::endl;
-
-						goto mainLoop; // goes back to the main loop
-					}
-				}
-			}
-		}
+		if (body2.Object != nullptr)
+			body2.Object->SetIntersection(true);
 	}
 
 }
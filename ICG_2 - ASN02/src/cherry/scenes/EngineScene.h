@@ -2,6 +2,7 @@
 #pragma once
 
 #include "GameplayScene.h"
+#include "..\physics\NarrowPhase.h"
 
 namespace cherry
 {
@@ -12,6 +13,9 @@ namespace cherry
 		// constructor
 		EngineScene(std::string sceneName);
 
+		// decodes the scene's images so that they don't need to be read from disk when the scene opens.
+		void OnPreload() override;
+
 		// loading the scene
 		void OnOpen() override;
 
@@ -66,6 +70,9 @@ namespace cherry
 		SamplerDesc description; // texture description 
 		TextureSampler::Sptr sampler; // texture sampler
 
+		// finds the collisions between the objects on the worker threads.
+		NarrowPhase narrowPhase;
+
 	protected:
 	};
 }
@@ -18,11 +18,107 @@ void cherry::Scene::OnClose()
 		delete layer;
 
 	layers.clear();
+
+	// the rigid bodies are made again when the scene is opened.
+	physicsWorld.Clear();
+
+	// the scene needs to be preloaded again before it's next opened.
+	ReleasePreloads();
+	preloaded = false;
+	preloadProgress = 0.0F;
+}
+
+// on preload
+void cherry::Scene::OnPreload()
+{
+}
+
+// preload step
+bool cherry::Scene::OnPreloadStep()
+{
+	// the .obj files don't need OpenGL, so they're all handed over at once.
+	for (std::pair<std::string, ObjFileData>& objFile : preloadObjFiles)
+	{
+		Object::AddPreloadedObjFile(objFile.first, std::move(objFile.second));
+		preloadObjFileNames.push_back(objFile.first);
+	}
+
+	preloadObjFiles.clear();
+
+	// all of the images have been loaded.
+	if (preloadImagesLoaded >= preloadImages.size())
+		return true;
+
+	Texture2DImage& image = preloadImages[preloadImagesLoaded];
+	const std::string fileName = image.FileName;
+	const bool alpha = image.Alpha;
+
+	Texture2D::Sptr texture = Texture2D::LoadFromImage(image);
+
+	if (texture != nullptr)
+	{
+		Texture2D::AddPreloadedTexture(fileName, alpha, texture);
+		preloadTextures.push_back(std::make_pair(fileName, alpha));
+	}
+
+	preloadImagesLoaded++;
+
+	// the images fill in the second half of the progress.
+	SetPreloadProgress(0.5F + 0.5F * (float)preloadImagesLoaded / (float)preloadImages.size());
+
+	return preloadImagesLoaded >= preloadImages.size();
+}
+
+// checks if the scene is preloaded.
+bool cherry::Scene::IsPreloaded() const { return preloaded; }
+
+// gets the preload progress
+float cherry::Scene::GetPreloadProgress() const { return preloadProgress; }
+
+// decodes an image for the preload
+void cherry::Scene::PreloadTexture(const std::string& fileName, bool loadAlpha)
+{
+	preloadImages.push_back(Texture2D::DecodeFile(fileName, loadAlpha));
+}
+
+// reads a .obj file for the preload
+void cherry::Scene::PreloadObjFile(const std::string& filePath)
+{
+	ObjFileData data;
+
+	if (Object::ParseObjFile(filePath, data))
+		preloadObjFiles.push_back(std::make_pair(filePath, std::move(data)));
+}
+
+// sets the preload progress
+void cherry::Scene::SetPreloadProgress(float progress) { preloadProgress = glm::clamp(progress, 0.0F, 1.0F); }
+
+// releases the preloaded textures and .obj files
+void cherry::Scene::ReleasePreloads()
+{
+	for (const std::string& objFile : preloadObjFileNames)
+		Object::RemovePreloadedObjFile(objFile);
+
+	preloadObjFiles.clear();
+	preloadObjFileNames.clear();
+
+	for (const std::pair<std::string, bool>& texture : preloadTextures)
+		Texture2D::RemovePreloadedTexture(texture.first, texture.second);
+
+	for (Texture2DImage& image : preloadImages)
+		Texture2D::FreeImage(image);
+
+	preloadTextures.clear();
+	preloadImages.clear();
+	preloadImagesLoaded = 0;
 }
 
 // returns the main/primary registry
 entt::registry& cherry::Scene::Registry() { return myRegistry; }
 
+// returns the physics world
+cherry::PhysicsWorld& cherry::Scene::GetPhysicsWorld() { return physicsWorld; }
+
 const std::string& cherry::Scene::GetName() const { return myName; }
 
 // returns 'true' if the frame buffer(s) are being used.
@@ -5,13 +5,21 @@
 #include <entt/entt.hpp>
 
 #include "..\textures/TextureCube.h"
+#include "..\textures/Texture2D.h"
 #include "..\Shader.h"
 #include "..\Mesh.h"
 #include "..\post/PostLayer.h"
+#include "..\objects/Object.h"
+#include "..\physics/PhysicsWorld.h"
 
 #include <GLFW/glfw3.h>
+#include <atomic>
+#include <vector>
+
 namespace cherry
 {
+	class SceneManager;
+
 	class Scene {
 	public:
 		TextureCube::Sptr Skybox = nullptr;
@@ -30,9 +38,30 @@ namespace cherry
 
 		virtual void OnClose();
 
+		// PRELOADING //
+		// called on a worker thread by SceneManager::PreloadScene(), before the scene is opened.
+		// there's no OpenGL context on the worker thread, so only CPU work can be done here (reading files, parsing, and decoding).
+		// images that OnOpen() uses can be decoded with PreloadTexture(), and .obj files can be read with PreloadObjFile().
+		virtual void OnPreload();
+
+		// called on the main thread once OnPreload() is finished, until 'true' is returned.
+		// each call should only do a small amount of GPU work, since it's called during the frame.
+		// by default, this hands the .obj files from PreloadObjFile() to the objects, then turns one image from PreloadTexture() into a texture each call.
+		virtual bool OnPreloadStep();
+
+		// returns 'true' if the scene has finished preloading. This is reset when the scene is closed.
+		bool IsPreloaded() const;
+
+		// gets the preload progress, which is in a [0, 1] range.
+		float GetPreloadProgress() const;
+
 		// returns the main/primary registry
 		entt::registry& Registry();
 
+		// returns the scene's physics world, which the game steps every update.
+		// the world is cleared when the scene is closed.
+		cherry::PhysicsWorld& GetPhysicsWorld();
+
 		const std::string& GetName() const;
 
 		// void SetName(const std::string& name);
@@ -74,15 +103,55 @@ namespace cherry
 
 
 	private:
+		// the scene manager runs the preloads.
+		friend class SceneManager;
+
 		entt::registry myRegistry; // registry
 
+		cherry::PhysicsWorld physicsWorld; // physics world
+
 		std::string myName; // name
 
+		// the images decoded by PreloadTexture(), which haven't been made into textures yet.
+		std::vector<Texture2DImage> preloadImages;
+
+		// the amount of images that have been made into textures.
+		size_t preloadImagesLoaded = 0;
+
+		// the textures that have been made from the preloaded images, which are given out by Texture2D::LoadFromFile().
+		std::vector<std::pair<std::string, bool>> preloadTextures;
+
+		// the .obj files read by PreloadObjFile(), which haven't been handed to the objects yet.
+		std::vector<std::pair<std::string, ObjFileData>> preloadObjFiles;
+
+		// the .obj files that have been handed to the objects (see Object::AddPreloadedObjFile()).
+		std::vector<std::string> preloadObjFileNames;
+
+		// 'true' once the preload is done.
+		std::atomic<bool> preloaded{ false };
+
+		// the preload progress
+		std::atomic<float> preloadProgress{ 0.0F };
+
 	protected:
 
 		// tells the scene to use (or not use) its frame buffers.
 		void SetUsingFrameBuffers(bool useFbs);
 
+		// decodes an image so that Texture2D::LoadFromFile() can use it once the scene is opened. Only call this in OnPreload().
+		void PreloadTexture(const std::string& fileName, bool loadAlpha = true);
+
+		// reads a .obj file so that the objects made from it in OnOpen() don't read the file again. Only call this in OnPreload().
+		void PreloadObjFile(const std::string& filePath);
+
+		// sets the preload progress, which should be in a [0, 1] range. This can be called from OnPreload().
+		// by default, the progress goes to 0.5 once OnPreload() is done, and the preloaded images fill in the rest.
+		void SetPreloadProgress(float progress);
+
+		// stops Texture2D::LoadFromFile() and the objects from using the preloaded textures and .obj files, and frees any images that weren't used.
+		// this is called by the scene manager once the scene has been opened.
+		void ReleasePreloads();
+
 		// TODO: set it to use the frame buffer.
 		// if 'true', then the game renders to the frame buffer.
 		bool useFrameBuffers = false;
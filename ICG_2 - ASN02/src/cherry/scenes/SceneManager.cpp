@@ -1,9 +1,12 @@
 // SceneManager - Manages Scenes
 #include "SceneManager.h"
 #include<toolkit/Logging.h>
+#include <chrono>
+#include <stdexcept>
 
 cherry::Scene* cherry::SceneManager::_CurrentScene = nullptr;
 std::unordered_map<std::string, cherry::Scene*> cherry::SceneManager::_KnownScenes;
+std::unordered_map<std::string, std::future<void>> cherry::SceneManager::_Preloads;
 entt::registry cherry::SceneManager::Prefabs;
 
 cherry::Scene* cherry::SceneManager::Current() {
@@ -30,11 +33,18 @@ bool cherry::SceneManager::SetCurrentScene(const std::string& name) {
 	if (it != _KnownScenes.end()) {
 		if (_CurrentScene != it->second) {
 			
+			// if the scene is being preloaded, the preload is finished first so that it isn't running while the scene opens.
+			if (IsPreloading(name))
+				__StepPreload(name, -1.0, true);
+
 			// this would be null if it's the first time we're making the m_Scene. We don't want to close null.
 			if (_CurrentScene != nullptr)
 				_CurrentScene->OnClose();
 			_CurrentScene = it->second;
 			_CurrentScene->OnOpen();
+
+			// the preloaded textures now belong to the scene's materials, and the preloaded .obj files are in its objects.
+			_CurrentScene->ReleasePreloads();
 		}
 		return true;
 	}
@@ -80,9 +90,107 @@ cherry::SceneManager::SceneIterator cherry::SceneManager::Each() { return SceneI
 
 // interates over every m_Scene and deletes it.
 void cherry::SceneManager::DestroyScenes() {
+	// waits for the worker threads before the scenes are deleted.
+	for (auto& kvp : _Preloads) {
+		if (kvp.second.valid())
+			kvp.second.wait();
+	}
+	_Preloads.clear();
+
 	for (auto& kvp : _KnownScenes) {
+		kvp.second->ReleasePreloads();
 		delete kvp.second;
 	}
 	_KnownScenes.clear();
 	_CurrentScene = nullptr;
-}
\ No newline at end of file
+}
+
+// starts preloading a scene
+bool cherry::SceneManager::PreloadScene(const std::string& name)
+{
+	Scene* scene = Get(name);
+
+	// the scene doesn't exist, or doesn't need to be preloaded.
+	if (scene == nullptr || scene == _CurrentScene || scene->IsPreloaded() || IsPreloading(name))
+		return false;
+
+	scene->ReleasePreloads();
+	scene->SetPreloadProgress(0.0F);
+
+	// the CPU work is done on a worker thread.
+	_Preloads[name] = std::async(std::launch::async, [scene]() { scene->OnPreload(); });
+
+	return true;
+}
+
+// checks if a scene is being preloaded.
+bool cherry::SceneManager::IsPreloading(const std::string& name) { return _Preloads.find(name) != _Preloads.end(); }
+
+// updates the preloads
+void cherry::SceneManager::UpdatePreloads(float timeBudget)
+{
+	const double endTime = glfwGetTime() + timeBudget;
+
+	// the names are copied, since finished preloads are removed from the map.
+	std::vector<std::string> names;
+
+	for (auto& kvp : _Preloads)
+		names.push_back(kvp.first);
+
+	for (const std::string& name : names)
+	{
+		if (glfwGetTime() >= endTime)
+			break;
+
+		__StepPreload(name, endTime, false);
+	}
+}
+
+// runs the preload steps for a scene.
+bool cherry::SceneManager::__StepPreload(const std::string& name, double endTime, bool wait)
+{
+	auto it = _Preloads.find(name);
+	Scene* scene = Get(name);
+
+	if (it == _Preloads.end() || scene == nullptr)
+		return true;
+
+	std::future<void>& work = it->second;
+
+	// the worker thread is finished with.
+	if (work.valid())
+	{
+		if (!wait && work.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+			return false;
+
+		// if OnPreload() threw an exception, the scene can still load everything when it's opened.
+		try
+		{
+			work.get();
+		}
+		catch (const std::exception& e)
+		{
+			LOG_ERROR("Preloading scene \"{}\" failed: {}", name, e.what());
+		}
+
+		if (scene->GetPreloadProgress() < 0.5F)
+			scene->SetPreloadProgress(0.5F);
+	}
+
+	// the GPU work is done on the main thread, a step at a time. A negative end time means there's no limit.
+	bool done = false;
+
+	do
+	{
+		done = scene->OnPreloadStep();
+	} while (!done && (endTime < 0.0 || glfwGetTime() < endTime));
+
+	if (done)
+	{
+		scene->SetPreloadProgress(1.0F);
+		scene->preloaded = true;
+		_Preloads.erase(it);
+	}
+
+	return done;
+}
@@ -2,6 +2,10 @@
 #pragma once
 #include "Scene.h"
 #include <unordered_map>
+#include <future>
+
+// the amount of time (in seconds) that the preloads can use on the main thread each frame.
+#define SCENE_PRELOAD_BUDGET 0.004F
 
 
 namespace cherry
@@ -37,10 +41,28 @@ namespace cherry
 
 		static void DestroyScenes();
 
+		// starts preloading a registered scene. Its OnPreload() is run on a worker thread, and its OnPreloadStep() is run by UpdatePreloads().
+		// a 'false' is returned if the scene doesn't exist, is already being preloaded, or has already been preloaded.
+		static bool PreloadScene(const std::string& name);
+
+		// returns 'true' if the scene is being preloaded.
+		static bool IsPreloading(const std::string& name);
+
+		// continues the preloads. This must be called on the main thread, and should be called once per frame.
+		// the scenes' OnPreloadStep() functions are called until they're done, or until the time budget (in seconds) is used up.
+		static void UpdatePreloads(float timeBudget = SCENE_PRELOAD_BUDGET);
+
 		static entt::registry Prefabs;
 	private:
+		// runs the preload steps for a scene until they're done or the time runs out. Returns 'true' if the preload is done.
+		// if 'wait' is true, the worker thread is waited on if it isn't finished.
+		static bool __StepPreload(const std::string& name, double endTime, bool wait);
+
 		static Scene* _CurrentScene;
 		static std::unordered_map<std::string, Scene*> _KnownScenes;
+
+		// the worker threads for the scenes being preloaded. The future is made invalid once the worker thread has been finished.
+		static std::unordered_map<std::string, std::future<void>> _Preloads;
 	};
 
 	// We can make some macros to shorten our calls
@@ -1,12 +1,18 @@
 #include "Texture2D.h"
+#include "..\GLState.h"
 #include <toolkit/Logging.h>
 #include <stbs/stb_image.h> // single header file for image loading
 #include <GLM/gtc/integer.hpp> // integer mapping
 #include <GLM/gtc/type_ptr.hpp>
+#include <vector>
+#include <string.h>
 
 // the maixmum number of samples
 uint32_t cherry::Texture2D::MaxNumSamples = 1;
 
+// the preloaded textures
+std::map<std::pair<std::string, bool>, cherry::Texture2D::Sptr> cherry::Texture2D::preloadedTextures;
+
 cherry::Texture2D::Texture2D(const Texture2DDescription& desc) {
 	myDescription = desc;
 	myTextureHandle = 0; // checked later in case the project breaks and goes crazy.
@@ -15,6 +21,7 @@ cherry::Texture2D::Texture2D(const Texture2DDescription& desc) {
 
 // deletes the texture
 cherry::Texture2D::~Texture2D() {
+	GLState::ForgetTexture(myTextureHandle);
 	glDeleteTextures(1, &myTextureHandle);
 }
 
@@ -64,13 +71,13 @@ void cherry::Texture2D::__SetupTexture() {
 void cherry::Texture2D::Bind(int slot) const {
 	// Bind to the given texture slot. OpenGL 4 guarantees that we have at least 80 texture slots.
 	// Note that this is part of Direct State Access added in 4.5, replacing the old glActiveTexture and glBindTexture calls.
-	glBindTextureUnit(slot, myTextureHandle);
+	GLState::BindTextureUnit(slot, myTextureHandle);
 }
 
 
 void cherry::Texture2D::UnBind(int slot) {
 	// Binding zero to a texture slot will unbind the texture
-	glBindTextureUnit(slot, 0);
+	GLState::BindTextureUnit(slot, 0);
 }
 
 void cherry::Texture2D::LoadData(void* data, size_t width, size_t height, PixelFormat format, PixelType type) {
@@ -89,36 +96,79 @@ void cherry::Texture2D::LoadData(void* data, size_t width, size_t height, PixelF
 		glGenerateTextureMipmap(myTextureHandle);
 }
 
+// uploads data to part of the texture
+void cherry::Texture2D::LoadSubData(void* data, size_t x, size_t y, size_t width, size_t height, PixelFormat format, PixelType type)
+{
+	LOG_ASSERT(x + width <= myDescription.Width, "Region goes past the width of this texture!");
+	LOG_ASSERT(y + height <= myDescription.Height, "Region goes past the height of this texture!");
+
+	glTextureSubImage2D(myTextureHandle, 0, x, y, width, height, (GLenum)format, (GLenum)type, data);
+}
+
 // loads in the texture from a file.
 cherry::Texture2D::Sptr cherry::Texture2D::LoadFromFile(const std::string& fileName, bool loadAlpha) {
 
+	// the file was already loaded by a scene preload.
+	std::map<std::pair<std::string, bool>, Sptr>::iterator iter = preloadedTextures.find(std::make_pair(fileName, loadAlpha));
+
+	if (iter != preloadedTextures.end())
+		return iter->second;
+
+	Texture2DImage image = DecodeFile(fileName, loadAlpha);
+	return LoadFromImage(image);
+}
+
+// decodes the file
+cherry::Texture2DImage cherry::Texture2D::DecodeFile(const std::string& fileName, bool loadAlpha)
+{
+	Texture2DImage image;
+	image.FileName = fileName;
+	image.Alpha = loadAlpha;
+
 	// tells the file, the size, and the number of channel.
-	int width, height, numChannels;
-	void* data = stbi_load(fileName.c_str(), &width, &height, &numChannels, loadAlpha ? 4 : 3);
-	if (data != nullptr && width != 0 && height != 0 && numChannels != 0) {
+	int numChannels = 0;
+	image.Data = stbi_load(fileName.c_str(), &image.Width, &image.Height, &numChannels, loadAlpha ? 4 : 3);
+
+	// the file couldn't be used.
+	if (image.Data != nullptr && (image.Width == 0 || image.Height == 0 || numChannels == 0))
+		FreeImage(image);
+
+	if (image.Data != nullptr)
+		FlipImage(image.Data, image.Width, image.Height, loadAlpha ? 4 : 3);
+
+	return image;
+}
+
+// loads the decoded image
+cherry::Texture2D::Sptr cherry::Texture2D::LoadFromImage(Texture2DImage& image)
+{
+	if (image.Data != nullptr) {
 		
 		// endif //!_DEBUG
 		Texture2DDescription desc = Texture2DDescription();
-		desc.Width = width;
-		desc.Height = height;
+		desc.Width = image.Width;
+		desc.Height = image.Height;
 
 		// checks to see if the texture is small enough to be loaded. If it isn't, a runtime error is thrown.
 		// ifndef _DEBUG (TODO: add debug wrappers)
-		if (width > GetMaximumSideLength() || height > GetMaximumSideLength())
+		if (image.Width > GetMaximumSideLength() || image.Height > GetMaximumSideLength())
+		{
+			FreeImage(image);
 			throw std::runtime_error("Texture too large to load into memory.");
+		}
 
 		// format differs based on whether we loaded the alpha or not.
-		desc.Format = loadAlpha ? InternalFormat::RGBA8 : InternalFormat::RGB8;
+		desc.Format = image.Alpha ? InternalFormat::RGBA8 : InternalFormat::RGB8;
 		Sptr result = std::make_shared<Texture2D>(desc); // if the texture is too large, the texture loader throws an error here.
-		result->LoadData(data, width, height, loadAlpha ? PixelFormat::Rgba : PixelFormat::Rgb, PixelType::UByte);
+		result->LoadData(image.Data, image.Width, image.Height, image.Alpha ? PixelFormat::Rgba : PixelFormat::Rgb, PixelType::UByte);
 
 		// image files take up a lot of data, so we call this to clean up the data once it's on our GPU.
-		stbi_image_free(data);
+		FreeImage(image);
 		return result;
 	}
 	else {
 		// not throwing exceptions since we can't use the file, but for now we just have a warning.
-		LOG_WARN("Failed to load image from \"{}\"", fileName);
+		LOG_WARN("Failed to load image from \"{}\"", image.FileName);
 
 //#ifndef _DEBUG
 //		return LoadFromFile("res/images/default.png", loadAlpha);
@@ -128,6 +178,43 @@ cherry::Texture2D::Sptr cherry::Texture2D::LoadFromFile(const std::string& fileN
 	}
 }
 
+// frees the image
+void cherry::Texture2D::FreeImage(Texture2DImage& image)
+{
+	if (image.Data != nullptr)
+		stbi_image_free(image.Data);
+
+	image.Data = nullptr;
+}
+
+// flips the rows of an image
+void cherry::Texture2D::FlipImage(void* data, int width, int height, int channels)
+{
+	const size_t rowSize = (size_t)width * channels;
+	std::vector<unsigned char> row(rowSize);
+	unsigned char* bytes = (unsigned char*)data;
+
+	for (int top = 0, bottom = height - 1; top < bottom; top++, bottom--)
+	{
+		memcpy(row.data(), bytes + top * rowSize, rowSize);
+		memcpy(bytes + top * rowSize, bytes + bottom * rowSize, rowSize);
+		memcpy(bytes + bottom * rowSize, row.data(), rowSize);
+	}
+}
+
+// adds a preloaded texture
+void cherry::Texture2D::AddPreloadedTexture(const std::string& fileName, bool loadAlpha, const Sptr& texture)
+{
+	if (texture != nullptr)
+		preloadedTextures[std::make_pair(fileName, loadAlpha)] = texture;
+}
+
+// removes a preloaded texture
+void cherry::Texture2D::RemovePreloadedTexture(const std::string& fileName, bool loadAlpha)
+{
+	preloadedTextures.erase(std::make_pair(fileName, loadAlpha));
+}
+
 // returns the limit on the width of the texture.
 int cherry::Texture2D::GetMaximumSideLength()
 {
@@ -3,6 +3,7 @@
 // #include <glad\glad.h>
 #include <memory>
 #include <string>
+#include <map>
 #include <toolkit/EnumToString.h>
 
 #include "..\UtilsCRY.h" // including macros
@@ -63,6 +64,16 @@ namespace cherry
 		SamplerDesc Sampler = SamplerDesc();
 	};
 
+	// an image that has been decoded from a file, but hasn't been sent to the GPU.
+	// this is made by Texture2D::DecodeFile(), which can be called on a thread without an OpenGL context.
+	struct Texture2DImage {
+		std::string FileName = "";
+		void* Data = nullptr; // freed by Texture2D::LoadFromImage() (or Texture2D::FreeImage() if it's not used).
+		int Width = 0;
+		int Height = 0;
+		bool Alpha = false;
+	};
+
 	// Represents a 2D texture in OpenGL.
 	// TODO: currently ITexture does nothing.
 	class Texture2D : public cherry::ITexture
@@ -78,6 +89,10 @@ namespace cherry
 		// handles uploading data to the GPU
 		void LoadData(void* data, size_t width, size_t height, PixelFormat format, PixelType type);
 
+		// uploads data to a region of the texture, starting at (x, y). The rest of the texture keeps its data.
+		// this doesn't regenerate the mipmaps.
+		void LoadSubData(void* data, size_t x, size_t y, size_t width, size_t height, PixelFormat format, PixelType type);
+
 		// overriding the version in ITexture
 		// void Bind(uint32_t slot) override;
 
@@ -87,8 +102,30 @@ namespace cherry
 		static void UnBind(int slot);
 
 		// loading from the file so that we don't have to manually apply a texture.
+		// if the file has been preloaded (see AddPreloadedTexture()), the preloaded texture is returned instead.
 		static Sptr LoadFromFile(const std::string& fileName, bool loadAlpha = true);
 
+		// decodes an image file without using OpenGL, so that it can be done on a worker thread.
+		// if the file couldn't be decoded, the image's data is a nullptr.
+		static Texture2DImage DecodeFile(const std::string& fileName, bool loadAlpha = true);
+
+		// creates a texture using a decoded image, and then frees the image data. This must be called on the main thread.
+		// a nullptr is returned if the image has no data.
+		static Sptr LoadFromImage(Texture2DImage& image);
+
+		// frees the data of a decoded image that won't be loaded.
+		static void FreeImage(Texture2DImage& image);
+
+		// flips the rows of decoded image data, so that the first row is the bottom of the image (which is what OpenGL expects).
+		// stb_image's own flip setting is shared by every thread, so images are flipped with this after they're decoded instead.
+		static void FlipImage(void* data, int width, int height, int channels);
+
+		// adds a texture that LoadFromFile() returns for the file, rather than loading the file again.
+		static void AddPreloadedTexture(const std::string& fileName, bool loadAlpha, const Sptr& texture);
+
+		// removes a preloaded texture, so that LoadFromFile() loads the file again.
+		static void RemovePreloadedTexture(const std::string& fileName, bool loadAlpha);
+
 		// gets the limit on the width of the texture. This is the same as the height.
 		// this is based on the GPU of the user.
 		static int GetMaximumSideLength();
@@ -108,5 +145,8 @@ namespace cherry
 
 		// the maximum number of samples
 		static uint32_t MaxNumSamples;
+
+		// the preloaded textures, which are found by their file name and if they have alpha.
+		static std::map<std::pair<std::string, bool>, Sptr> preloadedTextures;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,278 @@
+// TextureAtlas (Source) - packs small images into shared texture pages, so that they can be drawn together.
+#include "TextureAtlas.h"
+#include "..\ShaderCache.h"
+#include "..\HotReload.h"
+
+#include <toolkit/Logging.h>
+#include <algorithm>
+#include <string.h>
+
+std::vector<cherry::TextureAtlas::Page> cherry::TextureAtlas::pages;
+std::unordered_map<std::string, cherry::AtlasRegion> cherry::TextureAtlas::regions;
+
+// adds an image to the atlas
+bool cherry::TextureAtlas::Add(const std::string& filePath, AtlasRegion& region)
+{
+	std::string path = HotReload::NormalizePath(filePath);
+
+	// already in the atlas
+	{
+		std::unordered_map<std::string, AtlasRegion>::iterator iter = regions.find(path);
+
+		if (iter != regions.end())
+		{
+			region = iter->second;
+			return true;
+		}
+	}
+
+	Texture2DImage image = Texture2D::DecodeFile(filePath, true);
+
+	// couldn't be decoded.
+	if (image.Data == nullptr)
+		return false;
+
+	// the image is too large, so it should get its own texture.
+	if (image.Width > TEXTURE_ATLAS_MAX_SIDE || image.Height > TEXTURE_ATLAS_MAX_SIDE)
+	{
+		Texture2D::FreeImage(image);
+		return false;
+	}
+
+	// the size of the image with the padding around it.
+	const uint32_t width = image.Width + TEXTURE_ATLAS_PADDING * 2;
+	const uint32_t height = image.Height + TEXTURE_ATLAS_PADDING * 2;
+
+	glm::u32vec2 position;
+	bool packed = false;
+
+	// tries the existing pages before making a new one.
+	for (size_t i = 0; i < pages.size() && !packed; i++)
+	{
+		if (__Pack(pages[i], width, height, position))
+		{
+			region.Page = (int)i;
+			packed = true;
+		}
+	}
+
+	if (!packed)
+	{
+		__AddPage();
+		__Pack(pages.back(), width, height, position);
+		region.Page = (int)pages.size() - 1;
+	}
+
+	// copies the image into the padded space. The pixels in the padding take the colour of the closest edge pixel.
+	std::vector<uint8_t> pixels(width * height * 4);
+	const uint8_t* src = (const uint8_t*)image.Data;
+
+	for (uint32_t y = 0; y < height; y++)
+	{
+		int srcY = glm::clamp((int)y - TEXTURE_ATLAS_PADDING, 0, image.Height - 1);
+
+		for (uint32_t x = 0; x < width; x++)
+		{
+			int srcX = glm::clamp((int)x - TEXTURE_ATLAS_PADDING, 0, image.Width - 1);
+
+			memcpy(&pixels[(y * width + x) * 4], &src[(srcY * image.Width + srcX) * 4], 4);
+		}
+	}
+
+	pages[region.Page].Texture->LoadSubData(pixels.data(), position.x, position.y, width, height, PixelFormat::Rgba, PixelType::UByte);
+
+	region.Position = position + glm::u32vec2(TEXTURE_ATLAS_PADDING);
+	region.Size = glm::u32vec2(image.Width, image.Height);
+
+	Texture2D::FreeImage(image);
+
+	regions[path] = region;
+	return true;
+}
+
+// checks if the file is in the atlas
+bool cherry::TextureAtlas::Contains(const std::string& filePath)
+{
+	return regions.find(HotReload::NormalizePath(filePath)) != regions.end();
+}
+
+// converts the uvs to page uvs
+glm::vec4 cherry::TextureAtlas::ConvertToPageUVs(const AtlasRegion& region, const glm::vec4& uvs)
+{
+	const float pageSize = (float)TEXTURE_ATLAS_PAGE_SIZE;
+
+	// the start and size of the region in page uvs.
+	glm::vec2 start = glm::vec2(region.Position) / pageSize;
+	glm::vec2 size = glm::vec2(region.Size) / pageSize;
+
+	return glm::vec4(
+		start.x + uvs.x * size.x,
+		start.y + uvs.y * size.y,
+		start.x + uvs.z * size.x,
+		start.y + uvs.w * size.y
+	);
+}
+
+// gets the page texture
+cherry::Texture2D::Sptr cherry::TextureAtlas::GetPageTexture(int page)
+{
+	return (page >= 0 && page < (int)pages.size()) ? pages[page].Texture : nullptr;
+}
+
+// gets the page material
+cherry::Material::Sptr cherry::TextureAtlas::GetPageMaterial(int page)
+{
+	return (page >= 0 && page < (int)pages.size()) ? pages[page].Material : nullptr;
+}
+
+// gets the amount of pages
+size_t cherry::TextureAtlas::GetPageCount() { return pages.size(); }
+
+// gets the amount of images
+size_t cherry::TextureAtlas::GetImageCount() { return regions.size(); }
+
+// deletes the pages
+void cherry::TextureAtlas::Clear()
+{
+	pages.clear();
+	regions.clear();
+}
+
+// adds a page
+void cherry::TextureAtlas::__AddPage()
+{
+	Page page;
+
+	// the pages don't have mipmaps, since the smaller levels would blend the images together.
+	Texture2DDescription desc = Texture2DDescription();
+	desc.Width = TEXTURE_ATLAS_PAGE_SIZE;
+	desc.Height = TEXTURE_ATLAS_PAGE_SIZE;
+	desc.Format = InternalFormat::RGBA8;
+	desc.Sampler.MinFilter = MinFilter::Linear;
+	desc.Sampler.MagFilter = MagFilter::Linear;
+
+	page.Texture = std::make_shared<Texture2D>(desc);
+
+	// clears the page so that the unused space is transparent.
+	std::vector<uint8_t> empty(TEXTURE_ATLAS_PAGE_SIZE * TEXTURE_ATLAS_PAGE_SIZE * 4, 0);
+	page.Texture->LoadData(empty.data(), TEXTURE_ATLAS_PAGE_SIZE, TEXTURE_ATLAS_PAGE_SIZE, PixelFormat::Rgba, PixelType::UByte);
+
+	SamplerDesc description = SamplerDesc();
+	description.MinFilter = MinFilter::Linear;
+	description.MagFilter = MagFilter::Linear;
+
+	TextureSampler::Sptr sampler = std::make_shared<TextureSampler>(description);
+
+	// the same material that an image uses. The alpha of each image is stored in its vertex colours instead of a_Alpha.
+	page.Material = std::make_shared<Material>(ShaderCache::Get("res/shaders/image.vs.glsl", "res/shaders/image.fs.glsl"));
+	page.Material->Set("s_Albedos[0]", page.Texture, sampler);
+	page.Material->Set("s_Albedos[1]", page.Texture, sampler);
+	page.Material->Set("s_Albedos[2]", page.Texture, sampler);
+	page.Material->Set("a_Alpha", 1.0F);
+	page.Material->HasTransparency = true;
+
+	// the sprite batch gives each sprite its frame, so batched images can be animated without changing their vertices.
+	if (!page.Material->SetKeyword(TEXTURE_ATLAS_KEYWORD, true))
+		LOG_WARN("The batched image shader couldn't be used for texture atlas page {}.", pages.size());
+
+	// the skyline starts as a single segment along the bottom of the page.
+	page.Skyline.push_back(SkylineNode{ 0, 0, TEXTURE_ATLAS_PAGE_SIZE });
+
+	pages.push_back(page);
+
+	LOG_TRACE("Texture atlas page {} created.", pages.size() - 1);
+}
+
+// checks if the rectangle fits at the node
+bool cherry::TextureAtlas::__FitsAt(const Page& page, size_t node, uint32_t width, uint32_t height, uint32_t& y)
+{
+	uint32_t x = page.Skyline[node].X;
+
+	// goes past the right side of the page.
+	if (x + width > TEXTURE_ATLAS_PAGE_SIZE)
+		return false;
+
+	// the rectangle sits on the highest segment underneath it.
+	int widthLeft = (int)width;
+	y = page.Skyline[node].Y;
+
+	for (size_t i = node; widthLeft > 0; i++)
+	{
+		y = std::max(y, page.Skyline[i].Y);
+
+		// goes past the top of the page.
+		if (y + height > TEXTURE_ATLAS_PAGE_SIZE)
+			return false;
+
+		widthLeft -= (int)page.Skyline[i].Width;
+	}
+
+	return true;
+}
+
+// packs the rectangle
+bool cherry::TextureAtlas::__Pack(Page& page, uint32_t width, uint32_t height, glm::u32vec2& position)
+{
+	size_t best = page.Skyline.size();
+	uint32_t bestTop = UINT32_MAX, bestWidth = UINT32_MAX;
+	uint32_t y = 0;
+
+	// finds the node where the top of the rectangle would be the lowest.
+	// if there's a tie, the narrower segment is used so that wide gaps are left for wide images.
+	for (size_t i = 0; i < page.Skyline.size(); i++)
+	{
+		if (!__FitsAt(page, i, width, height, y))
+			continue;
+
+		if (y + height < bestTop || (y + height == bestTop && page.Skyline[i].Width < bestWidth))
+		{
+			best = i;
+			bestTop = y + height;
+			bestWidth = page.Skyline[i].Width;
+			position = glm::u32vec2(page.Skyline[i].X, y);
+		}
+	}
+
+	// the page is full
+	if (best == page.Skyline.size())
+		return false;
+
+	// the new segment is the top of the rectangle.
+	page.Skyline.insert(page.Skyline.begin() + best, SkylineNode{ position.x, position.y + height, width });
+
+	// the segments underneath the rectangle are shortened or removed.
+	for (size_t i = best + 1; i < page.Skyline.size(); i++)
+	{
+		SkylineNode& prev = page.Skyline[i - 1];
+		SkylineNode& node = page.Skyline[i];
+
+		// the segment isn't underneath the rectangle.
+		if (node.X >= prev.X + prev.Width)
+			break;
+
+		uint32_t shrink = prev.X + prev.Width - node.X;
+
+		if (shrink < node.Width)
+		{
+			node.X += shrink;
+			node.Width -= shrink;
+			break;
+		}
+
+		page.Skyline.erase(page.Skyline.begin() + i);
+		i--;
+	}
+
+	// segments next to each other at the same height are merged.
+	for (size_t i = 0; i + 1 < page.Skyline.size(); i++)
+	{
+		if (page.Skyline[i].Y == page.Skyline[i + 1].Y)
+		{
+			page.Skyline[i].Width += page.Skyline[i + 1].Width;
+			page.Skyline.erase(page.Skyline.begin() + i + 1);
+			i--;
+		}
+	}
+
+	return true;
+}
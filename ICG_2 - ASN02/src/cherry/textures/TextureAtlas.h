@@ -0,0 +1,99 @@
+// TextureAtlas (Header) - packs small images into shared texture pages, so that they can be drawn together.
+#pragma once
+#include <GLM/glm.hpp>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "Texture2D.h"
+#include "..\Material.h"
+
+// the width and height of each atlas page.
+#define TEXTURE_ATLAS_PAGE_SIZE 2048
+
+// the largest side length an image can have to be put into the atlas. Larger images get their own texture.
+#define TEXTURE_ATLAS_MAX_SIDE 256
+
+// the keyword for the image shader variant that the pages use, which moves each sprite's uvs into its frame (see SpriteFrame).
+#define TEXTURE_ATLAS_KEYWORD ("SPRITE_BATCH")
+
+// the amount of pixels around each image. The edges of the image are copied into it so that filtering doesn't pick up other images.
+#define TEXTURE_ATLAS_PADDING 2
+
+namespace cherry
+{
+	// where an image was put in the atlas.
+	struct AtlasRegion
+	{
+		int Page = -1; // the page the image is on (-1 if it isn't in the atlas)
+		glm::u32vec2 Position = glm::u32vec2(0); // the position of the image on the page (in pixels), without the padding.
+		glm::u32vec2 Size = glm::u32vec2(0); // the size of the image (in pixels).
+	};
+
+	/*
+	 * Images are packed into pages using a skyline packer.
+	 * The skyline is the top edge of the images that have been placed. Each image is put at the lowest point along the skyline it fits in.
+	 * Every page has one material (the image shader with the page as its texture), which is shared by all the images on the page.
+	 * Since the images share a material, the render queue puts them next to each other, and they're drawn in one batch (see SpriteBatch).
+	*/
+	class TextureAtlas
+	{
+	public:
+		// adds an image file to the atlas. If the file is already in the atlas, its region is returned.
+		// returns 'false' if the file couldn't be loaded, or if the image is too large to be put in the atlas.
+		static bool Add(const std::string& filePath, AtlasRegion& region);
+
+		// returns 'true' if the file is in the atlas.
+		static bool Contains(const std::string& filePath);
+
+		// converts uvs for the whole image (0 - 1) to uvs for the image's region on its page.
+		// uvs are (x0, y0, x1, y1), the same as the ones used by Image.
+		static glm::vec4 ConvertToPageUVs(const AtlasRegion& region, const glm::vec4& uvs);
+
+		// gets the texture for a page.
+		static Texture2D::Sptr GetPageTexture(int page);
+
+		// gets the material for a page.
+		static Material::Sptr GetPageMaterial(int page);
+
+		// gets the amount of pages.
+		static size_t GetPageCount();
+
+		// gets the amount of images in the atlas.
+		static size_t GetImageCount();
+
+		// deletes all the pages. The images that were using them should be deleted first.
+		static void Clear();
+
+	private:
+		// a segment of the skyline.
+		struct SkylineNode
+		{
+			uint32_t X;
+			uint32_t Y;
+			uint32_t Width;
+		};
+
+		// a page in the atlas.
+		struct Page
+		{
+			Texture2D::Sptr Texture;
+			Material::Sptr Material;
+			std::vector<SkylineNode> Skyline;
+		};
+
+		// makes a new page.
+		static void __AddPage();
+
+		// finds the y position that a rectangle would be placed at if its left side is at the start of the node.
+		// returns 'false' if it doesn't fit.
+		static bool __FitsAt(const Page& page, size_t node, uint32_t width, uint32_t height, uint32_t& y);
+
+		// finds a place for the rectangle on the page, and adds it to the skyline.
+		// returns 'false' if the page doesn't have room.
+		static bool __Pack(Page& page, uint32_t width, uint32_t height, glm::u32vec2& position);
+
+		static std::vector<Page> pages;
+		static std::unordered_map<std::string, AtlasRegion> regions; // the regions, found by their file paths.
+	};
+}
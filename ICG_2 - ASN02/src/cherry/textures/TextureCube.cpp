@@ -1,44 +1,75 @@
 // TextureCube - used for making cube maps; taken from the Computer Graphics framework.
 #include "TextureCube.h"
+#include "..\GLState.h"
 #include <toolkit/Logging.h>
 #include <stbs/stb_image.h>
+#include <GLM/gtc/integer.hpp>
+#include <fstream>
+#include <string.h>
+
+// the cube maps that have been loaded
+std::unordered_map<std::string, cherry::TextureCube::Sptr> cherry::TextureCube::loadedCubes;
 
 cherry::TextureCube::TextureCube(const TextureCubeDesc& desc) {
 	myDesc = desc;
 	myHandle = 0;
 	__InitTexture();
 }
-cherry::TextureCube::~TextureCube() { glDeleteTextures(1, &myHandle); }
+cherry::TextureCube::~TextureCube()
+{
+	GLState::ForgetTexture(myHandle);
+	glDeleteTextures(1, &myHandle);
+}
 
-void cherry::TextureCube::Bind(int slot) { glBindTextureUnit(slot, myHandle); }
+void cherry::TextureCube::Bind(int slot) { GLState::BindTextureUnit(slot, myHandle); }
 
-void cherry::TextureCube::Unbind(int slot) { glBindTextureUnit(slot, 0); }
+void cherry::TextureCube::Unbind(int slot) { GLState::BindTextureUnit(slot, 0); }
 
 void cherry::TextureCube::__InitTexture() {
 	GLenum format = (GLenum)myDesc.Format;
 
+	// the full mip chain goes down to 1 x 1, so there's one more level than log2 of the size.
+	int fullChain = glm::log2(glm::max(myDesc.Size, 1u)) + 1;
+	myDesc.MipLevels = myDesc.MipLevels == -1 ? fullChain : glm::clamp(myDesc.MipLevels, 1, fullChain);
+
 	// only differece from Texture2D and this class is that we use GL_TEXTURE_CUBE_MAP here.
 	glCreateTextures(GL_TEXTURE_CUBE_MAP, 1, &myHandle);
 
 	glTextureParameteri(myHandle, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
 	glTextureParameteri(myHandle, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTextureParameteri(myHandle, GL_TEXTURE_MIN_FILTER, (GLenum)MinFilter::Linear);
+	glTextureParameteri(myHandle, GL_TEXTURE_MIN_FILTER, (GLenum)(myDesc.MipLevels > 1 ? MinFilter::LinearMipLinear : MinFilter::Linear));
 	glTextureParameteri(myHandle, GL_TEXTURE_MAG_FILTER, (GLenum)MagFilter::Linear);
-	glTextureStorage2D(myHandle, 1, format, myDesc.Size, myDesc.Size);
+	glTextureStorage2D(myHandle, myDesc.MipLevels, format, myDesc.Size, myDesc.Size);
 }
 
 void cherry::TextureCube::LoadData(uint32_t width, uint32_t height, CubeMapFace face, PixelFormat format, PixelType type, void* data) {
 	glTextureSubImage3D(myHandle, 0, 0, 0, (int)face, myDesc.Size, myDesc.Size, 1, (GLenum)format, (GLenum)type, data);
 }
 
+// generates the mipmaps
+void cherry::TextureCube::GenerateMipmaps()
+{
+	if (myDesc.MipLevels > 1)
+		glGenerateTextureMipmap(myHandle);
+}
+
 cherry::TextureCube::Sptr cherry::TextureCube::LoadFromFiles(const std::string faceFiles[6]) {
+	// the key is all six files, since the same image can be used for more than one face.
+	std::string key = faceFiles[0];
+	for (int ix = 1; ix < 6; ix++)
+		key += "|" + faceFiles[ix];
+
+	std::unordered_map<std::string, Sptr>::iterator iter = loadedCubes.find(key);
+
+	if (iter != loadedCubes.end())
+		return iter->second;
+
 	TextureCubeDesc desc = TextureCubeDesc();
 	desc.Format = InternalFormat::RGB8;
-	stbi_set_flip_vertically_on_load(true);
 	Sptr result = nullptr;
 	
 	for (int ix = 0; ix < 6; ix++) {
-		int width, height, numChannels;
+		int width = 0, height = 0, numChannels = 0;
 		void* data = stbi_load(faceFiles[ix].c_str(), &width, &height, &numChannels, 3);
 		if (desc.Size != 0 && ((width != desc.Size) | (height != desc.Size))) {
 			stbi_image_free(data);
@@ -54,6 +85,7 @@ cherry::TextureCube::Sptr cherry::TextureCube::LoadFromFiles(const std::string f
 			result = std::make_shared<TextureCube>(desc);
 		}
 		if (data != nullptr && width != 0 && height != 0 && numChannels != 0) {
+			Texture2D::FlipImage(data, width, height, 3);
 			result->LoadData(width, height, (CubeMapFace)ix,
 				numChannels == 4 ? PixelFormat::Rgba : PixelFormat::Rgb,
 				PixelType::UByte, data);
@@ -64,5 +96,192 @@ cherry::TextureCube::Sptr cherry::TextureCube::LoadFromFiles(const std::string f
 		}
 		
 	}
+
+	// the images only fill in the first level, so the rest are made from it.
+	if (result != nullptr) {
+		result->GenerateMipmaps();
+		loadedCubes[key] = result;
+	}
+
 	return result;
-}
\ No newline at end of file
+}
+
+// loads a cube map file
+cherry::TextureCube::Sptr cherry::TextureCube::LoadFromFile(const std::string& filePath)
+{
+	std::unordered_map<std::string, Sptr>::iterator iter = loadedCubes.find(filePath);
+
+	if (iter != loadedCubes.end())
+		return iter->second;
+
+	std::ifstream file(filePath, std::ios::in | std::ios::binary | std::ios::ate);
+
+	if (!file) {
+		LOG_WARN("Cube map file \"{}\" could not be opened.", filePath);
+		return nullptr;
+	}
+
+	// the whole file is read in one go.
+	std::vector<char> data((size_t)file.tellg());
+	file.seekg(0, std::ios::beg);
+	file.read(data.data(), data.size());
+	file.close();
+
+	CubeMapFileHeader header;
+
+	if (data.size() >= sizeof(CubeMapFileHeader))
+		memcpy(&header, data.data(), sizeof(CubeMapFileHeader));
+
+	if (data.size() < sizeof(CubeMapFileHeader) || memcmp(header.Magic, CubeMapFileHeader().Magic, 4) != 0 ||
+		header.Version != CubeMapFileHeader().Version || header.Size == 0 || header.MipLevels == 0 ||
+		header.MipLevels > (uint32_t)glm::log2(header.Size) + 1) {
+		LOG_WARN("\"{}\" is not a cube map file.", filePath);
+		return nullptr;
+	}
+
+	TextureCubeDesc desc = TextureCubeDesc();
+	desc.Size = header.Size;
+	desc.Format = (InternalFormat)header.Format;
+	desc.MipLevels = header.MipLevels;
+
+	// only the formats that Save() writes can be loaded. Anything else would have the wrong level sizes, or be an invalid format.
+	if (desc.Format != InternalFormat::BC1 && desc.Format != InternalFormat::BC6H &&
+		desc.Format != InternalFormat::RGBA8 && desc.Format != InternalFormat::RGB8) {
+		LOG_WARN("Cube map file \"{}\" has an unsupported format ({}).", filePath, header.Format);
+		return nullptr;
+	}
+
+	bool compressed = IsCompressedFormat(desc.Format);
+
+	// the levels that aren't compressed are always saved as RGBA bytes (see Save()).
+	if (!compressed && (header.PixelFormat != (uint32_t)PixelFormat::Rgba || header.PixelType != (uint32_t)PixelType::UByte)) {
+		LOG_WARN("Cube map file \"{}\" has an unsupported pixel format.", filePath);
+		return nullptr;
+	}
+
+	// checks that every level is there before anything is made.
+	size_t total = sizeof(CubeMapFileHeader);
+	for (int level = 0; level < desc.MipLevels; level++)
+		total += GetLevelSize(desc.Format, desc.Size, level);
+
+	if (total > data.size()) {
+		LOG_WARN("Cube map file \"{}\" is missing some of its mip levels.", filePath);
+		return nullptr;
+	}
+
+	Sptr result = std::make_shared<TextureCube>(desc);
+	const char* levelData = data.data() + sizeof(CubeMapFileHeader);
+
+	// each level has all six faces, so it's uploaded as a 3D image that's six layers deep.
+	for (int level = 0; level < desc.MipLevels; level++) {
+		GLsizei side = glm::max(desc.Size >> level, 1u);
+		size_t levelSize = GetLevelSize(desc.Format, desc.Size, level);
+
+		if (compressed)
+			glCompressedTextureSubImage3D(result->myHandle, level, 0, 0, 0, side, side, 6, (GLenum)desc.Format, (GLsizei)levelSize, levelData);
+		else
+			glTextureSubImage3D(result->myHandle, level, 0, 0, 0, side, side, 6, GL_RGBA, GL_UNSIGNED_BYTE, levelData);
+
+		levelData += levelSize;
+	}
+
+	loadedCubes[filePath] = result;
+	return result;
+}
+
+// bakes a cube map file
+bool cherry::TextureCube::Bake(const std::string faceFiles[6], const std::string& filePath, InternalFormat format)
+{
+	Sptr cube = LoadFromFiles(faceFiles);
+	return cube != nullptr && cube->Save(filePath, format);
+}
+
+// saves the cube map
+bool cherry::TextureCube::Save(const std::string& filePath, InternalFormat format) const
+{
+	bool compressed = IsCompressedFormat(format);
+
+	CubeMapFileHeader header;
+	header.Size = myDesc.Size;
+	header.MipLevels = myDesc.MipLevels;
+	header.Format = (uint32_t)format;
+	header.PixelFormat = compressed ? 0 : (uint32_t)PixelFormat::Rgba;
+	header.PixelType = compressed ? 0 : (uint32_t)PixelType::UByte;
+
+	std::vector<char> data(sizeof(CubeMapFileHeader));
+	memcpy(data.data(), &header, sizeof(CubeMapFileHeader));
+
+	// to compress the cube map, each level is copied into a texture with the compressed format, which the driver compresses.
+	Sptr converted = nullptr;
+	std::vector<char> pixels;
+
+	if (compressed && format != myDesc.Format) {
+		TextureCubeDesc desc = myDesc;
+		desc.Format = format;
+		converted = std::make_shared<TextureCube>(desc);
+	}
+
+	for (int level = 0; level < myDesc.MipLevels; level++) {
+		GLsizei side = glm::max(myDesc.Size >> level, 1u);
+		size_t offset = data.size();
+		size_t levelSize = GetLevelSize(format, myDesc.Size, level);
+
+		data.resize(offset + levelSize);
+
+		if (converted != nullptr) {
+			pixels.resize(GetLevelSize(InternalFormat::RGBA8, myDesc.Size, level));
+			glGetTextureSubImage(myHandle, level, 0, 0, 0, side, side, 6, GL_RGBA, GL_UNSIGNED_BYTE, (GLsizei)pixels.size(), pixels.data());
+			glTextureSubImage3D(converted->myHandle, level, 0, 0, 0, side, side, 6, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		}
+
+		if (compressed)
+			glGetCompressedTextureSubImage(converted != nullptr ? converted->myHandle : myHandle, level, 0, 0, 0, side, side, 6, (GLsizei)levelSize, data.data() + offset);
+		else
+			glGetTextureSubImage(myHandle, level, 0, 0, 0, side, side, 6, GL_RGBA, GL_UNSIGNED_BYTE, (GLsizei)levelSize, data.data() + offset);
+	}
+
+	std::ofstream file(filePath, std::ios::out | std::ios::binary);
+
+	if (!file) {
+		LOG_WARN("Cube map file \"{}\" could not be written.", filePath);
+		return false;
+	}
+
+	file.write(data.data(), data.size());
+	return file.good();
+}
+
+// gets the size
+uint32_t cherry::TextureCube::GetSize() const { return myDesc.Size; }
+
+// gets the format
+cherry::InternalFormat cherry::TextureCube::GetFormat() const { return myDesc.Format; }
+
+// gets the amount of mip levels
+int cherry::TextureCube::GetMipLevels() const { return myDesc.MipLevels; }
+
+// checks if the format is compressed
+bool cherry::TextureCube::IsCompressedFormat(InternalFormat format)
+{
+	return format == InternalFormat::BC1 || format == InternalFormat::BC6H;
+}
+
+// gets the size of a level
+size_t cherry::TextureCube::GetLevelSize(InternalFormat format, uint32_t size, int level, PixelFormat pixelFormat, PixelType pixelType)
+{
+	size_t side = glm::max(size >> level, 1u);
+	size_t blocks = ((side + 3) / 4) * ((side + 3) / 4); // the compressed formats use 4 x 4 blocks, even for levels smaller than that.
+
+	switch (format)
+	{
+	case InternalFormat::BC1:
+		return blocks * 8 * 6;
+	case InternalFormat::BC6H:
+		return blocks * 16 * 6;
+	default:
+		return side * side * GetTexelSize(pixelFormat, pixelType) * 6;
+	}
+}
+
+// clears the loaded cube maps
+void cherry::TextureCube::ClearLoaded() { loadedCubes.clear(); }
\ No newline at end of file
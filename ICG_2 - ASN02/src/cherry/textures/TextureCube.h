@@ -2,10 +2,15 @@
 #pragma once
 #include <glad/glad.h>
 #include <string>
+#include <vector>
+#include <unordered_map>
 #include <toolkit/EnumToString.h>
 #include "Texture2D.h"
 #include "..\UtilsCRY.h"
 
+// the extension used for cube map files (see TextureCube::Bake()).
+#define CUBE_MAP_FILE_EXTENSION ".cubemap"
+
 namespace cherry
 {
 	// this is how the cube map refers to its faces.
@@ -21,6 +26,24 @@ namespace cherry
 	struct TextureCubeDesc {
 		uint32_t Size = 0;
 		InternalFormat Format = InternalFormat::RGBA8;
+		int MipLevels = -1; // if this is -1, the full mip chain is made (down to 1 x 1).
+	};
+
+	/*
+	 * The start of a cube map file. The file has every mip level of the cube map, from largest to smallest.
+	 * Each level has the six faces one after the other (in CubeMapFace order), so a level is uploaded with a single call.
+	 * If the format is compressed (see TextureCube::IsCompressedFormat()), the levels are stored exactly as OpenGL takes them.
+	 * Otherwise, they're stored as the pixel format and type in the header.
+	*/
+	struct CubeMapFileHeader {
+		char Magic[4] = { 'C', 'U', 'B', 'E' };
+		uint32_t Version = 1;
+		uint32_t Size = 0; // the width and height of each face on the first level.
+		uint32_t MipLevels = 0;
+		uint32_t Format = 0; // the internal format.
+		uint32_t PixelFormat = 0; // only used if the format isn't compressed.
+		uint32_t PixelType = 0; // only used if the format isn't compressed.
+		uint32_t Reserved = 0;
 	};
 
 	class TextureCube {
@@ -30,14 +53,57 @@ namespace cherry
 		virtual ~TextureCube();
 
 		// loading from six different files for now.
+		// this only loads the first mip level. Call GenerateMipmaps() once all of the faces are loaded.
 		void LoadData(uint32_t width, uint32_t height, CubeMapFace face, PixelFormat format, PixelType type, void* data);
+
+		// fills in the other mip levels from the first one on the GPU.
+		void GenerateMipmaps();
+
+		// loads the cube map from six image files, and generates its mipmaps on the GPU.
+		// if the same files were already loaded, the same texture is returned.
 		static Sptr LoadFromFiles(const std::string faceFiles[6]);
+
+		// loads a cube map file (see Bake()) with a single read. Every mip level is uploaded as it is, so nothing is decoded or generated.
+		// if the file was already loaded, the same texture is returned. A nullptr is returned if the file couldn't be used.
+		static Sptr LoadFromFile(const std::string& filePath);
+
+		// loads six face images, and saves them as a cube map file with all of its mipmaps.
+		// this is meant to be done once ahead of time, so that the game can use LoadFromFile() instead of decoding the images.
+		// if the format is compressed, the driver compresses the faces. Returns 'true' if the file was written.
+		static bool Bake(const std::string faceFiles[6], const std::string& filePath, InternalFormat format = InternalFormat::BC1);
+
+		// saves the cube map as a cube map file, converting it to the provided format.
+		// this reads the texture back from the GPU, so it shouldn't be used while the game is running. Returns 'true' if the file was written.
+		bool Save(const std::string& filePath, InternalFormat format = InternalFormat::RGBA8) const;
+
 		void Bind(int slot);
 		static void Unbind(int slot);
 
+		// gets the width and height of each face.
+		uint32_t GetSize() const;
+
+		// gets the internal format.
+		InternalFormat GetFormat() const;
+
+		// gets the amount of mip levels.
+		int GetMipLevels() const;
+
+		// returns 'true' if the format is block compressed.
+		static bool IsCompressedFormat(InternalFormat format);
+
+		// gets the size of a mip level (all six faces) in bytes. For formats that aren't compressed, the pixel format and type are used.
+		static size_t GetLevelSize(InternalFormat format, uint32_t size, int level, PixelFormat pixelFormat = PixelFormat::Rgba, PixelType pixelType = PixelType::UByte);
+
+		// removes the loaded cube maps, so they're loaded again the next time they're asked for.
+		// the cube maps that are still being used aren't deleted until they're no longer used.
+		static void ClearLoaded();
+
 	protected:
 		GLuint myHandle;
 		TextureCubeDesc myDesc;
 		void __InitTexture();
+
+		// the cube maps that have been loaded, by their file (or their face files).
+		static std::unordered_map<std::string, Sptr> loadedCubes;
 	};
-}
\ No newline at end of file
+}
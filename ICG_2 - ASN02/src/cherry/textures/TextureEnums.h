@@ -3,6 +3,11 @@
 #include <toolkit/EnumToString.h>
 #include <glad/glad.h>
 
+// S3TC isn't part of core OpenGL, so glad doesn't define it.
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
 namespace cherry
 {
 	// Formats: https://www.khronos.org/registry/OpenGL-Refpages/gl4/html/glTexImage2D.xhtml
@@ -15,7 +20,9 @@ namespace cherry
 		RGB8 = GL_RGB8,
 		RGB16 = GL_RGB16,
 		RGBA8 = GL_RGBA8,
-		RGBA16 = GL_RGBA16
+		RGBA16 = GL_RGBA16,
+		BC1 = GL_COMPRESSED_RGB_S3TC_DXT1_EXT, // block compressed (8 bytes per 4 x 4 block).
+		BC6H = GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT // block compressed HDR (16 bytes per 4 x 4 block).
 		// Note: there are sized internal formats, but there are a LOT of them.
 	);
 
@@ -1,5 +1,6 @@
 // Texture Sampler - used for mipmapping; taken from the Computer Graphics framework
 #include "TextureSampler.h"
+#include "..\GLState.h"
 #include <GLM/gtc/type_ptr.hpp>
 
 // essentially just copying parameters into our OpenGL state.
@@ -17,11 +18,12 @@ cherry::TextureSampler::TextureSampler(const SamplerDesc& desc) {
 }
 
 cherry::TextureSampler::~TextureSampler() {
+	GLState::ForgetSampler(myHandle);
 	glDeleteSamplers(1, &myHandle);
 }
 void cherry::TextureSampler::Bind(uint32_t slot) {
-	glBindSampler(slot, myHandle);
+	GLState::BindSampler(slot, myHandle);
 }
 void cherry::TextureSampler::Unbind(uint32_t slot) {
-	glBindSampler(slot, 0);
+	GLState::BindSampler(slot, 0);
 }
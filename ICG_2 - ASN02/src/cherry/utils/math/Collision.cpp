@@ -746,3 +746,96 @@ bool util::math::sphereOBBCollision(const Sphere& sphere, const Box3D& box, cons
 	return sphereOBBCollision(sphere.position, sphere.radius,
 		box.position, box.width, box.height, box.depth, box.rotation, inDegrees, box.rotationOrder);
 }
+
+// CONTINUOUS COLLISION
+// line-AABB collision (slab test)
+bool util::math::lineAABBCollision(const Vec3 lineStart, const Vec3 lineEnd, const Vec3 aabbMin, const Vec3 aabbMax, float& t)
+{
+	Vec3 dir = lineEnd - lineStart;
+
+	// the line is inside the box between the last time it enters a slab and the first time it leaves one.
+	float tEnter = 0.0F, tExit = 1.0F;
+
+	for (int i = 0; i < 3; i++)
+	{
+		// the line doesn't move on this axis, so it's either always in the slab or never in it.
+		if (fabsf(dir[i]) < 1.0E-8F)
+		{
+			if (lineStart[i] < aabbMin[i] || lineStart[i] > aabbMax[i])
+				return false;
+
+			continue;
+		}
+
+		float t0 = (aabbMin[i] - lineStart[i]) / dir[i];
+		float t1 = (aabbMax[i] - lineStart[i]) / dir[i];
+
+		tEnter = fmaxf(tEnter, fminf(t0, t1));
+		tExit = fminf(tExit, fmaxf(t0, t1));
+
+		if (tEnter > tExit)
+			return false;
+	}
+
+	t = tEnter;
+	return true;
+}
+
+// swept sphere-sphere collision
+bool util::math::sweptSphereCollision(const Vec3 startA, const Vec3 endA, const float radiusA, const Vec3 startB, const Vec3 endB, const float radiusB, float& toi)
+{
+	// sphere A moves relative to sphere B, which is treated as being still.
+	Vec3 s = startA - startB;
+	Vec3 d = (endA - startA) - (endB - startB);
+	float r = radiusA + radiusB;
+
+	// the spheres touch when |s + d * t| = r, which is a quadratic in t.
+	float a = d.dot(d);
+	float b = 2.0F * s.dot(d);
+	float c = s.dot(s) - r * r;
+
+	// already touching
+	if (c <= 0.0F)
+	{
+		toi = 0.0F;
+		return true;
+	}
+
+	// not moving relative to each other, or moving apart.
+	if (a < 1.0E-12F || b >= 0.0F)
+		return false;
+
+	float disc = b * b - 4.0F * a * c;
+
+	if (disc < 0.0F)
+		return false;
+
+	float t = (-b - sqrtf(disc)) / (2.0F * a);
+
+	if (t > 1.0F)
+		return false;
+
+	toi = t;
+	return true;
+}
+
+// swept sphere-AABB collision
+bool util::math::sweptSphereAABBCollision(const Vec3 sphereStart, const Vec3 sphereEnd, const float sphereRadius,
+	const Vec3 aabbStart, const Vec3 aabbEnd, const float aabbWidth, const float aabbHeight, const float aabbDepth, float& toi)
+{
+	// the sphere's centre moves relative to the box, which is grown by the sphere's radius.
+	Vec3 halfSize = Vec3(aabbWidth / 2.0F + sphereRadius, aabbHeight / 2.0F + sphereRadius, aabbDepth / 2.0F + sphereRadius);
+	Vec3 end = sphereStart + (sphereEnd - sphereStart) - (aabbEnd - aabbStart);
+
+	return lineAABBCollision(sphereStart, end, aabbStart - halfSize, aabbStart + halfSize, toi);
+}
+
+// swept AABB-AABB collision
+bool util::math::sweptAABBCollision(const Vec3 startA, const Vec3 endA, const Vec3 sizeA, const Vec3 startB, const Vec3 endB, const Vec3 sizeB, float& toi)
+{
+	// box A's centre moves relative to box B, which is grown by the size of box A.
+	Vec3 halfSize = (sizeA + sizeB) / 2.0F;
+	Vec3 end = startA + (endA - startA) - (endB - startB);
+
+	return lineAABBCollision(startA, end, startB - halfSize, startB + halfSize, toi);
+}
@@ -118,6 +118,25 @@ namespace util
 		// sphere and OBB collision with sphere and box.
 		bool sphereOBBCollision(const Sphere& sphere, const Box3D& box, const bool inDegrees);
 
+		// Continuous (swept) collisions
+		// these check for collision between shapes that move in a straight line over a step (e.g. a frame), so fast shapes can't pass through each other between steps.
+		// 'toi' is the time of impact, which is how far through the step the shapes first touch (0 = the start of the step, 1 = the end of the step).
+		// if the shapes are already touching at the start of the step, the time of impact is 0.
+
+		// collision between a line segment and an AABB, given by its minimum and maximum. 't' is how far along the line the box is entered (0 - 1).
+		bool lineAABBCollision(const Vec3 lineStart, const Vec3 lineEnd, const Vec3 aabbMin, const Vec3 aabbMax, float& t);
+
+		// swept sphere-sphere collision. Both spheres move from their start positions to their end positions over the step.
+		bool sweptSphereCollision(const Vec3 startA, const Vec3 endA, const float radiusA, const Vec3 startB, const Vec3 endB, const float radiusB, float& toi);
+
+		// swept sphere-AABB collision. The sphere and the box both move from their start positions to their end positions over the step.
+		// the box is grown by the sphere's radius, so around the box's corners the contact is found slightly early.
+		bool sweptSphereAABBCollision(const Vec3 sphereStart, const Vec3 sphereEnd, const float sphereRadius,
+			const Vec3 aabbStart, const Vec3 aabbEnd, const float aabbWidth, const float aabbHeight, const float aabbDepth, float& toi);
+
+		// swept AABB-AABB collision. The positions are the centres of the boxes, and the sizes are (width, height, depth).
+		bool sweptAABBCollision(const Vec3 startA, const Vec3 endA, const Vec3 sizeA, const Vec3 startB, const Vec3 endB, const Vec3 sizeB, float& toi);
+
 		// calculates seperating axis theorem collision.
 		// float satCollision();
 	}